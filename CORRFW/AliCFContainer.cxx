@@ -123,6 +123,66 @@ void AliCFContainer::Fill(const Double_t *var, Int_t istep, Double_t weight)
   fGrid[istep]->Fill(var,weight);
 }
 
+//____________________________________________________________________
+void AliCFContainer::FillSteps(const Double_t *var, Int_t nSteps, const Int_t *steps, Double_t weight)
+{
+  //
+  // Fills the grids of the nSteps selection steps listed in steps for a 
+  // set of values of the input variables, with a given weight (by default w=1)
+  // The bin coordinates are computed once on the axes of step 0, and only 
+  // the bin look-up is repeated for each step. A step whose grid has another 
+  // binning (see SetGrid) is recognised because the values do not fall in the 
+  // same bins of its axes, and is filled with its own FindBin as in Fill.
+  //
+  if (nSteps <= 0 || fNStep <= 0) return;
+
+  const Int_t kMaxVar = 16;
+  Int_t  nVar = GetNVar();
+  Int_t  coordBuf[kMaxVar];
+  Int_t* coord = (nVar <= kMaxVar ? coordBuf : new Int_t[nVar]);
+
+  THnSparse* grid = fGrid[0]->GetGrid();
+  for (Int_t iVar=0; iVar<nVar; iVar++) coord[iVar] = grid->GetAxis(iVar)->FindBin(var[iVar]);
+
+  for (Int_t i=0; i<nSteps; i++) {
+    Int_t istep = steps[i];
+    if(istep >= fNStep || istep < 0){
+      AliError("Non-existent selection step, grid was not filled");
+      continue;
+    }
+    grid = fGrid[istep]->GetGrid();
+    if (istep != 0 && !InSameBins(grid,coord,var)) {
+      fGrid[istep]->Fill(var,weight);
+      continue;
+    }
+    grid->FillBin(grid->GetBin(coord,kTRUE),weight);
+  }
+  if (coord != coordBuf) delete [] coord;
+}
+
+//____________________________________________________________________
+Bool_t AliCFContainer::InSameBins(const THnSparse* grid, const Int_t *coord, const Double_t *var) const
+{
+  //
+  // Checks that the values var fall in the bins coord of the axes of grid,
+  // i.e. that FindBin on these axes would return coord (constant time,
+  // whatever the binning)
+  //
+  Int_t nVar = GetNVar();
+  for (Int_t iVar=0; iVar<nVar; iVar++) {
+    const TAxis* axis = grid->GetAxis(iVar);
+    Int_t bin = coord[iVar];
+    if (bin <= 0) {
+      if (!(var[iVar] < axis->GetXmin())) return kFALSE;
+    }
+    else if (bin > axis->GetNbins()) {
+      if (bin != axis->GetNbins()+1 || var[iVar] < axis->GetXmax()) return kFALSE;
+    }
+    else if (var[iVar] < axis->GetBinLowEdge(bin) || !(var[iVar] < axis->GetBinUpEdge(bin))) return kFALSE;
+  }
+  return kTRUE;
+}
+
 //____________________________________________________________________
 TH1* AliCFContainer::Project(Int_t istep, Int_t ivar1, Int_t ivar2, Int_t ivar3) const
 {
@@ -62,6 +62,10 @@ class AliCFContainer : public AliCFFrame
   virtual Int_t GetNStep() const {return fNStep;};
   virtual void  SetNStep(Int_t nStep) {fNStep=nStep;}
   virtual void  Fill(const Double_t *var, Int_t istep, Double_t weight=1.) ;
+  // fill the nSteps selection steps listed in steps (e.g. all the steps passed
+  // by a particle) at once : the bin coordinates are computed only once
+  // (steps with another binning than step 0 are filled as in Fill)
+  virtual void  FillSteps(const Double_t *var, Int_t nSteps, const Int_t *steps, Double_t weight=1.) ;
 
   virtual Float_t  GetOverFlows (Int_t var,Int_t istep,Bool_t excl=kFALSE) const;
   virtual Float_t  GetUnderFlows(Int_t var,Int_t istep,Bool_t excl=kFALSE) const ;
@@ -94,6 +98,8 @@ class AliCFContainer : public AliCFFrame
   virtual TH3D* ShowProjection( Int_t ivar1, Int_t ivar2,Int_t ivar3, Int_t istep) const {return (TH3D*)Project(istep,ivar1,ivar2,ivar3);}
   
  private:
+  Bool_t InSameBins(const THnSparse* grid, const Int_t *coord, const Double_t *var) const;
+
   Int_t    fNStep; //number of selection steps
   AliCFGridSparse **fGrid;//[fNStep]
   
@@ -34,7 +34,13 @@ AliCFManager::AliCFManager() :
   fEvtContainer(0x0),
   fPartContainer(0x0),
   fEvtCutList(0x0),
-  fPartCutList(0x0)
+  fPartCutList(0x0),
+  fEvtSelCuts(0x0),
+  fEvtSelMask(0x0),
+  fEvtSelNCuts(0x0),
+  fPartSelCuts(0x0),
+  fPartSelMask(0x0),
+  fPartSelNCuts(0x0)
 { 
   //
   // ctor
@@ -48,7 +54,13 @@ AliCFManager::AliCFManager(const Char_t* name, const Char_t* title) :
   fEvtContainer(0x0),
   fPartContainer(0x0),
   fEvtCutList(0x0),
-  fPartCutList(0x0)
+  fPartCutList(0x0),
+  fEvtSelCuts(0x0),
+  fEvtSelMask(0x0),
+  fEvtSelNCuts(0x0),
+  fPartSelCuts(0x0),
+  fPartSelMask(0x0),
+  fPartSelNCuts(0x0)
 { 
    //
    // ctor
@@ -62,7 +74,13 @@ AliCFManager::AliCFManager(const AliCFManager& c) :
   fEvtContainer(c.fEvtContainer),
   fPartContainer(c.fPartContainer),
   fEvtCutList(c.fEvtCutList),
-  fPartCutList(c.fPartCutList)
+  fPartCutList(c.fPartCutList),
+  fEvtSelCuts(0x0),
+  fEvtSelMask(0x0),
+  fEvtSelNCuts(0x0),
+  fPartSelCuts(0x0),
+  fPartSelMask(0x0),
+  fPartSelNCuts(0x0)
 { 
    //
    //copy ctor
@@ -84,6 +102,7 @@ AliCFManager& AliCFManager::operator=(const AliCFManager& c)
   this->fPartContainer=c.fPartContainer;
   this->fEvtCutList=c.fEvtCutList;
   this->fPartCutList=c.fPartCutList;
+  ResetSelCache();
   return *this ;
 }
 
@@ -92,6 +111,20 @@ AliCFManager::~AliCFManager() {
    //
    //dtor
    //
+  ResetSelCache();
+}
+
+//_____________________________________________________________________________
+void AliCFManager::ResetSelCache() {
+  //
+  // drop the resolved cut selections
+  //
+  delete [] fEvtSelCuts;  fEvtSelCuts  = 0x0;
+  delete [] fEvtSelMask;  fEvtSelMask  = 0x0;
+  delete [] fEvtSelNCuts; fEvtSelNCuts = 0x0;
+  delete [] fPartSelCuts; fPartSelCuts = 0x0;
+  delete [] fPartSelMask; fPartSelMask = 0x0;
+  delete [] fPartSelNCuts; fPartSelNCuts = 0x0;
 }
 
 //_____________________________________________________________________________
@@ -105,14 +138,22 @@ Bool_t AliCFManager::CheckParticleCuts(Int_t isel, TObject *obj, const TString
     return kTRUE;
   }
   if(!fPartCutList[isel])return kTRUE;
-  TObjArrayIter iter(fPartCutList[isel]);
-  AliCFCutBase *cut = 0;
-  while ( (cut = (AliCFCutBase*)iter.Next()) ) {
-    TString cutName=cut->GetName();
-    Bool_t checkCut=CompareStrings(cutName,selcuts);
-    if(checkCut && !cut->IsSelected(obj)) return kFALSE;   
+  return CheckCuts(fPartCutList[isel],obj,selcuts,fPartSelCuts,fPartSelMask,fPartSelNCuts,fNStepPart,isel);
+}
+
+//_____________________________________________________________________________
+Bool_t AliCFManager::CheckParticleCuts(Int_t isel, TObject *obj, ULong64_t mask) const {
+  //
+  // check whether object obj passes the cuts in mask of particle-level 
+  // selection isel (see GetParticleCutsMask)
+  //
+
+  if(isel>=fNStepPart){
+    AliWarning(Form("Selection index out of Range! isel=%i, max. number of selections= %i", isel,fNStepPart));
+    return kTRUE;
   }
-  return kTRUE;
+  if(!fPartCutList[isel])return kTRUE;
+  return CheckCuts(fPartCutList[isel],obj,mask);
 }
 
 //_____________________________________________________________________________
@@ -126,16 +167,121 @@ Bool_t AliCFManager::CheckEventCuts(Int_t isel, TObject *obj, const TString  &se
       return kTRUE;
   }
   if(!fEvtCutList[isel])return kTRUE;
-  TObjArrayIter iter(fEvtCutList[isel]);
-  AliCFCutBase *cut = 0;
-  while ( (cut = (AliCFCutBase*)iter.Next()) ) {
-    TString cutName=cut->GetName();
-    Bool_t checkCut=CompareStrings(cutName,selcuts);
-    if(checkCut && !cut->IsSelected(obj)) return kFALSE;   
+  return CheckCuts(fEvtCutList[isel],obj,selcuts,fEvtSelCuts,fEvtSelMask,fEvtSelNCuts,fNStepEvt,isel);
+}
+
+//_____________________________________________________________________________
+Bool_t AliCFManager::CheckEventCuts(Int_t isel, TObject *obj, ULong64_t mask) const {
+  //
+  // check whether object obj passes the cuts in mask of event-level 
+  // selection isel (see GetEventCutsMask)
+  //
+
+  if(isel>=fNStepEvt){
+    AliWarning(Form("Selection index out of Range! isel=%i, max. number of selections= %i", isel,fNStepEvt));
+    return kTRUE;
+  }
+  if(!fEvtCutList[isel])return kTRUE;
+  return CheckCuts(fEvtCutList[isel],obj,mask);
+}
+
+//_____________________________________________________________________________
+ULong64_t AliCFManager::GetEventCutsMask(Int_t isel, const TString &selcuts) const {
+  //
+  // resolve the cuts of event-level selection isel selected by selcuts
+  //
+
+  if(isel>=fNStepEvt){
+    AliWarning(Form("Selection index out of Range! isel=%i, max. number of selections= %i", isel,fNStepEvt));
+    return 0;
+  }
+  if(!fEvtCutList || !fEvtCutList[isel])return 0;
+  return ResolveCuts(fEvtCutList[isel],selcuts);
+}
+
+//_____________________________________________________________________________
+ULong64_t AliCFManager::GetParticleCutsMask(Int_t isel, const TString &selcuts) const {
+  //
+  // resolve the cuts of particle-level selection isel selected by selcuts
+  //
+
+  if(isel>=fNStepPart){
+    AliWarning(Form("Selection index out of Range! isel=%i, max. number of selections= %i", isel,fNStepPart));
+    return 0;
+  }
+  if(!fPartCutList || !fPartCutList[isel])return 0;
+  return ResolveCuts(fPartCutList[isel],selcuts);
+}
+
+//_____________________________________________________________________________
+ULong64_t AliCFManager::ResolveCuts(const TObjArray *cuts, const TString &selcuts) const {
+  //
+  // bit mask of the cuts in the list selected by selcuts
+  //
+
+  Int_t ncuts = cuts->GetEntriesFast();
+  if(ncuts>64){
+    AliError(Form("Cannot mask a list of %d cuts, only the first 64 are used",ncuts));
+    ncuts=64;
+  }
+  ULong64_t mask = 0;
+  for(Int_t icut=0; icut<ncuts; icut++){
+    AliCFCutBase *cut = (AliCFCutBase*)cuts->UncheckedAt(icut);
+    if(!cut)continue;
+    if(CompareStrings(cut->GetName(),selcuts)) mask |= (1ULL<<icut);
+  }
+  return mask;
+}
+
+//_____________________________________________________________________________
+Bool_t AliCFManager::CheckCuts(const TObjArray *cuts, TObject *obj, ULong64_t mask) const {
+  //
+  // check the cuts of the list in mask, in list order
+  //
+
+  for(Int_t icut=0; mask; icut++, mask>>=1){
+    if(!(mask & 1ULL))continue;
+    AliCFCutBase *cut = (AliCFCutBase*)cuts->UncheckedAt(icut);
+    if(cut && !cut->IsSelected(obj)) return kFALSE;
   }
   return kTRUE;
 }
 
+//_____________________________________________________________________________
+Bool_t AliCFManager::CheckCuts(const TObjArray *cuts, TObject *obj, const TString &selcuts,
+			       TString *&lastSel, ULong64_t *&lastMask, Int_t *&lastNCuts, Int_t nstep, Int_t isel) const {
+  //
+  // check the cuts of the list selected by selcuts. The selection is
+  // resolved once per step and string, and re-used as long as the same
+  // selcuts is passed and the number of cuts in the list does not change.
+  // A cut replaced in place in the list (same number of cuts) is not
+  // noticed: pass the list again with Set{Event,Particle}CutsList
+  //
+
+  if(cuts->GetEntriesFast()>64 || selcuts.IsNull()){
+    TObjArrayIter iter(cuts);
+    AliCFCutBase *cut = 0;
+    while ( (cut = (AliCFCutBase*)iter.Next()) ) {
+      TString cutName=cut->GetName();
+      Bool_t checkCut=CompareStrings(cutName,selcuts);
+      if(checkCut && !cut->IsSelected(obj)) return kFALSE;   
+    }
+    return kTRUE;
+  }
+  if(!lastSel){
+    lastSel  = new TString[nstep];
+    lastMask = new ULong64_t[nstep];
+    lastNCuts = new Int_t[nstep];
+    for(Int_t i=0; i<nstep; i++) {lastMask[i] = 0; lastNCuts[i] = -1;}
+  }
+  if(lastSel[isel].IsNull() || lastSel[isel]!=selcuts || lastNCuts[isel]!=cuts->GetEntriesFast()){
+    lastMask[isel]  = ResolveCuts(cuts,selcuts);
+    lastSel[isel]   = selcuts;
+    lastNCuts[isel] = cuts->GetEntriesFast();
+  }
+  return CheckCuts(cuts,obj,lastMask[isel]);
+}
+
 //_____________________________________________________________________________
 void  AliCFManager::SetMCEventInfo(const TObject *obj) const {
 
@@ -243,6 +389,7 @@ void AliCFManager::SetEventCutsList(Int_t isel, TObjArray* array) {
     return;
   }
   fEvtCutList[isel] = array;
+  if (fEvtSelCuts) fEvtSelCuts[isel] = "";
 }
 
 //_____________________________________________________________________________
@@ -267,4 +414,5 @@ void AliCFManager::SetParticleCutsList(Int_t isel, TObjArray* array) {
     return;
   }
   fPartCutList[isel] = array;
+  if (fPartSelCuts) fPartSelCuts[isel] = "";
 }
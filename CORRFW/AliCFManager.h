@@ -78,8 +78,8 @@ class AliCFManager : public TNamed
   }
   
   //Set the number of steps (already done if you have defined your containers)
-  virtual void SetNStepEvent   (Int_t nstep) {fNStepEvt  = nstep;}
-  virtual void SetNStepParticle(Int_t nstep) {fNStepPart = nstep;}
+  virtual void SetNStepEvent   (Int_t nstep) {fNStepEvt  = nstep; ResetSelCache();}
+  virtual void SetNStepParticle(Int_t nstep) {fNStepPart = nstep; ResetSelCache();}
 
   //Setter for event-level selection cut list at selection step isel
   virtual void SetEventCutsList(Int_t isel, TObjArray* array) ;
@@ -111,11 +111,22 @@ class AliCFManager : public TNamed
 
   //Cut Checkers: by default *all* the cuts of a given input list is checked 
   //(.and. of all cuts), but the user can select a subsample of cuts in the 
-  //list via the string argument selcuts
+  //list via the string argument selcuts. The selection is resolved once per
+  //step and string; it is resolved again when cuts are added to or removed 
+  //from the list, but a cut replaced in place in the list is only seen after 
+  //passing the list again with SetEventCutsList/SetParticleCutsList
  
   virtual Bool_t CheckEventCuts(Int_t isel, TObject *obj, const TString &selcuts="all") const;
   virtual Bool_t CheckParticleCuts(Int_t isel, TObject *obj, const TString &selcuts="all") const;
 
+  //The subsample of cuts selected by selcuts can also be resolved once 
+  //into a bit mask (bit i <-> cut i of the list), and the mask passed to
+  //the cut checkers. Only lists of up to 64 cuts can be masked.
+  virtual ULong64_t GetEventCutsMask(Int_t isel, const TString &selcuts="all") const;
+  virtual ULong64_t GetParticleCutsMask(Int_t isel, const TString &selcuts="all") const;
+  virtual Bool_t CheckEventCuts(Int_t isel, TObject *obj, ULong64_t mask) const;
+  virtual Bool_t CheckParticleCuts(Int_t isel, TObject *obj, ULong64_t mask) const;
+
  private:
   
   //number of steps
@@ -130,9 +141,22 @@ class AliCFManager : public TNamed
   //Particle-level selections
   TObjArray **fPartCutList ; //[fNStepPart] arrays of cuts for each particle-selection level
 
+  //Last selcuts string resolved at each step, and the corresponding mask
+  mutable TString   *fEvtSelCuts;  //! selcuts last used for each event-selection level
+  mutable ULong64_t *fEvtSelMask;  //! cuts selected by fEvtSelCuts
+  mutable Int_t     *fEvtSelNCuts; //! number of cuts in the list when fEvtSelMask was resolved
+  mutable TString   *fPartSelCuts; //! selcuts last used for each particle-selection level
+  mutable ULong64_t *fPartSelMask; //! cuts selected by fPartSelCuts
+  mutable Int_t     *fPartSelNCuts;//! number of cuts in the list when fPartSelMask was resolved
+
   Bool_t CompareStrings(const TString  &cutname,const TString  &selcuts) const;
+  ULong64_t ResolveCuts(const TObjArray *cuts, const TString &selcuts) const;
+  Bool_t CheckCuts(const TObjArray *cuts, TObject *obj, ULong64_t mask) const;
+  Bool_t CheckCuts(const TObjArray *cuts, TObject *obj, const TString &selcuts,
+		   TString *&lastSel, ULong64_t *&lastMask, Int_t *&lastNCuts, Int_t nstep, Int_t isel) const;
+  void ResetSelCache();
 
-  ClassDef(AliCFManager,2);
+  ClassDef(AliCFManager,4);
 };
 
 
@@ -52,6 +52,7 @@
 #include "AliCentrality.h"
 #include "AliOADBCentrality.h"
 #include "AliOADBContainer.h"
+#include "AliOADBObjectCache.h"
 #include "AliMultiplicity.h"
 #include "AliAODHandler.h"
 #include "AliAODHeader.h"
@@ -84,6 +85,7 @@ AliAnalysisTaskSE(),
   fAnalysisInput("ESD"),
   fIsMCInput(kFALSE),
   fCurrentRun(-1),
+  fOADBFileName(),
   fUseScaling(0),
   fUseCleaning(0),
   fFillHistos(0),
@@ -354,6 +356,7 @@ AliCentralitySelectionTask::AliCentralitySelectionTask(const char *name):
   fAnalysisInput("ESD"),
   fIsMCInput(kFALSE),
   fCurrentRun(-1),
+  fOADBFileName(),
   fUseScaling(0),
   fUseCleaning(0),
   fFillHistos(0),
@@ -634,6 +637,7 @@ AliCentralitySelectionTask::AliCentralitySelectionTask(const AliCentralitySelect
   fAnalysisInput(ana.fAnalysisInput),
   fIsMCInput(ana.fIsMCInput),
   fCurrentRun(ana.fCurrentRun),
+  fOADBFileName(),
   fUseScaling(ana.fUseScaling),
   fUseCleaning(ana.fUseCleaning),
   fFillHistos(ana.fFillHistos),
@@ -901,6 +905,7 @@ AliCentralitySelectionTask::~AliCentralitySelectionTask()
   if (fEsdTrackCuts) delete fEsdTrackCuts;
   if (fEsdTrackCutsExtra1) delete fEsdTrackCutsExtra1;
   if (fEsdTrackCutsExtra2) delete fEsdTrackCutsExtra2;
+  if (!fOADBFileName.IsNull()) AliOADBObjectCache::Instance()->Release(fOADBFileName,"Centrality");
 }  
 
 //________________________________________________________________________
@@ -2008,14 +2013,20 @@ Int_t AliCentralitySelectionTask::SetupRun(const AliVEvent* const esd)
   TString fileName =(Form("%s/COMMON/CENTRALITY/data/centrality.root", AliAnalysisManager::GetOADBPath()));
   AliInfo(Form("Setup Centrality Selection for run %d with file %s\n",fCurrentRun,fileName.Data()));
 
-  AliOADBContainer *con = new AliOADBContainer("OADB");
-  con->InitFromFile(fileName,"Centrality");
+  // the container is read once per process and shared with the other tasks
+  AliOADBObjectCache *cache = AliOADBObjectCache::Instance();
+  if (!fOADBFileName.EqualTo(fileName)) {
+    if (!fOADBFileName.IsNull()) cache->Release(fOADBFileName,"Centrality");
+    fOADBFileName = "";
+    if (!cache->Acquire(fileName,"Centrality")) AliFatal(Form("Cannot read centrality OADB from %s", fileName.Data()));
+    fOADBFileName = fileName;
+  }
 
   AliOADBCentrality*  centOADB = 0;
-  centOADB = (AliOADBCentrality*)(con->GetObject(fCurrentRun));
+  centOADB = (AliOADBCentrality*)(cache->GetObject(fileName,"Centrality",fCurrentRun));
   if (!centOADB) {
     AliWarning(Form("Centrality OADB does not exist for run %d, using Default \n",fCurrentRun ));
-    centOADB  = (AliOADBCentrality*)(con->GetDefaultObject("oadbDefault"));
+    centOADB  = (AliOADBCentrality*)(cache->GetDefaultObject(fileName,"Centrality","oadbDefault"));
   }
 
   Bool_t isHijing=kFALSE;
@@ -53,6 +53,7 @@ class AliCentralitySelectionTask : public AliAnalysisTaskSE {
   TString  fAnalysisInput; 	// "ESD", "AOD"
   Bool_t   fIsMCInput;          // true when input is MC
   Int_t    fCurrentRun;         // current run number
+  TString  fOADBFileName;       //! OADB file acquired from AliOADBObjectCache
   Bool_t   fUseScaling;         // flag to use scaling 
   Bool_t   fUseCleaning;        // flag to use cleaning  
   Bool_t   fFillHistos;         // flag to fill the QA histos
@@ -326,7 +327,7 @@ class AliCentralitySelectionTask : public AliAnalysisTaskSE {
   TH1F *fHOutVertex ;           //control histogram for vertex SPD
   TH1F *fHOutVertexT0 ;         //control histogram for vertex T0
 
-  ClassDef(AliCentralitySelectionTask, 31); 
+  ClassDef(AliCentralitySelectionTask, 32); 
 };
 
 #endif
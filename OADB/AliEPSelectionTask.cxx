@@ -54,7 +54,7 @@
 #include "AliAnalysisTaskSE.h"
 #include "AliBackgroundSelection.h"
 #include "AliESDUtils.h"
-#include "AliOADBContainer.h"
+#include "AliOADBObjectCache.h"
 #include "AliAODMCHeader.h"
 #include "AliAODTrack.h"
 #include "AliVTrack.h"
@@ -84,9 +84,8 @@ AliAnalysisTaskSE(),
   fEtaGap(0.),
   fSplitMethod(0),
   fESDtrackCuts(0),
-  fEPContainer(0),
-  fQxContainer(0),
-  fQyContainer(0),
+  fEPOADBFileName(),
+  fQOADBFileName(),
   fSparseDist(0),
   fHruns(0),
   fQVector(0),
@@ -135,9 +134,8 @@ AliEPSelectionTask::AliEPSelectionTask(const char *name):
   fEtaGap(0.),
   fSplitMethod(0),
   fESDtrackCuts(0),
-  fEPContainer(0),
-  fQxContainer(0),
-  fQyContainer(0),
+  fEPOADBFileName(),
+  fQOADBFileName(),
   fSparseDist(0),
   fHruns(0),
   fQVector(0),
@@ -180,15 +178,16 @@ AliEPSelectionTask::~AliEPSelectionTask()
       delete fESDtrackCuts;
       fESDtrackCuts = 0;
   }
-  if (fUserphidist) {
+  if (fUserphidist || fPeriod.CompareTo("LHC10h")==0) {
     if (fPhiDist[0]) {
       delete fPhiDist[0];
       fPhiDist[0] = 0;
     }
   }
-  if (fEPContainer){
-      delete fEPContainer;
-      fEPContainer = 0;
+  if (!fEPOADBFileName.IsNull()) AliOADBObjectCache::Instance()->Release(fEPOADBFileName,"epphidist");
+  if (!fQOADBFileName.IsNull()) {
+      AliOADBObjectCache::Instance()->Release(fQOADBFileName,"eprecentering.Qx");
+      AliOADBObjectCache::Instance()->Release(fQOADBFileName,"eprecentering.Qy");
   }
   if (fPeriod.CompareTo("LHC11h")==0){
       for(Int_t i = 0; i < 4; i++) {
@@ -198,6 +197,7 @@ AliEPSelectionTask::~AliEPSelectionTask()
         }
       }
       if(fHruns) delete fHruns;
+      if(fSparseDist) delete fSparseDist;
   }
   if(fQDist[0] && fQDist[1]) {
     for(Int_t i = 0; i < 2; i++) {
@@ -745,7 +745,11 @@ void AliEPSelectionTask::SetPhiDist()
 
     if (fPeriod.CompareTo("LHC10h")==0)
        {
-        fPhiDist[0] = (TH1F*) fEPContainer->GetObject(fRunNumber, "Default");}
+        // own copy of the shared OADB histogram, it may be rebinned below
+        if (fPhiDist[0]) delete fPhiDist[0];
+        const TH1F *phiDist = (const TH1F*) AliOADBObjectCache::Instance()->GetObject(fEPOADBFileName, "epphidist", fRunNumber, "Default");
+        fPhiDist[0] = phiDist ? (TH1F*) phiDist->Clone() : 0x0;
+        if (fPhiDist[0]) fPhiDist[0]->SetDirectory(0);}
         else if(fPeriod.CompareTo("LHC11h")==0){
             Int_t runbin=fHruns->FindBin(fRunNumber);
             if (fHruns->GetBinContent(runbin) > 1){
@@ -821,13 +825,23 @@ void AliEPSelectionTask::SetQvectorDist()
 {
   if(!fUseRecentering) return;
   AliInfo(Form("Setting q vector distributions"));
-  fQDist[0] = (TProfile*) fQxContainer->GetObject(fRunNumber, "Default");
-  fQDist[1] = (TProfile*) fQyContainer->GetObject(fRunNumber, "Default");
+  for(Int_t i = 0; i < 2; i++) {
+    if(fQDist[i]) delete fQDist[i];
+    fQDist[i] = 0;
+  }
+  AliOADBObjectCache *cache = AliOADBObjectCache::Instance();
+  const TProfile *qx = (const TProfile*) cache->GetObject(fQOADBFileName, "eprecentering.Qx", fRunNumber, "Default");
+  const TProfile *qy = (const TProfile*) cache->GetObject(fQOADBFileName, "eprecentering.Qy", fRunNumber, "Default");
 
-  if (!fQDist[0] || !fQDist[1]) {
+  if (!qx || !qy) {
     AliError(Form("Cannot find OADB q-vector distributions for run %d. Using default values (mean=0,rms=1).", fRunNumber));
     return;
   }
+  // own copies of the shared OADB profiles, they may be rebinned below
+  fQDist[0] = (TProfile*) qx->Clone();
+  fQDist[1] = (TProfile*) qy->Clone();
+  fQDist[0]->SetDirectory(0);
+  fQDist[1]->SetDirectory(0);
 
   Bool_t emptybins;
 
@@ -918,13 +932,15 @@ void AliEPSelectionTask::SetOADBandPeriod()
            oadbfilename = (Form("%s/COMMON/EVENTPLANE/data/epphidist.root", AliAnalysisManager::GetOADBPath()));
            }
 
-       TFile foadb(oadbfilename);
-       if(!foadb.IsOpen()) AliFatal(Form("Cannot open OADB file %s", oadbfilename.Data()));
-
+       // the container is read once per process and shared with the other tasks
+       AliOADBObjectCache *cache = AliOADBObjectCache::Instance();
+       if (!fEPOADBFileName.EqualTo(oadbfilename)) {
+         if (!fEPOADBFileName.IsNull()) cache->Release(fEPOADBFileName,"epphidist");
+         fEPOADBFileName = "";
+         if (!cache->Acquire(oadbfilename,"epphidist")) AliFatal(Form("Cannot fetch OADB container for EP selection from %s", oadbfilename.Data()));
+         fEPOADBFileName = oadbfilename;
+       }
        AliInfo("Using Standard OADB");
-       fEPContainer = (AliOADBContainer*) foadb.Get("epphidist");
-       if (!fEPContainer) AliFatal("Cannot fetch OADB container for EP selection");
-       foadb.Close();
        }
      }
 
@@ -933,14 +949,18 @@ void AliEPSelectionTask::SetOADBandPeriod()
       if (!fUserphidist) {
       // if it's already set and custom class is required, we use the one provided by the user
 
+      // not an OADB container, the same (all-run) distribution is read once
+      if (!fSparseDist) {
       oadbfilename = (Form("%s/COMMON/EVENTPLANE/data/epphidist2011.root", AliAnalysisManager::GetOADBPath()));
       TFile *foadb = TFile::Open(oadbfilename);
-      if(!foadb->IsOpen()) AliFatal(Form("Cannot open OADB file %s", oadbfilename.Data()));
+      if(!foadb || !foadb->IsOpen()) AliFatal(Form("Cannot open OADB file %s", oadbfilename.Data()));
 
       AliInfo("Using Standard OADB");
       fSparseDist = (THnSparse*) foadb->Get("Default");
       if (!fSparseDist) AliFatal("Cannot fetch OADB container for EP selection");
       foadb->Close();
+      delete foadb;
+      }
       if(!fHruns){
            fHruns = (TH1F*)fSparseDist->Projection(0); //projection on run axis;
            fHruns->SetName("runsHisto");
@@ -949,14 +969,18 @@ void AliEPSelectionTask::SetOADBandPeriod()
 
       if(fUseRecentering) {
 	oadbfilename = (Form("%s/COMMON/EVENTPLANE/data/eprecentering.root", AliAnalysisManager::GetOADBPath()));
-	TFile *foadb = TFile::Open(oadbfilename);
-	if(!foadb->IsOpen()) AliFatal(Form("Cannot open OADB file %s", oadbfilename.Data()));
-
+	AliOADBObjectCache *cache = AliOADBObjectCache::Instance();
+	if (!fQOADBFileName.EqualTo(oadbfilename)) {
+	  if (!fQOADBFileName.IsNull()) {
+	    cache->Release(fQOADBFileName,"eprecentering.Qx");
+	    cache->Release(fQOADBFileName,"eprecentering.Qy");
+	  }
+	  fQOADBFileName = "";
+	  if (!cache->Acquire(oadbfilename,"eprecentering.Qx") || !cache->Acquire(oadbfilename,"eprecentering.Qy"))
+	    AliFatal(Form("Cannot fetch OADB container for EP recentering from %s", oadbfilename.Data()));
+	  fQOADBFileName = oadbfilename;
+	}
 	AliInfo("Using Standard OADB");
-	fQxContainer = (AliOADBContainer*) foadb->Get("eprecentering.Qx");
-	fQyContainer = (AliOADBContainer*) foadb->Get("eprecentering.Qy");
-	if (!fQxContainer || !fQyContainer) AliFatal("Cannot fetch OADB container for EP recentering");
-	foadb->Close();
       }
 
      }
@@ -0,0 +1,231 @@
+/**************************************************************************
+ * Copyright(c) 1998-2007, ALICE Experiment at CERN, All rights reserved. *
+ *                                                                        *
+ * Author: The ALICE Off-line Project.                                    *
+ * Contributors are mentioned in the code where appropriate.              *
+ *                                                                        *
+ * Permission to use, copy, modify and distribute this software and its   *
+ * documentation strictly for non-commercial purposes is hereby granted   *
+ * without fee, provided that the above copyright notice appears in all   *
+ * copies and that both the copyright notice and this permission notice   *
+ * appear in the supporting documentation. The authors make no claims     *
+ * about the suitability of this software for any purpose. It is          *
+ * provided "as is" without express or implied warranty.                  *
+ **************************************************************************/
+
+/* $Id$ */
+
+//-------------------------------------------------------------------------
+//     Process-wide cache of OADB containers
+//     Usage:
+//       AliOADBObjectCache* cache = AliOADBObjectCache::Instance();
+//       cache->Acquire(file, "Centrality");            // once per client
+//       obj = cache->GetObject(file, "Centrality", run); // at run change
+//       cache->Release(file, "Centrality");            // in the destructor
+//-------------------------------------------------------------------------
+
+#include <algorithm>
+#include <TDirectory.h>
+#include <TFile.h>
+#include <TString.h>
+#include "AliOADBContainer.h"
+#include "AliOADBObjectCache.h"
+#include "AliLog.h"
+
+ClassImp(AliOADBObjectCache);
+
+AliOADBObjectCache* AliOADBObjectCache::fgInstance = 0;
+
+//______________________________________________________________________________
+AliOADBObjectCache::AliOADBObjectCache() :
+  TObject(),
+  fFiles()
+{
+  // Default constructor
+}
+
+//______________________________________________________________________________
+AliOADBObjectCache::~AliOADBObjectCache()
+{
+  // Destructor: the singleton lives until the end of the process, files
+  // are closed by ROOT at exit
+}
+
+//______________________________________________________________________________
+AliOADBObjectCache* AliOADBObjectCache::Instance()
+{
+  // Return the cache of this process
+  if (!fgInstance) fgInstance = new AliOADBObjectCache();
+  return fgInstance;
+}
+
+//______________________________________________________________________________
+Bool_t AliOADBObjectCache::Acquire(const char* fileName, const char* containerName)
+{
+  // Register a client of the container, reading it if needed
+  ContainerEntry* entry = Load(fileName, containerName);
+  if (!entry) return kFALSE;
+  entry->fRefCount++;
+  return kTRUE;
+}
+
+//______________________________________________________________________________
+void AliOADBObjectCache::Release(const char* fileName, const char* containerName)
+{
+  // Unregister a client of the container. The container is deleted when
+  // it has no clients any more, the file when none of its containers is used
+  std::map<std::string, FileEntry>::iterator fit = fFiles.find(fileName);
+  if (fit == fFiles.end()) return;
+  FileEntry& file = fit->second;
+  std::map<std::string, ContainerEntry>::iterator cit = file.fContainers.find(containerName);
+  if (cit == file.fContainers.end()) return;
+  //
+  if (cit->second.fRefCount <= 0) {
+    AliWarning(Form("Container %s of %s released more often than acquired", containerName, fileName));
+    return;
+  }
+  if (--cit->second.fRefCount > 0) return;
+  //
+  delete cit->second.fContainer;
+  file.fContainers.erase(cit);
+  if (!file.fContainers.empty()) return;
+  //
+  AliInfo(Form("Closing OADB file %s", fileName));
+  if (file.fFile) {
+    file.fFile->Close();
+    delete file.fFile;
+  }
+  fFiles.erase(fit);
+}
+
+//______________________________________________________________________________
+Int_t AliOADBObjectCache::GetReferenceCount(const char* fileName, const char* containerName) const
+{
+  // Number of clients of the container
+  std::map<std::string, FileEntry>::const_iterator fit = fFiles.find(fileName);
+  if (fit == fFiles.end()) return 0;
+  std::map<std::string, ContainerEntry>::const_iterator cit = fit->second.fContainers.find(containerName);
+  if (cit == fit->second.fContainers.end()) return 0;
+  return cit->second.fRefCount;
+}
+
+//______________________________________________________________________________
+AliOADBObjectCache::ContainerEntry* AliOADBObjectCache::Load(const char* fileName, const char* containerName)
+{
+  // Find the container, open the file and read the container if not done yet
+  FileEntry& file = fFiles[fileName];
+  std::map<std::string, ContainerEntry>::iterator cit = file.fContainers.find(containerName);
+  if (cit != file.fContainers.end()) return &cit->second;
+  //
+  TDirectory::TContext ctx(gDirectory); // TFile::Open changes the current directory
+  if (!file.fFile) {
+    AliInfo(Form("Opening OADB file %s", fileName));
+    file.fFile = TFile::Open(fileName);
+    if (!file.fFile || !file.fFile->IsOpen()) {
+      AliError(Form("Cannot open OADB file %s", fileName));
+      delete file.fFile;
+      fFiles.erase(fileName);
+      return 0;
+    }
+  }
+  AliOADBContainer* cont = dynamic_cast<AliOADBContainer*>(file.fFile->Get(containerName));
+  if (!cont) {
+    AliError(Form("OADB file %s does not contain a container named %s", fileName, containerName));
+    if (file.fContainers.empty()) {
+      file.fFile->Close();
+      delete file.fFile;
+      fFiles.erase(fileName);
+    }
+    return 0;
+  }
+  //
+  ContainerEntry& entry = file.fContainers[containerName];
+  entry.fContainer = cont;
+  BuildIndex(entry);
+  return &entry;
+}
+
+//______________________________________________________________________________
+void AliOADBObjectCache::BuildIndex(ContainerEntry& entry) const
+{
+  // Sort the run ranges by lower limit. The binary search is used only if
+  // no two ranges overlap, otherwise (e.g. one entry per pass) the look-up
+  // is left to AliOADBContainer::GetObject
+  AliOADBContainer* cont = entry.fContainer;
+  const Int_t n = cont->GetNumberOfEntries();
+  std::vector<std::pair<Int_t,Int_t> > ranges(n);
+  for (Int_t i = 0; i < n; i++) ranges[i] = std::make_pair(cont->LowerLimit(i), i);
+  std::sort(ranges.begin(), ranges.end());
+  //
+  entry.fLower.resize(n);
+  entry.fUpper.resize(n);
+  entry.fIndex.resize(n);
+  entry.fIndexed = kTRUE;
+  for (Int_t k = 0; k < n; k++) {
+    entry.fLower[k] = ranges[k].first;
+    entry.fIndex[k] = ranges[k].second;
+    entry.fUpper[k] = cont->UpperLimit(ranges[k].second);
+    if (k > 0 && entry.fLower[k] <= entry.fUpper[k-1]) entry.fIndexed = kFALSE;
+  }
+}
+
+//______________________________________________________________________________
+const AliOADBContainer* AliOADBObjectCache::GetContainer(const char* fileName, const char* containerName)
+{
+  // Container as read from the file
+  ContainerEntry* entry = Load(fileName, containerName);
+  return entry ? entry->fContainer : 0;
+}
+
+//______________________________________________________________________________
+const TObject* AliOADBObjectCache::GetObject(const char* fileName, const char* containerName, Int_t run,
+                                             const char* def, const char* passName)
+{
+  // Object valid for the run, as AliOADBContainer::GetObject(run, def, passName)
+  ContainerEntry* entry = Load(fileName, containerName);
+  if (!entry) return 0;
+  //
+  std::string key(Form("%d/%s/%s", run, def, passName));
+  std::map<std::string, const TObject*>::const_iterator it = entry->fFound.find(key);
+  if (it != entry->fFound.end()) return it->second;
+  //
+  const TObject* obj = 0;
+  Bool_t found = kFALSE;
+  if (entry->fIndexed && passName[0] == '\0') {
+    std::vector<Int_t>::const_iterator up = std::upper_bound(entry->fLower.begin(), entry->fLower.end(), run);
+    Int_t k = (up - entry->fLower.begin()) - 1;
+    if (k >= 0 && run <= entry->fUpper[k]) {
+      obj = entry->fContainer->GetObjectByIndex(entry->fIndex[k]);
+      found = kTRUE;
+    }
+  }
+  // no range or more than one candidate: default object and pass handling
+  if (!found) obj = entry->fContainer->GetObject(run, def, passName);
+  entry->fFound[key] = obj;
+  return obj;
+}
+
+//______________________________________________________________________________
+const TObject* AliOADBObjectCache::GetDefaultObject(const char* fileName, const char* containerName, const char* key)
+{
+  // Default object of the container
+  ContainerEntry* entry = Load(fileName, containerName);
+  if (!entry) return 0;
+  return entry->fContainer->GetDefaultObject(key);
+}
+
+//______________________________________________________________________________
+void AliOADBObjectCache::Print(Option_t* /*option*/) const
+{
+  // Print the files and containers in the cache
+  Printf("%s: %d files", ClassName(), (Int_t)fFiles.size());
+  for (std::map<std::string, FileEntry>::const_iterator fit = fFiles.begin(); fit != fFiles.end(); ++fit) {
+    Printf("  %s", fit->first.c_str());
+    const std::map<std::string, ContainerEntry>& conts = fit->second.fContainers;
+    for (std::map<std::string, ContainerEntry>::const_iterator cit = conts.begin(); cit != conts.end(); ++cit) {
+      Printf("    %-30s clients: %d, entries: %d, indexed: %d, cached look-ups: %d",
+             cit->first.c_str(), cit->second.fRefCount, (Int_t)cit->second.fIndex.size(),
+             cit->second.fIndexed, (Int_t)cit->second.fFound.size());
+    }
+  }
+}
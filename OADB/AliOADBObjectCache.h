@@ -0,0 +1,73 @@
+#ifndef ALIOADBOBJECTCACHE_H
+#define ALIOADBOBJECTCACHE_H
+/* Copyright(c) 1998-2007, ALICE Experiment at CERN, All rights reserved. *
+ * See cxx source for full Copyright notice                               */
+
+
+//-------------------------------------------------------------------------
+//     Process-wide cache of OADB containers
+//     Each file is opened once and each container read once, the run
+//     ranges of a container are indexed for a binary search, and the
+//     objects found for a (run, default, pass) are remembered. Clients
+//     Acquire() the containers they use and Release() them when done;
+//     a file is closed when none of its containers is used any more.
+//     The objects handed out are owned by the cache: do not modify or
+//     delete them.
+//-------------------------------------------------------------------------
+
+#include <TObject.h>
+#include <map>
+#include <string>
+#include <vector>
+class TFile;
+class AliOADBContainer;
+
+class AliOADBObjectCache : public TObject
+{
+ public :
+  static AliOADBObjectCache* Instance();
+  //
+  Bool_t                  Acquire(const char* fileName, const char* containerName);
+  void                    Release(const char* fileName, const char* containerName);
+  Int_t                   GetReferenceCount(const char* fileName, const char* containerName) const;
+  //
+  const AliOADBContainer* GetContainer(const char* fileName, const char* containerName);
+  const TObject*          GetObject(const char* fileName, const char* containerName, Int_t run,
+                                    const char* def = "", const char* passName = "");
+  const TObject*          GetDefaultObject(const char* fileName, const char* containerName, const char* key);
+  //
+  virtual void            Print(Option_t* option = "") const;
+  //
+ private:
+  struct ContainerEntry {
+    ContainerEntry() : fContainer(0), fRefCount(0), fIndexed(kFALSE) {}
+    AliOADBContainer*  fContainer;   // container read from the file
+    Int_t              fRefCount;    // number of clients
+    Bool_t             fIndexed;     // run ranges do not overlap, binary search possible
+    std::vector<Int_t> fLower;       // lower run limits, sorted
+    std::vector<Int_t> fUpper;       // upper run limits, in the order of fLower
+    std::vector<Int_t> fIndex;       // container index, in the order of fLower
+    std::map<std::string, const TObject*> fFound; // objects found by (run, default, pass)
+  };
+  struct FileEntry {
+    FileEntry() : fFile(0) {}
+    TFile*             fFile;        // OADB file, kept open while containers are used
+    std::map<std::string, ContainerEntry> fContainers;
+  };
+  //
+  AliOADBObjectCache();
+  AliOADBObjectCache(const AliOADBObjectCache&);
+  AliOADBObjectCache& operator=(const AliOADBObjectCache&);
+  virtual ~AliOADBObjectCache();
+  //
+  ContainerEntry*         Load(const char* fileName, const char* containerName);
+  void                    BuildIndex(ContainerEntry& entry) const;
+  //
+  std::map<std::string, FileEntry> fFiles; //! cached files
+  //
+  static AliOADBObjectCache* fgInstance;   //! singleton
+  //
+  ClassDef(AliOADBObjectCache,1)  // process-wide OADB container cache
+};
+
+#endif
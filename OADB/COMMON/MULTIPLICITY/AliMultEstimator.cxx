@@ -20,11 +20,173 @@
 #include "TBrowser.h"
 #include "TFormula.h"
 #include "RVersion.h"
+#include "AliLog.h"
+#include <cstdlib>
+#include <cstring>
 
 ClassImp(AliMultEstimator);
+
+namespace {
+    //________________________________________________________________
+    // Recursive descent parser for estimator definitions, after the
+    // variables have been replaced by [index]. Follows the C++ operator
+    // precedence, as TFormula does. Emits a postfix program.
+    class AliMultExpressionParser {
+    public:
+        AliMultExpressionParser(const char* lExpr, Long_t lNVar,
+                                std::vector<Int_t>& lProgram,
+                                std::vector<Double_t>& lConstants,
+                                std::vector<Int_t>& lVarIndex) :
+        fExpr(lExpr), fPos(0), fNVar(lNVar), fProgram(lProgram), fConstants(lConstants),
+        fVarIndex(lVarIndex), fDepth(0), fMaxDepth(0), fOk(kTRUE) {}
+        
+        Bool_t Parse() {
+            ParseConditional();
+            SkipBlanks();
+            return fOk && fExpr[fPos] == '\0';
+        }
+        Int_t GetMaxDepth() const { return fMaxDepth; }
+        
+    private:
+        void SkipBlanks() { while (fExpr[fPos] == ' ' || fExpr[fPos] == '\t') fPos++; }
+        Bool_t Match(const char* lToken) {
+            SkipBlanks();
+            Int_t n = strlen(lToken);
+            if (strncmp(fExpr + fPos, lToken, n) != 0) return kFALSE;
+            fPos += n;
+            return kTRUE;
+        }
+        void Emit(Int_t lOp, Int_t lArg = 0) {
+            fProgram.push_back((lArg << 5) | lOp);
+            switch (lOp) {
+                case AliMultEstimator::kPushConst:
+                case AliMultEstimator::kPushVar: fDepth++;    break;
+                case AliMultEstimator::kNeg:
+                case AliMultEstimator::kNot:                  break;
+                case AliMultEstimator::kCond:    fDepth -= 2; break;
+                default:                         fDepth--;    break;
+            }
+            if (fDepth > fMaxDepth) fMaxDepth = fDepth;
+        }
+        void ParseConditional() {
+            ParseOr();
+            if (!Match("?")) return;
+            ParseConditional();
+            if (!Match(":")) { fOk = kFALSE; return; }
+            ParseConditional();
+            Emit(AliMultEstimator::kCond);
+        }
+        void ParseOr() {
+            ParseAnd();
+            while (fOk && Match("||")) { ParseAnd(); Emit(AliMultEstimator::kOr); }
+        }
+        void ParseAnd() {
+            ParseEquality();
+            while (fOk && Match("&&")) { ParseEquality(); Emit(AliMultEstimator::kAnd); }
+        }
+        void ParseEquality() {
+            ParseRelational();
+            while (fOk) {
+                if      (Match("==")) { ParseRelational(); Emit(AliMultEstimator::kEqual);    }
+                else if (Match("!=")) { ParseRelational(); Emit(AliMultEstimator::kNotEqual); }
+                else break;
+            }
+        }
+        void ParseRelational() {
+            ParseAdditive();
+            while (fOk) {
+                if      (Match("<=")) { ParseAdditive(); Emit(AliMultEstimator::kLessEq);    }
+                else if (Match(">=")) { ParseAdditive(); Emit(AliMultEstimator::kGreaterEq); }
+                else if (Match("<"))  { ParseAdditive(); Emit(AliMultEstimator::kLess);      }
+                else if (Match(">"))  { ParseAdditive(); Emit(AliMultEstimator::kGreater);   }
+                else break;
+            }
+        }
+        void ParseAdditive() {
+            ParseMultiplicative();
+            while (fOk) {
+                if      (Match("+")) { ParseMultiplicative(); Emit(AliMultEstimator::kAdd); }
+                else if (Match("-")) { ParseMultiplicative(); Emit(AliMultEstimator::kSub); }
+                else break;
+            }
+        }
+        void ParseMultiplicative() {
+            ParseUnary();
+            while (fOk) {
+                if      (Match("*")) { ParseUnary(); Emit(AliMultEstimator::kMul); }
+                else if (Match("/")) { ParseUnary(); Emit(AliMultEstimator::kDiv); }
+                else break;
+            }
+        }
+        void ParseUnary() {
+            if (Match("-")) { ParseUnary(); Emit(AliMultEstimator::kNeg); return; }
+            if (Match("+")) { ParseUnary(); return; }
+            if (fExpr[fPos] == '!' && fExpr[fPos+1] != '=') {
+                fPos++;
+                ParseUnary();
+                Emit(AliMultEstimator::kNot);
+                return;
+            }
+            ParsePrimary();
+        }
+        void ParsePrimary() {
+            SkipBlanks();
+            const char c = fExpr[fPos];
+            if (c == '(') {
+                fPos++;
+                ParseConditional();
+                if (!Match(")")) fOk = kFALSE;
+                return;
+            }
+            if (c == '[') {
+                char* lEnd = 0;
+                Long_t lIdx = strtol(fExpr + fPos + 1, &lEnd, 10);
+                if (lEnd == fExpr + fPos + 1 || *lEnd != ']' || lIdx < 0 || lIdx >= fNVar) {
+                    fOk = kFALSE;
+                    return;
+                }
+                fPos = lEnd - fExpr + 1;
+                Int_t lSlot = -1;
+                for (UInt_t i = 0; i < fVarIndex.size(); i++)
+                    if (fVarIndex[i] == lIdx) lSlot = i;
+                if (lSlot < 0) {
+                    lSlot = fVarIndex.size();
+                    fVarIndex.push_back(lIdx);
+                }
+                Emit(AliMultEstimator::kPushVar, lSlot);
+                return;
+            }
+            if ((c >= '0' && c <= '9') || c == '.') {
+                char* lEnd = 0;
+                Double_t lVal = strtod(fExpr + fPos, &lEnd);
+                if (lEnd == fExpr + fPos) {
+                    fOk = kFALSE;
+                    return;
+                }
+                fPos = lEnd - fExpr;
+                fConstants.push_back(lVal);
+                Emit(AliMultEstimator::kPushConst, fConstants.size() - 1);
+                return;
+            }
+            //Functions, named parameters, ...: leave it to TFormula
+            fOk = kFALSE;
+        }
+        
+        const char*            fExpr;
+        Int_t                  fPos;
+        Long_t                 fNVar;
+        std::vector<Int_t>&    fProgram;
+        std::vector<Double_t>& fConstants;
+        std::vector<Int_t>&    fVarIndex;
+        Int_t                  fDepth;
+        Int_t                  fMaxDepth;
+        Bool_t                 fOk;
+    };
+}
 //________________________________________________________________
 AliMultEstimator::AliMultEstimator() :
   TNamed(), fDefinition(""), fIsInteger(kFALSE), fValue(0), fMean(0), fPercentile(0), fFormula(0),
+fProgram(), fConstants(), fVarIndex(), fVariables(), fInputs(), fStack(), fSetupInput(0),
 fkUseAnchor(kFALSE), fAnchorPoint(0), fAnchorPercentile(100.0)
 {
   // Constructor
@@ -32,6 +194,7 @@ fkUseAnchor(kFALSE), fAnchorPoint(0), fAnchorPercentile(100.0)
 }
 AliMultEstimator::AliMultEstimator(const char * name, const char * title, TString lInitDef):
 TNamed(name,title), fDefinition(""), fIsInteger(kFALSE), fValue(0), fMean(0), fPercentile(0), fFormula(0),
+fProgram(), fConstants(), fVarIndex(), fVariables(), fInputs(), fStack(), fSetupInput(0),
 fkUseAnchor(kFALSE), fAnchorPoint(0), fAnchorPercentile(100.0)
 {
     //Named, titled, definition constructor
@@ -46,6 +209,13 @@ fValue(e.fValue),
 fMean(e.fMean),
 fPercentile(e.fPercentile),
 fFormula(0),
+fProgram(e.fProgram),
+fConstants(e.fConstants),
+fVarIndex(e.fVarIndex),
+fVariables(e.fVariables),
+fInputs(e.fInputs),
+fStack(e.fStack),
+fSetupInput(e.fSetupInput),
 fkUseAnchor(e.fkUseAnchor),
 fAnchorPoint(e.fAnchorPoint),
 fAnchorPercentile(e.fAnchorPercentile)
@@ -67,6 +237,13 @@ AliMultEstimator& AliMultEstimator::operator=(const AliMultEstimator& e)
     if (fFormula) delete fFormula;
     fFormula = 0;
     if (e.fFormula) fFormula = new TFormula(*e.fFormula);
+    fProgram    = e.fProgram;
+    fConstants  = e.fConstants;
+    fVarIndex   = e.fVarIndex;
+    fVariables  = e.fVariables;
+    fInputs     = e.fInputs;
+    fStack      = e.fStack;
+    fSetupInput = e.fSetupInput;
     
     //Anchor point configs
     fkUseAnchor         = e.fkUseAnchor;
@@ -121,14 +298,92 @@ void AliMultEstimator::SetupFormula(const AliMultInput* lInput)
         lVarName.Prepend("(");
         expr.ReplaceAll(lVarName, repl);
     }
+    if (fFormula) delete fFormula;
+    fFormula = 0;
+    
+    //Arithmetic, comparisons and logic are compiled once and evaluated
+    //directly (same double precision operations in the same order as
+    //TFormula), anything else goes through TFormula
+    if (Compile(expr, nVar)) {
+        ResolveVariables(lInput);
+        return;
+    }
+    AliWarning(Form("Estimator %s: definition %s not compiled, using TFormula", GetName(), fDefinition.Data()));
     fFormula = new TFormula(Form("e%s", GetName()), expr);
 #if ROOT_VERSION_CODE < ROOT_VERSION(5,99,4)
     fFormula->Optimize();
 #endif
 }
 //________________________________________________________________
+Bool_t AliMultEstimator::Compile(const TString& lExpr, Long_t lNVar)
+{
+    fProgram.clear();
+    fConstants.clear();
+    fVarIndex.clear();
+    fVariables.clear();
+    fSetupInput = 0;
+    
+    AliMultExpressionParser lParser(lExpr.Data(), lNVar, fProgram, fConstants, fVarIndex);
+    if (!lParser.Parse() || fProgram.empty()) {
+        fProgram.clear();
+        fConstants.clear();
+        fVarIndex.clear();
+        return kFALSE;
+    }
+    fInputs.assign(fVarIndex.size(), 0.);
+    fStack.assign(lParser.GetMaxDepth(), 0.);
+    return kTRUE;
+}
+//________________________________________________________________
+void AliMultEstimator::ResolveVariables(const AliMultInput* lInput)
+{
+    fVariables.resize(fVarIndex.size());
+    for (UInt_t i = 0; i < fVarIndex.size(); i++)
+        fVariables[i] = lInput->GetVariable(fVarIndex[i]);
+    fSetupInput = lInput;
+}
+//________________________________________________________________
 Float_t AliMultEstimator::Evaluate(const AliMultInput* lInput)
 {
+    if (IsCompiled()) {
+        if (lInput != fSetupInput) ResolveVariables(lInput);
+        
+        //Gather the inputs in a flat array
+        for (UInt_t i = 0; i < fVariables.size(); i++) {
+            const AliMultVariable* v = fVariables[i];
+            if (!v) fInputs[i] = 0;
+            else    fInputs[i] = v->IsInteger() ? v->GetValueInteger() : v->GetValue();
+        }
+        
+        Double_t* st = &fStack[0];
+        Int_t     sp = -1;
+        const Int_t lN = fProgram.size();
+        for (Int_t i = 0; i < lN; i++) {
+            const Int_t lOp  = fProgram[i] & 31;
+            const Int_t lArg = fProgram[i] >> 5;
+            switch (lOp) {
+                case kPushConst: st[++sp] = fConstants[lArg];             break;
+                case kPushVar:   st[++sp] = fInputs[lArg];                break;
+                case kNeg:       st[sp]   = -st[sp];                      break;
+                case kNot:       st[sp]   = !st[sp];                      break;
+                case kAdd:       st[sp-1] = st[sp-1] +  st[sp]; sp--;     break;
+                case kSub:       st[sp-1] = st[sp-1] -  st[sp]; sp--;     break;
+                case kMul:       st[sp-1] = st[sp-1] *  st[sp]; sp--;     break;
+                case kDiv:       st[sp-1] = st[sp-1] /  st[sp]; sp--;     break;
+                case kLess:      st[sp-1] = st[sp-1] <  st[sp]; sp--;     break;
+                case kGreater:   st[sp-1] = st[sp-1] >  st[sp]; sp--;     break;
+                case kLessEq:    st[sp-1] = st[sp-1] <= st[sp]; sp--;     break;
+                case kGreaterEq: st[sp-1] = st[sp-1] >= st[sp]; sp--;     break;
+                case kEqual:     st[sp-1] = st[sp-1] == st[sp]; sp--;     break;
+                case kNotEqual:  st[sp-1] = st[sp-1] != st[sp]; sp--;     break;
+                case kAnd:       st[sp-1] = st[sp-1] && st[sp]; sp--;     break;
+                case kOr:        st[sp-1] = st[sp-1] || st[sp]; sp--;     break;
+                case kCond:      st[sp-2] = st[sp-2] ? st[sp-1] : st[sp]; sp -= 2; break;
+            }
+        }
+        return fValue = st[0];
+    }
+    
     if (!fFormula) return fValue = 0;
     for (Int_t i = 0; i < lInput->GetNVariables(); i++) {
         AliMultVariable* v = lInput->GetVariable(i);
@@ -1,7 +1,9 @@
 #ifndef AliMultEstimator_H
 #define AliMultEstimator_H
 #include <TNamed.h>
+#include <vector>
 class AliMultInput;
+class AliMultVariable;
 class TFormula;
 
 class AliMultEstimator : public TNamed {
@@ -43,15 +45,35 @@ public:
     //Pre-processing for speed
     void SetupFormula(const AliMultInput* lInput);
     Float_t Evaluate(const AliMultInput* lInput);
+    Bool_t IsCompiled() const { return !fProgram.empty(); }
+    
+    //Operations of the compiled definition
+    enum EOperation {
+        kPushConst = 0, kPushVar, kNeg, kNot, kAdd, kSub, kMul, kDiv,
+        kLess, kGreater, kLessEq, kGreaterEq, kEqual, kNotEqual, kAnd, kOr, kCond
+    };
     
 private:
+    Bool_t Compile(const TString& lExpr, Long_t lNVar);
+    void   ResolveVariables(const AliMultInput* lInput);
+    
+
     TString fDefinition; //How to evaluate based on AliMultVariables
     Bool_t fIsInteger; //Requires special treatment when calibrating
     
     Float_t fValue;     // estimator value
     Float_t fMean;   // estimator mean value
     Float_t fPercentile;   //Percentile
-    TFormula* fFormula; //!
+    TFormula* fFormula; //! fallback if the definition cannot be compiled
+    
+    //Compiled definition: postfix program over a flat array of input values
+    std::vector<Int_t>    fProgram;    //! operations, (argument<<5)|operation
+    std::vector<Double_t> fConstants;  //! constants of the program
+    std::vector<Int_t>    fVarIndex;   //! index in AliMultInput of the variables used
+    std::vector<const AliMultVariable*> fVariables; //! variables used, resolved from fSetupInput
+    std::vector<Double_t> fInputs;     //! values of the variables used in this event
+    std::vector<Double_t> fStack;      //! evaluation stack
+    const AliMultInput*   fSetupInput; //! input the variables were resolved from
     
     //Anchor point definition
     Bool_t  fkUseAnchor;        //Use Anchor Logic (default: No)
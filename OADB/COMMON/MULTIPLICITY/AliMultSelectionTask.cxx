@@ -80,6 +80,7 @@ class AliESDAD; //AD
 
 //For MultSelection Framework
 #include "AliOADBContainer.h"
+#include "AliOADBObjectCache.h"
 #include "AliOADBMultSelection.h"
 #include "AliMultEstimator.h"
 #include "AliMultVariable.h"
@@ -102,6 +103,7 @@ AliMultSelectionTask::AliMultSelectionTask()
       fkUseDefaultCalib (kFALSE), fkUseDefaultMCCalib (kFALSE),
       fkTrigger(AliVEvent::kINT7), fAlternateOADBForEstimators(""),
       fAlternateOADBFullManualBypass(""),fAlternateOADBFullManualBypassMC(""),
+      fOADBCacheFile(""), fOADBCacheFileAlter(""),
       //don't change the default, or we'll be in big trouble!
       fStoredObjectName("MultSelection"),
       fZncEnergy(0),
@@ -229,6 +231,7 @@ AliMultSelectionTask::AliMultSelectionTask(const char *name, TString lExtraOptio
       fkUseDefaultCalib (kFALSE), fkUseDefaultMCCalib (kFALSE),
       fkTrigger(AliVEvent::kINT7), fAlternateOADBForEstimators(""),
       fAlternateOADBFullManualBypass(""),fAlternateOADBFullManualBypassMC(""),
+      fOADBCacheFile(""), fOADBCacheFileAlter(""),
       //don't change the default, or we'll be in big trouble!
       fStoredObjectName("MultSelection"),
       fZncEnergy(0),
@@ -395,6 +398,11 @@ AliMultSelectionTask::~AliMultSelectionTask()
         delete fUtils;
         fUtils = 0x0;
     }
+    //Release shared OADB containers
+    if ( !fOADBCacheFile.IsNull() )
+        AliOADBObjectCache::Instance()->Release(fOADBCacheFile, "MultSel");
+    if ( !fOADBCacheFileAlter.IsNull() )
+        AliOADBObjectCache::Instance()->Release(fOADBCacheFileAlter, "MultSel");
 }
 
 
@@ -1481,25 +1489,15 @@ void AliMultSelectionTask::UserExec(Option_t *)
         fEvSelCode = lSelection->GetEvSelCode();
 
         //Determine Quantiles from calibration histogram
-        TH1F *lThisCalibHisto = 0x0;
-        TString lThisCalibHistoName;
+        //(look-up tables prepared in SetupRun, kNoCalib if no histogram)
         Float_t lThisQuantile = -1;
         for(Long_t iEst=0; iEst<lSelection->GetNEstimators(); iEst++) {
-            //Changed: no need for run number, object already matches required one
-            lThisCalibHistoName = Form("hCalib_%s",lSelection->GetEstimator(iEst)->GetName());
-            lThisCalibHisto = 0x0;
-            lThisCalibHisto = fOadbMultSelection->GetCalibHisto( lThisCalibHistoName );
-            if ( ! lThisCalibHisto ) {
-                lThisQuantile = AliMultSelectionCuts::kNoCalib;
-                if( iEst < fNDebug ) fQuantiles[iEst] = lThisQuantile;
-                lSelection->GetEstimator(iEst)->SetPercentile(lThisQuantile);
-            } else {
-                lThisQuantile = lThisCalibHisto->GetBinContent( lThisCalibHisto->FindBin( lSelection->GetEstimator(iEst)->GetValue() ));
-                if( iEst < fNDebug ) {
-                    fQuantiles[iEst] = lThisQuantile; //Debug, please
-                }
-                lSelection->GetEstimator(iEst)->SetPercentile(lThisQuantile);
+            AliMultEstimator *lThisEstimator = lSelection->GetEstimator(iEst);
+            lThisQuantile = fOadbMultSelection->GetPercentile( iEst, lThisEstimator->GetValue() );
+            if( iEst < fNDebug ) {
+                fQuantiles[iEst] = lThisQuantile; //Debug, please
             }
+            lThisEstimator->SetPercentile(lThisQuantile);
         }
 
         //=============================================================================
@@ -1747,17 +1745,15 @@ Int_t AliMultSelectionTask::SetupRun(const AliVEvent* const esd)
         fileName = Form("%s", fAlternateOADBFullManualBypass.Data() );
     }
 
-    //Open File without calling InitFromFile, don't load it all!
-    TFile * foadb = TFile::Open(fileName);
-    if(!foadb->IsOpen()) AliFatal(Form("Cannot open OADB file %s", fileName.Data()));
-
-    AliOADBContainer * MultContainer = (AliOADBContainer*) foadb->Get("MultSel");
-    if(!MultContainer) AliFatal(Form("OADB file %s does not contain OADBContainer named MultSel, stopping here", fileName.Data()));
+    //File opened and container read once per process, shared with other tasks
+    AliOADBObjectCache *lCache = AliOADBObjectCache::Instance();
+    if ( !AcquireOADB(fOADBCacheFile, fileName) )
+        AliFatal(Form("Cannot read OADBContainer named MultSel from OADB file %s, stopping here", fileName.Data()));
     
     //Get Object for this run!
-    TObject *lObjAcquired = 0x0;
+    const TObject *lObjAcquired = 0x0;
 
-    lObjAcquired = MultContainer->GetObject(fCurrentRun, "Default");
+    lObjAcquired = lCache->GetObject(fileName, "MultSel", fCurrentRun, "Default");
 
     if (!lObjAcquired) {
         if ( fkUseDefaultCalib ) {
@@ -1766,7 +1762,7 @@ Int_t AliMultSelectionTask::SetupRun(const AliVEvent* const esd)
             AliWarning(" This is only a 'good guess'! Use with Care! ");
             AliWarning(" To Switch off this good guess, use SetUseDefaultCalib(kFALSE)");
             AliWarning("======================================================================");
-            lObjAcquired  = MultContainer->GetDefaultObject("oadbDefault");
+            lObjAcquired  = lCache->GetDefaultObject(fileName, "MultSel", "oadbDefault");
         } else {
             AliWarning("======================================================================");
             AliWarning(Form(" Multiplicity OADB does not exist for run %d, will return kNoCalib!",fCurrentRun ));
@@ -1781,7 +1777,7 @@ Int_t AliMultSelectionTask::SetupRun(const AliVEvent* const esd)
         AliFatal("Really cannot find any OADB object - giving up!");
     }
 
-    AliOADBMultSelection *lObjTypecast = (AliOADBMultSelection*) lObjAcquired;
+    const AliOADBMultSelection *lObjTypecast = (const AliOADBMultSelection*) lObjAcquired;
 
     fOadbMultSelection = new AliOADBMultSelection(*lObjTypecast);
     // De-couple histograms from the underlying file
@@ -1811,16 +1807,13 @@ Int_t AliMultSelectionTask::SetupRun(const AliVEvent* const esd)
             fileNameAlter = Form("%s", fAlternateOADBFullManualBypassMC.Data() );
         }
         
-        //Open fileNameAlter
-        TFile * foadbAlter = TFile::Open(fileNameAlter);
-        if(!foadbAlter->IsOpen()) AliFatal(Form("Cannot open OADB file %s", fileNameAlter.Data()));
-        
-        AliOADBContainer * MultContainerAlter = (AliOADBContainer*) foadbAlter->Get("MultSel");
-        if(!MultContainerAlter) AliFatal(Form("OADB file %s does not contain OADBContainer named MultSel, stopping here", fileNameAlter.Data()));
+        //Get container of fileNameAlter from the cache
+        if ( !AcquireOADB(fOADBCacheFileAlter, fileNameAlter) )
+            AliFatal(Form("Cannot read OADBContainer named MultSel from OADB file %s, stopping here", fileNameAlter.Data()));
 
         //Get Object for this run
-        TObject *lObjAcquiredAlter = 0x0;
-        lObjAcquiredAlter = MultContainerAlter->GetObject(fCurrentRun, "Default");
+        const TObject *lObjAcquiredAlter = 0x0;
+        lObjAcquiredAlter = lCache->GetObject(fileNameAlter, "MultSel", fCurrentRun, "Default");
         if (!lObjAcquiredAlter) {
             if ( fkUseDefaultMCCalib ) {
                 AliWarning("======================================================================");
@@ -1828,7 +1821,7 @@ Int_t AliMultSelectionTask::SetupRun(const AliVEvent* const esd)
                 AliWarning(" This is usually only approximately OK! Use with Care! ");
                 AliWarning(" To Switch off this good guess, use SetUseDefaultMCCalib(kFALSE)");
                 AliWarning("======================================================================");
-                lObjAcquiredAlter  = MultContainerAlter->GetDefaultObject("oadbDefault");
+                lObjAcquiredAlter  = lCache->GetDefaultObject(fileNameAlter, "MultSel", "oadbDefault");
             } else {
                 AliWarning("======================================================================");
                 AliWarning(Form(" MC Multiplicity OADB does not exist for run %d, will return kNoCalib!",fCurrentRun ));
@@ -1845,7 +1838,7 @@ Int_t AliMultSelectionTask::SetupRun(const AliVEvent* const esd)
 
         //Actually, it's not required that we keep a copy of this object in memory. We only need to grab
         //the definitions... This can be much optimized!
-        AliOADBMultSelection *fOadbMultSelectionAlter = (AliOADBMultSelection*) lObjAcquiredAlter;
+        const AliOADBMultSelection *fOadbMultSelectionAlter = (const AliOADBMultSelection*) lObjAcquiredAlter;
         AliMultSelection* selAlter = fOadbMultSelectionAlter->GetMultSelection();
 
         //Sweep all estimators from standard OADB and replace their definitions...
@@ -2279,6 +2272,18 @@ TString AliMultSelectionTask::GetPeriodNameByRunNumber() const
     return lProductionName;
 }
 //______________________________________________________________________
+Bool_t AliMultSelectionTask::AcquireOADB(TString &lHeldFile, const TString &lFileName) {
+    //Make sure the MultSel container of lFileName is held in the process-wide
+    //OADB cache, releasing the one held before (lHeldFile) if it changed
+    if ( lHeldFile.EqualTo(lFileName) ) return kTRUE;
+    AliOADBObjectCache *lCache = AliOADBObjectCache::Instance();
+    if ( !lHeldFile.IsNull() ) lCache->Release(lHeldFile, "MultSel");
+    lHeldFile = "";
+    if ( !lCache->Acquire(lFileName, "MultSel") ) return kFALSE;
+    lHeldFile = lFileName;
+    return kTRUE;
+}
+//______________________________________________________________________
 Bool_t AliMultSelectionTask::CheckOADB(TString lProdName) const { 
     //This helper function checks if an OADB exists for the production named lProdName
     //Determine file name 
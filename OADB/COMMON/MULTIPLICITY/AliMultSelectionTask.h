@@ -85,6 +85,7 @@ public:
     Bool_t IsDPMJet() const; 
  
     void CreateEmptyOADB(); //In case we really didn't get anything ...
+    Bool_t AcquireOADB( TString &lHeldFile, const TString &lFileName ); //MultSel container from AliOADBObjectCache
     
     //Cannot be static: requires AliAnalysisUtils Object (why not static?) 
     Bool_t IsNotPileupMV           (AliVEvent *event);
@@ -154,6 +155,10 @@ private:
     TString fAlternateOADBFullManualBypass;
     TString fAlternateOADBFullManualBypassMC;
     
+    //OADB files whose MultSel container is held in AliOADBObjectCache
+    TString fOADBCacheFile;      //!
+    TString fOADBCacheFileAlter; //!
+    
     //Object name for attaching to ESD/AOD
     TString fStoredObjectName;
     
@@ -313,7 +318,7 @@ private:
     AliMultSelectionTask(const AliMultSelectionTask&);            // not implemented
     AliMultSelectionTask& operator=(const AliMultSelectionTask&); // not implemented
 
-    ClassDef(AliMultSelectionTask, 2);
+    ClassDef(AliMultSelectionTask, 3);
 };
 
 #endif
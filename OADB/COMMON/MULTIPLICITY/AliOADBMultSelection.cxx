@@ -11,13 +11,15 @@
 #include "TBrowser.h"
 #include <TMap.h>
 #include <TROOT.h>
+#include <algorithm>
 
 ClassImp(AliOADBMultSelection);
 
 //________________________________________________________________
 //Constructors/Destructor
 AliOADBMultSelection::AliOADBMultSelection() :
-TNamed("multSel",""), fCalibList(0), fEventCuts(0), fSelection(0), fMap(0)
+TNamed("multSel",""), fCalibList(0), fEventCuts(0), fSelection(0), fMap(0),
+fTableOffset(), fTableNBins(), fTableXMin(), fTableXMax(), fTableEdges(), fEdges(), fTableContents()
 {
     // constructor
     // fCalibList = new TList();
@@ -29,7 +31,8 @@ AliOADBMultSelection::AliOADBMultSelection(const AliOADBMultSelection& o)
 fCalibList(0),
 fEventCuts(0),
 fSelection(0),
-fMap(0)
+fMap(0),
+fTableOffset(), fTableNBins(), fTableXMin(), fTableXMax(), fTableEdges(), fEdges(), fTableContents()
 {
     fCalibList = new TList();
     fCalibList->SetOwner (kTRUE);
@@ -41,7 +44,8 @@ fMap(0)
 }
 //________________________________________________________________
 AliOADBMultSelection::AliOADBMultSelection(const char * name, const char * title) :
-TNamed(name, title), fCalibList(0), fEventCuts(0), fSelection(0), fMap(0)
+TNamed(name, title), fCalibList(0), fEventCuts(0), fSelection(0), fMap(0),
+fTableOffset(), fTableNBins(), fTableXMin(), fTableXMax(), fTableEdges(), fEdges(), fTableContents()
 {
     // constructor
     fCalibList = new TList();
@@ -61,6 +65,7 @@ AliOADBMultSelection& AliOADBMultSelection::operator=(const AliOADBMultSelection
         delete fMap;
         fMap = 0;
     }
+    fTableOffset.clear();
     fCalibList = new TList();
     fCalibList->SetOwner (kTRUE);
     TIter next(o.fCalibList);
@@ -247,6 +252,75 @@ void AliOADBMultSelection::Setup()
         
         fMap->Add(e, h);
     }
+    BuildTables();
+}
+//________________________________________________________________
+void AliOADBMultSelection::BuildTables()
+{
+    //Copy axis and contents of the calibration histograms into flat
+    //arrays indexed by estimator, so that the per-event percentile does
+    //not need a look-up by name
+    fTableOffset.clear();
+    fTableNBins.clear();
+    fTableXMin.clear();
+    fTableXMax.clear();
+    fTableEdges.clear();
+    fEdges.clear();
+    fTableContents.clear();
+    
+    AliMultSelection* sel = GetMultSelection();
+    if (!sel) return;
+    
+    for(Long_t iEst=0; iEst<sel->GetNEstimators(); iEst++) {
+        AliMultEstimator* e = sel->GetEstimator(iEst);
+        TH1F* h = e ? FindHisto(e) : 0;
+        if (!h) {
+            fTableOffset.push_back(-1);
+            fTableNBins.push_back(0);
+            fTableXMin.push_back(0);
+            fTableXMax.push_back(0);
+            fTableEdges.push_back(-1);
+            continue;
+        }
+        const TAxis* ax = h->GetXaxis();
+        const Int_t  nb = ax->GetNbins();
+        fTableOffset.push_back(fTableContents.size());
+        fTableNBins.push_back(nb);
+        fTableXMin.push_back(ax->GetXmin());
+        fTableXMax.push_back(ax->GetXmax());
+        if (ax->GetXbins()->GetSize() == 0) {
+            fTableEdges.push_back(-1);
+        } else {
+            fTableEdges.push_back(fEdges.size());
+            for (Int_t i = 0; i <= nb; i++) fEdges.push_back(ax->GetXbins()->At(i));
+        }
+        for (Int_t i = 0; i <= nb+1; i++) fTableContents.push_back(h->GetBinContent(i));
+    }
+}
+//________________________________________________________________
+Float_t AliOADBMultSelection::GetPercentile(Long_t iEst, Float_t lValue) const
+{
+    //Same bin as TAxis::FindBin: arithmetic for fixed bins, binary
+    //search in the edges for variable bins
+    if (iEst < 0 || iEst >= (Long_t)fTableOffset.size() || fTableOffset[iEst] < 0)
+        return AliMultSelectionCuts::kNoCalib;
+    
+    const Double_t x    = lValue;
+    const Int_t    nb   = fTableNBins[iEst];
+    const Double_t xmin = fTableXMin[iEst];
+    const Double_t xmax = fTableXMax[iEst];
+    Int_t bin = 0;
+    if (x < xmin) {
+        bin = 0;
+    } else if (!(x < xmax)) {
+        bin = nb + 1;
+    } else if (fTableEdges[iEst] < 0) {
+        bin = 1 + Int_t(nb*(x-xmin)/(xmax-xmin));
+    } else {
+        const Double_t* edges = &fEdges[fTableEdges[iEst]];
+        bin = std::upper_bound(edges, edges + nb + 1, x) - edges;
+    }
+    return fTableContents[fTableOffset[iEst] + bin];
 }
 
 
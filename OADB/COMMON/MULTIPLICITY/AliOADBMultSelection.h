@@ -3,6 +3,7 @@
 
 #include <TNamed.h>
 #include <AliMultSelection.h>
+#include <vector>
 class TBrowser;
 class TH1F;
 class TList; 
@@ -39,6 +40,9 @@ public:
     //Use internal map
     void Setup();
     TH1F* FindHisto(AliMultEstimator* e);
+    
+    //Percentile of estimator iEst from the look-up tables built in Setup()
+    Float_t GetPercentile(Long_t iEst, Float_t lValue) const;
     void Print(Option_t* option="") const;
     
 private:
@@ -46,6 +50,16 @@ private:
     AliMultSelectionCuts * fEventCuts; // EventCuts
     AliMultSelection     * fSelection; // Definition of Estimators
     TMap*                  fMap; //! Map estimator to histogram
+    
+    //Look-up tables of the calibration histograms, per estimator index
+    void BuildTables();
+    std::vector<Int_t>     fTableOffset;  //! first bin of each estimator in fTableContents, -1 if no calibration
+    std::vector<Int_t>     fTableNBins;   //! number of bins
+    std::vector<Double_t>  fTableXMin;    //! lower edge
+    std::vector<Double_t>  fTableXMax;    //! upper edge
+    std::vector<Int_t>     fTableEdges;   //! first edge of each estimator in fEdges, -1 if fixed bins
+    std::vector<Double_t>  fEdges;        //! bin edges of variable bin histograms
+    std::vector<Float_t>   fTableContents;//! bin contents, including under- and overflow
     ClassDef(AliOADBMultSelection, 1)
     
     
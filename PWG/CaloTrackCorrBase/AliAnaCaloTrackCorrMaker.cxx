@@ -29,6 +29,7 @@
 #include "AliAODEvent.h"
 #include "AliAnaCaloTrackCorrBaseClass.h"
 #include "AliAnaCaloTrackCorrMaker.h"
+#include "AliMCAncestryCache.h"
 #include "AliLog.h"
 #include "AliGenPythiaEventHeader.h"
 
@@ -50,6 +51,7 @@ fAnaDebug(0),                 fCuts(new TList),
 fScaleFactor(-1),
 fFillDataControlHisto(1),     fSumw2(0),
 fCheckPtHard(0),
+fShareMCAncestry(kTRUE),      fMCAncestryCache(0),
 // Control histograms
 fhNEventsIn(0),               fhNEvents(0),
 fhNExoticEvents(0),           fhNEventsNoTriggerFound(0),
@@ -103,6 +105,8 @@ fScaleFactor(maker.fScaleFactor),
 fFillDataControlHisto(maker.fFillDataControlHisto),
 fSumw2(maker.fSumw2),
 fCheckPtHard(maker.fCheckPtHard),
+fShareMCAncestry(maker.fShareMCAncestry),
+fMCAncestryCache(0),
 fhNEventsIn(maker.fhNEventsIn),
 fhNEvents(maker.fhNEvents),
 fhNExoticEvents(maker.fhNExoticEvents),
@@ -180,6 +184,8 @@ AliAnaCaloTrackCorrMaker::~AliAnaCaloTrackCorrMaker()
   if (fReader)    delete fReader ;
   if (fCaloUtils) delete fCaloUtils ;
   
+  if (fMCAncestryCache) delete fMCAncestryCache ;
+  
   if(fCuts)
   {
 	  fCuts->Delete();
@@ -984,6 +990,14 @@ void AliAnaCaloTrackCorrMaker::Init()
     ana->SetReader(fReader);       // Set Reader for each analysis
     ana->SetCaloUtils(fCaloUtils); // Set CaloUtils for each analysis
     
+    // Share the MC origin ancestry of the event between the analysis
+    if ( fShareMCAncestry && ana->IsDataMC() )
+    {
+      if ( !fMCAncestryCache ) fMCAncestryCache = new AliMCAncestryCache();
+      
+      ana->GetMCAnalysisUtils()->SetAncestryCache(fMCAncestryCache);
+    }
+    
     ana->Init();
     ana->InitDebug();
   }//Loop on analysis defined
@@ -1017,6 +1031,7 @@ void AliAnaCaloTrackCorrMaker::Print(const Option_t * opt) const
   printf("Debug level                =     %d\n", fAnaDebug   ) ;
   printf("Produce Histo              =     %d\n", fMakeHisto  ) ;
   printf("Produce AOD                =     %d\n", fMakeAOD    ) ;
+  printf("Share MC ancestry          =     %d\n", fShareMCAncestry) ;
   printf("Number of analysis tasks   =     %d\n", fAnalysisContainer->GetEntries()) ;
   
   if(!strcmp("all",opt))
@@ -1115,6 +1130,9 @@ void AliAnaCaloTrackCorrMaker::ProcessEvent(Int_t iEntry, const char * currentFi
   
   AliDebug(1,"*** Begin analysis ***");
   
+  // New event, forget the MC ancestry of the previous one
+  if ( fMCAncestryCache ) fMCAncestryCache->Reset();
+  
   Int_t nana = fAnalysisContainer->GetEntries() ;
   for(Int_t iana = 0; iana <  nana; iana++)
   {
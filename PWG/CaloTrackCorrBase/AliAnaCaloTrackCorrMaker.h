@@ -31,6 +31,7 @@ class TH1F;
 // --- Analysis system ---
 #include "AliCaloTrackReader.h" 
 #include "AliCalorimeterUtils.h"
+class AliMCAncestryCache;
 
 class AliAnaCaloTrackCorrMaker : public TObject {
 
@@ -82,6 +83,9 @@ class AliAnaCaloTrackCorrMaker : public TObject {
   void    SwitchOnPtHardHistogram()        { fCheckPtHard = kTRUE  ; }
   void    SwitchOffPtHardHistogram()       { fCheckPtHard = kFALSE ; }
 
+  void    SwitchOnMCAncestryCache()        { fShareMCAncestry = kTRUE  ; }
+  void    SwitchOffMCAncestryCache()       { fShareMCAncestry = kFALSE ; }
+
   void    SetScaleFactor(Double_t scale)   { fScaleFactor = scale  ; } 
 
   void    SetCaloUtils(AliCalorimeterUtils * cu) { fCaloUtils = cu ; }
@@ -136,6 +140,10 @@ class AliAnaCaloTrackCorrMaker : public TObject {
     
   Bool_t   fCheckPtHard ;                            ///< For MC done in pT-Hard bins, plot specific histogram
     
+  Bool_t   fShareMCAncestry ;                        ///<  Share the MC ancestry walk of CheckOrigin between analyses in the same event.
+    
+  AliMCAncestryCache * fMCAncestryCache ;            //!<! Per-event MC ancestry cache passed to the analysis MC utils, owned.
+    
   // Control histograms
   
   TH1F *   fhNEventsIn;                              //!<! Number of input events counter histogram.
@@ -206,7 +214,7 @@ class AliAnaCaloTrackCorrMaker : public TObject {
   AliAnaCaloTrackCorrMaker & operator = (const AliAnaCaloTrackCorrMaker & ) ; 
   
   /// \cond CLASSIMP
-  ClassDef(AliAnaCaloTrackCorrMaker,27) ;
+  ClassDef(AliAnaCaloTrackCorrMaker,28) ;
   /// \endcond
 
 } ;
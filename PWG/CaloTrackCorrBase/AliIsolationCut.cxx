@@ -15,6 +15,7 @@
 
 // --- ROOT system ---
 #include <TObjArray.h>
+#include <algorithm>
 
 // --- AliRoot system ---
 #include "AliAODPWG4ParticleCorrelation.h"
@@ -53,9 +54,23 @@ fDebug(0),
 fFracIsThresh(1),
 fIsTMClusterInConeRejected(1),
 fDistMinToTrigger(-1.),
+fUseIndex(kTRUE),
+fIdxEvent(-1),
+fIdxPID(0x0),
+fIdxPartInCone(-1),
+fIdxTMRejected(0),
+fIdxSelected(),
 fMomentum(),
 fTrackVector()
 {
+  for(Int_t i = 0; i < 2; i++)
+  {
+    fIdxList    [i] = 0x0;
+    fIdxNEntries[i] = -1;
+    fIdxFirst   [i] = 0x0;
+    fIdxLast    [i] = 0x0;
+  }
+  
   InitParameters();
 }
 
@@ -371,6 +386,8 @@ TString AliIsolationCut::GetICParametersList()
   parList+=onePar ;
   snprintf(onePar,buffersize,"fDistMinToTrigger=%1.2f \n",fDistMinToTrigger) ;
   parList+=onePar ;
+  snprintf(onePar,buffersize,"fUseIndex=%d \n",fUseIndex) ;
+  parList+=onePar ;
 
   return parList;
 }
@@ -392,6 +409,254 @@ void AliIsolationCut::InitParameters()
   fDistMinToTrigger = -1.; // no effect
 }
 
+//____________________________________________________________________________________
+/// Fill once per event the eta-phi index of the tracks and clusters lists
+/// used by MakeIsolationCut(), see BuildIndex(Int_t,...).
+/// Nothing is done if the lists were already indexed in this event.
+///
+/// \param plCTS: List of tracks.
+/// \param plNe: List of clusters.
+/// \param reader: pointer to AliCaloTrackReader. Needed to access event info.
+/// \param pid: pointer to AliCaloPID. Needed to reject matched clusters in isolation cone.
+//____________________________________________________________________________________
+void AliIsolationCut::BuildIndex(TObjArray * plCTS, TObjArray * plNe,
+                                 AliCaloTrackReader * reader, AliCaloPID * pid)
+{
+  TObjArray * lists[] = { plCTS, plNe };
+  
+  // Only the lists used for this isolation
+  if ( fPartInCone == kOnlyNeutral ) lists[0] = 0x0;
+  if ( fPartInCone == kOnlyCharged ) lists[1] = 0x0;
+  
+  Bool_t same = ( fIdxEvent      == reader->GetEventNumber()    &&
+                  fIdxPID        == pid                          &&
+                  fIdxPartInCone == fPartInCone                  &&
+                  fIdxTMRejected == fIsTMClusterInConeRejected      );
+  
+  for(Int_t ilist = 0; ilist < 2 && same; ilist++)
+  {
+    TObjArray * list = lists[ilist];
+    Int_t n = list ? list->GetEntries() : -1;
+    
+    if ( fIdxList[ilist] != list || fIdxNEntries[ilist] != n ) same = kFALSE;
+    else if ( n > 0 && ( fIdxFirst[ilist] != list->At(0) || fIdxLast[ilist] != list->At(n-1) ) ) same = kFALSE;
+  }
+  
+  if ( same ) return;
+  
+  fIdxEvent      = reader->GetEventNumber();
+  fIdxPID        = pid;
+  fIdxPartInCone = fPartInCone;
+  fIdxTMRejected = fIsTMClusterInConeRejected;
+  
+  for(Int_t ilist = 0; ilist < 2; ilist++)
+    BuildIndex(ilist, lists[ilist], reader, pid);
+}
+
+//____________________________________________________________________________________
+/// Fill the index of one list, tracks (ilist=0) or clusters (ilist=1).
+/// The kinematics and ID of each entry are calculated as in MakeIsolationCut() and
+/// the entries are sorted in eta-phi cells, see AliEtaPhiGrid.
+/// Clusters rejected by the track matching are left out of the cells.
+//____________________________________________________________________________________
+void AliIsolationCut::BuildIndex(Int_t ilist, TObjArray * list,
+                                 AliCaloTrackReader * reader, AliCaloPID * pid)
+{
+  Int_t n = list ? list->GetEntries() : 0;
+  
+  fIdxList    [ilist] = list;
+  fIdxNEntries[ilist] = list ? n : -1;
+  fIdxFirst   [ilist] = n > 0 ? list->At(0)   : 0x0;
+  fIdxLast    [ilist] = n > 0 ? list->At(n-1) : 0x0;
+  
+  fIdxPt  [ilist].Set(n);
+  fIdxEta [ilist].Set(n);
+  fIdxPhi [ilist].Set(n);
+  fIdxID  [ilist].Set(n);
+  fIdxType[ilist].Set(n);
+  
+  if ( fIdxSelected.GetSize() < n ) fIdxSelected.Set(n);
+  
+  Float_t etaMin = 0, etaMax = 0;
+  Bool_t  first  = kTRUE;
+  
+  for(Int_t ipr = 0; ipr < n; ipr++)
+  {
+    TObject * obj = list->At(ipr);
+    
+    Float_t pt = 0, eta = 0, phi = 0;
+    Int_t   id = 0;
+    Int_t type = kIdxObject;
+    
+    if ( ilist == 0 )
+    {
+      AliVTrack* track = dynamic_cast<AliVTrack*>(obj) ;
+      
+      if(track)
+      {
+        id = reader->GetTrackID(track) ; // needed instead of track->GetID() since AOD needs some manipulations
+        
+        fTrackVector.SetXYZ(track->Px(),track->Py(),track->Pz());
+        pt  = fTrackVector.Pt();
+        eta = fTrackVector.Eta();
+        phi = fTrackVector.Phi() ;
+      }
+      else
+      {// Mixed event stored in AliAODPWG4Particles
+        AliAODPWG4Particle * trackmix = dynamic_cast<AliAODPWG4Particle*>(obj) ;
+        if(!trackmix)
+        {
+          AliWarning("Wrong track data type, continue");
+          type = kIdxNotUsed;
+        }
+        else
+        {
+          pt  = trackmix->Pt();
+          eta = trackmix->Eta();
+          phi = trackmix->Phi() ;
+          type = kIdxMixed;
+        }
+      }
+    }
+    else
+    {
+      AliVCluster * calo = dynamic_cast<AliVCluster *>(obj) ;
+      
+      if(calo)
+      {
+        id = calo->GetID();
+        
+        // Get the index where the cluster comes, to retrieve the corresponding vertex
+        Int_t evtIndex = 0 ;
+        if (reader->GetMixedEvent())
+          evtIndex=reader->GetMixedEvent()->EventIndexForCaloCluster(calo->GetID()) ;
+        
+        // Skip matched clusters with tracks in case of neutral+charged analysis
+        if( fIsTMClusterInConeRejected && fPartInCone == kNeutralAndCharged &&
+            pid->IsTrackMatched(calo,reader->GetCaloUtils(),reader->GetInputEvent()) )
+          type = kIdxNotUsed;
+        
+        // Assume that come from vertex in straight line
+        calo->GetMomentum(fMomentum,reader->GetVertex(evtIndex)) ;
+        
+        pt  = fMomentum.Pt()  ;
+        eta = fMomentum.Eta() ;
+        phi = fMomentum.Phi() ;
+      }
+      else
+      {// Mixed event stored in AliAODPWG4Particles
+        AliAODPWG4Particle * calomix = dynamic_cast<AliAODPWG4Particle*>(obj) ;
+        if(!calomix)
+        {
+          AliWarning("Wrong calo data type, continue");
+          type = kIdxNotUsed;
+        }
+        else
+        {
+          pt  = calomix->Pt();
+          eta = calomix->Eta();
+          phi = calomix->Phi() ;
+          type = kIdxMixed;
+        }
+      }
+    }
+    
+    if ( phi < 0 ) phi+=TMath::TwoPi();
+    
+    fIdxPt  [ilist][ipr] = pt;
+    fIdxEta [ilist][ipr] = eta;
+    fIdxPhi [ilist][ipr] = phi;
+    fIdxID  [ilist][ipr] = id;
+    fIdxType[ilist][ipr] = type;
+    
+    if ( type == kIdxNotUsed ) continue;
+    
+    if ( first || eta < etaMin ) etaMin = eta;
+    if ( first || eta > etaMax ) etaMax = eta;
+    first = kFALSE;
+  }
+  
+  // Eta bins of 0.1, or wider if the range is too large
+  Float_t width = 0.1;
+  Int_t   nEta  = Int_t((etaMax-etaMin)/width) + 1;
+  if ( nEta > kIdxMaxEtaBins )
+  {
+    nEta  = kIdxMaxEtaBins;
+    width = (etaMax-etaMin)/(nEta-1);
+  }
+  
+  AliEtaPhiGrid & grid = fIdxGrid[ilist];
+  
+  grid.SetBinning(nEta, etaMin, width, kIdxNPhiBins);
+  
+  // Cell of each entry, the entries not used are left out
+  // (fIdxSelected is only used as buffer here)
+  TArrayI & cells = fIdxSelected;
+  for(Int_t ipr = 0; ipr < n; ipr++)
+  {
+    if ( fIdxType[ilist][ipr] == kIdxNotUsed ) cells[ipr] = -1;
+    else cells[ipr] = grid.GetCell(fIdxEta[ilist][ipr], fIdxPhi[ilist][ipr]);
+  }
+  
+  grid.Sort(n, cells.GetArray());
+}
+
+//____________________________________________________________________________________
+/// Select from the index the entries of list ilist that can contribute to the
+/// isolation of a candidate at (etaC,phiC), and keep them in fIdxSelected.
+///
+/// Particles in cone are at less than fConeSize in eta and, being on the same side
+/// as the candidate, at less than min(fConeSize,pi/2) in phi, without phi wrapping.
+/// For the background subtraction method the full eta and phi bands around
+/// the candidate are also selected. One extra cell is taken on each side, so that
+/// the selection is never tighter than the cuts applied in MakeIsolationCut().
+///
+/// \return number of selected entries, in increasing list order.
+//____________________________________________________________________________________
+Int_t AliIsolationCut::SelectFromIndex(Int_t ilist, Float_t etaC, Float_t phiC)
+{
+  const AliEtaPhiGrid & grid = fIdxGrid[ilist];
+  
+  Int_t   nEta  = grid.GetNEtaBins();
+  Float_t etaMin= grid.GetEtaMin();
+  Float_t width = grid.GetEtaWidth();
+  
+  Bool_t  bands = ( fICMethod == kSumBkgSubIC );
+  
+  Float_t dPhi  = bands ? fConeSize : TMath::Min(fConeSize, Float_t(TMath::PiOver2()));
+  
+  // Bin ranges clamped before the integer conversion, candidate can be far from the particles
+  Double_t etaLowBin  = TMath::Floor((etaC-fConeSize-etaMin)/width) - 1;
+  Double_t etaHighBin = TMath::Floor((etaC+fConeSize-etaMin)/width) + 1;
+  Double_t phiLowBin  = TMath::Floor((phiC-dPhi)/TMath::TwoPi()*kIdxNPhiBins) - 1;
+  Double_t phiHighBin = TMath::Floor((phiC+dPhi)/TMath::TwoPi()*kIdxNPhiBins) + 1;
+  
+  Int_t etaLow  = Int_t(TMath::Min(Double_t(nEta)        , TMath::Max( 0., etaLowBin )));
+  Int_t etaHigh = Int_t(TMath::Max(-1.                   , TMath::Min(nEta-1., etaHighBin)));
+  Int_t phiLow  = Int_t(TMath::Min(Double_t(kIdxNPhiBins), TMath::Max( 0., phiLowBin )));
+  Int_t phiHigh = Int_t(TMath::Max(-1.                   , TMath::Min(kIdxNPhiBins-1., phiHighBin)));
+  
+  Int_t nsel = 0;
+  
+  for(Int_t ieta = 0; ieta < nEta; ieta++)
+  {
+    Bool_t inEta = ( ieta >= etaLow && ieta <= etaHigh );
+    
+    if ( !inEta && !bands ) continue;
+    
+    // Full phi band for the rows of the eta band, phi window otherwise
+    Int_t iphi0 = ( inEta && bands ) ? 0                : phiLow;
+    Int_t iphi1 = ( inEta && bands ) ? kIdxNPhiBins - 1 : phiHigh;
+    
+    nsel += grid.CopyEntries(ieta, iphi0, iphi1, fIdxSelected.GetArray()+nsel);
+  }
+  
+  // Keep the list order, needed for identical sums and references
+  std::sort(fIdxSelected.GetArray(), fIdxSelected.GetArray()+nsel);
+  
+  return nsel;
+}
+
 //________________________________________________________________________________
 /// Declare a candidate particle isolated depending on the
 /// cluster or track particle multiplicity and/or momentum.
@@ -453,6 +718,10 @@ void  AliIsolationCut::MakeIsolationCut(TObjArray * plCTS,
   Int_t       ntrackrefs   = 0;
   Int_t       nclusterrefs = 0;
   
+  // Tracks and clusters kinematics and position in eta-phi,
+  // done once per event and list
+  if ( fUseIndex ) BuildIndex(plCTS, plNe, reader, pid);
+  
   // --------------------------------
   // Check charged tracks in cone.
   // --------------------------------
@@ -460,45 +729,69 @@ void  AliIsolationCut::MakeIsolationCut(TObjArray * plCTS,
   if(plCTS &&
      (fPartInCone==kOnlyCharged || fPartInCone==kNeutralAndCharged))
   {
-    for(Int_t ipr = 0;ipr < plCTS->GetEntries() ; ipr ++ )
+    // With the index, only the tracks near the candidate, in list order
+    Int_t nsel = fUseIndex ? SelectFromIndex(0, etaC, phiC) : plCTS->GetEntries() ;
+    
+    for(Int_t isel = 0; isel < nsel ; isel ++ )
     {
-      AliVTrack* track = dynamic_cast<AliVTrack*>(plCTS->At(ipr)) ;
+      Int_t      ipr   = fUseIndex ? fIdxSelected[isel] : isel;
+      AliVTrack* track = 0x0;
+      Int_t   trackID  = 0;
       
-      if(track)
+      if ( fUseIndex )
       {
-        // In case of isolation of single tracks or conversion photon (2 tracks) or pi0 (4 tracks),
-        // do not count the candidate or the daughters of the candidate
-        // in the isolation conte
-        if ( pCandidate->GetDetectorTag() == AliFiducialCut::kCTS ) // make sure conversions are tagged as kCTS!!!
+        // Kinematics already calculated in BuildIndex()
+        if ( fIdxType[0][ipr] == kIdxObject )
         {
-          Int_t  trackID   = reader->GetTrackID(track) ; // needed instead of track->GetID() since AOD needs some manipulations
-          Bool_t contained = kFALSE;
+          track   = static_cast<AliVTrack*>(plCTS->At(ipr)) ;
+          trackID = fIdxID[0][ipr];
+        }
+        
+        pt  = fIdxPt [0][ipr];
+        eta = fIdxEta[0][ipr];
+        phi = fIdxPhi[0][ipr];
+      }
+      else
+      {
+        track = dynamic_cast<AliVTrack*>(plCTS->At(ipr)) ;
+        
+        if(track)
+        {
+          trackID = reader->GetTrackID(track) ; // needed instead of track->GetID() since AOD needs some manipulations
           
-          for(Int_t i = 0; i < 4; i++) 
+          fTrackVector.SetXYZ(track->Px(),track->Py(),track->Pz());
+          pt  = fTrackVector.Pt();
+          eta = fTrackVector.Eta();
+          phi = fTrackVector.Phi() ;
+        }
+        else
+        {// Mixed event stored in AliAODPWG4Particles
+          AliAODPWG4Particle * trackmix = dynamic_cast<AliAODPWG4Particle*>(plCTS->At(ipr)) ;
+          if(!trackmix)
           {
-            if( trackID == pCandidate->GetTrackLabel(i) ) contained = kTRUE;
+            AliWarning("Wrong track data type, continue");
+            continue;
           }
           
-          if ( contained ) continue ;
+          pt  = trackmix->Pt();
+          eta = trackmix->Eta();
+          phi = trackmix->Phi() ;
         }
-        
-        fTrackVector.SetXYZ(track->Px(),track->Py(),track->Pz());
-        pt  = fTrackVector.Pt();
-        eta = fTrackVector.Eta();
-        phi = fTrackVector.Phi() ;
       }
-      else
-      {// Mixed event stored in AliAODPWG4Particles
-        AliAODPWG4Particle * trackmix = dynamic_cast<AliAODPWG4Particle*>(plCTS->At(ipr)) ;
-        if(!trackmix)
+      
+      // In case of isolation of single tracks or conversion photon (2 tracks) or pi0 (4 tracks),
+      // do not count the candidate or the daughters of the candidate
+      // in the isolation conte
+      if ( track && pCandidate->GetDetectorTag() == AliFiducialCut::kCTS ) // make sure conversions are tagged as kCTS!!!
+      {
+        Bool_t contained = kFALSE;
+        
+        for(Int_t i = 0; i < 4; i++) 
         {
-          AliWarning("Wrong track data type, continue");
-          continue;
+          if( trackID == pCandidate->GetTrackLabel(i) ) contained = kTRUE;
         }
         
-        pt  = trackmix->Pt();
-        eta = trackmix->Eta();
-        phi = trackmix->Phi() ;
+        if ( contained ) continue ;
       }
       
       // ** Calculate distance between candidate and tracks **
@@ -606,48 +899,73 @@ void  AliIsolationCut::MakeIsolationCut(TObjArray * plCTS,
      (fPartInCone==kOnlyNeutral || fPartInCone==kNeutralAndCharged))
   {
     
-    for(Int_t ipr = 0;ipr < plNe->GetEntries() ; ipr ++ )
+    // With the index, only the clusters near the candidate, in list order
+    Int_t nsel = fUseIndex ? SelectFromIndex(1, etaC, phiC) : plNe->GetEntries() ;
+    
+    for(Int_t isel = 0; isel < nsel ; isel ++ )
     {
-      AliVCluster * calo = dynamic_cast<AliVCluster *>(plNe->At(ipr)) ;
+      Int_t ipr = fUseIndex ? fIdxSelected[isel] : isel;
+      AliVCluster * calo = 0x0;
       
-      if(calo)
+      if ( fUseIndex )
       {
-        // Get the index where the cluster comes, to retrieve the corresponding vertex
-        Int_t evtIndex = 0 ;
-        if (reader->GetMixedEvent())
-          evtIndex=reader->GetMixedEvent()->EventIndexForCaloCluster(calo->GetID()) ;
-        
-        
-        // Do not count the candidate (photon or pi0) or the daughters of the candidate
-        if(calo->GetID() == pCandidate->GetCaloLabel(0) ||
-           calo->GetID() == pCandidate->GetCaloLabel(1)   ) continue ;
-        
-        // Skip matched clusters with tracks in case of neutral+charged analysis
-        if(fIsTMClusterInConeRejected)
+        // Kinematics and track matching rejection already done in BuildIndex()
+        if ( fIdxType[1][ipr] == kIdxObject )
         {
-          if( fPartInCone == kNeutralAndCharged &&
-             pid->IsTrackMatched(calo,reader->GetCaloUtils(),reader->GetInputEvent()) ) continue ;
+          calo = static_cast<AliVCluster *>(plNe->At(ipr)) ;
+          
+          // Do not count the candidate (photon or pi0) or the daughters of the candidate
+          if(fIdxID[1][ipr] == pCandidate->GetCaloLabel(0) ||
+             fIdxID[1][ipr] == pCandidate->GetCaloLabel(1)   ) continue ;
         }
         
-        // Assume that come from vertex in straight line
-        calo->GetMomentum(fMomentum,reader->GetVertex(evtIndex)) ;
-        
-        pt  = fMomentum.Pt()  ;
-        eta = fMomentum.Eta() ;
-        phi = fMomentum.Phi() ;
+        pt  = fIdxPt [1][ipr];
+        eta = fIdxEta[1][ipr];
+        phi = fIdxPhi[1][ipr];
       }
       else
-      {// Mixed event stored in AliAODPWG4Particles
-        AliAODPWG4Particle * calomix = dynamic_cast<AliAODPWG4Particle*>(plNe->At(ipr)) ;
-        if(!calomix)
+      {
+        calo = dynamic_cast<AliVCluster *>(plNe->At(ipr)) ;
+        
+        if(calo)
         {
-          AliWarning("Wrong calo data type, continue");
-          continue;
+          // Get the index where the cluster comes, to retrieve the corresponding vertex
+          Int_t evtIndex = 0 ;
+          if (reader->GetMixedEvent())
+            evtIndex=reader->GetMixedEvent()->EventIndexForCaloCluster(calo->GetID()) ;
+          
+          
+          // Do not count the candidate (photon or pi0) or the daughters of the candidate
+          if(calo->GetID() == pCandidate->GetCaloLabel(0) ||
+             calo->GetID() == pCandidate->GetCaloLabel(1)   ) continue ;
+          
+          // Skip matched clusters with tracks in case of neutral+charged analysis
+          if(fIsTMClusterInConeRejected)
+          {
+            if( fPartInCone == kNeutralAndCharged &&
+               pid->IsTrackMatched(calo,reader->GetCaloUtils(),reader->GetInputEvent()) ) continue ;
+          }
+          
+          // Assume that come from vertex in straight line
+          calo->GetMomentum(fMomentum,reader->GetVertex(evtIndex)) ;
+          
+          pt  = fMomentum.Pt()  ;
+          eta = fMomentum.Eta() ;
+          phi = fMomentum.Phi() ;
+        }
+        else
+        {// Mixed event stored in AliAODPWG4Particles
+          AliAODPWG4Particle * calomix = dynamic_cast<AliAODPWG4Particle*>(plNe->At(ipr)) ;
+          if(!calomix)
+          {
+            AliWarning("Wrong calo data type, continue");
+            continue;
+          }
+          
+          pt  = calomix->Pt();
+          eta = calomix->Eta();
+          phi = calomix->Phi() ;
         }
-        
-        pt  = calomix->Pt();
-        eta = calomix->Eta();
-        phi = calomix->Phi() ;
       }
       
       // ** Calculate distance between candidate and tracks **
@@ -896,6 +1214,7 @@ void AliIsolationCut::Print(const Option_t * opt) const
   printf("particle type in cone =  %d\n",    fPartInCone ) ;
   printf("using fraction for high pt leading instead of frac ? %i\n",fFracIsThresh);
   printf("minimum distance to candidate, R>%1.2f\n",fDistMinToTrigger);
+  printf("use eta-phi index of tracks/clusters  %d\n",fUseIndex);
   printf("    \n") ;
 }
 
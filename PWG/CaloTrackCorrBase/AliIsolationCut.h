@@ -22,8 +22,11 @@
 #include <TObject.h>
 class TObjArray ;
 #include <TLorentzVector.h>
+#include <TArrayF.h>
+#include <TArrayI.h>
 
 // --- ANALYSIS system ---
+#include "AliEtaPhiGrid.h"
 class AliAODPWG4ParticleCorrelation ;
 class AliCaloTrackReader ;
 class AliCaloPID;
@@ -109,9 +112,27 @@ class AliIsolationCut : public TObject {
   void       SetFracIsThresh(Bool_t f )                        { fFracIsThresh      = f    ; }
   void       SetTrackMatchedClusterRejectionInCone(Bool_t tm)  { fIsTMClusterInConeRejected = tm ; }
   void       SetMinDistToTrigger(Float_t md)                   { fDistMinToTrigger  = md   ; }
+  
+  Bool_t     IsEtaPhiIndexUsed()      const { return fUseIndex       ; }
+  void       SwitchOnEtaPhiIndex()                             { fUseIndex          = kTRUE  ; }
+  void       SwitchOffEtaPhiIndex()                            { fUseIndex          = kFALSE ; }
     
  private:
 
+  void       BuildIndex(TObjArray * plCTS, TObjArray * plNe,
+                        AliCaloTrackReader * reader, AliCaloPID * pid) ;
+  
+  void       BuildIndex(Int_t ilist, TObjArray * list,
+                        AliCaloTrackReader * reader, AliCaloPID * pid) ;
+  
+  Int_t      SelectFromIndex(Int_t ilist, Float_t etaC, Float_t phiC) ;
+  
+  /// Status of a track/cluster in the eta-phi index.
+  enum indexType  { kIdxNotUsed = 0, kIdxObject = 1, kIdxMixed = 2 } ;
+  
+  /// Eta-phi index binning.
+  enum indexBins  { kIdxNPhiBins = 64, kIdxMaxEtaBins = 100 } ;
+  
   Float_t    fConeSize ;         ///< Size of the isolation cone
 
   Float_t    fPtThreshold ;      ///< Minimum pt of the particles in the cone or sum in cone (UE pt mean in the forward region cone)
@@ -136,6 +157,26 @@ class AliIsolationCut : public TObject {
   
   Float_t    fDistMinToTrigger;  ///<  Minimal distance between isolation candidate particle and particles in cone to count them for this isolation.
   
+  Bool_t     fUseIndex;          ///<  Loop only on the tracks/clusters near the candidate, found with a per-event eta-phi index.
+  
+  // Per-event eta-phi index of tracks [0] and clusters [1], see BuildIndex()
+  
+  Int_t        fIdxEvent;              //!<! Event number of the indexed lists.
+  TObjArray  * fIdxList[2];            //!<! Indexed lists.
+  Int_t        fIdxNEntries[2];        //!<! Number of entries of the indexed lists.
+  TObject    * fIdxFirst[2];           //!<! First entry of the indexed lists.
+  TObject    * fIdxLast[2];            //!<! Last entry of the indexed lists.
+  AliCaloPID * fIdxPID;                //!<! PID used for the track matching rejection of clusters.
+  Int_t        fIdxPartInCone;         //!<! fPartInCone when the index was built.
+  Bool_t       fIdxTMRejected;         //!<! fIsTMClusterInConeRejected when the index was built.
+  TArrayF      fIdxPt[2];              //!<! pT of each list entry.
+  TArrayF      fIdxEta[2];             //!<! Eta of each list entry.
+  TArrayF      fIdxPhi[2];             //!<! Phi of each list entry, in [0,2pi].
+  TArrayI      fIdxID[2];              //!<! Track or cluster ID of each list entry.
+  TArrayI      fIdxType[2];            //!<! indexType of each list entry.
+  AliEtaPhiGrid fIdxGrid[2];           //!<! List entries sorted in eta-phi cells.
+  TArrayI      fIdxSelected;           //!<! List entries near the current candidate, increasing order.
+  
   TLorentzVector fMomentum;      //!<! Momentum of cluster, temporal object.
 
   TVector3   fTrackVector;       //!<! Track moment, temporal object.
@@ -147,7 +188,7 @@ class AliIsolationCut : public TObject {
   AliIsolationCut & operator = (const AliIsolationCut & g) ; 
 
   /// \cond CLASSIMP
-  ClassDef(AliIsolationCut,11) ;
+  ClassDef(AliIsolationCut,13) ;
   /// \endcond
 
 } ;
@@ -22,6 +22,7 @@
 
 //---- ANALYSIS system ----
 #include "AliMCAnalysisUtils.h"
+#include "AliMCAncestryCache.h"
 #include "AliMCEvent.h"
 #include "AliGenPythiaEventHeader.h"
 #include "AliVParticle.h"
@@ -41,6 +42,7 @@ fDebug(0),
 fJetsList(new TList), 
 fMCGenerator(kPythia),
 fMCGeneratorString("PYTHIA"),
+fAncestryCache(0x0),
 fDaughMom(),  fDaughMom2(),
 fMotherMom(), fGMotherMom()
 {}
@@ -222,115 +224,23 @@ Int_t AliMCAnalysisUtils::CheckOrigin(const Int_t *labels, Int_t nlabels,
   // Most significant particle contributing to the cluster
   Int_t label=labels[0];
     
-  // Mother
-  AliVParticle * mom = mcevent->GetTrack(label);
-  Int_t iMom     = label;
-  Int_t mPdgSign = mom->PdgCode();
-  Int_t mPdg     = TMath::Abs(mPdgSign);
-  Int_t mStatus  = mom->MCStatusCode() ;
-  Int_t iParent  = mom->GetMother() ;
-  
-  //if(label < 8 && fMCGenerator != kBoxLike) AliDebug(1,Form("Mother is parton %d\n",iParent));
-  
-  //GrandParent
-  AliVParticle * parent = NULL ;
-  Int_t pPdg    =-1;
-  Int_t pStatus =-1;
-  if(iParent >= 0)
+  // First non converted mother and its parent, from the
+  // per-event cache when it is shared by several analyses
+  AliMCAncestryCache::Ancestry anc;
+  if ( !fAncestryCache || !fAncestryCache->Find(label, anc) )
   {
-    parent = mcevent->GetTrack(iParent);
-    pPdg = TMath::Abs(parent->PdgCode());
-    pStatus = parent->MCStatusCode();  
+    FindAncestry(label, mcevent, anc);
+    
+    if ( fAncestryCache ) fAncestryCache->Store(label, anc);
   }
-  else AliDebug(1,Form("Parent with label %d",iParent));
-  
-  AliDebug(2,"Cluster most contributing mother and its parent:");
-  AliDebug(2,Form("\t Mother label %d, pdg %d, status %d, Primary? %d, Physical Primary? %d",
-                  iMom   , mPdg, mStatus, mom->IsPrimary()             , mom->IsPhysicalPrimary()));
-  AliDebug(2,Form("\t Parent label %d, pdg %d, status %d, Primary? %d, Physical Primary? %d",
-                  iParent, pPdg, pStatus, parent?parent->IsPrimary():-1, parent?parent->IsPhysicalPrimary():-1));
   
-  //Check if mother is converted, if not, get the first non converted mother
-  if((mPdg == 22 || mPdg == 11) && (pPdg == 22 || pPdg == 11) && mStatus==0)
-  {
-    SetTagBit(tag,kMCConversion);
-    
-    // Check if the mother is photon or electron with status not stable
-    while ((pPdg == 22 || pPdg == 11) && !mom->IsPhysicalPrimary())
-    {
-      // Mother
-      iMom  = mom->GetMother();
-      
-      if(iMom < 0) 
-      {
-        AliInfo(Form("pdg = %d, mother = %d, skip",pPdg,iMom));
-        break;
-      }
-      
-      mom      = mcevent->GetTrack(iMom);
-      mPdgSign = mom->PdgCode();
-      mPdg     = TMath::Abs(mPdgSign);
-      mStatus  = mom->MCStatusCode() ;
-      iParent  = mom->GetMother() ;
-      //if(label < 8 ) AliDebug(1, Form("AliMCAnalysisUtils::CheckOriginInAOD() - Mother is parton %d\n",iParent));
-      
-      // GrandParent
-      if(iParent >= 0 && parent)
-      {
-        parent = mcevent->GetTrack(iParent);
-        pPdg = TMath::Abs(parent->PdgCode());
-        pStatus = parent->MCStatusCode();  
-      }
-      // printf("\t While Mother label %d, pdg %d, Primary? %d, Physical Primary? %d\n",iMom, mPdg, mom->IsPrimary(), mom->IsPhysicalPrimary());
-      // printf("\t While Parent label %d, pdg %d, Primary? %d, Physical Primary? %d\n",iParent, pPdg, parent->IsPrimary(), parent->IsPhysicalPrimary()); 
-      
-    }//while	
-    
-    AliDebug(2,"Converted photon/electron:");
-    AliDebug(2,Form("\t Mother label %d, pdg %d, status %d, Primary? %d, Physical Primary? %d"
-                    ,iMom   , mPdg, mStatus, mom->IsPrimary()             , mom->IsPhysicalPrimary()));
-    AliDebug(2,Form("\t Parent label %d, pdg %d, status %d, Primary? %d, Physical Primary? %d"
-                    ,iParent, pPdg, pStatus, parent?parent->IsPrimary():-1, parent?parent->IsPhysicalPrimary():-1));
-    
-  } // mother and parent are electron or photon and have status 0 and parent is photon or electron
-  else if((mPdg == 22 || mPdg == 11) && mStatus==0)
-  {
-    // Still a conversion but only one electron/photon generated. Just from hadrons
-    if(pPdg == 2112 ||  pPdg == 211 ||  pPdg == 321 ||  
-       pPdg == 2212 ||  pPdg == 130 ||  pPdg == 13 )
-    {
-      SetTagBit(tag,kMCConversion);
-      iMom     = mom->GetMother();
-      
-      if(iMom < 0) 
-      {
-        AliInfo(Form("pdg = %d, mother = %d, skip",pPdg,iMom));
-      }
-      else
-      {
-        mom      = mcevent->GetTrack(iMom);
-        mPdgSign = mom->PdgCode();
-        mPdg     = TMath::Abs(mPdgSign);
-        mStatus  = mom->MCStatusCode() ;
-
-        AliDebug(2,"Converted hadron:");
-        AliDebug(2,Form("\t Mother label %d, pdg %d, status %d, Primary? %d, Physical Primary? %d",
-                        iMom, mPdg, mStatus, mom->IsPrimary(), mom->IsPhysicalPrimary()));
-      }
-    } // hadron converted
-    
-    //Comment for next lines, we do not check the parent of the hadron for the moment.
-    //iParent =  mom->GetMother() ;
-    //if(fDebug > 0 && label < 8 ) printf("AliMCAnalysisUtils::CheckOriginInAOD() - Mother is parton %d\n",iParent);
-    
-    //GrandParent
-    //if(iParent >= 0){
-    //	parent = mcevent->GetTrack(iParent);
-    //	pPdg = TMath::Abs(parent->PdgCode());
-    //}
-  }  
+  tag |= anc.fTag;
   
-  //printf("Final mother mPDG %d\n",mPdg);
+  Int_t iMom     = anc.fMother;
+  Int_t mPdgSign = anc.fMotherPdg;
+  Int_t mPdg     = TMath::Abs(mPdgSign);
+  Int_t iParent  = anc.fParent;
+  Int_t pPdg     = anc.fParentPdg;
   
   // conversion into electrons/photons checked  
   
@@ -395,7 +305,7 @@ Int_t AliMCAnalysisUtils::CheckOrigin(const Int_t *labels, Int_t nlabels,
       if(!CheckTagBit(tag, kMCEta) && !CheckTagBit(tag,kMCDecayPairInCalo) && !CheckTagBit(tag,kMCDecayPairLost))
         CheckLostDecayPair(arrayCluster,iMom, iParent, mcevent, tag);
     }
-    else if( mom->IsPhysicalPrimary() && ( fMCGenerator == kPythia || fMCGenerator == kHerwig ) ) //undecayed particle
+    else if( anc.fMotherPhysPrim && ( fMCGenerator == kPythia || fMCGenerator == kHerwig ) ) //undecayed particle
     {
       if(iParent < 8 && iParent > 5 )
       {
@@ -444,13 +354,11 @@ Int_t AliMCAnalysisUtils::CheckOrigin(const Int_t *labels, Int_t nlabels,
   else if(mPdg == 11)
   { 
     //electron
-    if(pPdg == 11 && parent)
+    if(pPdg == 11 && anc.fHasParent)
     {
-      Int_t iGrandma = parent->GetMother();
-      if(iGrandma >= 0)
+      if(anc.fGrandParentPdg >= 0)
       {
-        AliVParticle * gma = mcevent->GetTrack(iGrandma);
-        Int_t gPdg = TMath::Abs(gma->PdgCode());
+        Int_t gPdg = anc.fGrandParentPdg;
         
         if      (gPdg == 23) { SetTagBit(tag,kMCZDecay); } //parent is Z-boson
         else if (gPdg == 24) { SetTagBit(tag,kMCWDecay); } //parent is W-boson
@@ -467,13 +375,11 @@ Int_t AliMCAnalysisUtils::CheckOrigin(const Int_t *labels, Int_t nlabels,
     else if((399 < pPdg && pPdg < 500)||(3999 < pPdg && pPdg < 5000))
     { 
       //c-hadron decay check
-      if(parent)
+      if(anc.fHasParent)
       {
-        Int_t iGrandma = parent->GetMother();
-        if(iGrandma >= 0)
+        if(anc.fGrandParentPdg >= 0)
         {
-          AliVParticle * gma = mcevent->GetTrack(iGrandma); //charm's mother
-          Int_t gPdg = TMath::Abs(gma->PdgCode());
+          Int_t gPdg = anc.fGrandParentPdg; //charm's mother
           if((499 < gPdg && gPdg < 600)||(4999 < gPdg && gPdg < 6000)) SetTagBit(tag,kMCEFromCFromB); //b-->c-->e decay
           else SetTagBit(tag,kMCEFromC); //c-hadron decay
         }
@@ -501,6 +407,148 @@ Int_t AliMCAnalysisUtils::CheckOrigin(const Int_t *labels, Int_t nlabels,
   return tag;
 }
 
+//__________________________________________________________________________________________
+/// Walk up the MC stack from the label to the first non converted mother
+/// and its parent, used by CheckOrigin(). The result only depends on the label
+/// and the MC event, so it can be kept in the AliMCAncestryCache.
+///
+/// \param label: MC label of the particle, already checked to be valid
+/// \param mcevent: pointer to MCEvent()
+/// \param anc: ancestry of the label, filled here
+//__________________________________________________________________________________________
+void AliMCAnalysisUtils::FindAncestry(Int_t label, const AliMCEvent* mcevent,
+                                      AliMCAncestryCache::Ancestry & anc) const
+{
+  Int_t tag = 0;
+  
+  // Mother
+  AliVParticle * mom = mcevent->GetTrack(label);
+  Int_t iMom     = label;
+  Int_t mPdgSign = mom->PdgCode();
+  Int_t mPdg     = TMath::Abs(mPdgSign);
+  Int_t mStatus  = mom->MCStatusCode() ;
+  Int_t iParent  = mom->GetMother() ;
+  
+  //if(label < 8 && fMCGenerator != kBoxLike) AliDebug(1,Form("Mother is parton %d\n",iParent));
+  
+  //GrandParent
+  AliVParticle * parent = NULL ;
+  Int_t pPdg    =-1;
+  Int_t pStatus =-1;
+  if(iParent >= 0)
+  {
+    parent = mcevent->GetTrack(iParent);
+    pPdg = TMath::Abs(parent->PdgCode());
+    pStatus = parent->MCStatusCode();  
+  }
+  else AliDebug(1,Form("Parent with label %d",iParent));
+  
+  AliDebug(2,"Cluster most contributing mother and its parent:");
+  AliDebug(2,Form("\t Mother label %d, pdg %d, status %d, Primary? %d, Physical Primary? %d",
+                  iMom   , mPdg, mStatus, mom->IsPrimary()             , mom->IsPhysicalPrimary()));
+  AliDebug(2,Form("\t Parent label %d, pdg %d, status %d, Primary? %d, Physical Primary? %d",
+                  iParent, pPdg, pStatus, parent?parent->IsPrimary():-1, parent?parent->IsPhysicalPrimary():-1));
+  
+  //Check if mother is converted, if not, get the first non converted mother
+  if((mPdg == 22 || mPdg == 11) && (pPdg == 22 || pPdg == 11) && mStatus==0)
+  {
+    SetTagBit(tag,kMCConversion);
+    
+    // Check if the mother is photon or electron with status not stable
+    while ((pPdg == 22 || pPdg == 11) && !mom->IsPhysicalPrimary())
+    {
+      // Mother
+      iMom  = mom->GetMother();
+      
+      if(iMom < 0) 
+      {
+        AliInfo(Form("pdg = %d, mother = %d, skip",pPdg,iMom));
+        break;
+      }
+      
+      mom      = mcevent->GetTrack(iMom);
+      mPdgSign = mom->PdgCode();
+      mPdg     = TMath::Abs(mPdgSign);
+      mStatus  = mom->MCStatusCode() ;
+      iParent  = mom->GetMother() ;
+      //if(label < 8 ) AliDebug(1, Form("AliMCAnalysisUtils::CheckOriginInAOD() - Mother is parton %d\n",iParent));
+      
+      // GrandParent
+      if(iParent >= 0 && parent)
+      {
+        parent = mcevent->GetTrack(iParent);
+        pPdg = TMath::Abs(parent->PdgCode());
+        pStatus = parent->MCStatusCode();  
+      }
+      // printf("\t While Mother label %d, pdg %d, Primary? %d, Physical Primary? %d\n",iMom, mPdg, mom->IsPrimary(), mom->IsPhysicalPrimary());
+      // printf("\t While Parent label %d, pdg %d, Primary? %d, Physical Primary? %d\n",iParent, pPdg, parent->IsPrimary(), parent->IsPhysicalPrimary()); 
+      
+    }//while	
+    
+    AliDebug(2,"Converted photon/electron:");
+    AliDebug(2,Form("\t Mother label %d, pdg %d, status %d, Primary? %d, Physical Primary? %d"
+                    ,iMom   , mPdg, mStatus, mom->IsPrimary()             , mom->IsPhysicalPrimary()));
+    AliDebug(2,Form("\t Parent label %d, pdg %d, status %d, Primary? %d, Physical Primary? %d"
+                    ,iParent, pPdg, pStatus, parent?parent->IsPrimary():-1, parent?parent->IsPhysicalPrimary():-1));
+    
+  } // mother and parent are electron or photon and have status 0 and parent is photon or electron
+  else if((mPdg == 22 || mPdg == 11) && mStatus==0)
+  {
+    // Still a conversion but only one electron/photon generated. Just from hadrons
+    if(pPdg == 2112 ||  pPdg == 211 ||  pPdg == 321 ||  
+       pPdg == 2212 ||  pPdg == 130 ||  pPdg == 13 )
+    {
+      SetTagBit(tag,kMCConversion);
+      iMom     = mom->GetMother();
+      
+      if(iMom < 0) 
+      {
+        AliInfo(Form("pdg = %d, mother = %d, skip",pPdg,iMom));
+      }
+      else
+      {
+        mom      = mcevent->GetTrack(iMom);
+        mPdgSign = mom->PdgCode();
+        mPdg     = TMath::Abs(mPdgSign);
+        mStatus  = mom->MCStatusCode() ;
+
+        AliDebug(2,"Converted hadron:");
+        AliDebug(2,Form("\t Mother label %d, pdg %d, status %d, Primary? %d, Physical Primary? %d",
+                        iMom, mPdg, mStatus, mom->IsPrimary(), mom->IsPhysicalPrimary()));
+      }
+    } // hadron converted
+    
+    //Comment for next lines, we do not check the parent of the hadron for the moment.
+    //iParent =  mom->GetMother() ;
+    //if(fDebug > 0 && label < 8 ) printf("AliMCAnalysisUtils::CheckOriginInAOD() - Mother is parton %d\n",iParent);
+    
+    //GrandParent
+    //if(iParent >= 0){
+    //	parent = mcevent->GetTrack(iParent);
+    //	pPdg = TMath::Abs(parent->PdgCode());
+    //}
+  }  
+  
+  
+  // Grand parent, needed for the electron origin
+  Int_t gPdg = -1;
+  if ( parent )
+  {
+    Int_t iGrandma = parent->GetMother();
+    AliVParticle * gma = ( iGrandma >= 0 ) ? mcevent->GetTrack(iGrandma) : 0;
+    if ( gma ) gPdg = TMath::Abs(gma->PdgCode());
+  }
+  
+  anc.fTag            = tag;
+  anc.fMother         = iMom;
+  anc.fMotherPdg      = mPdgSign;
+  anc.fMotherPhysPrim = mom->IsPhysicalPrimary();
+  anc.fParent         = iParent;
+  anc.fParentPdg      = pPdg;
+  anc.fHasParent      = (parent != 0x0);
+  anc.fGrandParentPdg = gPdg;
+}
+
 //_________________________________________________________________________________________
 /// Check if cluster is formed from the contribution of 2 decay photons from pi0 or eta. 
 /// Input are AOD AliVParticles.
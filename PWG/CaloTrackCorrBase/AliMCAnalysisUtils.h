@@ -31,6 +31,9 @@ class TClonesArray;
 class AliMCEvent;
 class AliGenEventHeader;
 
+//--- ANALYSIS system ---
+#include "AliMCAncestryCache.h"
+
 class AliMCAnalysisUtils : public TObject {
 	
  public: 
@@ -119,11 +122,18 @@ class AliMCAnalysisUtils : public TObject {
   Int_t   GetMCGenerator()        const { return fMCGenerator  ; }
   TString GetMCGeneratorString()  const { return fMCGeneratorString ; }
   
+  /// Per-event cache of the CheckOrigin() ancestry walk, not owned.
+  /// Reset() must be called on it at each new event.
+  void    SetAncestryCache(AliMCAncestryCache * cache) { fAncestryCache = cache ; }
+  AliMCAncestryCache * GetAncestryCache() const      { return fAncestryCache ; }
+  
   void    Print(const Option_t * opt) const;
   void    PrintMCTag(Int_t tag) const;
 
  private:
 
+  void    FindAncestry(Int_t label, const AliMCEvent* mcevent, AliMCAncestryCache::Ancestry & anc) const ;
+  
   Int_t          fCurrentEvent;        ///<  Current Event number - GetJets()
   
   Int_t          fDebug;               ///<  Debug level
@@ -134,6 +144,8 @@ class AliMCAnalysisUtils : public TObject {
   
   TString        fMCGeneratorString;   ///<  MC generator used to generate data in simulation
   
+  AliMCAncestryCache * fAncestryCache; //!<! Per-event ancestry cache, shared with other analyses, not owned
+  
   TLorentzVector fDaughMom;            //!<! particle momentum
   
   TLorentzVector fDaughMom2;           //!<! particle momentum
@@ -149,7 +161,7 @@ class AliMCAnalysisUtils : public TObject {
   AliMCAnalysisUtils(              const AliMCAnalysisUtils & mcu) ; 
   
   /// \cond CLASSIMP
-  ClassDef(AliMCAnalysisUtils,7) ;
+  ClassDef(AliMCAnalysisUtils,8) ;
   /// \endcond
 
 } ;
@@ -0,0 +1,104 @@
+/**************************************************************************
+ * Copyright(c) 1998-1999, ALICE Experiment at CERN, All rights reserved. *
+ *                                                                        *
+ * Author: The ALICE Off-line Project.                                    *
+ * Contributors are mentioned in the code where appropriate.              *
+ *                                                                        *
+ * Permission to use, copy, modify and distribute this software and its   *
+ * documentation strictly for non-commercial purposes is hereby granted   *
+ * without fee, provided that the above copyright notice appears in all   *
+ * copies and that both the copyright notice and this permission notice   *
+ * appear in the supporting documentation. The authors make no claims     *
+ * about the suitability of this software for any purpose. It is          *
+ * provided "as is" without express or implied warranty.                  *
+ **************************************************************************/
+
+// --- ROOT system ---
+#include <TMath.h>
+
+//---- ANALYSIS system ----
+#include "AliMCAncestryCache.h"
+
+/// \cond CLASSIMP
+ClassImp(AliMCAncestryCache) ;
+/// \endcond
+
+//________________________________________
+/// Constructor
+//________________________________________
+AliMCAncestryCache::AliMCAncestryCache() :
+TObject(),
+fStamp(1),
+fStamps(),
+fRecords()
+{}
+
+//_____________________________________________________________________________
+/// \return kTRUE if the ancestry of the label was stored in the current event,
+/// in which case it is copied in anc.
+//_____________________________________________________________________________
+Bool_t AliMCAncestryCache::Find(Int_t label, Ancestry & anc) const
+{
+  if ( label < 0 || label >= fStamps.GetSize() || fStamps.At(label) != fStamp )
+    return kFALSE;
+
+  const Int_t * rec = fRecords.GetArray() + label*kNFields;
+
+  anc.fTag            = rec[0];
+  anc.fMother         = rec[1];
+  anc.fMotherPdg      = rec[2];
+  anc.fMotherPhysPrim = rec[3];
+  anc.fParent         = rec[4];
+  anc.fParentPdg      = rec[5];
+  anc.fHasParent      = rec[6];
+  anc.fGrandParentPdg = rec[7];
+
+  return kTRUE;
+}
+
+//_____________________________________________________________________________
+/// Keep the ancestry of the label for the current event.
+/// Arrays are enlarged to the highest label seen, and kept between events.
+//_____________________________________________________________________________
+void AliMCAncestryCache::Store(Int_t label, const Ancestry & anc)
+{
+  if ( label < 0 ) return;
+
+  if ( label >= fStamps.GetSize() )
+  {
+    Int_t size = TMath::Max(2*fStamps.GetSize(), label+1);
+    fStamps .Set(size);
+    fRecords.Set(size*kNFields);
+  }
+
+  Int_t * rec = fRecords.GetArray() + label*kNFields;
+
+  rec[0] = anc.fTag;
+  rec[1] = anc.fMother;
+  rec[2] = anc.fMotherPdg;
+  rec[3] = anc.fMotherPhysPrim;
+  rec[4] = anc.fParent;
+  rec[5] = anc.fParentPdg;
+  rec[6] = anc.fHasParent;
+  rec[7] = anc.fGrandParentPdg;
+
+  fStamps[label] = fStamp;
+}
+
+//________________________________________________________
+/// Print the cache size.
+//________________________________________________________
+void AliMCAncestryCache::Print(const Option_t * opt) const
+{
+  if(! opt)
+    return;
+
+  printf("***** Print: %s %s ******\n", GetName(), GetTitle() ) ;
+
+  Int_t nStored = 0;
+  for(Int_t i = 0; i < fStamps.GetSize(); i++)
+    if ( fStamps.At(i) == fStamp ) nStored++;
+
+  printf("Labels in current event = %d, capacity %d\n", nStored, fStamps.GetSize());
+  printf(" \n");
+}
@@ -0,0 +1,82 @@
+#ifndef ALIMCANCESTRYCACHE_H
+#define ALIMCANCESTRYCACHE_H
+/* Copyright(c) 1998-1999, ALICE Experiment at CERN, All rights reserved. *
+ * See cxx source for full Copyright notice     */
+
+//_________________________________________________________________________
+/// \class AliMCAncestryCache
+/// \ingroup CaloTrackCorrelationsBase
+/// \brief Per-event cache of the MC ancestry walk done in AliMCAnalysisUtils::CheckOrigin.
+///
+/// For each MC label the first non converted mother, its parent and the
+/// parent's mother are found walking up the MC stack. The result only depends on
+/// the label and on the MC event, so it is kept here and reused by all the analyses
+/// of an AliAnaCaloTrackCorrMaker asking for the origin of the same label
+/// in the same event. The cluster dependent checks (merged or lost decay pairs)
+/// are not cached.
+///
+/// Entries are invalidated in one go with Reset(), which must be called
+/// at the beginning of each event; the maker does it for its analyses.
+//_________________________________________________________________________
+
+// --- ROOT system ---
+#include <TObject.h>
+#include <TArrayI.h>
+
+class AliMCAncestryCache : public TObject {
+
+ public:
+
+  AliMCAncestryCache() ;                   // ctor
+
+  virtual ~AliMCAncestryCache() { ; }      // virtual dtor
+
+  /// Result of the ancestry walk for one MC label.
+  struct Ancestry
+  {
+    Int_t fTag;              ///< Origin bits set during the walk (conversion)
+    Int_t fMother;           ///< Label of the first non converted mother
+    Int_t fMotherPdg;        ///< Signed PDG of the mother
+    Int_t fMotherPhysPrim;   ///< Mother is physical primary
+    Int_t fParent;           ///< Label of the mother's parent
+    Int_t fParentPdg;        ///< Absolute PDG of the parent, -1 if not found
+    Int_t fHasParent;        ///< Parent particle was accessed in the walk
+    Int_t fGrandParentPdg;   ///< Absolute PDG of the parent's mother, -1 if none
+  } ;
+
+  Bool_t  Find (Int_t label, Ancestry & anc) const ;
+
+  void    Store(Int_t label, const Ancestry & anc) ;
+
+  /// Invalidate all entries, call it once per event.
+  void    Reset()                          { fStamp++ ; }
+
+  void    Print(const Option_t * opt) const ;
+
+ private:
+
+  /// Number of integers stored per label.
+  enum { kNFields = 8 } ;
+
+  Int_t          fStamp;               //!<! Current event stamp
+
+  TArrayI        fStamps;              //!<! Event stamp of each label entry
+
+  TArrayI        fRecords;             //!<! Ancestry of each label, kNFields per label
+
+  /// Assignment operator not implemented.
+  AliMCAncestryCache & operator = (const AliMCAncestryCache & cache) ;
+
+  /// Copy constructor not implemented.
+  AliMCAncestryCache(              const AliMCAncestryCache & cache) ;
+
+  /// \cond CLASSIMP
+  ClassDef(AliMCAncestryCache,1) ;
+  /// \endcond
+
+} ;
+
+#endif //ALIMCANCESTRYCACHE_H
+
+
+
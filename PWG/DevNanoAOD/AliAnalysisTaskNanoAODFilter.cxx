@@ -57,7 +57,8 @@ AliAnalysisTaskNanoAODFilter::AliAnalysisTaskNanoAODFilter() // All data members
   fEvtCuts(0),
   fTrkCuts(0),
   fSetter(0),
-  fSaveCutsFlag(0)
+  fSaveCutsFlag(0),
+  fColumnarTracks(0)
 {
   // Dummy constructor ALWAYS needed for I/O.
 }
@@ -71,7 +72,8 @@ AliAnalysisTaskNanoAODFilter::AliAnalysisTaskNanoAODFilter(const char *name, Boo
    fEvtCuts(0),
    fTrkCuts(0),
    fSetter(0),
-   fSaveCutsFlag(saveCutsFlag)
+   fSaveCutsFlag(saveCutsFlag),
+   fColumnarTracks(0)
      
 {
   // Constructor
@@ -125,6 +127,7 @@ void AliAnalysisTaskNanoAODFilter::AddFilteredAOD(const char* aodfilename, const
      
   cout<<"rep: "<<rep<<endl;
   rep->SetCustomSetter(fSetter);
+  rep->SetColumnar(fColumnarTracks);
   std::cout << "SETTER: " << fSetter << " " << rep->GetCustomSetter() << std::endl;
   
   ext->DropUnspecifiedBranches(); // all branches not part of a FilterBranch call (below) will be dropped
@@ -74,6 +74,7 @@ class AliAODRecoDecay;
 #include "TCanvas.h"
 #include "AliNanoAODHeader.h"
 #include "AliNanoAODCustomSetter.h"
+#include "AliNanoAODTrackColumn.h"
 
 using std::cout;
 using std::endl;
@@ -93,7 +94,9 @@ AliAODBranchReplicator(),
   fParticleSelected(),
   fVarList(""),
   fVarListHeader(""),
-  fCustomSetter(0){
+  fCustomSetter(0),
+  fColumnar(kFALSE),
+  fColumns(0x0){
   // Default ctor. we need it to avoid instantiating a wrong mapping when reading from file 
   }
 
@@ -114,7 +117,9 @@ AliNanoAODReplicator::AliNanoAODReplicator(const char* name, const char* title,
   fParticleSelected(),
   fVarList(varlist),
   fVarListHeader(""),// FIXME: this should be set to a meaningful value: add an arg to the constructor
-  fCustomSetter(0)
+  fCustomSetter(0),
+  fColumnar(kFALSE),
+  fColumns(0x0)
 {
   // default ctor
   AliNanoAODTrackMapping * tm =new AliNanoAODTrackMapping(fVarList);
@@ -128,6 +133,8 @@ AliNanoAODReplicator::~AliNanoAODReplicator()
   // dtor
   delete fTrackCut;
   delete fList;
+  if (fColumnar) delete fTracks; // not in fList in the columnar layout
+  delete fColumns;
 }
 
 //_____________________________________________________________________________
@@ -407,7 +414,22 @@ TList* AliNanoAODReplicator::GetList() const
 
       fTracks = new TClonesArray("AliNanoAODTrack");      
       fTracks->SetName("tracks"); // TODO: consider the possibility to use a different name to distinguish in AliAODEvent
-      fList->Add(fTracks);    
+      if (!fColumnar) {
+	fList->Add(fTracks);    
+      } else {
+	// The tracks are still built (custom setter, MC label remapping),
+	// but only their columns are written
+	AliNanoAODTrackMapping * tm = AliNanoAODTrackMapping::GetInstance();
+	fColumns = new TObjArray(tm->GetSize()+2);
+	for (Int_t ivar = 0; ivar < tm->GetSize(); ivar++) {
+	  fColumns->Add(new AliNanoAODTrackColumn(tm->GetVarName(ivar)));
+	}
+	fColumns->Add(new AliNanoAODTrackColumn("label"));
+	fColumns->Add(new AliNanoAODTrackColumn("charge"));
+	for (Int_t icol = 0; icol < fColumns->GetEntriesFast(); icol++) {
+	  fList->Add(fColumns->UncheckedAt(icol)); // owned by fList
+	}
+      }
 
       fHeader = new AliNanoAODHeader(3);// TODO: to be customized
       fHeader->SetName("header"); // TODO: consider the possibility to use a different name to distinguish in AliAODEvent
@@ -445,6 +467,7 @@ void AliNanoAODReplicator::ReplicateAndFilter(const AliAODEvent& source)
   
 
   fTracks->Clear("C");			
+  if (fColumns) FillColumns(); // empty columns in case of early return
   assert(fVertices!=0x0);
   fVertices->Clear("C");
   if (fMCMode > 0){
@@ -510,11 +533,38 @@ void AliNanoAODReplicator::ReplicateAndFilter(const AliAODEvent& source)
     FilterMC(source);      
   }
   
+  // columns are filled last, after the MC labels have been remapped
+  if (fColumns) FillColumns();
 
 }
 
 
 
+//_____________________________________________________________________________
+void AliNanoAODReplicator::FillColumns()
+{
+  // Copy the variables of the kept tracks to the columns (columnar layout)
+
+  const Int_t ntracks = fTracks->GetEntriesFast();
+  const Int_t nvars = fColumns->GetEntriesFast() - 2;
+
+  Float_t ** values = new Float_t*[nvars+2];
+  for (Int_t icol = 0; icol < nvars+2; icol++) {
+    AliNanoAODTrackColumn * column = static_cast<AliNanoAODTrackColumn*>(fColumns->UncheckedAt(icol));
+    column->SetSize(ntracks);
+    values[icol] = column->GetArray();
+  }
+
+  for (Int_t itrack = 0; itrack < ntracks; itrack++) {
+    AliNanoAODTrack * track = static_cast<AliNanoAODTrack*>(fTracks->UncheckedAt(itrack));
+    for (Int_t ivar = 0; ivar < nvars; ivar++) values[ivar][itrack] = track->GetVar(ivar);
+    values[nvars][itrack]   = track->GetLabel(); // exact up to 2^24
+    values[nvars+1][itrack] = track->Charge();
+  }
+
+  delete [] values;
+}
+
 //-----------------------------------------------------------------------------
 
 //----------------------------------------------------------------------------
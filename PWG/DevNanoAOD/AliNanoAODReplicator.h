@@ -58,6 +58,7 @@ class AliAODTrack;
 class AliNanoAODCustomSetter;
 
 class TH1F;
+class TObjArray;
 
 class AliNanoAODReplicator : public AliAODBranchReplicator
 {
@@ -88,6 +89,11 @@ class AliNanoAODReplicator : public AliAODBranchReplicator
   AliNanoAODCustomSetter * GetCustomSetter() { return fCustomSetter; }
   void  SetCustomSetter (AliNanoAODCustomSetter * var) { fCustomSetter = var;  }
 
+  // Columnar layout: one branch per track variable ("tracks_<var>", see
+  // AliNanoAODTrackColumn) instead of the "tracks" array. To be set before GetList()
+  Bool_t IsColumnar() const { return fColumnar; }
+  void  SetColumnar (Bool_t var) { fColumnar = var; }
+
 
  private:
 
@@ -96,6 +102,7 @@ class AliNanoAODReplicator : public AliAODBranchReplicator
   void CreateLabelMap(const AliAODEvent& source);
   Int_t GetNewLabel(Int_t i);
   void FilterMC(const AliAODEvent& source);
+  void FillColumns();
  
 
  private:
@@ -121,13 +128,16 @@ class AliNanoAODReplicator : public AliAODBranchReplicator
 
   AliNanoAODCustomSetter * fCustomSetter;  // Setter class for custom variables
 
+  Bool_t fColumnar; // if true, the tracks are written as one column per variable
+  mutable TObjArray* fColumns; //! track columns: one per variable, then label and charge
+
  private:
 
   
   AliNanoAODReplicator(const AliNanoAODReplicator&);
   AliNanoAODReplicator& operator=(const AliNanoAODReplicator&);
   
-  ClassDef(AliNanoAODReplicator,1) // Branch replicator for ESD to muon AOD.
+  ClassDef(AliNanoAODReplicator,2) // Branch replicator for ESD to muon AOD.
 };
 
 #endif
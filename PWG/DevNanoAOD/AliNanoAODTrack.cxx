@@ -445,7 +445,11 @@ Bool_t AliNanoAODTrack::GetPxPyPz(Double_t p[3]) const
     //---------------------------------------------------------------------
     // This function returns the global track momentum components
     //---------------------------------------------------------------------
-  p[0]=Px(); p[1]=Py(); p[2]=Pz();
+  AliNanoAODTrackMapping * m = AliNanoAODTrackMapping::GetInstance();
+  Double_t pt    = GetVar(m->GetPt());
+  Double_t phi   = GetVar(m->GetPhi());
+  Double_t theta = GetVar(m->GetTheta());
+  p[0]=pt*TMath::Cos(phi); p[1]=pt*TMath::Sin(phi); p[2]=pt/TMath::Tan(theta);
   return kTRUE;
 }
 
@@ -89,12 +89,13 @@ public:
   virtual Double_t Phi()       const { return GetVar(AliNanoAODTrackMapping::GetInstance()->GetPhi());   }
   virtual Double_t Theta()     const { return GetVar(AliNanoAODTrackMapping::GetInstance()->GetTheta()); }
   
-  virtual Double_t Px() const { return Pt() * TMath::Cos(Phi()); }
-  virtual Double_t Py() const { return Pt() * TMath::Sin(Phi()); }
-  virtual Double_t Pz() const { return Pt() / TMath::Tan(Theta()); }
+  // momentum components read pt, phi, theta directly from the storage (no virtual calls)
+  virtual Double_t Px() const { AliNanoAODTrackMapping * m = AliNanoAODTrackMapping::GetInstance(); return GetVar(m->GetPt()) * TMath::Cos(GetVar(m->GetPhi())); }
+  virtual Double_t Py() const { AliNanoAODTrackMapping * m = AliNanoAODTrackMapping::GetInstance(); return GetVar(m->GetPt()) * TMath::Sin(GetVar(m->GetPhi())); }
+  virtual Double_t Pz() const { AliNanoAODTrackMapping * m = AliNanoAODTrackMapping::GetInstance(); return GetVar(m->GetPt()) / TMath::Tan(GetVar(m->GetTheta())); }
   virtual Double_t Pt() const { return GetVar(AliNanoAODTrackMapping::GetInstance()->GetPt()); }
-  virtual Double_t P()  const { return TMath::Sqrt(Pt()*Pt()+Pz()*Pz()); }
-  virtual Bool_t   PxPyPz(Double_t p[3]) const { p[0] = Px(); p[1] = Py(); p[2] = Pz(); return kTRUE; }
+  virtual Double_t P()  const { AliNanoAODTrackMapping * m = AliNanoAODTrackMapping::GetInstance(); return GetVar(m->GetPt()) / TMath::Sin(GetVar(m->GetTheta())); }
+  virtual Bool_t   PxPyPz(Double_t p[3]) const { return GetPxPyPz(p); }
 
   virtual Double_t Xv() const { return GetProdVertex() ? GetProdVertex()->GetX() : -999.; }
   virtual Double_t Yv() const { return GetProdVertex() ? GetProdVertex()->GetY() : -999.; }
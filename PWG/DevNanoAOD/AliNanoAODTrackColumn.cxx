@@ -0,0 +1,157 @@
+/**************************************************************************
+* Copyright(c) 1998-1999, ALICE Experiment at CERN, All rights reserved. *
+*                                                                        *
+* Author: The ALICE Off-line Project.                                    *
+* Contributors are mentioned in the code where appropriate.              *
+*                                                                        *
+* Permission to use, copy, modify and distribute this software and its   *
+* documentation strictly for non-commercial purposes is hereby granted   *
+* without fee, provided that the above copyright notice appears in all   *
+* copies and that both the copyright notice and this permission notice   *
+* appear in the supporting documentation. The authors make no claims     *
+* about the suitability of this software for any purpose. It is          *
+* provided "as is" without express or implied warranty.                  *
+**************************************************************************/
+
+// Columnar layout of the nano AOD tracks: one object (and one branch)
+// per track variable, see AliNanoAODTrackColumn.h
+
+#include "TMath.h"
+#include "TTree.h"
+#include "TObjString.h"
+#include "AliLog.h"
+#include "AliAODEvent.h"
+
+#include "AliNanoAODTrackColumn.h"
+
+ClassImp(AliNanoAODTrackColumn)
+ClassImp(AliNanoAODTrackColumnReader)
+
+//_____________________________________________________________________________
+AliNanoAODTrackColumn::AliNanoAODTrackColumn() :
+  TNamed(),
+  fN(0),
+  fValues(0),
+  fCapacity(0)
+{
+  // Default ctor, used when reading
+}
+
+//_____________________________________________________________________________
+AliNanoAODTrackColumn::AliNanoAODTrackColumn(const char * var) :
+  TNamed(GetBranchName(var), var),
+  fN(0),
+  fValues(0),
+  fCapacity(0)
+{
+  // ctor: the name is the branch name, the title the variable name
+}
+
+//_____________________________________________________________________________
+AliNanoAODTrackColumn::~AliNanoAODTrackColumn()
+{
+  // dtor
+  delete [] fValues;
+}
+
+//_____________________________________________________________________________
+void AliNanoAODTrackColumn::SetSize(Int_t n)
+{
+  // Set the number of tracks of the event. The array is only reallocated
+  // when it grows, so that in the event loop no allocation is done once the
+  // largest event has been seen. The content is not preserved.
+  // Only meant for the writing side: when reading, the streamer reallocates
+  // fValues to fN entries behind our back.
+
+  if (n > fCapacity) {
+    delete [] fValues;
+    fCapacity = TMath::Max(n, 2*fCapacity);
+    fValues = new Float_t[fCapacity];
+  }
+  fN = n;
+}
+
+//_____________________________________________________________________________
+AliNanoAODTrackColumnReader::AliNanoAODTrackColumnReader(const char * varlist) :
+  TNamed("AliNanoAODTrackColumnReader", varlist),
+  fVars(),
+  fColumns()
+{
+  // ctor: varlist is the comma separated list of the variables to be read,
+  // e.g. "pt,phi,theta,label,charge"
+
+  TObjArray * vars = TString(varlist).Tokenize(",");
+  for (Int_t i = 0; i < vars->GetEntriesFast(); i++) {
+    TString var = static_cast<TObjString*>(vars->UncheckedAt(i))->GetString();
+    var = var.Strip(TString::kBoth);
+    if (!var.IsNull()) fVars.Add(new TObjString(var));
+  }
+  delete vars;
+  fVars.SetOwner(kTRUE);
+}
+
+//_____________________________________________________________________________
+Int_t AliNanoAODTrackColumnReader::Connect(AliAODEvent * event, TTree * tree)
+{
+  // Connect the requested columns of the event. To be called once, after
+  // the event has been connected to the tree (e.g. in UserCreateOutputObjects
+  // or at the first event).
+  // If the tree is given, the branches of the track columns which were not
+  // requested are switched off, so that they are neither read nor decompressed.
+  // Returns the number of connected columns; if any of the requested columns
+  // is missing from the file nothing is connected and 0 is returned.
+
+  fColumns.Clear();
+  if (!event) {
+    AliError("No event");
+    return 0;
+  }
+
+  if (tree) tree->SetBranchStatus(AliNanoAODTrackColumn::GetBranchName("*"), 0);
+
+  for (Int_t i = 0; i < fVars.GetEntriesFast(); i++) {
+    const char * var = fVars.UncheckedAt(i)->GetName();
+    TString name = AliNanoAODTrackColumn::GetBranchName(var);
+    AliNanoAODTrackColumn * column = dynamic_cast<AliNanoAODTrackColumn*>(event->FindListObject(name));
+    if (!column) {
+      AliError(Form("Column %s not found: was the nano AOD produced with AliNanoAODReplicator::SetColumnar?", name.Data()));
+      fColumns.Clear();
+      return 0;
+    }
+    if (tree) tree->SetBranchStatus(name + "*", 1);
+    fColumns.Add(column);
+  }
+
+  return fColumns.GetEntriesFast();
+}
+
+//_____________________________________________________________________________
+Int_t AliNanoAODTrackColumnReader::GetNTracks() const
+{
+  // Number of tracks in the current event
+  if (!fColumns.GetEntriesFast()) return 0;
+  return static_cast<AliNanoAODTrackColumn*>(fColumns.UncheckedAt(0))->GetSize();
+}
+
+//_____________________________________________________________________________
+Int_t AliNanoAODTrackColumnReader::GetIndex(const char * var) const
+{
+  // Index of the column of var, -1 if it was not requested. Use it outside
+  // of the event loop to avoid the string comparisons of GetColumn(var).
+  TObject * obj = fVars.FindObject(var);
+  return obj ? fVars.IndexOf(obj) : -1;
+}
+
+//_____________________________________________________________________________
+const Float_t * AliNanoAODTrackColumnReader::GetColumn(const char * var) const
+{
+  // Values of var for all the tracks of the current event, 0 if the column
+  // was not requested
+
+  Int_t i = GetIndex(var);
+  if (i < 0 || i >= fColumns.GetEntriesFast()) {
+    AliError(Form("Column %s was not requested (%s) or not connected", var, GetTitle()));
+    return 0;
+  }
+  return GetColumn(i);
+}
@@ -0,0 +1,88 @@
+#ifndef ALINANOAODTRACKCOLUMN_H
+#define ALINANOAODTRACKCOLUMN_H
+
+/* Copyright(c) 1998-1999, ALICE Experiment at CERN, All rights reserved. *
+* See cxx source for full Copyright notice                               */
+
+//
+// Columnar layout of the nano AOD tracks.
+//
+// AliNanoAODTrackColumn holds one variable of all the tracks of the event
+// as a contiguous array. When AliNanoAODReplicator::SetColumnar() is used,
+// one column per track variable (plus "label" and "charge") is written,
+// each one in its own branch called "tracks_<variable>", instead of the
+// "tracks" array of AliNanoAODTrack.
+//
+// AliNanoAODTrackColumnReader connects to the subset of columns requested
+// by the analysis and, if the tree is given, switches off the branches of
+// all the other columns, so that only those are read and decompressed:
+//
+//   AliNanoAODTrackColumnReader reader("pt,phi,theta");
+//   reader.Connect(aodEvent, tree);                   // once
+//   ...
+//   const Float_t * pt = reader.GetColumn("pt");      // every event
+//   for(Int_t i = 0; i < reader.GetNTracks(); i++) h->Fill(pt[i]);
+//
+
+#include "TNamed.h"
+#include "TObjArray.h"
+#include "TString.h"
+
+class AliAODEvent;
+class TTree;
+
+class AliNanoAODTrackColumn : public TNamed
+{
+ public:
+
+  AliNanoAODTrackColumn();
+  AliNanoAODTrackColumn(const char * var);
+  virtual ~AliNanoAODTrackColumn();
+
+  void            SetSize(Int_t n);
+  Int_t           GetSize()  const { return fN; }
+  Float_t       * GetArray()       { return fValues; }
+  const Float_t * GetArray() const { return fValues; }
+
+  static TString  GetBranchName(const char * var) { return TString::Format("tracks_%s", var); }
+
+ private:
+
+  Int_t     fN;         // number of tracks in the event
+  Float_t * fValues;    //[fN] values of the variable, one per track
+  Int_t     fCapacity;  //! allocated size of fValues
+
+  AliNanoAODTrackColumn(const AliNanoAODTrackColumn&); // not implemented
+  AliNanoAODTrackColumn& operator=(const AliNanoAODTrackColumn&); // not implemented
+
+  ClassDef(AliNanoAODTrackColumn, 1); // One variable of all the nano AOD tracks
+};
+
+
+class AliNanoAODTrackColumnReader : public TNamed
+{
+ public:
+
+  AliNanoAODTrackColumnReader(const char * varlist = "pt,phi,theta");
+  virtual ~AliNanoAODTrackColumnReader() { ; }
+
+  Int_t           Connect(AliAODEvent * event, TTree * tree = 0);
+
+  Int_t           GetNColumns() const { return fColumns.GetEntriesFast(); }
+  Int_t           GetNTracks()  const;
+  Int_t           GetIndex(const char * var) const;
+  const Float_t * GetColumn(Int_t i) const { return static_cast<AliNanoAODTrackColumn*>(fColumns.UncheckedAt(i))->GetArray(); }
+  const Float_t * GetColumn(const char * var) const;
+
+ private:
+
+  TObjArray fVars;      // names of the requested variables
+  TObjArray fColumns;   //! connected columns, same order as fVars
+
+  AliNanoAODTrackColumnReader(const AliNanoAODTrackColumnReader&); // not implemented
+  AliNanoAODTrackColumnReader& operator=(const AliNanoAODTrackColumnReader&); // not implemented
+
+  ClassDef(AliNanoAODTrackColumnReader, 1); // Reads a subset of the nano AOD track columns
+};
+
+#endif
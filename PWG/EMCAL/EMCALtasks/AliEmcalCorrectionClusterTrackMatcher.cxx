@@ -5,6 +5,9 @@
 
 #include <TH1.h>
 #include <TList.h>
+#include <TStopwatch.h>
+#include <TVector2.h>
+#include <TVector3.h>
 
 #include "AliClusterContainer.h"
 #include "AliParticleContainer.h"
@@ -13,6 +16,7 @@
 #include "AliAODCaloCluster.h"
 #include "AliVParticle.h"
 #include "AliEmcalParticle.h"
+#include "AliEtaPhiGrid.h"
 #include "AliEMCALGeometry.h"
 #include "AliMCEvent.h"
 
@@ -37,6 +41,8 @@ AliEmcalCorrectionClusterTrackMatcher::AliEmcalCorrectionClusterTrackMatcher() :
   fUseDCA(kTRUE),
   fUpdateTracks(kTRUE),
   fUpdateClusters(kTRUE),
+  fUseGridMatching(kTRUE),
+  fBenchmarkMatching(kFALSE),
   fClusterContainerIndexMap(),
   fParticleContainerIndexMap(),
   fEmcalTracks(0),
@@ -45,6 +51,17 @@ AliEmcalCorrectionClusterTrackMatcher::AliEmcalCorrectionClusterTrackMatcher() :
   fNEmcalClusters(0),
   fHistMatchEtaAll(0),
   fHistMatchPhiAll(0),
+  fHistMatchTimeGrid(0),
+  fHistMatchTimeAllPairs(0),
+  fMatchTimer(0),
+  fClusterEta(),
+  fClusterPhi(),
+  fClusterGrid(0),
+  fCandidates(),
+  fMatchDeta(),
+  fMatchDphi(),
+  fMatchHistBin(),
+  fHistFillBuffer(),
   fMCGenerToAcceptForTrack(1),
   fNMCGenerToAccept(0)
 {
@@ -65,6 +82,8 @@ AliEmcalCorrectionClusterTrackMatcher::AliEmcalCorrectionClusterTrackMatcher() :
  */
 AliEmcalCorrectionClusterTrackMatcher::~AliEmcalCorrectionClusterTrackMatcher()
 {
+  delete fMatchTimer;
+  delete fClusterGrid;
 }
 
 /**
@@ -81,6 +100,8 @@ Bool_t AliEmcalCorrectionClusterTrackMatcher::Initialize()
   GetProperty("maxDist", fMaxDistance);
   GetProperty("updateClusters", fUpdateClusters);
   GetProperty("updateTracks", fUpdateTracks);
+  GetProperty("useGridMatching", fUseGridMatching);
+  GetProperty("benchmarkMatching", fBenchmarkMatching);
   fDoPropagation = fEsdMode;
   
   Bool_t enableFracEMCRecalc = kFALSE;
@@ -173,6 +194,14 @@ void AliEmcalCorrectionClusterTrackMatcher::UserCreateOutputObjects()
     }
     fOutput->SetOwner(kTRUE);
   }
+
+  if (fBenchmarkMatching) {
+    fHistMatchTimeGrid = new TH1F("fHistMatchTimeGrid", "fHistMatchTimeGrid;Real Time (#mus)", 2000, 0, 20000);
+    fOutput->Add(fHistMatchTimeGrid);
+    fHistMatchTimeAllPairs = new TH1F("fHistMatchTimeAllPairs", "fHistMatchTimeAllPairs;Real Time (#mus)", 2000, 0, 20000);
+    fOutput->Add(fHistMatchTimeAllPairs);
+    fMatchTimer = new TStopwatch();
+  }
 }
 
 /**
@@ -364,36 +393,59 @@ void AliEmcalCorrectionClusterTrackMatcher::GenerateEmcalParticles()
 
 /**
  * Set the links between tracks and clusters.
+ *
+ * The clusters are binned on an eta-phi grid (see FillClusterGrid()) and each track is only compared
+ * to the clusters of the neighbouring cells. The candidates are tested in increasing cluster index and
+ * the tracks in increasing index, so the matches are added in the same order as in the all-pairs loop.
+ * The match histograms are filled at the end of the event, preserving the order of the fills.
+ *
+ * If the benchmark is enabled, the time of this function (including the bookkeeping of the matches)
+ * and of the all-pairs distance loop (without bookkeeping) are filled in two histograms.
  */
 void AliEmcalCorrectionClusterTrackMatcher::DoMatching()
 {
   const Double_t maxd2 = fMaxDistance*fMaxDistance;
 
+  if (fBenchmarkMatching) fMatchTimer->Start(kTRUE);
+
+  FillClusterGrid();
+
+  fMatchDeta.clear();
+  fMatchDphi.clear();
+  fMatchHistBin.clear();
+  Int_t nMatches = 0;
+
   for (Int_t itrack = 0; itrack < fNEmcalTracks; itrack++) {
     AliEmcalParticle* emcalTrack = static_cast<AliEmcalParticle*>(fEmcalTracks->At(itrack));
     AliVTrack* track = emcalTrack->GetTrack();
 
-    for (Int_t icluster = 0; icluster < fNEmcalClusters; icluster++) {
+    const Double_t veta = track->GetTrackEtaOnEMCal();
+    const Double_t vphi = track->GetTrackPhiOnEMCal();
+    FindMatchCandidates(veta, vphi);
+
+    for (UInt_t icand = 0; icand < fCandidates.size(); icand++) {
+      const Int_t icluster = fCandidates[icand];
       AliEmcalParticle* emcalCluster = static_cast<AliEmcalParticle*>(fEmcalClusters->At(icluster));
       AliVCluster* cluster = emcalCluster->GetCluster();
-      
-      Double_t deta = 999;
-      Double_t dphi = 999;
-      GetEtaPhiDiff(track, cluster, dphi, deta);
+
+      // Same as GetEtaPhiDiff(), with the cluster position computed once per event
+      Double_t deta = veta - fClusterEta[icluster];
+      Double_t dphi = TVector2::Phi_mpi_pi(vphi - fClusterPhi[icluster]);
       Double_t d2 = deta * deta + dphi * dphi;
 
       if (d2 > maxd2) continue;
-      
+
       Double_t d = TMath::Sqrt(d2);
       emcalCluster->AddMatchedObj(itrack, d);
       emcalTrack->AddMatchedObj(icluster, d);
+      nMatches++;
       AliDebug(2, Form("Now matching cluster E = %.3f, pT = %.3f, eta = %.3f, phi = %.3f "
                        "with track pT = %.3f, eta = %.3f, phi = %.3f"
                        "Track eta, phi on EMCal = %.3f, %.3f, d = %.3f",
                        cluster->GetNonLinCorrEnergy(), emcalCluster->Pt(), emcalCluster->Eta(), emcalCluster->Phi(),
                        emcalTrack->Pt(), emcalTrack->Eta(), emcalTrack->Phi(),
                        track->GetTrackEtaOnEMCal(), track->GetTrackPhiOnEMCal(), d));
-      
+
       if (fCreateHisto) {
         Int_t mombin = GetMomBin(track->P());
         Int_t centbinch = fCentBin;
@@ -401,13 +453,145 @@ void AliEmcalCorrectionClusterTrackMatcher::DoMatching()
         Int_t etabin = 0;
         if(track->Eta() > 0) etabin = 1;
 
-        fHistMatchEta[centbinch][mombin][etabin]->Fill(deta);
-        fHistMatchPhi[centbinch][mombin][etabin]->Fill(dphi);
-        fHistMatchEtaAll->Fill(deta);
-        fHistMatchPhiAll->Fill(dphi);
+        fMatchDeta.push_back(deta);
+        fMatchDphi.push_back(dphi);
+        fMatchHistBin.push_back((centbinch * 9 + mombin) * 2 + etabin);
       }
     }
   }
+
+  if (fCreateHisto) FillMatchHistograms();
+
+  if (fBenchmarkMatching) {
+    fMatchTimer->Stop();
+    fHistMatchTimeGrid->Fill(fMatchTimer->RealTime() * 1e6);
+    fMatchTimer->Start(kTRUE);
+    Int_t nMatchesAllPairs = DoAllPairsMatching();
+    fMatchTimer->Stop();
+    fHistMatchTimeAllPairs->Fill(fMatchTimer->RealTime() * 1e6);
+    if (nMatchesAllPairs != nMatches) {
+      AliError(Form("Grid matching found %d matches, all-pairs matching %d", nMatches, nMatchesAllPairs));
+    }
+  }
+}
+
+/**
+ * Compute the cluster positions used for the matching and sort the clusters in eta-phi cells.
+ * The cells are slightly larger than the maximum matching distance, so that a cluster matching
+ * a track is always in one of the 3x3 cells around the track. The phi axis is periodic.
+ * No grid is built (and all clusters are candidates) if it is disabled or not useful.
+ */
+void AliEmcalCorrectionClusterTrackMatcher::FillClusterGrid()
+{
+  fClusterEta.resize(fNEmcalClusters);
+  fClusterPhi.resize(fNEmcalClusters);
+
+  Double_t etaMin = 0, etaMax = 0;
+  for (Int_t icluster = 0; icluster < fNEmcalClusters; icluster++) {
+    AliEmcalParticle* emcalCluster = static_cast<AliEmcalParticle*>(fEmcalClusters->At(icluster));
+    Float_t pos[3] = {0};
+    emcalCluster->GetCluster()->GetPosition(pos);
+    TVector3 cpos(pos);
+    fClusterEta[icluster] = cpos.Eta();
+    fClusterPhi[icluster] = cpos.Phi();
+    if (icluster == 0 || fClusterEta[icluster] < etaMin) etaMin = fClusterEta[icluster];
+    if (icluster == 0 || fClusterEta[icluster] > etaMax) etaMax = fClusterEta[icluster];
+  }
+
+  if (!fClusterGrid) fClusterGrid = new AliEtaPhiGrid();
+  fClusterGrid->SetBinning(0, 0, 1, 0);
+  if (!fUseGridMatching || fNEmcalClusters == 0 || !(fMaxDistance > 0)) return;
+
+  const Double_t cellSize = 1.01 * fMaxDistance;
+  const Int_t nPhi = TMath::FloorNint(TMath::TwoPi() / cellSize);
+  if (nPhi < 3) return;
+  Double_t nEta = (etaMax - etaMin) / cellSize + 1;
+  if (nEta > 1000) return;
+  fClusterGrid->SetBinning((Int_t)nEta, etaMin, cellSize, nPhi);
+
+  // Counting sort of the clusters by cell, keeping the clusters of a cell in increasing index
+  fCandidates.resize(fNEmcalClusters);
+  for (Int_t icluster = 0; icluster < fNEmcalClusters; icluster++) {
+    fCandidates[icluster] = fClusterGrid->GetCell(fClusterEta[icluster], fClusterPhi[icluster]);
+  }
+  fClusterGrid->Sort(fNEmcalClusters, &fCandidates[0]);
+}
+
+/**
+ * Fill fCandidates with the clusters in the cells around the given track position, in increasing index.
+ * @param[in] etaOnEMCal Track eta on the EMCal surface
+ * @param[in] phiOnEMCal Track phi on the EMCal surface
+ */
+void AliEmcalCorrectionClusterTrackMatcher::FindMatchCandidates(Double_t etaOnEMCal, Double_t phiOnEMCal)
+{
+  if (fClusterGrid->GetNCells() == 0 || TMath::IsNaN(etaOnEMCal) || TMath::IsNaN(phiOnEMCal)) {
+    fCandidates.clear();
+    for (Int_t icluster = 0; icluster < fNEmcalClusters; icluster++) fCandidates.push_back(icluster);
+    return;
+  }
+
+  fClusterGrid->GetNeighbours(etaOnEMCal, phiOnEMCal, fCandidates);
+}
+
+/**
+ * Fill the match histograms with the matches collected in DoMatching().
+ * Each histogram is filled with a single FillN call, in the order in which the matches were found.
+ */
+void AliEmcalCorrectionClusterTrackMatcher::FillMatchHistograms()
+{
+  const Int_t nMatches = fMatchDeta.size();
+  if (nMatches == 0) return;
+
+  fHistMatchEtaAll->FillN(nMatches, &fMatchDeta[0], 0);
+  fHistMatchPhiAll->FillN(nMatches, &fMatchDphi[0], 0);
+
+  // Group the matches by histogram, keeping their order (counting sort)
+  const Int_t nHists = 10 * 9 * 2;
+  std::vector<Int_t> offsets(nHists + 1, 0);
+  for (Int_t i = 0; i < nMatches; i++) offsets[fMatchHistBin[i] + 1]++;
+  for (Int_t ih = 0; ih < nHists; ih++) offsets[ih + 1] += offsets[ih];
+  std::vector<Int_t> next(offsets.begin(), offsets.end() - 1);
+  fHistFillBuffer.resize(2 * nMatches);
+  for (Int_t i = 0; i < nMatches; i++) {
+    Int_t j = next[fMatchHistBin[i]]++;
+    fHistFillBuffer[j] = fMatchDeta[i];
+    fHistFillBuffer[nMatches + j] = fMatchDphi[i];
+  }
+
+  for (Int_t ih = 0; ih < nHists; ih++) {
+    Int_t n = offsets[ih + 1] - offsets[ih];
+    if (n == 0) continue;
+    Int_t etabin = ih % 2;
+    Int_t mombin = (ih / 2) % 9;
+    Int_t centbinch = ih / 18;
+    fHistMatchEta[centbinch][mombin][etabin]->FillN(n, &fHistFillBuffer[offsets[ih]], 0);
+    fHistMatchPhi[centbinch][mombin][etabin]->FillN(n, &fHistFillBuffer[nMatches + offsets[ih]], 0);
+  }
+}
+
+/**
+ * All-pairs distance loop, as the matching was done before the grid was introduced.
+ * Only counts the matches, used as reference for the benchmark.
+ * @return Number of track-cluster pairs within the maximum distance
+ */
+Int_t AliEmcalCorrectionClusterTrackMatcher::DoAllPairsMatching()
+{
+  const Double_t maxd2 = fMaxDistance*fMaxDistance;
+  Int_t nMatches = 0;
+
+  for (Int_t itrack = 0; itrack < fNEmcalTracks; itrack++) {
+    AliVTrack* track = static_cast<AliEmcalParticle*>(fEmcalTracks->At(itrack))->GetTrack();
+    for (Int_t icluster = 0; icluster < fNEmcalClusters; icluster++) {
+      AliVCluster* cluster = static_cast<AliEmcalParticle*>(fEmcalClusters->At(icluster))->GetCluster();
+      Double_t deta = 999;
+      Double_t dphi = 999;
+      GetEtaPhiDiff(track, cluster, dphi, deta);
+      if (deta * deta + dphi * dphi > maxd2) continue;
+      nMatches++;
+    }
+  }
+
+  return nMatches;
 }
 
 /**
@@ -1,6 +1,8 @@
 #ifndef ALIEMCALCORRECTIONCLUSTERTRACKMATCHER_H
 #define ALIEMCALCORRECTIONCLUSTERTRACKMATCHER_H
 
+#include <vector>
+
 #include "AliEmcalCorrectionComponent.h"
 
 #if !(defined(__CINT__) || defined(__MAKECINT__))
@@ -9,7 +11,9 @@
 
 class TH1;
 class TClonesArray;
+class TStopwatch;
 
+class AliEtaPhiGrid;
 class AliVParticle;
 
 /**
@@ -44,6 +48,11 @@ class AliVParticle;
  AliVCluster *cluster = GetClusterContainer(0)->GetCluster(iCluster);
  ~~~
  (again assuming that the task is derived from AliAnalysisTaskEmcal or AliAnalysisTaskEmcalJet).
+
+ By default the clusters are binned on an \f$\eta\f$-\f$\phi\f$ grid with cells at least as large as the
+ maximum matching distance, and each track is only compared to the clusters in the neighbouring cells
+ (`useGridMatching`). The matches are identical to the all-pairs comparison. With `benchmarkMatching` the
+ time spent in the grid and in the all-pairs matching is filled in two histograms for each event.
  *
  * Based on code in AliEmcalClusTrackMatcherTask. 
  *
@@ -69,6 +78,10 @@ class AliEmcalCorrectionClusterTrackMatcher : public AliEmcalCorrectionComponent
   Int_t         GetMomBin(Double_t p) const;
   void          GenerateEmcalParticles();
   void          DoMatching();
+  void          FillClusterGrid();
+  void          FindMatchCandidates(Double_t etaOnEMCal, Double_t phiOnEMCal);
+  void          FillMatchHistograms();
+  Int_t         DoAllPairsMatching();
   void          UpdateTracks();
   void          UpdateClusters();
   Bool_t        IsTrackInEmcalAcceptance(AliVParticle* part, Double_t edges=0.9) const;
@@ -87,6 +100,8 @@ class AliEmcalCorrectionClusterTrackMatcher : public AliEmcalCorrectionComponent
   Bool_t        fUseDCA;                ///< Use DCA as starting point for track propagation, rather than primary vertex
   Bool_t        fUpdateTracks;          ///< update tracks with matching info
   Bool_t        fUpdateClusters;        ///< update clusters with matching info
+  Bool_t        fUseGridMatching;       ///< test tracks only against clusters in the neighbouring eta-phi cells
+  Bool_t        fBenchmarkMatching;     ///< time the grid and the all-pairs matching in each event
   
 #if !(defined(__CINT__) || defined(__MAKECINT__))
   // Handle mapping between index and containers
@@ -102,6 +117,18 @@ class AliEmcalCorrectionClusterTrackMatcher : public AliEmcalCorrectionComponent
   TH1          *fHistMatchPhiAll;       //!<!dphi distribution
   TH1          *fHistMatchEta[10][9][2]; //!<!deta distribution
   TH1          *fHistMatchPhi[10][9][2]; //!<!dphi distribution
+  TH1          *fHistMatchTimeGrid;     //!<!real time of the grid matching
+  TH1          *fHistMatchTimeAllPairs; //!<!real time of the all-pairs matching
+  TStopwatch   *fMatchTimer;            //!<!timer for the matching benchmark
+
+  std::vector<Double_t> fClusterEta;    //!<!eta of the clusters, as used in GetEtaPhiDiff
+  std::vector<Double_t> fClusterPhi;    //!<!phi of the clusters, as used in GetEtaPhiDiff
+  AliEtaPhiGrid        *fClusterGrid;  //!<!clusters sorted in eta-phi cells (no cells = no grid in this event)
+  std::vector<Int_t>    fCandidates;    //!<!clusters in the cells neighbouring the current track
+  std::vector<Double_t> fMatchDeta;     //!<!deta of the matches of this event, filled at the end of DoMatching
+  std::vector<Double_t> fMatchDphi;     //!<!dphi of the matches of this event
+  std::vector<Int_t>    fMatchHistBin;  //!<!index of the histogram of each match
+  std::vector<Double_t> fHistFillBuffer;//!<!buffer for the batched filling
   
   Int_t      fNMCGenerToAccept;          ///<  Number of MC generators that should not be included in analysis
   TString    fMCGenerToAccept[5];        ///<  List with name of generators that should not be included
@@ -115,7 +142,7 @@ private:
   static RegisterCorrectionComponent<AliEmcalCorrectionClusterTrackMatcher> reg;
 
   /// \cond CLASSIMP
-  ClassDef(AliEmcalCorrectionClusterTrackMatcher, 4); // EMCal cluster track matcher correction component
+  ClassDef(AliEmcalCorrectionClusterTrackMatcher, 6); // EMCal cluster track matcher correction component
   /// \endcond
 };
 
@@ -16,6 +16,8 @@
  **************************************************************************/
 
 // --- Root ---
+#include <TClass.h>
+#include <TClonesArray.h>
 #include <TObjArray.h>
 #include <TArrayI.h>
 #include <TStopwatch.h>
@@ -38,6 +40,7 @@
 #include "AliClusterContainer.h"
 #include "AliAODMCParticle.h"
 #include "AliEMCALRecoUtils.h"
+#include "AliEMCALTowerGridClusterizer.h"
 #include "AliAODEvent.h"
 #include "AliESDEvent.h"
 #include "AliAnalysisManager.h"
@@ -84,6 +87,10 @@ AliEmcalCorrectionClusterizer::AliEmcalCorrectionClusterizer() :
   fShiftEta(2),
   fTRUShift(0),
   fTestPatternInput(kFALSE),
+  fUseNativeClusterizer(kFALSE),
+  fGridClusterizer(0),
+  fValidateNativeClusterizer(kFALSE),
+  fGridClusters(0),
   fSetCellMCLabelFromCluster(0),
   fSetCellMCLabelFromEdepFrac(0),
   fRemapMCLabelForAODs(0),
@@ -104,6 +111,8 @@ AliEmcalCorrectionClusterizer::AliEmcalCorrectionClusterizer() :
 AliEmcalCorrectionClusterizer::~AliEmcalCorrectionClusterizer()
 {
   delete fClusterizer;
+  delete fGridClusterizer;
+  delete fGridClusters;
   delete fUnfolder;
   delete fRecParam;
 }
@@ -140,6 +149,8 @@ Bool_t AliEmcalCorrectionClusterizer::Initialize()
   Float_t diffEAggregation = 0.;
   GetProperty("diffEAggregation", diffEAggregation);
   GetProperty("useTestPatternForInput", fTestPatternInput);
+  GetProperty("useNativeClusterizer", fUseNativeClusterizer);
+  GetProperty("validateNativeClusterizer", fValidateNativeClusterizer);
   
   Int_t removeNMCGenerators = 0;
   GetProperty("removeNMCGenerators", removeNMCGenerators);
@@ -273,11 +284,16 @@ Bool_t AliEmcalCorrectionClusterizer::Run()
     return kTRUE;
   }
   
-  FillDigitsArray();
+  if (UseNativeClusterizer()) {
+    ClusterizeOnTowerGrid();
+  }
+  else {
+    FillDigitsArray();
   
-  Clusterize();
+    Clusterize();
   
-  UpdateClusters();
+    UpdateClusters();
+  }
   
   CalibrateClusters();
 
@@ -903,6 +919,12 @@ void AliEmcalCorrectionClusterizer::Init()
   fClusterizer->SetOutput(0);
   fClusterArr = const_cast<TObjArray *>(fClusterizer->GetRecPoints());
   
+  // tower grid clusterizer, the digits clusterizer above is kept for the settings it does not handle
+  if (fUseNativeClusterizer) {
+    if (!fGridClusterizer)
+      fGridClusterizer = new AliEMCALTowerGridClusterizer;
+    fGridClusterizer->Init(fGeom, fRecParam);
+  }
 }
 
 /**
@@ -945,3 +967,73 @@ void AliEmcalCorrectionClusterizer::ClearEMCalClusters()
     }
   }
 }
+
+/**
+ * Check whether the event can be clusterized on the tower grid. The digits
+ * clusterizers are used for uncalibrated input, background subtraction,
+ * unfolding, test pattern input and whenever MC labels have to be propagated.
+ */
+Bool_t AliEmcalCorrectionClusterizer::UseNativeClusterizer() const
+{
+  if (!fUseNativeClusterizer || !fGridClusterizer)
+    return kFALSE;
+
+  if (!AliEMCALTowerGridClusterizer::IsClusterizerSupported(fRecParam->GetClusterizerFlag()))
+    return kFALSE;
+
+  if (fRecParam->GetUnfold() || fSubBackground || fCalibData || fPedestalData || fTestPatternInput)
+    return kFALSE;
+
+  if (fSetCellMCLabelFromCluster || fSetCellMCLabelFromEdepFrac || fRemapMCLabelForAODs || fMCEvent)
+    return kFALSE;
+
+  return kTRUE;
+}
+
+/**
+ * Clusterize the cells on the tower grid and replace the EMCal clusters.
+ * Same cell selection as in FillDigitsArray().
+ *
+ * In validation mode the EMCal clusters are produced by the digits clusterizer
+ * as usual and the tower grid clusters are only compared to them, see
+ * AliEMCALTowerGridClusterizer::CompareClusters() for the tolerances.
+ */
+void AliEmcalCorrectionClusterizer::ClusterizeOnTowerGrid()
+{
+  fGridClusterizer->Reset();
+
+  const Int_t ncells = fCaloCells->GetNumberOfCells();
+  for (Int_t icell = 0; icell < ncells; ++icell) {
+    Short_t  cellNumber = fCaloCells->GetCellNumber(icell);
+    Double_t amp        = fCaloCells->GetAmplitude(icell);
+
+    if (amp < 1e-6 || cellNumber < 0)
+      continue;
+
+    fGridClusterizer->AddTower(cellNumber, amp, fCaloCells->GetTime(icell));
+  }
+
+  fGridClusterizer->Clusterize();
+
+  if (fValidateNativeClusterizer) {
+    if (!fGridClusters)
+      fGridClusters = new TClonesArray(fCaloClusters->GetClass()->GetName());
+    fGridClusters->Delete();
+    fGridClusterizer->FillClusters(fGridClusters);
+
+    FillDigitsArray();
+    Clusterize();
+    UpdateClusters();
+
+    Int_t ndiff = AliEMCALTowerGridClusterizer::CompareClusters(fCaloClusters, fGridClusters);
+    if (ndiff > 0)
+      AliWarning(Form("Tower grid clusterizer: %d cluster differences in this event", ndiff));
+    return;
+  }
+
+  ClearEMCalClusters();
+
+  fCaloClusters->Compress();
+
+  fGridClusterizer->FillClusters(fCaloClusters);
+}
@@ -6,6 +6,7 @@
 #include "AliEMCALRecParam.h"
 
 class TStopwatch;
+class AliEMCALTowerGridClusterizer;
 
 /**
  * @class AliEmcalCorrectionClusterizer
@@ -56,6 +57,8 @@ protected:
   void           RemapMCLabelForAODs(Int_t &label);
   void           SetClustersMCLabelFromOriginalClusters();
   void           ClearEMCalClusters();
+  Bool_t         UseNativeClusterizer() const;
+  void           ClusterizeOnTowerGrid();
   
   TH1F* fHistCPUTime;                                     //!<! CPU time for the Run() function (event loop)
   TH1F* fHistRealTime;                                    //!<! Real time for the Run() function (event loop)
@@ -83,6 +86,10 @@ protected:
   Int_t                  fShiftEta;                       ///< shift in eta (for FixedWindowsClusterizer)
   Bool_t                 fTRUShift;                       ///< shifting inside a TRU (true) or through the whole calorimeter (false) (for FixedWindowsClusterizer)
   Bool_t                 fTestPatternInput;               ///< Use test pattern as input instead of cells
+  Bool_t                 fUseNativeClusterizer;           ///< Clusterize on the tower grid, without digits and rec points
+  AliEMCALTowerGridClusterizer *fGridClusterizer;         //!<!tower grid clusterizer
+  Bool_t                 fValidateNativeClusterizer;      ///< Keep the digits clusterizer output and compare the tower grid clusters to it
+  TClonesArray          *fGridClusters;                   //!<!tower grid clusters in validation mode
   
   // MC labels
   static const Int_t     fgkTotalCellNumber = 17664 ;     ///< Maximum number of cells in EMCAL/DCAL: (48*24)*(10+4/3.+6*2/3.)
@@ -114,7 +121,7 @@ protected:
   static RegisterCorrectionComponent<AliEmcalCorrectionClusterizer> reg;
 
   /// \cond CLASSIMP
-  ClassDef(AliEmcalCorrectionClusterizer, 4); // EMCal correction clusterizer component
+  ClassDef(AliEmcalCorrectionClusterizer, 6); // EMCal correction clusterizer component
   /// \endcond
 };
 
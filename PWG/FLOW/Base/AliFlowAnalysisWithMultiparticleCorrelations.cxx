@@ -64,6 +64,9 @@ AliFlowAnalysisWithMultiparticleCorrelations::AliFlowAnalysisWithMultiparticleCo
  fQvectorFlagsPro(NULL),
  fCalculateQvector(kFALSE),
  fCalculateDiffQvectors(kFALSE),
+ fCorrelator(NULL),
+ fPhiRPs(),
+ fWeightRPs(),
  // 3.) Correlations:
  fCorrelationsList(NULL),
  fCorrelationsFlagsPro(NULL),
@@ -169,6 +172,7 @@ AliFlowAnalysisWithMultiparticleCorrelations::~AliFlowAnalysisWithMultiparticleC
  // Destructor.
  
  delete fHistList;
+ delete fCorrelator;
 
 } // end of AliFlowAnalysisWithMultiparticleCorrelations::~AliFlowAnalysisWithMultiparticleCorrelations()
 
@@ -2000,6 +2004,13 @@ void AliFlowAnalysisWithMultiparticleCorrelations::FillQvector(AliFlowEventSimpl
  Double_t dEta = 0., wEta = 1.; // pseudorapidity and corresponding eta weight
  Double_t wToPowerP = 1.; // weight raised to power p
  Int_t nCounterRPs = 0;
+ Int_t nRPs = 0; // RPs collected for fCorrelator
+ if(fPhiRPs.GetSize()<nTracks)
+ {
+  fPhiRPs.Set(nTracks);
+  fWeightRPs.Set(nTracks);
+ }
+ Bool_t bUseWeightsRP = fUseWeights[0][0]||fUseWeights[0][1]||fUseWeights[0][2];
  for(Int_t t=0;t<nTracks;t++) // loop over all tracks
  {
   AliFlowTrackSimple *pTrack = NULL;
@@ -2035,15 +2046,10 @@ void AliFlowAnalysisWithMultiparticleCorrelations::FillQvector(AliFlowEventSimpl
    dEta = pTrack->Eta();
    if(fUseWeights[0][2]){wEta = Weight(dEta,"RP","eta");} // corresponding eta weight
 
-   // Calculate Q-vector components:
-   for(Int_t h=0;h<fMaxHarmonic*fMaxCorrelator+1;h++)
-   {
-    for(Int_t wp=0;wp<fMaxCorrelator+1;wp++) // weight power
-    {
-     if(fUseWeights[0][0]||fUseWeights[0][1]||fUseWeights[0][2]){wToPowerP = pow(wPhi*wPt*wEta,wp);} 
-     fQvector[h][wp] += TComplex(wToPowerP*TMath::Cos(h*dPhi),wToPowerP*TMath::Sin(h*dPhi));
-    } // for(Int_t wp=0;wp<fMaxCorrelator+1;wp++)
-   } // for(Int_t h=0;h<fMaxHarmonic*fMaxCorrelator+1;h++)
+   // Collect RPs, Q-vector components are calculated by fCorrelator after the loop:
+   fPhiRPs[nRPs] = dPhi;
+   fWeightRPs[nRPs] = wPhi*wPt*wEta;
+   nRPs++;
   } // if(pTrack->InRPSelection()) // fill Q-vector components only with reference particles
 
   // Differential Q-vectors (a.k.a. p-vector and q-vector):
@@ -2072,12 +2078,13 @@ void AliFlowAnalysisWithMultiparticleCorrelations::FillQvector(AliFlowEventSimpl
       binNo = fDiffCorrelationsPro[0][0]->FindBin(dEta); // TBI: hardwired [0][0]
      }
    // Calculate p-vector components:
+   AliFlowMultiparticleCorrelator::CosSinHarmonics(dPhi,fMaxHarmonic*fMaxCorrelator,fCosHarmonics,fSinHarmonics);
    for(Int_t h=0;h<fMaxHarmonic*fMaxCorrelator+1;h++)
    {
     for(Int_t wp=0;wp<fMaxCorrelator+1;wp++) // weight power
     {
      if(fUseWeights[1][0]||fUseWeights[1][1]||fUseWeights[1][2]){wToPowerP = pow(wPhi*wPt*wEta,wp);} 
-     fpvector[binNo-1][h][wp] += TComplex(wToPowerP*TMath::Cos(h*dPhi),wToPowerP*TMath::Sin(h*dPhi));
+     fpvector[binNo-1][h][wp] += TComplex(wToPowerP*fCosHarmonics[h],wToPowerP*fSinHarmonics[h]);
 
      if(pTrack->InRPSelection()) 
      {
@@ -2095,7 +2102,7 @@ void AliFlowAnalysisWithMultiparticleCorrelations::FillQvector(AliFlowEventSimpl
       if(fUseWeights[1][1]){wPt = Weight(dPt,"POI","pt");} // corresponding pT weight
       if(fUseWeights[1][2]){wEta = Weight(dEta,"POI","eta");} // corresponding eta weight
       if(fUseWeights[0][0]||fUseWeights[0][1]||fUseWeights[0][2]||fUseWeights[1][0]||fUseWeights[1][1]||fUseWeights[1][2]){wToPowerP = pow(wPhi*wPt*wEta,wp);} 
-      fqvector[binNo-1][h][wp] += TComplex(wToPowerP*TMath::Cos(h*dPhi),wToPowerP*TMath::Sin(h*dPhi));
+      fqvector[binNo-1][h][wp] += TComplex(wToPowerP*fCosHarmonics[h],wToPowerP*fSinHarmonics[h]);
      } // if(pTrack->InRPSelection()) 
 
     } // for(Int_t wp=0;wp<fMaxCorrelator+1;wp++)
@@ -2104,6 +2111,16 @@ void AliFlowAnalysisWithMultiparticleCorrelations::FillQvector(AliFlowEventSimpl
 
  } // for(Int_t t=0;t<nTracks;t++) // loop over all tracks
 
+ // Q-vector components (angle-addition recurrence instead of Cos/Sin for each harmonic, products instead of pow()):
+ fCorrelator->Fill(nRPs,fPhiRPs.GetArray(),bUseWeightsRP ? fWeightRPs.GetArray() : NULL);
+ for(Int_t h=0;h<fMaxHarmonic*fMaxCorrelator+1;h++)
+ {
+  for(Int_t wp=0;wp<fMaxCorrelator+1;wp++) // weight power
+  {
+   fQvector[h][wp] = fCorrelator->Q(h,wp);
+  } // for(Int_t wp=0;wp<fMaxCorrelator+1;wp++)
+ } // for(Int_t h=0;h<fMaxHarmonic*fMaxCorrelator+1;h++)
+
 } // void AliFlowAnalysisWithMultiparticleCorrelations::FillQvector(AliFlowEventSimple *anEvent)
 
 //=======================================================================================================================
@@ -3854,6 +3871,14 @@ void AliFlowAnalysisWithMultiparticleCorrelations::InitializeArraysForQvector()
   }
  }
 
+ // Powers up to the highest supported correlator are kept by fCorrelator, since CorrelationPsi2nPsi1n(...) goes beyond 8-p:
+ fCorrelator = new AliFlowMultiparticleCorrelator(fMaxHarmonic*fMaxCorrelator,AliFlowMultiparticleCorrelator::fgkMaxOrder);
+ for(Int_t h=0;h<fMaxHarmonic*fMaxCorrelator+1;h++) 
+ {
+  fCosHarmonics[h] = 0.;
+  fSinHarmonics[h] = 0.;
+ }
+
 } // void AliFlowAnalysisWithMultiparticleCorrelations::InitializeArraysForQvector()
 
 //=======================================================================================================================
@@ -3862,6 +3887,8 @@ void AliFlowAnalysisWithMultiparticleCorrelations::ResetQvector()
 {
  // Reset all Q-vector components to zero before starting a new event. 
 
+ if(fCorrelator){fCorrelator->Reset();}
+
  for(Int_t h=0;h<fMaxHarmonic*fMaxCorrelator+1;h++) 
  {
   for(Int_t wp=0;wp<fMaxCorrelator+1;wp++) // weight powe
@@ -4129,7 +4156,7 @@ TComplex AliFlowAnalysisWithMultiparticleCorrelations::Seven(Int_t n1, Int_t n2,
 
  Int_t harmonic[7] = {n1,n2,n3,n4,n5,n6,n7};
 
- TComplex seven = Recursion(7,harmonic); 
+ TComplex seven = fCorrelator->Correlator(7,harmonic); // same as Recursion(7,harmonic), without recursion and with cached subterms
 
  return seven;
 
@@ -4143,7 +4170,7 @@ TComplex AliFlowAnalysisWithMultiparticleCorrelations::Eight(Int_t n1, Int_t n2,
 
  Int_t harmonic[8] = {n1,n2,n3,n4,n5,n6,n7,n8};
 
- TComplex eight = Recursion(8,harmonic); 
+ TComplex eight = fCorrelator->Correlator(8,harmonic); // same as Recursion(8,harmonic), without recursion and with cached subterms
 
  return eight;
 
@@ -5635,9 +5662,9 @@ Double_t AliFlowAnalysisWithMultiparticleCorrelations::CorrelationPsi2nPsi1n(Int
  } // switch(k)
 
  // Calculate weight and correlators:
- Double_t dWeight = Recursion(order,harmonics0.GetArray()).Re(); // weight is 'number of combinations' by default
- TComplex cNum1 = Recursion(order,harmonics1.GetArray())/dWeight;
- TComplex cNum2 = Recursion(order,harmonics2.GetArray())/dWeight;
+ Double_t dWeight = fCorrelator->Correlator(order,harmonics0.GetArray()).Re(); // weight is 'number of combinations' by default
+ TComplex cNum1 = fCorrelator->Correlator(order,harmonics1.GetArray())/dWeight;
+ TComplex cNum2 = fCorrelator->Correlator(order,harmonics2.GetArray())/dWeight;
  ratio = cNum1.Re()/cNum2.Re();
 
  return ratio;
@@ -26,10 +26,12 @@
 #include "TRandom3.h"
 #include "TSystem.h"
 #include "TArrayI.h"
+#include "TArrayD.h"
 #include "TGraphErrors.h"
 #include "TStopwatch.h"
 #include "AliFlowEventSimple.h"
 #include "AliFlowTrackSimple.h"
+#include "AliFlowMultiparticleCorrelator.h"
 
 class AliFlowAnalysisWithMultiparticleCorrelations{
  public:
@@ -385,6 +387,11 @@ class AliFlowAnalysisWithMultiparticleCorrelations{
   Bool_t fCalculateDiffQvectors; // to calculate or not to calculate p- and q-vector components, that's a Boolean...  
   TComplex fpvector[100][49][9]; // p-vector components [bin][fMaxHarmonic*fMaxCorrelator+1][fMaxCorrelator+1] = [6*8+1][8+1] TBI hardwired 100
   TComplex fqvector[100][49][9]; // q-vector components [bin][fMaxHarmonic*fMaxCorrelator+1][fMaxCorrelator+1] = [6*8+1][8+1] TBI hardwired 100
+  AliFlowMultiparticleCorrelator *fCorrelator; //! fills fQvector and calculates the generic correlators (iteratively, with cache)
+  TArrayD fPhiRPs;               //! azimuthal angles of RPs in the current event
+  TArrayD fWeightRPs;            //! weights of RPs in the current event
+  Double_t fCosHarmonics[49];    //! cos(h*phi) for the current POI, h = 0,...,fMaxHarmonic*fMaxCorrelator
+  Double_t fSinHarmonics[49];    //! sin(h*phi) for the current POI, h = 0,...,fMaxHarmonic*fMaxCorrelator
 
   // 3.) Correlations:
   TList *fCorrelationsList;           // list to hold all correlations objects
@@ -476,7 +483,7 @@ class AliFlowAnalysisWithMultiparticleCorrelations{
   Int_t fHighestHarmonicEtaGaps;      // 2-p correlations with eta gaps will be calculated for harmonics [fLowestHarmonicEtaGaps,fHighestHarmonicEtaGaps]
   TProfile *fEtaGapsPro[6];           // [harmonic] different eta gaps are different bins
 
-  ClassDef(AliFlowAnalysisWithMultiparticleCorrelations,6);
+  ClassDef(AliFlowAnalysisWithMultiparticleCorrelations,7);
 
 };
 
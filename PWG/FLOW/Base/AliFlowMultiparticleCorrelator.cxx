@@ -0,0 +1,371 @@
+/*************************************************************************
+* Copyright(c) 1998-2008, ALICE Experiment at CERN, All rights reserved. *
+*                                                                        *
+* Author: The ALICE Off-line Project.                                    *
+* Contributors are mentioned in the code where appropriate.              *
+*                                                                        *
+* Permission to use, copy, modify and distribute this software and its   *
+* documentation strictly for non-commercial purposes is hereby granted   *
+* without fee, provided that the above copyright notice appears in all   *
+* copies and that both the copyright notice and this permission notice   *
+* appear in the supporting documentation. The authors make no claims     *
+* about the suitability of this software for any purpose. It is          *
+* provided "as is" without express or implied warranty.                  *
+**************************************************************************/
+
+ /**************************************
+ * Q-vector based engine for generic   *
+ * multi-particle correlators          *
+ **************************************/
+
+// The n-particle correlator (sum over all distinct n-tuples of exp[i(h1*phi1+...+hn*phin)],
+// weighted with w1*...*wn) is given by the sum over all set partitions of {1,...,n}:
+//
+//   N<n> = sum_{partitions} prod_{blocks B} (-1)^{|B|-1} (|B|-1)! Q_{sum_{i in B} h_i,|B|}
+//
+// Taking the block which contains the last element, this is evaluated iteratively over the
+// subsets S of {1,...,n} (in increasing order of the bit mask, so that all subsets of S are done before S):
+//
+//   N(S) = sum_{T subset of S\{m}} (-1)^{|T|} |T|! Q_{h_m+sum_{i in T} h_i,|T|+1} N(S\{m}\T),  N({}) = 1,  m = last element of S
+//
+// which is the same expansion as the recursion by K. Gulbrandsen (gulbrand@nbi.dk), without recursion.
+// N(S) depends only on the multiset of harmonics in S, therefore each value is cached under its sorted
+// harmonics: sub-correlators are shared between all correlators requested in the same event.
+// The Q-vectors are filled with the angle-addition recurrence cos((h+1)phi) = cos(h*phi)cos(phi)-sin(h*phi)sin(phi),
+// and the weight powers with successive multiplications. Compared to TMath::Cos/Sin and pow() the results
+// differ only by rounding (relative differences of order 1e-13 for h <= 48).
+
+#include "AliFlowMultiparticleCorrelator.h"
+
+#include <algorithm>
+
+#include "Riostream.h"
+#include "TMath.h"
+#include "TRandom3.h"
+#include "TStopwatch.h"
+
+using std::cout;
+using std::endl;
+
+ClassImp(AliFlowMultiparticleCorrelator)
+
+//================================================================================================================
+
+AliFlowMultiparticleCorrelator::AliFlowMultiparticleCorrelator(Int_t maxHarmonic, Int_t maxPower):
+ fMaxHarmonic(maxHarmonic),
+ fMaxPower(maxPower),
+ fQre((maxHarmonic+1)*(maxPower+1),0.),
+ fQim((maxHarmonic+1)*(maxPower+1),0.),
+ fCos(maxHarmonic+1,0.),
+ fSin(maxHarmonic+1,0.),
+ fSubset(),
+ fSubsetHarmonic(),
+ fCache()
+{
+ // Constructor.
+
+} // AliFlowMultiparticleCorrelator::AliFlowMultiparticleCorrelator(Int_t maxHarmonic, Int_t maxPower)
+
+//================================================================================================================
+
+AliFlowMultiparticleCorrelator::~AliFlowMultiparticleCorrelator()
+{
+ // Destructor.
+
+} // AliFlowMultiparticleCorrelator::~AliFlowMultiparticleCorrelator()
+
+//================================================================================================================
+
+void AliFlowMultiparticleCorrelator::Reset()
+{
+ // Set all Q-vector components to zero and forget the correlators of the previous event.
+
+ std::fill(fQre.begin(),fQre.end(),0.);
+ std::fill(fQim.begin(),fQim.end(),0.);
+ fCache.clear();
+
+} // void AliFlowMultiparticleCorrelator::Reset()
+
+//================================================================================================================
+
+void AliFlowMultiparticleCorrelator::CosSinHarmonics(Double_t phi, Int_t maxHarmonic, Double_t *cosPhi, Double_t *sinPhi)
+{
+ // Calculate cos(h*phi) and sin(h*phi) for h = 0,...,maxHarmonic with the angle-addition recurrence.
+
+ cosPhi[0] = 1.;
+ sinPhi[0] = 0.;
+ if(maxHarmonic<1){return;}
+ const Double_t c1 = TMath::Cos(phi);
+ const Double_t s1 = TMath::Sin(phi);
+ cosPhi[1] = c1;
+ sinPhi[1] = s1;
+ for(Int_t h=2;h<=maxHarmonic;h++)
+ {
+  cosPhi[h] = cosPhi[h-1]*c1 - sinPhi[h-1]*s1;
+  sinPhi[h] = sinPhi[h-1]*c1 + cosPhi[h-1]*s1;
+ }
+
+} // void AliFlowMultiparticleCorrelator::CosSinHarmonics(Double_t phi, Int_t maxHarmonic, Double_t *cosPhi, Double_t *sinPhi)
+
+//================================================================================================================
+
+void AliFlowMultiparticleCorrelator::Fill(Int_t nParticles, const Double_t *phi, const Double_t *weight)
+{
+ // Add particles to the Q-vectors. The cache is invalidated.
+
+ const Int_t nH = fMaxHarmonic+1;
+ Double_t *cosPhi = &fCos[0];
+ Double_t *sinPhi = &fSin[0];
+ for(Int_t i=0;i<nParticles;i++)
+ {
+  CosSinHarmonics(phi[i],fMaxHarmonic,cosPhi,sinPhi);
+  Double_t wToPowerP = 1.;
+  for(Int_t wp=0;wp<fMaxPower+1;wp++) // weight power
+  {
+   Double_t *qre = &fQre[wp*nH];
+   Double_t *qim = &fQim[wp*nH];
+   for(Int_t h=0;h<nH;h++)
+   {
+    qre[h] += wToPowerP*cosPhi[h];
+    qim[h] += wToPowerP*sinPhi[h];
+   }
+   if(weight){wToPowerP *= weight[i];}
+  } // for(Int_t wp=0;wp<fMaxPower+1;wp++) // weight power
+ } // for(Int_t i=0;i<nParticles;i++)
+
+ fCache.clear();
+
+} // void AliFlowMultiparticleCorrelator::Fill(Int_t nParticles, const Double_t *phi, const Double_t *weight)
+
+//================================================================================================================
+
+TComplex AliFlowMultiparticleCorrelator::Q(Int_t n, Int_t p) const
+{
+ // Using the fact that Q{-n,p} = Q{n,p}^*.
+
+ if(TMath::Abs(n)>fMaxHarmonic || p<0 || p>fMaxPower)
+ {
+  cout<<Form("\n AliFlowMultiparticleCorrelator::Q(%d,%d): out of range (max. harmonic = %d, max. power = %d) !!!!",n,p,fMaxHarmonic,fMaxPower)<<endl;
+  return TComplex(0.,0.);
+ }
+
+ if(n>=0){return TComplex(fQre[p*(fMaxHarmonic+1)+n],fQim[p*(fMaxHarmonic+1)+n]);}
+ return TComplex(fQre[p*(fMaxHarmonic+1)-n],-fQim[p*(fMaxHarmonic+1)-n]);
+
+} // TComplex AliFlowMultiparticleCorrelator::Q(Int_t n, Int_t p) const
+
+//================================================================================================================
+
+TComplex AliFlowMultiparticleCorrelator::Correlator(Int_t n, const Int_t *harmonic)
+{
+ // Not normalized n-particle correlator for harmonics harmonic[0],...,harmonic[n-1] (see the comment on top).
+
+ if(n<1 || n>fgkMaxOrder || n>fMaxPower)
+ {
+  cout<<Form("\n AliFlowMultiparticleCorrelator::Correlator: %d-particle correlator not supported (max. %d) !!!!",n,TMath::Min(fgkMaxOrder,fMaxPower))<<endl;
+  return TComplex(0.,0.);
+ }
+
+ // Coefficients (-1)^k k!:
+ static Double_t coefficient[fgkMaxOrder] = {0.};
+ if(coefficient[0]==0.)
+ {
+  coefficient[0] = 1.;
+  for(Int_t k=1;k<fgkMaxOrder;k++){coefficient[k] = -k*coefficient[k-1];}
+ }
+
+ const Int_t nSubsets = 1<<n;
+ fSubset.resize(nSubsets);
+ fSubsetHarmonic.resize(nSubsets);
+ fSubset[0] = TComplex(1.,0.);
+ fSubsetHarmonic[0] = 0;
+
+ std::string key;
+ Int_t sorted[fgkMaxOrder] = {0};
+ for(Int_t mask=1;mask<nSubsets;mask++)
+ {
+  // Harmonics of this subset and their sum:
+  Int_t nInMask = 0;
+  Int_t last = -1;
+  for(Int_t i=0;i<n;i++)
+  {
+   if(!(mask & (1<<i))){continue;}
+   sorted[nInMask++] = harmonic[i];
+   last = i;
+  }
+  const Int_t rest = mask ^ (1<<last);
+  fSubsetHarmonic[mask] = fSubsetHarmonic[rest] + harmonic[last];
+
+  // Look up the cache:
+  std::sort(sorted,sorted+nInMask);
+  key.assign(nInMask,'\0');
+  for(Int_t i=0;i<nInMask;i++){key[i] = (char)sorted[i];}
+  std::map<std::string,TComplex>::const_iterator it = fCache.find(key);
+  if(it != fCache.end())
+  {
+   fSubset[mask] = it->second;
+   continue;
+  }
+
+  // Sum over the subsets T of rest (the block of 'last' is {last} + T):
+  TComplex value(0.,0.);
+  Int_t t = rest;
+  while(kTRUE)
+  {
+   Int_t k = 0;
+   for(Int_t b=t;b;b&=b-1){k++;}
+   value += coefficient[k]*Q(harmonic[last]+fSubsetHarmonic[t],k+1)*fSubset[rest^t];
+   if(t==0){break;}
+   t = (t-1) & rest;
+  }
+  fSubset[mask] = value;
+  fCache[key] = value;
+ } // for(Int_t mask=1;mask<nSubsets;mask++)
+
+ return fSubset[nSubsets-1];
+
+} // TComplex AliFlowMultiparticleCorrelator::Correlator(Int_t n, const Int_t *harmonic)
+
+//================================================================================================================
+
+TComplex AliFlowMultiparticleCorrelator::RecursionReference(Int_t n, Int_t* harmonic, Int_t mult, Int_t skip) const
+{
+ // Calculate multi-particle correlators by using recursion (an improved faster version) originally developed by
+ // Kristjan Gulbrandsen (gulbrand@nbi.dk). Same as AliFlowAnalysisWithMultiparticleCorrelations::Recursion(...),
+ // kept here to validate and benchmark Correlator(...).
+
+  Int_t nm1 = n-1;
+  TComplex c(Q(harmonic[nm1], mult));
+  if (nm1 == 0) return c;
+  c *= RecursionReference(nm1, harmonic);
+  if (nm1 == skip) return c;
+
+  Int_t multp1 = mult+1;
+  Int_t nm2 = n-2;
+  Int_t counter1 = 0;
+  Int_t hhold = harmonic[counter1];
+  harmonic[counter1] = harmonic[nm2];
+  harmonic[nm2] = hhold + harmonic[nm1];
+  TComplex c2(RecursionReference(nm1, harmonic, multp1, nm2));
+  Int_t counter2 = n-3;
+  while (counter2 >= skip) {
+    harmonic[nm2] = harmonic[counter1];
+    harmonic[counter1] = hhold;
+    ++counter1;
+    hhold = harmonic[counter1];
+    harmonic[counter1] = harmonic[nm2];
+    harmonic[nm2] = hhold + harmonic[nm1];
+    c2 += RecursionReference(nm1, harmonic, multp1, counter2);
+    --counter2;
+  }
+  harmonic[nm2] = harmonic[counter1];
+  harmonic[counter1] = hhold;
+
+  if (mult == 1) return c-c2;
+  return c-Double_t(mult)*c2;
+
+} // TComplex AliFlowMultiparticleCorrelator::RecursionReference(Int_t n, Int_t* harmonic, Int_t mult, Int_t skip) const
+
+//================================================================================================================
+
+void AliFlowMultiparticleCorrelator::Benchmark(Int_t nParticles, Int_t nEvents, Int_t maxOrder, UInt_t seed)
+{
+ // Microbenchmark, to be run from the ROOT prompt:
+ //  AliFlowMultiparticleCorrelator::Benchmark(1000,100,8);
+ // a) Q-vector filling: TMath::Cos/Sin and pow() per harmonic and weight power vs. recurrence;
+ // b) For each order: recursion vs. iterative correlator, for the typical set of correlators of a cumulant
+ //    analysis in an event (denominator with zero harmonics and numerators for v2,...,v6).
+ //    Largest relative difference between the two is printed as well.
+
+ if(maxOrder>fgkMaxOrder){maxOrder = fgkMaxOrder;}
+
+ const Int_t maxHarmonic = 6*maxOrder;
+ AliFlowMultiparticleCorrelator engine(maxHarmonic,maxOrder);
+ TRandom3 random(seed);
+ std::vector<Double_t> phi(nParticles), weight(nParticles);
+ std::vector<Double_t> qRe((maxHarmonic+1)*(maxOrder+1)), qIm((maxHarmonic+1)*(maxOrder+1));
+
+ // a) Q-vector filling:
+ Double_t timeFillOld = 0., timeFillNew = 0., maxDiffQ = 0.;
+ TStopwatch watch;
+ for(Int_t e=0;e<nEvents;e++)
+ {
+  for(Int_t i=0;i<nParticles;i++)
+  {
+   phi[i] = random.Uniform(0.,TMath::TwoPi());
+   weight[i] = random.Uniform(0.5,1.5);
+  }
+  std::fill(qRe.begin(),qRe.end(),0.);
+  std::fill(qIm.begin(),qIm.end(),0.);
+  watch.Start();
+  for(Int_t i=0;i<nParticles;i++)
+  {
+   for(Int_t h=0;h<maxHarmonic+1;h++)
+   {
+    for(Int_t wp=0;wp<maxOrder+1;wp++)
+    {
+     Double_t wToPowerP = pow(weight[i],wp);
+     qRe[wp*(maxHarmonic+1)+h] += wToPowerP*TMath::Cos(h*phi[i]);
+     qIm[wp*(maxHarmonic+1)+h] += wToPowerP*TMath::Sin(h*phi[i]);
+    }
+   }
+  }
+  watch.Stop();
+  timeFillOld += watch.RealTime();
+  engine.Reset();
+  watch.Start();
+  engine.Fill(nParticles,&phi[0],&weight[0]);
+  watch.Stop();
+  timeFillNew += watch.RealTime();
+  for(Int_t h=0;h<maxHarmonic+1;h++)
+  {
+   for(Int_t wp=0;wp<maxOrder+1;wp++)
+   {
+    TComplex diff = engine.Q(h,wp) - TComplex(qRe[wp*(maxHarmonic+1)+h],qIm[wp*(maxHarmonic+1)+h]);
+    Double_t norm = TMath::Max(1.,TComplex::Abs(engine.Q(0,wp)));
+    maxDiffQ = TMath::Max(maxDiffQ,TComplex::Abs(diff)/norm);
+   }
+  }
+ } // for(Int_t e=0;e<nEvents;e++)
+ cout<<Form("Q-vector filling (%d particles, h <= %d, p <= %d): cos/sin/pow %.3f ms/event, recurrence %.3f ms/event, max. rel. difference %.2e",
+            nParticles,maxHarmonic,maxOrder,1.e3*timeFillOld/nEvents,1.e3*timeFillNew/nEvents,maxDiffQ)<<endl;
+
+ // b) Correlators per order:
+ for(Int_t order=2;order<=maxOrder;order++)
+ {
+  Double_t timeRecursion = 0., timeIterative = 0., maxDiff = 0.;
+  Int_t harmonic[fgkMaxOrder] = {0};
+  for(Int_t e=0;e<nEvents;e++)
+  {
+   for(Int_t i=0;i<nParticles;i++){phi[i] = random.Uniform(0.,TMath::TwoPi());}
+   engine.Reset();
+   engine.Fill(nParticles,&phi[0]);
+   TComplex resultRecursion[7], resultIterative[7];
+   watch.Start();
+   for(Int_t n=0;n<7;n++) // n=0 is the denominator
+   {
+    for(Int_t i=0;i<order;i++){harmonic[i] = (i%2==0 ? n : -n);}
+    resultRecursion[n] = engine.RecursionReference(order,harmonic);
+   }
+   watch.Stop();
+   timeRecursion += watch.RealTime();
+   watch.Start();
+   for(Int_t n=0;n<7;n++)
+   {
+    for(Int_t i=0;i<order;i++){harmonic[i] = (i%2==0 ? n : -n);}
+    resultIterative[n] = engine.Correlator(order,harmonic);
+   }
+   watch.Stop();
+   timeIterative += watch.RealTime();
+   for(Int_t n=0;n<7;n++)
+   {
+    maxDiff = TMath::Max(maxDiff,TComplex::Abs(resultRecursion[n]-resultIterative[n])/TComplex::Abs(resultRecursion[0]));
+   }
+  } // for(Int_t e=0;e<nEvents;e++)
+  cout<<Form("%d-particle correlators (7 per event): recursion %.3f ms/event, iterative+cache %.3f ms/event, max. rel. difference %.2e",
+             order,1.e3*timeRecursion/nEvents,1.e3*timeIterative/nEvents,maxDiff)<<endl;
+ } // for(Int_t order=2;order<=maxOrder;order++)
+
+} // void AliFlowMultiparticleCorrelator::Benchmark(Int_t nParticles, Int_t nEvents, Int_t maxOrder, UInt_t seed)
+
+//================================================================================================================
@@ -0,0 +1,64 @@
+/*
+ * Copyright(c) 1998-1999, ALICE Experiment at CERN, All rights reserved.
+ * See cxx source for full Copyright notice
+ * $Id$
+ */
+
+ /**************************************
+ * Q-vector based engine for generic   *
+ * multi-particle correlators          *
+ **************************************/
+
+#ifndef ALIFLOWMULTIPARTICLECORRELATOR_H
+#define ALIFLOWMULTIPARTICLECORRELATOR_H
+
+#include <string>
+#include <map>
+#include <vector>
+
+#include "TComplex.h"
+
+class AliFlowMultiparticleCorrelator{
+ public:
+  AliFlowMultiparticleCorrelator(Int_t maxHarmonic = 48, Int_t maxPower = 8);
+  virtual ~AliFlowMultiparticleCorrelator();
+
+  // Q-vectors:
+  void Reset(); // set all Q-vector components to zero and clear the cache, to be called for each new event
+  void Fill(Int_t nParticles, const Double_t *phi, const Double_t *weight = NULL); // add particles to the Q-vectors, weight = NULL means unit weights
+  TComplex Q(Int_t n, Int_t p) const; // Q_{n,p} = sum_i w_i^p exp(i n phi_i), Q_{-n,p} = Q_{n,p}^*
+  Int_t GetMaxHarmonic() const {return fMaxHarmonic;};
+  Int_t GetMaxPower() const {return fMaxPower;};
+
+  // Correlators:
+  TComplex Correlator(Int_t n, const Int_t *harmonic); // not normalized n-particle correlator, i.e. sum over all distinct n-tuples
+  Int_t GetCacheSize() const {return fCache.size();};
+  static void CosSinHarmonics(Double_t phi, Int_t maxHarmonic, Double_t *cosPhi, Double_t *sinPhi); // cos(h*phi) and sin(h*phi) for h = 0,...,maxHarmonic
+  TComplex RecursionReference(Int_t n, Int_t* harmonic, Int_t mult = 1, Int_t skip = 0) const; // recursion by K. Gulbrandsen, kept for validation
+
+  // Microbenchmark:
+  static void Benchmark(Int_t nParticles = 1000, Int_t nEvents = 100, Int_t maxOrder = 8, UInt_t seed = 4357);
+
+  static const Int_t fgkMaxOrder = 12; // highest supported correlator
+
+ private:
+  AliFlowMultiparticleCorrelator(const AliFlowMultiparticleCorrelator& other);
+  AliFlowMultiparticleCorrelator& operator=(const AliFlowMultiparticleCorrelator& other);
+
+  Int_t fMaxHarmonic;                // highest harmonic stored in the Q-vectors
+  Int_t fMaxPower;                   // highest weight power stored in the Q-vectors
+  std::vector<Double_t> fQre;        // real part of Q-vectors [p*(fMaxHarmonic+1)+h]
+  std::vector<Double_t> fQim;        // imaginary part of Q-vectors [p*(fMaxHarmonic+1)+h]
+  std::vector<Double_t> fCos;        //! cos(h*phi) for the current particle
+  std::vector<Double_t> fSin;        //! sin(h*phi) for the current particle
+  std::vector<TComplex> fSubset;     //! correlators of all subsets of the current harmonics
+  std::vector<Int_t> fSubsetHarmonic;//! sum of the harmonics of all subsets of the current harmonics
+  std::map<std::string,TComplex> fCache; //! correlators already calculated in this event, keyed by their sorted harmonics
+
+  ClassDef(AliFlowMultiparticleCorrelator,1);
+
+};
+
+//================================================================================================================
+
+#endif
@@ -0,0 +1,138 @@
+// $Id: AliEtaPhiGrid.cxx  $
+//
+// Counting sort of entries (tracks, clusters, jets...) in eta-phi cells,
+// to only look at the entries near a given direction instead of looping
+// over all of them.
+//
+// The cells are fNEta bins of width fEtaWidth starting at fEtaMin (values
+// outside are put in the first/last bin) times fNPhi bins over [0,2pi),
+// phi being periodic. Usage:
+//
+//   grid.SetBinning(nEta, etaMin, etaWidth, nPhi);
+//   for (i...) cells[i] = grid.GetCell(eta[i], phi[i]);  // or -1 to leave out entry i
+//   grid.Sort(n, cells);
+//   grid.GetNeighbours(eta, phi, candidates);            // 3x3 cells around (eta,phi)
+//
+// The entries of a cell are kept in increasing entry number and the
+// candidates are returned in increasing entry number, so that a loop on
+// them visits the entries in the same order as a loop on all entries.
+
+#include <algorithm>
+
+#include <TMath.h>
+#include <TVector2.h>
+
+#include "AliEtaPhiGrid.h"
+
+ClassImp(AliEtaPhiGrid)
+
+//________________________________________________________________________
+AliEtaPhiGrid::AliEtaPhiGrid() :
+  TObject(),
+  fNEta(0),
+  fNPhi(0),
+  fEtaMin(0),
+  fEtaWidth(1),
+  fCellFirst(),
+  fEntries()
+{
+  // Default constructor.
+}
+
+//________________________________________________________________________
+void AliEtaPhiGrid::SetBinning(Int_t nEta, Double_t etaMin, Double_t etaWidth, Int_t nPhi)
+{
+  // Set the cells, the entries have to be sorted again.
+
+  fNEta     = nEta;
+  fNPhi     = nPhi;
+  fEtaMin   = etaMin;
+  fEtaWidth = etaWidth;
+  fCellFirst.assign(GetNCells() + 1, 0);
+  fEntries.clear();
+}
+
+//________________________________________________________________________
+Int_t AliEtaPhiGrid::GetEtaBin(Double_t eta) const
+{
+  // Eta bin, values outside of the grid go to the first/last bin.
+
+  Double_t pos = (eta - fEtaMin) / fEtaWidth;
+  if (!(pos > 0)) return 0;
+  if (pos >= fNEta) return fNEta - 1;
+  return Int_t(pos);
+}
+
+//________________________________________________________________________
+Int_t AliEtaPhiGrid::GetPhiBin(Double_t phi) const
+{
+  // Phi bin, phi in any range (2pi itself goes to the last bin).
+
+  if (TMath::IsNaN(phi)) return 0;
+  if (phi < 0 || phi > TMath::TwoPi()) phi = TVector2::Phi_0_2pi(phi);
+  return TMath::Min(Int_t(phi / TMath::TwoPi() * fNPhi), fNPhi - 1);
+}
+
+//________________________________________________________________________
+void AliEtaPhiGrid::Sort(Int_t n, const Int_t *cells)
+{
+  // Sort the n entries by cell: cells[i] is the cell of entry i (see GetCell()),
+  // a negative value leaves the entry out. The cells are counted first and each
+  // entry is then placed at the running sum of the counts of the previous cells.
+
+  const Int_t nCells = GetNCells();
+  fCellFirst.assign(nCells + 1, 0);
+  for (Int_t i = 0; i < n; i++) {
+    if (cells[i] >= 0) fCellFirst[cells[i] + 1]++;
+  }
+  for (Int_t c = 0; c < nCells; c++) fCellFirst[c + 1] += fCellFirst[c];
+
+  // fCellFirst[c] is used as insertion point of cell c, it ends up at the first entry of cell c+1
+  fEntries.resize(fCellFirst[nCells]);
+  for (Int_t i = 0; i < n; i++) {
+    if (cells[i] >= 0) fEntries[fCellFirst[cells[i]]++] = i;
+  }
+  for (Int_t c = nCells; c > 0; c--) fCellFirst[c] = fCellFirst[c - 1];
+  fCellFirst[0] = 0;
+}
+
+//________________________________________________________________________
+Int_t AliEtaPhiGrid::CopyEntries(Int_t ieta, Int_t iphi0, Int_t iphi1, Int_t *out) const
+{
+  // Copy to out the entries of the phi cells iphi0 to iphi1 (no wrap-around) of eta row ieta,
+  // which are contiguous. Returns the number of entries copied.
+
+  if (iphi0 > iphi1) return 0;
+  const Int_t first = fCellFirst[ieta * fNPhi + iphi0];
+  const Int_t last  = fCellFirst[ieta * fNPhi + iphi1 + 1];
+  for (Int_t k = first; k < last; k++) *out++ = fEntries[k];
+  return last - first;
+}
+
+//________________________________________________________________________
+void AliEtaPhiGrid::GetNeighbours(Double_t eta, Double_t phi, std::vector<Int_t> &out) const
+{
+  // Fill out with the entries of the 3x3 cells around (eta, phi), phi being periodic
+  // (all the phi cells if there are less than 3), in increasing entry number.
+  // Nothing is found if eta is more than one bin away from the grid.
+
+  out.clear();
+  if (fNEta <= 0 || fNPhi <= 0) return;
+
+  Double_t etaPos = (eta - fEtaMin) / fEtaWidth;
+  if (!(etaPos >= -1 && etaPos < fNEta + 1) || TMath::IsNaN(phi)) return;
+  const Int_t ieta = TMath::FloorNint(etaPos);
+  const Int_t iphi = GetPhiBin(phi);
+
+  for (Int_t je = TMath::Max(ieta - 1, 0); je <= TMath::Min(ieta + 1, fNEta - 1); je++) {
+    if (fNPhi < 3) {
+      out.insert(out.end(), fEntries.begin() + fCellFirst[je * fNPhi], fEntries.begin() + fCellFirst[(je + 1) * fNPhi]);
+      continue;
+    }
+    for (Int_t dp = -1; dp <= 1; dp++) {
+      const Int_t c = je * fNPhi + (iphi + dp + fNPhi) % fNPhi;
+      out.insert(out.end(), fEntries.begin() + fCellFirst[c], fEntries.begin() + fCellFirst[c + 1]);
+    }
+  }
+  std::sort(out.begin(), out.end());
+}
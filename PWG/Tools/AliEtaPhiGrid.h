@@ -0,0 +1,40 @@
+#ifndef ALIETAPHIGRID_H
+#define ALIETAPHIGRID_H
+
+// $Id: AliEtaPhiGrid.h  $
+
+#include <vector>
+
+#include <TObject.h>
+
+class AliEtaPhiGrid : public TObject {
+ public:
+  AliEtaPhiGrid();
+
+  void         SetBinning(Int_t nEta, Double_t etaMin, Double_t etaWidth, Int_t nPhi);
+  Int_t        GetNEtaBins()                 const { return fNEta                      ; }
+  Int_t        GetNPhiBins()                 const { return fNPhi                      ; }
+  Double_t     GetEtaMin()                   const { return fEtaMin                    ; }
+  Double_t     GetEtaWidth()                 const { return fEtaWidth                  ; }
+  Int_t        GetNCells()                   const { return fNEta * fNPhi              ; }
+  Int_t        GetEtaBin(Double_t eta)       const;
+  Int_t        GetPhiBin(Double_t phi)       const;
+  Int_t        GetCell(Double_t eta, Double_t phi) const { return GetEtaBin(eta) * fNPhi + GetPhiBin(phi); }
+
+  void         Sort(Int_t n, const Int_t *cells);
+  Int_t        GetFirst(Int_t cell)          const { return fCellFirst[cell]           ; }
+  Int_t        GetEntry(Int_t pos)           const { return fEntries[pos]              ; }
+  Int_t        CopyEntries(Int_t ieta, Int_t iphi0, Int_t iphi1, Int_t *out) const;
+  void         GetNeighbours(Double_t eta, Double_t phi, std::vector<Int_t> &out) const;
+
+ private:
+  Int_t                fNEta;        // number of eta bins
+  Int_t                fNPhi;        // number of phi bins, over [0,2pi)
+  Double_t             fEtaMin;      // low edge of the first eta bin
+  Double_t             fEtaWidth;    // eta bin width
+  std::vector<Int_t>   fCellFirst;   //! position in fEntries of the first entry of each cell, running sum of the cell counts
+  std::vector<Int_t>   fEntries;     //! entries sorted by cell, increasing entry number inside a cell
+
+  ClassDef(AliEtaPhiGrid, 1); // Counting sort of entries in eta-phi cells
+};
+#endif
@@ -286,6 +286,42 @@ void AliTHnT<TemplateArray, TemplateType>::Fill(const Double_t *var, Int_t istep
 {
   // fills an entry
 
+  Long64_t bin = GetGlobalBinIndex(var);
+  if (bin < 0)
+    return;
+  
+  FillStep(bin, istep, weight);
+
+  // debug
+//   AliCFContainer::Fill(var, istep, weight);
+}
+
+template <class TemplateArray, typename TemplateType>
+void AliTHnT<TemplateArray, TemplateType>::FillSteps(const Double_t *var, Int_t nSteps, const Int_t *steps, Double_t weight)
+{
+  // fills an entry in all steps listed in <steps>, computing the global bin index only once
+
+  Long64_t bin = GetGlobalBinIndex(var);
+  if (bin < 0)
+    return;
+  
+  for (Int_t i=0; i<nSteps; i++)
+  {
+    if (steps[i] < 0 || steps[i] >= fNSteps)
+    {
+      AliError(Form("Non-existent selection step %d, grid was not filled", steps[i]));
+      continue;
+    }
+    FillStep(bin, steps[i], weight);
+  }
+}
+
+template <class TemplateArray, typename TemplateType>
+Long64_t AliTHnT<TemplateArray, TemplateType>::GetGlobalBinIndex(const Double_t *var)
+{
+  // calculates the global bin index of the values <var>
+  // returns -1 if any value is in the under/overflow bin
+
   // fill axis cache
   if (!axisCache)
   {
@@ -327,13 +363,21 @@ void AliTHnT<TemplateArray, TemplateType>::Fill(const Double_t *var, Int_t istep
 
     // under/overflow not supported
     if (tmpBin < 1 || tmpBin > fNbinsCache[i])
-      return;
+      return -1;
     
     // bins start from 0 here
     bin += tmpBin - 1;
 //     Printf("%lld", bin);
   }
 
+  return bin;
+}
+
+template <class TemplateArray, typename TemplateType>
+void AliTHnT<TemplateArray, TemplateType>::FillStep(Long64_t bin, Int_t istep, Double_t weight)
+{
+  // adds <weight> to global bin <bin> of step <istep>
+
   if (!fValues[istep])
   {
     fValues[istep] = new TemplateArray(fNBins);
@@ -355,9 +399,49 @@ void AliTHnT<TemplateArray, TemplateType>::Fill(const Double_t *var, Int_t istep
     fSumw2[istep]->GetArray()[bin] += weight * weight;
   
 //   Printf("%f", fValues[istep][bin]);
+}
+
+template <class TemplateArray, typename TemplateType>
+void AliTHnT<TemplateArray, TemplateType>::SetGrid(Int_t step, AliCFGridSparse* grid)
+{
+  // replaces the grid of step <step>
+  // the dense arrays and the global bin index are shared by all steps, therefore <grid> must have the binning of the grid it replaces
+
+  if (step < 0 || step >= fNSteps)
+  {
+    AliError(Form("Non-existent selection step %d, grid was not set", step));
+    return;
+  }
   
-  // debug
-//   AliCFContainer::Fill(var, istep, weight);
+  AliCFGridSparse* old = GetGrid(step);
+  if (old && grid)
+  {
+    for (Int_t i=0; i<fNVars; i++)
+    {
+      TAxis* oldAxis = old->GetAxis(i);
+      TAxis* newAxis = grid->GetAxis(i);
+      Bool_t same = (oldAxis->GetNbins() == newAxis->GetNbins());
+      for (Int_t j=1; same && j<=oldAxis->GetNbins()+1; j++)
+	same = (oldAxis->GetBinLowEdge(j) == newAxis->GetBinLowEdge(j));
+      if (!same)
+      {
+	AliError(Form("Binning of axis %d of the grid differs from the one of step %d, grid was not set", i, step));
+	return;
+      }
+    }
+  }
+  
+  AliCFContainer::SetGrid(step, grid);
+  
+  // the axis cache may point to the axes of the replaced grid
+  delete[] axisCache;
+  delete[] fNbinsCache;
+  delete[] fLastVars;
+  delete[] fLastBins;
+  axisCache = 0;
+  fNbinsCache = 0;
+  fLastVars = 0;
+  fLastBins = 0;
 }
 
 template <class TemplateArray, typename TemplateType>
@@ -8,6 +8,9 @@
 //
 // Use AliTHn instead of AliCFContainer and your memory consumption will be drastically reduced
 // As AliTHn derives from AliCFContainer, you can just replace your current AliCFContainer object by AliTHn
+// All steps share the binning of step 0 (SetGrid refuses a grid with another binning), so that
+// FillSteps() fills several selection steps with a single bin look-up; this dense storage pays off
+// when a sizeable fraction of the bins gets filled (otherwise stay with the THnSparse of AliCFContainer)
 // Once you have the merged output, call FillParent() and you can use AliCFContainer as usual
 
 #include "TObject.h"
@@ -48,6 +51,8 @@ class AliTHnT : public AliTHnBase
   virtual ~AliTHnT();
   
   virtual void Fill(const Double_t *var, Int_t istep, Double_t weight=1.) ;
+  virtual void FillSteps(const Double_t *var, Int_t nSteps, const Int_t *steps, Double_t weight=1.) ;
+  virtual void SetGrid(Int_t step, AliCFGridSparse* grid);
   virtual void FillParent();
   virtual void FillContainer(AliCFContainer* cont);
   
@@ -66,6 +71,8 @@ class AliTHnT : public AliTHnBase
 protected:
   void Init();
   Long64_t GetGlobalBinIndex(const Int_t* binIdx);
+  Long64_t GetGlobalBinIndex(const Double_t* var);
+  void FillStep(Long64_t bin, Int_t istep, Double_t weight);
   
   Long64_t fNBins;   // number of total bins
   Int_t    fNVars;   // number of variables
@@ -30,6 +30,8 @@
  * - \ref HasMC to know if MC information is available in the analyzed data
  * - \ref Event to access the current event
  * - \ref MCEvent to access to current MC event (if available)
+ * - \ref SlotKey and \ref SlotObject to access, in the FillHistosForXXX methods, the histograms of the
+ *   combination being filled without building its path again for each event, track or pair
  *
  * A few trivial cut methods (\ref AlwaysTrue and \ref AlwaysFalse) are defined as well and
  * can be used to register some control cut combinations (see \ref AliAnalysisMuMuCutCombination)
@@ -69,11 +71,22 @@ fCutRegistry(0x0),
 fEvent(0x0),
 fMCEvent(0x0),
 fHistogramToDisable(0x0),
-fHasMC(kFALSE)
+fHasMC(kFALSE),
+fSlot(-1),
+fSlotKeys(0x0),
+fSlotObjects(),
+fSlotResolved()
 {
  /// default ctor
 }
 
+//_____________________________________________________________________________
+AliAnalysisMuMuBase::~AliAnalysisMuMuBase()
+{
+  /// dtor
+  delete fSlotKeys;
+}
+
 //_____________________________________________________________________________
 TString AliAnalysisMuMuBase::BuildPath(const char* eventSelection, const char* triggerClassName,
                                        const char* centrality, const char* cut) const
@@ -518,6 +531,8 @@ void AliAnalysisMuMuBase::Init(AliCounterCollection& cc,
   fHistogramCollection = &hc;
   fBinning             = &binning;
   fCutRegistry         = &registry;
+
+  ResetSlots();
 }
 
 //_____________________________________________________________________________
@@ -638,6 +653,93 @@ TProfile* AliAnalysisMuMuBase::MCProf(const char* eventSelection,
 	return fHistogramCollection ? static_cast<TProfile*>(fHistogramCollection->GetObject(Form("/%s/%s/%s/%s/%s",MCInputPrefix(),eventSelection,triggerClassName,cent,what),histoname)) : 0x0;
 }
 
+//_____________________________________________________________________________
+void AliAnalysisMuMuBase::ResetSlots()
+{
+  /// Forget the objects found so far for each slot. To be called whenever
+  /// objects may have been removed from (or replaced in) the histogram collection
+  fSlotObjects.clear();
+  fSlotResolved.clear();
+}
+
+//_____________________________________________________________________________
+Int_t AliAnalysisMuMuBase::SlotKey(const char* hname)
+{
+  /// Return the integer key of the object named hname, to be used with SlotObject.
+  /// Meant to be called once per name (e.g. at the first fill), not in the event loop
+
+  if (!fSlotKeys)
+  {
+    fSlotKeys = new TObjArray;
+    fSlotKeys->SetOwner(kTRUE);
+  }
+
+  for ( Int_t i = 0; i < fSlotKeys->GetEntriesFast(); ++i )
+  {
+    if ( static_cast<TObjString*>(fSlotKeys->UncheckedAt(i))->String() == hname ) return i;
+  }
+
+  fSlotKeys->Add(new TObjString(hname));
+
+  return fSlotKeys->GetEntriesFast()-1;
+}
+
+//_____________________________________________________________________________
+const char* AliAnalysisMuMuBase::SlotKeyName(Int_t key) const
+{
+  /// Name of the object corresponding to key
+  if ( !fSlotKeys || key < 0 || key >= fSlotKeys->GetEntriesFast() ) return "";
+  return static_cast<TObjString*>(fSlotKeys->UncheckedAt(key))->String().Data();
+}
+
+//_____________________________________________________________________________
+TObject* AliAnalysisMuMuBase::SlotObject(Int_t key,
+                                         const char* eventSelection, const char* triggerClassName, const char* centrality,
+                                         const char* cut, Bool_t mc)
+{
+  /** Get the object of key (see SlotKey) in the (MC) path eventSelection/triggerClassName/centrality/cut,
+   * which must be the path of the current slot (see SetSlot).
+   *
+   * The object is looked up in the histogram collection only the first time it is
+   * requested for a given slot, afterwards this is a plain array access.
+   * Without slot (-1) the lookup is done each time.
+   */
+
+  if ( key < 0 || !fHistogramCollection ) return 0x0;
+
+  if ( fSlot < 0 )
+  {
+    TString path = mc ? BuildMCPath(eventSelection,triggerClassName,centrality,cut) : BuildPath(eventSelection,triggerClassName,centrality,cut);
+    return fHistogramCollection->GetObject(path.Data(),SlotKeyName(key));
+  }
+
+  UInt_t row = 2*fSlot + ( mc ? 1 : 0 );
+
+  if ( row >= fSlotObjects.size() )
+  {
+    fSlotObjects.resize(row+1);
+    fSlotResolved.resize(row+1);
+  }
+
+  std::vector<TObject*>& objects = fSlotObjects[row];
+  std::vector<Bool_t>& resolved = fSlotResolved[row];
+
+  if ( static_cast<UInt_t>(key) >= objects.size() )
+  {
+    objects.resize(fSlotKeys->GetEntriesFast(),0x0);
+    resolved.resize(fSlotKeys->GetEntriesFast(),kFALSE);
+  }
+
+  if ( !resolved[key] )
+  {
+    TString path = mc ? BuildMCPath(eventSelection,triggerClassName,centrality,cut) : BuildPath(eventSelection,triggerClassName,centrality,cut);
+    objects[key]  = fHistogramCollection->GetObject(path.Data(),SlotKeyName(key));
+    resolved[key] = kTRUE;
+  }
+
+  return objects[key];
+}
+
 //_____________________________________________________________________________
 void AliAnalysisMuMuBase::SetEvent(AliVEvent* event, AliMCEvent* mcEvent)
 {
@@ -13,6 +13,7 @@
 #include "TObject.h"
 #include "TString.h"
 #include "TProfile.h"
+#include <vector>
 
 class AliCounterCollection;
 class AliAnalysisMuMuBinning;
@@ -23,13 +24,14 @@ class AliMCEvent;
 class TH1;
 class AliInputEventHandler;
 class AliAnalysisMuMuCutRegistry;
+class TObjArray;
 
 class AliAnalysisMuMuBase : public TObject
 {
 public:
 
   AliAnalysisMuMuBase();
-  virtual ~AliAnalysisMuMuBase() {}
+  virtual ~AliAnalysisMuMuBase();
 
   /** Define the histograms needed for the path starting at eventSelection/triggerClassName/centrality.
    * This method has to ensure the histogram creation is performed only once !
@@ -101,7 +103,16 @@ public:
   Bool_t AlwaysFalse(const AliVParticle& /*particle*/, const AliVParticle& /*particle*/) const { return kFALSE; }
   void NameOfAlwaysFalse(TString& name) const { name = "NONE"; }
 
-  void SetHistogramCollection(AliMergeableCollection* h) { fHistogramCollection = h; }
+  void SetHistogramCollection(AliMergeableCollection* h) { fHistogramCollection = h; ResetSlots(); }
+
+  /** Set the index of the combination (eventSelection/triggerClassName/centrality/cut)
+   * the next FillHistosForXXX calls are for. Set by the steering task, -1 if unknown.
+   */
+  void SetSlot(Int_t slot) { fSlot = slot; }
+
+  Int_t Slot() const { return fSlot; }
+
+  void ResetSlots();
 
 protected:
 
@@ -194,6 +205,14 @@ protected:
 
   Int_t GetNbins(Double_t xmin, Double_t xmax, Double_t xstep);
 
+  Int_t SlotKey(const char* hname);
+
+  const char* SlotKeyName(Int_t key) const;
+
+  TObject* SlotObject(Int_t key,
+                      const char* eventSelection, const char* triggerClassName, const char* centrality,
+                      const char* cut="", Bool_t mc=kFALSE);
+
   AliCounterCollection* CounterCollection() const { return fEventCounters; }
   AliMergeableCollection* HistogramCollection() const { return fHistogramCollection; }
   const AliAnalysisMuMuBinning* Binning() const { return fBinning; }
@@ -214,8 +233,12 @@ private:
   AliMCEvent* fMCEvent; //! current MC event
   TList* fHistogramToDisable; // list of regexp of histo name to disable
   Bool_t fHasMC; // whether or not we're dealing with MC data
+  Int_t fSlot; //! index of the current combination (see SetSlot)
+  TObjArray* fSlotKeys; //! histogram names used with SlotObject, index = key
+  std::vector<std::vector<TObject*> > fSlotObjects; //! objects per (slot,mc) and key
+  std::vector<std::vector<Bool_t> > fSlotResolved; //! whether the object above has been looked up
 
-  ClassDef(AliAnalysisMuMuBase,1) // base class for a companion class to AliAnalysisMuMu
+  ClassDef(AliAnalysisMuMuBase,2) // base class for a companion class to AliAnalysisMuMu
 };
 
 #endif
@@ -49,7 +49,13 @@ fmcptcutmax(12.0),
 fPtFuncOld(0x0),
 fPtFuncNew(0x0),
 fYFuncOld(0x0),
-fYFuncNew(0x0)
+fYFuncNew(0x0),
+fSlotKeysDone(kFALSE),
+fKeyPtPaireVsPtTrack(-1),
+fKeyPtRecVsSim(-1),
+fKeyNchForJpsi(-1),
+fKeyNchForPsiP(-1),
+fKeyMinv()
 {
   // FIXME ? find the AccxEff histogram from HistogramCollection()->Histo("/EXCHANGE/JpsiAccEff")
 
@@ -312,6 +318,54 @@ void AliAnalysisMuMuMinv::DefineMinvRange(Double_t minvMin, Double_t minvMax, Do
   fMinvBinSize = minvBinSize;
 }
 
+//_____________________________________________________________________________
+void AliAnalysisMuMuMinv::CreateSlotKeys()
+{
+  /// Get the keys (see AliAnalysisMuMuBase::SlotKey) of all the histograms filled for a pair,
+  /// so that their names are not built again for each pair
+
+  const char* dist[3]   = { "Pt", "Y", "Eta" };
+  const char* mix[2]    = { "", "Mix" };
+  const char* charge[3] = { "", "PP", "MM" };
+  const Double_t pairCharge[3] = { 0, 2, -2 };
+
+  for ( Int_t iq = 0; iq < 3; ++iq ){
+    fDistDisabled[iq] = IsHistogramDisabled(dist[iq]);
+    for ( Int_t im = 0; im < 2; ++im ){
+      for ( Int_t ic = 0; ic < 3; ++ic ) fKeyDist[iq][im][ic] = SlotKey(Form("%s%s%s",dist[iq],mix[im],charge[ic]));
+    }
+  }
+  fDistDisabled[3] = IsHistogramDisabled("PtPaireVsPtTrack");
+
+  fKeyPtPaireVsPtTrack = SlotKey("PtPaireVsPtTrack");
+  fKeyPtRecVsSim       = SlotKey("PtRecVsSim");
+  fKeyNchForJpsi       = SlotKey("NchForJpsi");
+  fKeyNchForPsiP       = SlotKey("NchForPsiP");
+
+  fKeyMinv.clear();
+
+  TIter nextBin(fBinsToFill);
+  AliAnalysisMuMuBinning::Range* r;
+
+  while ( ( r = static_cast<AliAnalysisMuMuBinning::Range*>(nextBin()) ) ){
+    for ( Int_t ia = 0; ia < 2; ++ia ){
+      for ( Int_t ic = 0; ic < 3; ++ic ){
+        for ( Int_t im = 0; im < 2; ++im ){
+
+          TString minvName = GetMinvHistoName(*r,ia==1,pairCharge[ic],im==1);
+          Bool_t disabled  = IsHistogramDisabled(minvName.Data());
+
+          fKeyMinv.push_back( disabled ? -1 : SlotKey(minvName.Data()) );
+          fKeyMinv.push_back( disabled ? -1 : SlotKey(Form("MeanPtVs%s",minvName.Data())) );
+          fKeyMinv.push_back( disabled ? -1 : SlotKey(Form("MeanPtSquareVs%s",minvName.Data())) );
+        }
+      }
+    }
+  }
+
+  fSlotKeysDone = kTRUE;
+}
+
 //_____________________________________________________________________________
 void AliAnalysisMuMuMinv::FillHistosForPair(const char* eventSelection,
                                             const char* triggerClassName,
@@ -324,15 +378,19 @@ void AliAnalysisMuMuMinv::FillHistosForPair(const char* eventSelection,
   /// Fill histograms for unlike-sign reconstructed  muon pairs.
   /// For the MC case, we check that only tracks with an associated MC label are selected (usefull when running on embedding).
   /// A weight is also applied for MC case at the pair or the muon track level according to SetMuonWeight() and systLevel.
+  /// Histograms are accessed through their slot keys (see CreateSlotKeys), their path is only
+  /// built the first time a combination is filled.
 
   // Usual cuts
   if (!AliAnalysisMuonUtility::IsMuonTrack(&tracki) || !AliAnalysisMuonUtility::IsMuonTrack(&trackj) ) return;
 
-  // Get total charge in order to get the correct histo name
+  if ( !fSlotKeysDone ) CreateSlotKeys();
+
+  // Get total charge in order to get the correct histo index (0 for +-, 1 for ++ and 2 for --)
   Double_t PairCharge = tracki.Charge() + trackj.Charge();
-  TString scharge  = "";
-  if( PairCharge == +2 )      scharge = "PP";
-  else if( PairCharge == -2 ) scharge = "MM";
+  Int_t icharge = 0;
+  if( PairCharge == +2 )      icharge = 1;
+  else if( PairCharge == -2 ) icharge = 2;
 
   // Pointers in case running on MC
   Int_t labeli               = 0;
@@ -342,12 +400,7 @@ void AliAnalysisMuMuMinv::FillHistosForPair(const char* eventSelection,
   TLorentzVector             * pair4MomentumMC(0x0);
   Double_t inputWeightMC(1.);
 
-  // Usefull string :)
-  TString smix = IsMixedHisto ? "Mix" : "";
-
-  // Create proxy in AliMergeableCollection
-  AliMergeableCollectionProxy* proxy = HistogramCollection()->CreateProxy(BuildPath(eventSelection,triggerClassName,centrality,pairCutName));
-  AliMergeableCollectionProxy* mcProxy(0x0); // to be set later maybe
+  Int_t imix = IsMixedHisto ? 1 : 0;
 
   // Construct dimuons vector
   TLorentzVector pi(tracki.Px(),tracki.Py(),tracki.Pz(),
@@ -373,47 +426,23 @@ void AliAnalysisMuMuMinv::FillHistosForPair(const char* eventSelection,
     // Check if first track is a muon
     mcTracki = MCEvent()->GetTrack(labeli);
     if(!mcTracki) return;
-    if ( TMath::Abs(mcTracki->PdgCode()) != 13 ) {
-      delete proxy;
-      delete mcProxy;
-      return;
-    }
+    if ( TMath::Abs(mcTracki->PdgCode()) != 13 ) return;
 
     // Check if second track is a muon
     mcTrackj = MCEvent()->GetTrack(labelj);
     if(!mcTrackj) return;
-    if ( TMath::Abs(mcTrackj->PdgCode()) != 13 ) {
-      delete proxy;
-      delete mcProxy;
-      return;
-    }
+    if ( TMath::Abs(mcTrackj->PdgCode()) != 13 ) return;
 
     // Check if tracks has the same mother
     Int_t currMotheri = mcTracki->GetMother();
     Int_t currMotherj = mcTrackj->GetMother();
-    if( currMotheri!=currMotherj ) {
-      delete proxy;
-      delete mcProxy;
-      return;
-    }
-    if( currMotheri<0 ) {
-      delete proxy;
-      delete mcProxy;
-      return;
-    }
+    if( currMotheri!=currMotherj ) return;
+    if( currMotheri<0 ) return;
 
     // Check if mother is J/psi
     AliMCParticle* mother = static_cast<AliMCParticle*>(MCEvent()->GetTrack(currMotheri));
-    if(!mother){
-      delete proxy;
-      delete mcProxy;
-      return;
-    }
-    if(mother->PdgCode() !=443) {
-      delete proxy;
-      delete mcProxy;
-      return;
-    }
+    if(!mother) return;
+    if(mother->PdgCode() !=443) return;
 
     // Weight tracks if specified
     if(!fWeightMuon)      inputWeightMC = WeightPairDistribution(mother->Pt(),mother->Y());
@@ -423,16 +452,8 @@ void AliAnalysisMuMuMinv::FillHistosForPair(const char* eventSelection,
 
     if(!mcTracki || !mcTrackj){
       AliError("Miss one or several MC track");
-      delete proxy;
-      delete mcProxy;
       return;
     }
-
-    // Create proxy for MC
-    mcProxy = HistogramCollection()->CreateProxy(BuildMCPath(eventSelection,triggerClassName,centrality,pairCutName));
-    TLorentzVector mcpi(mcTracki->Px(),mcTracki->Py(),mcTracki->Pz(),TMath::Sqrt(AliAnalysisMuonUtility::MuonMass2()+mcTracki->P()*mcTracki->P()));
-    TLorentzVector mcpj(mcTrackj->Px(),mcTrackj->Py(),mcTrackj->Pz(),TMath::Sqrt(AliAnalysisMuonUtility::MuonMass2()+mcTrackj->P()*mcTrackj->P()));
-    mcpj+=mcpi;
   }
 
   // Weight tracks if specified
@@ -441,25 +462,26 @@ void AliAnalysisMuMuMinv::FillHistosForPair(const char* eventSelection,
   else if(fWeightMuon)  inputWeight = WeightMuonDistribution(tracki.Pt()) * WeightMuonDistribution(trackj.Pt());
 
   // Fill some distribution histos
-  if ( !IsHistogramDisabled("Pt")  ) {
+  if ( !fDistDisabled[0] ) {
     Double_t x[2] = {pair4Momentum.Pt(),pair4Momentum.M()};
-    if(proxy->GetObject(Form("Pt%s%s",smix.Data(),scharge.Data())))
-      static_cast<THnSparse*>(proxy->GetObject(Form("Pt%s%s",smix.Data(),scharge.Data())))->Fill(x,inputWeight);
+    THnSparse* h = static_cast<THnSparse*>(SlotObject(fKeyDist[0][imix][icharge],eventSelection,triggerClassName,centrality,pairCutName));
+    if(h) h->Fill(x,inputWeight);
   }
-  if ( !IsHistogramDisabled("Y")   ){
+  if ( !fDistDisabled[1] ){
     Double_t x[2] = {pair4Momentum.Rapidity(),pair4Momentum.M()};
-    if(proxy->GetObject(Form("Y%s%s",smix.Data(),scharge.Data())))
-      static_cast<THnSparse*>(proxy->GetObject(Form("Y%s%s",smix.Data(),scharge.Data())))->Fill(x,inputWeight);
+    THnSparse* h = static_cast<THnSparse*>(SlotObject(fKeyDist[1][imix][icharge],eventSelection,triggerClassName,centrality,pairCutName));
+    if(h) h->Fill(x,inputWeight);
   }
-  if ( !IsHistogramDisabled("Eta") ){
+  if ( !fDistDisabled[2] ){
     Double_t x[2] = {pair4Momentum.Eta(),pair4Momentum.M()};
-    if(proxy->GetObject(Form("Eta%s%s",smix.Data(),scharge.Data())))
-      static_cast<THnSparse*>(proxy->GetObject(Form("Eta%s%s",smix.Data(),scharge.Data())))->Fill(x,inputWeight);
+    THnSparse* h = static_cast<THnSparse*>(SlotObject(fKeyDist[2][imix][icharge],eventSelection,triggerClassName,centrality,pairCutName));
+    if(h) h->Fill(x,inputWeight);
   }
 
-  if ( !IsHistogramDisabled("PtPaireVsPtTrack") && !IsMixedHisto &&  static_cast<int>(PairCharge) == 0) {
-    static_cast<TH2*>( proxy->Histo("PtPaireVsPtTrack"))->Fill(pair4Momentum.Pt(),tracki.Pt(),inputWeight);
-    static_cast<TH2*>( proxy->Histo("PtPaireVsPtTrack"))->Fill(pair4Momentum.Pt(),trackj.Pt(),inputWeight);
+  if ( !fDistDisabled[3] && !IsMixedHisto &&  static_cast<int>(PairCharge) == 0) {
+    TH2* h = static_cast<TH2*>(dynamic_cast<TH1*>(SlotObject(fKeyPtPaireVsPtTrack,eventSelection,triggerClassName,centrality,pairCutName)));
+    h->Fill(pair4Momentum.Pt(),tracki.Pt(),inputWeight);
+    h->Fill(pair4Momentum.Pt(),trackj.Pt(),inputWeight);
   }
 
   // Fill histos with MC stack info (only opposite charge muons)
@@ -470,20 +492,27 @@ void AliAnalysisMuMuMinv::FillHistosForPair(const char* eventSelection,
     TLorentzVector mcpj(mcTrackj->Px(),mcTrackj->Py(),mcTrackj->Pz(),TMath::Sqrt(AliAnalysisMuonUtility::MuonMass2()+mcTrackj->P()*mcTrackj->P()));
     mcpj+=mcpi;
 
-
     // Fill histo
-    if ( proxy->Histo("PtRecVsSim") )  proxy->Histo("PtRecVsSim")->Fill(mcpj.Pt(),pair4Momentum.Pt());
-    if ( mcProxy->Histo("Pt"))  mcProxy->Histo("Pt")->Fill(mcpj.Pt(),inputWeightMC);
-    if ( mcProxy->Histo("Y"))   mcProxy->Histo("Y")->Fill(mcpj.Rapidity(),inputWeightMC);
-    if ( mcProxy->Histo("Eta")) mcProxy->Histo("Eta")->Fill(mcpj.Eta());
+    TH1* h = dynamic_cast<TH1*>(SlotObject(fKeyPtRecVsSim,eventSelection,triggerClassName,centrality,pairCutName));
+    if ( h ) h->Fill(mcpj.Pt(),pair4Momentum.Pt());
+    h = dynamic_cast<TH1*>(SlotObject(fKeyDist[0][0][0],eventSelection,triggerClassName,centrality,pairCutName,kTRUE));
+    if ( h ) h->Fill(mcpj.Pt(),inputWeightMC);
+    h = dynamic_cast<TH1*>(SlotObject(fKeyDist[1][0][0],eventSelection,triggerClassName,centrality,pairCutName,kTRUE));
+    if ( h ) h->Fill(mcpj.Rapidity(),inputWeightMC);
+    h = dynamic_cast<TH1*>(SlotObject(fKeyDist[2][0][0],eventSelection,triggerClassName,centrality,pairCutName,kTRUE));
+    if ( h ) h->Fill(mcpj.Eta());
 
     // set pair4MomentumMC for the rest of the function
     pair4MomentumMC = &mcpj;
   }
 
+  TH1* hNchForJpsi = dynamic_cast<TH1*>(SlotObject(fKeyNchForJpsi,eventSelection,triggerClassName,centrality,pairCutName));
+  TH1* hNchForPsiP = dynamic_cast<TH1*>(SlotObject(fKeyNchForPsiP,eventSelection,triggerClassName,centrality,pairCutName));
+
   TIter nextBin(fBinsToFill);
   nextBin.Reset();
   AliAnalysisMuMuBinning::Range* r;
+  Int_t ib(0);
 
   // Loop over all bin ranges
   while ( ( r = static_cast<AliAnalysisMuMuBinning::Range*>(nextBin()) ) ){
@@ -494,19 +523,18 @@ void AliAnalysisMuMuMinv::FillHistosForPair(const char* eventSelection,
     Bool_t ok(kFALSE);
     Bool_t okMC(kFALSE);
 
-    ok = CheckBinRangeCut(r,&pair4Momentum,proxy);
-    if( pair4MomentumMC ) okMC = CheckBinRangeCut(r,pair4MomentumMC,proxy);
+    ok = CheckBinRangeCut(r,&pair4Momentum,hNchForJpsi,hNchForPsiP);
+    if( pair4MomentumMC ) okMC = CheckBinRangeCut(r,pair4MomentumMC,hNchForJpsi,hNchForPsiP);
+
+    // Index of the minv histo associated to the bin, without and with acc x eff correction
+    Int_t minvIndex    = ((ib*2+0)*3+icharge)*2+imix;
+    Int_t minvIndexAcc = ((ib*2+1)*3+icharge)*2+imix;
+    ++ib;
 
     // Check if pair pass all conditions, either MC or not, and fill Minv Histogrames
     if ( ok )
     {
-      // Get Minv histo name associated to the bin
-      TString minvName       = GetMinvHistoName(*r,kFALSE,PairCharge,IsMixedHisto);
-      TString hprofName      = Form("MeanPtVs%s",minvName.Data());
-      TString hprofNameSquare= Form("MeanPtSquareVs%s",minvName.Data());
-      TProfile* hprof        = Prof(eventSelection,triggerClassName,centrality,pairCutName,hprofName.Data());
-      TProfile* hprofsquare  = Prof(eventSelection,triggerClassName,centrality,pairCutName,hprofNameSquare.Data());
-      FillMinvHisto(&minvName,hprof,hprofsquare,proxy,&pair4Momentum,inputWeight);
+      FillMinvHisto(minvIndex,eventSelection,triggerClassName,centrality,pairCutName,kFALSE,&pair4Momentum,inputWeight);
 
       // Create, fill and store Minv histo already corrected with accxeff
       if ( ShouldCorrectDimuonForAccEff() )
@@ -519,23 +547,13 @@ void AliAnalysisMuMuMinv::FillHistosForPair(const char* eventSelection,
         if ( AccxEff <= 0.0 ) AliError(Form("AccxEff < 0 for pt = %f & y = %f ",pair4Momentum.Pt(),pair4Momentum.Rapidity()));
         else okAccEff = kTRUE;
 
-        minvName        = GetMinvHistoName(*r,kTRUE,PairCharge,IsMixedHisto);
-        hprofName       = Form("MeanPtVs%s",minvName.Data());
-        hprofNameSquare = Form("MeanPtSquareVs%s",minvName.Data());
-        hprof           = Prof(eventSelection,triggerClassName,centrality,pairCutName,hprofName.Data());
-        hprofsquare     = Prof(eventSelection,triggerClassName,centrality,pairCutName,hprofNameSquare.Data());
-        if( okAccEff ) FillMinvHisto(&minvName,hprof,hprofsquare,proxy,&pair4Momentum,inputWeight/AccxEff);
+        if( okAccEff ) FillMinvHisto(minvIndexAcc,eventSelection,triggerClassName,centrality,pairCutName,kFALSE,&pair4Momentum,inputWeight/AccxEff);
       }
     }
 
     if ( okMC ) {
 
-      TString minvName       = GetMinvHistoName(*r,kFALSE,PairCharge,IsMixedHisto);
-      TString hprofName      = Form("MeanPtVs%s",minvName.Data());
-      TString hprofNameSquare= Form("MeanPtSquareVs%s",minvName.Data());
-      TProfile* hprof        = MCProf(eventSelection,triggerClassName,centrality,pairCutName,hprofName.Data());
-      TProfile* hprofsquare  = MCProf(eventSelection,triggerClassName,centrality,pairCutName,hprofNameSquare.Data());
-      FillMinvHisto(&minvName,hprof,hprofsquare,mcProxy,&pair4Momentum,inputWeight);
+      FillMinvHisto(minvIndex,eventSelection,triggerClassName,centrality,pairCutName,kTRUE,&pair4Momentum,inputWeight);
 
       // Create, fill and store Minv histo already corrected with accxeff
       if ( ShouldCorrectDimuonForAccEff() ){
@@ -548,21 +566,13 @@ void AliAnalysisMuMuMinv::FillHistosForPair(const char* eventSelection,
         if ( AccxEff <= 0.0 ) AliError(Form("AccxEff < 0 for pt = %f & y = %f ",pair4MomentumMC->Pt(),pair4MomentumMC->Rapidity()));
         else okAccEff = kTRUE;
 
-        minvName        = GetMinvHistoName(*r,kTRUE,PairCharge,IsMixedHisto);
-        hprofName       = Form("MeanPtVs%s",minvName.Data());
-        hprofNameSquare = Form("MeanPtSquareVs%s",minvName.Data());
-        hprof           = MCProf(eventSelection,triggerClassName,centrality,pairCutName,hprofName.Data());
-        hprofsquare     = MCProf(eventSelection,triggerClassName,centrality,pairCutName,hprofNameSquare.Data());
-        if( okAccEff ) FillMinvHisto(&minvName,hprof,hprofsquare,mcProxy,&pair4Momentum,inputWeight/AccxEff);
+        if( okAccEff ) FillMinvHisto(minvIndexAcc,eventSelection,triggerClassName,centrality,pairCutName,kTRUE,&pair4Momentum,inputWeight/AccxEff);
 
       }
     }
   }
-  delete proxy;
-  delete mcProxy;
 }
 
-
 //_____________________________________________________________________________
 void AliAnalysisMuMuMinv::FillHistosForMCEvent(const char* eventSelection,const char* triggerClassName,const char* centrality)
 {
@@ -687,23 +697,29 @@ void AliAnalysisMuMuMinv::FillHistosForMCEvent(const char* eventSelection,const
 }
 
 //_____________________________________________________________________________
-void AliAnalysisMuMuMinv::FillMinvHisto(TString* minvName,TProfile* hprof,TProfile* hprof2,AliMergeableCollectionProxy* proxy, TLorentzVector* pair4Momentum, Double_t inputWeight)
+void AliAnalysisMuMuMinv::FillMinvHisto(Int_t minvIndex,
+                                        const char* eventSelection, const char* triggerClassName, const char* centrality, const char* pairCutName,
+                                        Bool_t mc, TLorentzVector* pair4Momentum, Double_t inputWeight)
 {
-  /// Create, fill and store Minv histo
-  if (!IsHistogramDisabled(minvName->Data())){
+  /// Fill Minv histo (and mean pt profiles) number minvIndex (see CreateSlotKeys)
+  /// of the (MC) path of the pair cut
 
-    TH1* h(0x0);
+  const Int_t* keys = &fKeyMinv[3*minvIndex];
 
-    h = proxy->Histo(minvName->Data());
-    if (h) h->Fill(pair4Momentum->M(),inputWeight);
+  // disabled histogram
+  if ( keys[0] < 0 ) return;
 
-    // Fill Mean pT
-    if ( fComputeMeanPt ){
-      if ( !hprof ) AliError(Form("Could not get hprofile for %s",minvName->Data()));
-      else hprof->Fill(pair4Momentum->M(),pair4Momentum->Pt(),inputWeight);
-      if ( !hprof2 ) AliError(Form("Could not get hprofile for %s",minvName->Data()));
-      else hprof2->Fill(pair4Momentum->M(),pair4Momentum->Pt()*pair4Momentum->Pt(),inputWeight);
-    }
+  TH1* h = dynamic_cast<TH1*>(SlotObject(keys[0],eventSelection,triggerClassName,centrality,pairCutName,mc));
+  if (h) h->Fill(pair4Momentum->M(),inputWeight);
+
+  // Fill Mean pT
+  if ( fComputeMeanPt ){
+    TProfile* hprof  = static_cast<TProfile*>(SlotObject(keys[1],eventSelection,triggerClassName,centrality,pairCutName,mc));
+    TProfile* hprof2 = static_cast<TProfile*>(SlotObject(keys[2],eventSelection,triggerClassName,centrality,pairCutName,mc));
+    if ( !hprof ) AliError(Form("Could not get hprofile for %s",SlotKeyName(keys[0])));
+    else hprof->Fill(pair4Momentum->M(),pair4Momentum->Pt(),inputWeight);
+    if ( !hprof2 ) AliError(Form("Could not get hprofile for %s",SlotKeyName(keys[0])));
+    else hprof2->Fill(pair4Momentum->M(),pair4Momentum->Pt()*pair4Momentum->Pt(),inputWeight);
   }
 }
 
@@ -818,7 +834,7 @@ Bool_t AliAnalysisMuMuMinv::IsPtInRange(const AliVParticle& t1, const AliVPartic
 }
 
 //_____________________________________________________________________________
-Bool_t AliAnalysisMuMuMinv::CheckBinRangeCut(AliAnalysisMuMuBinning::Range* r, TLorentzVector* pair4Momentum, AliMergeableCollectionProxy* proxy)
+Bool_t AliAnalysisMuMuMinv::CheckBinRangeCut(AliAnalysisMuMuBinning::Range* r, TLorentzVector* pair4Momentum, TH1* hNchForJpsi, TH1* hNchForPsiP)
 {
   /// Check if our pairs match conditions from the binning range
 
@@ -835,7 +851,7 @@ Bool_t AliAnalysisMuMuMinv::CheckBinRangeCut(AliAnalysisMuMuBinning::Range* r, T
     // Fill NchForJpsi histo according to pair4Momentum.M()
     if ( pair4Momentum->M() >= 2.9 && pair4Momentum->M() <= 3.3 ){
 
-      h = proxy->Histo("NchForJpsi");
+      h = hNchForJpsi;
 
       Double_t ntrcorr = (-1.);
       TList* list = static_cast<TList*>(Event()->FindListObject("NCH"));
@@ -859,7 +875,7 @@ Bool_t AliAnalysisMuMuMinv::CheckBinRangeCut(AliAnalysisMuMuBinning::Range* r, T
     }
     else if ( pair4Momentum->M() >= 3.6 && pair4Momentum->M() <= 3.9){
 
-      h = proxy->Histo("NchForPsiP");
+      h = hNchForPsiP;
       Double_t ntrcorr = (-1.);
 
       TList* list = static_cast<TList*>(Event()->FindListObject("NCH"));
@@ -1110,6 +1126,7 @@ void AliAnalysisMuMuMinv::SetBinsToFill(const char* particle, const char* bins)
 {
   delete fBinsToFill;
   fBinsToFill = Binning()->CreateBinObjArray(particle,bins,"");
+  fSlotKeysDone = kFALSE;
 }
 
 //________________________________________________________________________
@@ -72,7 +72,9 @@ protected:
 
   void FillHistosForMCEvent(const char* eventSelection,const char* triggerClassName,const char* centrality);
 
-  void FillMinvHisto(TString* minvName,TProfile* hprof,TProfile* hprof2,AliMergeableCollectionProxy* proxy, TLorentzVector* pair4Momentum, Double_t inputWeight);
+  void FillMinvHisto(Int_t minvIndex,
+                     const char* eventSelection, const char* triggerClassName, const char* centrality, const char* pairCutName,
+                     Bool_t mc, TLorentzVector* pair4Momentum, Double_t inputWeight);
 
 private:
 
@@ -91,7 +93,9 @@ private:
 
   Double_t TriggerLptApt(Double_t *x, Double_t *par);
 
-  Bool_t  CheckBinRangeCut(AliAnalysisMuMuBinning::Range* r, TLorentzVector* pair4Momentum, AliMergeableCollectionProxy* proxy);
+  Bool_t  CheckBinRangeCut(AliAnalysisMuMuBinning::Range* r, TLorentzVector* pair4Momentum, TH1* hNchForJpsi, TH1* hNchForPsiP);
+
+  void CreateSlotKeys();
 
   Bool_t CheckMCTracksMatchingStackAndMother(Int_t labeli, Int_t labelj, AliVParticle* mcTracki, AliVParticle* mcTrackj, Double_t inputWeightMC);
 
@@ -111,8 +115,16 @@ private:
   Double_t fMinvMax;
   Double_t fmcptcutmin;
   Double_t fmcptcutmax;
-
-  ClassDef(AliAnalysisMuMuMinv,8) // implementation of AliAnalysisMuMuBase for muon pairs
+  Bool_t fSlotKeysDone; //! whether the keys below are set
+  Int_t fKeyDist[3][2][3]; //! keys of the Pt, Y and Eta distributions, per mix and pair charge (0, ++, --)
+  Bool_t fDistDisabled[4]; //! whether the Pt, Y, Eta and PtPaireVsPtTrack histograms are disabled
+  Int_t fKeyPtPaireVsPtTrack; //! key of the PtPaireVsPtTrack histogram
+  Int_t fKeyPtRecVsSim; //! key of the PtRecVsSim histogram
+  Int_t fKeyNchForJpsi; //! key of the NchForJpsi histogram
+  Int_t fKeyNchForPsiP; //! key of the NchForPsiP histogram
+  std::vector<Int_t> fKeyMinv; //! keys of minv histo, mean pt and mean pt square profiles per bin, acceff correction, pair charge and mix (-1 if disabled)
+
+  ClassDef(AliAnalysisMuMuMinv,9) // implementation of AliAnalysisMuMuBase for muon pairs
 };
 
 #endif
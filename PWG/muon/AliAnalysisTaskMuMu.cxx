@@ -90,7 +90,12 @@ fDisableHistoLoop(kFALSE),
 fLegacyCentrality(kFALSE),
 fPool(0x0),
 fMaxPoolSize(0),
-fMix(kFALSE)
+fMix(kFALSE),
+fCentralities(0x0),
+fSlotTriggers(0x0),
+fNofSlotEventSelections(0),
+fNofSlotTrackCuts(0),
+fNofSlotCuts(1)
 {
   /// Constructor with a predefined list of triggers to consider
   /// Note that we take ownership of cutRegister
@@ -129,6 +134,10 @@ AliAnalysisTaskMuMu::~AliAnalysisTaskMuMu()
 
   if (fPool) delete fPool;
 
+  delete fCentralities;
+
+  delete fSlotTriggers;
+
   delete fHistogramToDisable;
 
   delete fCutRegistry;
@@ -281,9 +290,10 @@ void AliAnalysisTaskMuMu::CreateCentralityPools( const char* poolName ) const
 }
 
 //_____________________________________________________________________________
-void AliAnalysisTaskMuMu::Fill(const char* eventSelection, const char* triggerClassName)
+void AliAnalysisTaskMuMu::Fill(const char* eventSelection, const char* triggerClassName, Int_t slot)
 {
   /// Fill one set of histograms (only called for events which pass the eventSelection cut) for a given trigger/event .
+  /// slot is the index of (eventSelection,triggerClassName) in the slot numbering (see ResolveSlots)
 
   TString seventSelection(eventSelection);
   seventSelection.ToLower();
@@ -291,14 +301,15 @@ void AliAnalysisTaskMuMu::Fill(const char* eventSelection, const char* triggerCl
   // Fill counter collections (only for UserExec() )
   FillCounters(seventSelection.Data(), triggerClassName, "ALL", fCurrentRunNumber);
 
-  TObjArray* centralities = fBinning->CreateBinObjArray("centrality");
-
-  TIter next(centralities);
+  TIter next(fCentralities);
   AliAnalysisMuMuBinning::Range* r;
+  Int_t icent(-1);
 
   next.Reset();
   while ( ( r = static_cast<AliAnalysisMuMuBinning::Range*>(next()) ) ){
 
+    ++icent;
+
     Float_t fcent     = -42.0;
     TString estimator = r->Quantity();
     if(estimator.Contains("V0MPLUS05")) estimator ="V0Mplus05";
@@ -316,14 +327,13 @@ void AliAnalysisTaskMuMu::Fill(const char* eventSelection, const char* triggerCl
     if ( isPP || r->IsInRange(fcent) ){
       if ( !isPP  && !r->IsInRange(fcent) ) continue;
 
-      FillHistos(eventSelection,triggerClassName,r->AsString(),fcent);
+      FillHistos(eventSelection,triggerClassName,r->AsString(),fcent,slot+icent);
 
       // FIXME: this filling of global centrality histo is misplaced somehow...
       TH1* hcent = fHistogramCollection->Histo(Form("/%s/%s/V0M/Centrality",eventSelection,triggerClassName));
       if (hcent) hcent->Fill(fcent);
     }
   }
-  delete centralities;
 }
 
 //_____________________________________________________________________________
@@ -334,9 +344,7 @@ void AliAnalysisTaskMuMu::FillPools(const char* eventSelection, const char* trig
   TString seventSelection(eventSelection);
   seventSelection.ToLower();
 
-  TObjArray* centralities = fBinning->CreateBinObjArray("centrality");
-
-  TIter next(centralities);
+  TIter next(fCentralities);
   AliAnalysisMuMuBinning::Range* r;
 
   next.Reset();
@@ -360,16 +368,18 @@ void AliAnalysisTaskMuMu::FillPools(const char* eventSelection, const char* trig
       FillPoolsWithTracks(eventSelection,triggerClassName,fcent);
     }
   }
-  delete centralities;
 }
 
 //_____________________________________________________________________________
 void AliAnalysisTaskMuMu::FillHistos(const char* eventSelection,
                                      const char* triggerClassName,
                                      const char* centrality,
-                                     Float_t cent)
+                                     Float_t cent,
+                                     Int_t slot)
 {
   /// Fill histograms
+  /// slot is the index of (eventSelection,triggerClassName,centrality), from which the sub-analysis
+  /// get the index of each combination with the track and pair cuts (see ResolveSlots)
 
   // Fill counter collections (only for UserExec() )
   FillCounters( eventSelection, triggerClassName, centrality, fCurrentRunNumber);
@@ -386,6 +396,11 @@ void AliAnalysisTaskMuMu::FillHistos(const char* eventSelection,
   // Get number of tracks
   Int_t nTracks   = AliAnalysisMuonUtility::GetNTracks(Event());
 
+  // Slots of the event, of the first track cut and of the first pair cut combinations
+  Int_t eventSlot = slot*fNofSlotCuts;
+  Int_t trackSlot = eventSlot + 1;
+  Int_t pairSlot  = trackSlot + fNofSlotTrackCuts;
+
   // The main part, loop over subanalysis and fill histo
   if ( !IsHistogrammingDisabled() && !fDisableHistoLoop ){
 
@@ -395,6 +410,8 @@ void AliAnalysisTaskMuMu::FillHistos(const char* eventSelection,
       // Create proxy for the Histogram collections
       analysis->DefineHistogramCollection(eventSelection,triggerClassName,centrality,fMix);
 
+      analysis->SetSlot(eventSlot);
+
       if ( MCEvent() != 0x0 )
       {
         AliCodeTimerAuto(Form("%s (FillHistosForMCEvent)",analysis->ClassName()),1);
@@ -413,6 +430,7 @@ void AliAnalysisTaskMuMu::FillHistos(const char* eventSelection,
 
         nextTrackCut.Reset();
         AliAnalysisMuMuCutCombination* trackCut;
+        Int_t itrackCut(0);
 
         // Loop on all track selections and fill histos for track that pass it
         while ( ( trackCut = static_cast<AliAnalysisMuMuCutCombination*>(nextTrackCut()) ) )
@@ -420,8 +438,10 @@ void AliAnalysisTaskMuMu::FillHistos(const char* eventSelection,
           if ( trackCut->Pass(*tracki) )
           {
             AliCodeTimerAuto(Form("%s (FillHistosForTrack)",analysis->ClassName()),2);
+            analysis->SetSlot(trackSlot+itrackCut);
             analysis->FillHistosForTrack(eventSelection,triggerClassName,centrality,trackCut->GetName(),*tracki);
           }
+          ++itrackCut;
         }
 
         // --- loop on muon track pairs (no mix) ---
@@ -435,6 +455,7 @@ void AliAnalysisTaskMuMu::FillHistos(const char* eventSelection,
 
           nextPairCut.Reset();
           AliAnalysisMuMuCutCombination* pairCut;
+          Int_t ipairCut(0);
 
           // Fill pair histo
           while ( ( pairCut = static_cast<AliAnalysisMuMuCutCombination*>(nextPairCut()) ) )
@@ -447,8 +468,10 @@ void AliAnalysisTaskMuMu::FillHistos(const char* eventSelection,
             if ( ( testi && testj ) && testij )
             {
               AliCodeTimerAuto(Form("%s (FillHistosForPair)",analysis->ClassName()),3);
+              analysis->SetSlot(pairSlot+ipairCut);
               analysis->FillHistosForPair(eventSelection,triggerClassName,centrality,pairCut->GetName(),*tracki,*trackj,kFALSE);
             }
+            ++ipairCut;
           }
         }
 
@@ -461,10 +484,14 @@ void AliAnalysisTaskMuMu::FillHistos(const char* eventSelection,
         nextTrackCut.Reset();
 
         AliAnalysisMuMuCutCombination* pairCut;
+        Int_t ipairCut(0);
 
         // Loop over pair cut
         while ( ( pairCut = static_cast<AliAnalysisMuMuCutCombination*>(nextPairCut()) ) )
         {
+          analysis->SetSlot(pairSlot+ipairCut);
+          ++ipairCut;
+
           // Loop over single track cut from mixing configuration
           while ( ( trackCut = static_cast<AliAnalysisMuMuCutCombination*>(nextTrackCut()) ) )
           {
@@ -487,6 +514,8 @@ void AliAnalysisTaskMuMu::FillHistos(const char* eventSelection,
           }
         }
       }
+
+      analysis->SetSlot(-1);
     }
   }
 }
@@ -590,6 +619,13 @@ void AliAnalysisTaskMuMu::FillCounters(const char* eventSelection, const char* t
 void AliAnalysisTaskMuMu::FinishTaskOutput()
 {
   /// prune empty histograms BEFORE mergin, in order to save some bytes...
+
+  // the sub-analysis must forget the histograms they found, as they might be pruned
+  TIter next(fSubAnalysisVector);
+  AliAnalysisMuMuBase* analysis;
+
+  while ( ( analysis = static_cast<AliAnalysisMuMuBase*>(next()) ) ) analysis->ResetSlots();
+
   if ( fHistogramCollection ) fHistogramCollection->PruneEmptyObjects();
 }
 
@@ -602,8 +638,7 @@ TList*  AliAnalysisTaskMuMu::FindPool( Float_t cent, const char* poolName ) cons
 
   if(!fPool->FindObject(poolName)) return 0x0;
 
-  TObjArray* centralities = fBinning->CreateBinObjArray("centrality");
-  TIter next(centralities);
+  TIter next(fCentralities);
   AliAnalysisMuMuBinning::Range* r;
 
   next.Reset();
@@ -805,6 +840,51 @@ void AliAnalysisTaskMuMu::PrintPools() const
   }
 }
 
+//_____________________________________________________________________________
+void AliAnalysisTaskMuMu::ResolveSlots()
+{
+  /// Resolve, at the first event, the combination space of the histogram filling into integer slots,
+  /// so that the sub-analysis can find their histograms with an array access instead of
+  /// building their path for each event, track or pair.
+  ///
+  /// The slot of (eventSelection,triggerClassName,centrality) is
+  /// (triggerIndex*nEventSelections + eventSelectionIndex)*nCentralities + centralityIndex,
+  /// trigger classes being indexed in the order they are first seen (see TriggerSlotIndex).
+  /// Each of them is then split into fNofSlotCuts slots : the event itself, the track cuts and the pair cuts.
+  /// The path of the histograms are unchanged.
+
+  delete fCentralities;
+  fCentralities = fBinning->CreateBinObjArray("centrality");
+
+  delete fSlotTriggers;
+  fSlotTriggers = new THashList;
+  fSlotTriggers->SetOwner(kTRUE);
+
+  fNofSlotEventSelections = CutRegistry()->GetCutCombinations(AliAnalysisMuMuCutElement::kEvent)->GetEntries();
+  fNofSlotTrackCuts       = CutRegistry()->GetCutCombinations(AliAnalysisMuMuCutElement::kTrack)->GetEntries();
+  fNofSlotCuts            = 1 + fNofSlotTrackCuts + CutRegistry()->GetCutCombinations(AliAnalysisMuMuCutElement::kTrackPair)->GetEntries();
+
+  AliDebug(1,Form("%d event selections, %d centralities, %d slots per combination",
+                  fNofSlotEventSelections,fCentralities ? fCentralities->GetEntries() : 0,fNofSlotCuts));
+}
+
+//_____________________________________________________________________________
+Int_t AliAnalysisTaskMuMu::TriggerSlotIndex(const TString& triggerClassName)
+{
+  /// Index of the trigger class in the slot numbering (see ResolveSlots)
+
+  TObject* o = fSlotTriggers->FindObject(triggerClassName.Data());
+
+  if (!o)
+  {
+    o = new TObjString(triggerClassName);
+    o->SetUniqueID(fSlotTriggers->GetEntries());
+    fSlotTriggers->Add(o);
+  }
+
+  return o->GetUniqueID();
+}
+
 //_____________________________________________________________________________
 void
 AliAnalysisTaskMuMu::Terminate(Option_t *)
@@ -879,6 +959,8 @@ void AliAnalysisTaskMuMu::UserExec(Option_t* /*opt*/)
 
   Binning(); // insure we have a binning...
 
+  if ( !fSlotTriggers ) ResolveSlots();
+
   TIter nextAnalysis(fSubAnalysisVector);
   AliAnalysisMuMuBase* analysis;
 
@@ -919,11 +1001,16 @@ void AliAnalysisTaskMuMu::UserExec(Option_t* /*opt*/)
   TIter next(&selectedTriggerClasses);
   TObjString* tname;
 
+  Int_t nCentralities = fCentralities ? fCentralities->GetEntries() : 0;
+
   while ( ( tname = static_cast<TObjString*>(next()) ) ){
     nextEventCutCombination.Reset();
 
+    Int_t slot = TriggerSlotIndex(tname->String())*fNofSlotEventSelections*nCentralities;
+
     while ( ( cutCombination = static_cast<AliAnalysisMuMuCutCombination*>(nextEventCutCombination())) ){
-      if ( cutCombination->Pass(*fInputHandler) ) Fill(cutCombination->GetName(),tname->String().Data());
+      if ( cutCombination->Pass(*fInputHandler) ) Fill(cutCombination->GetName(),tname->String().Data(),slot);
+      slot += nCentralities;
     }
   }
 
@@ -36,6 +36,7 @@ class AliCounterCollection;
 class AliMergeableCollection;
 class AliVParticle;
 class TList;
+class THashList;
 class TObjArray;
 class AliAnalysisMuMuBase;
 class AliAnalysisMuMuCutRegistry;
@@ -106,13 +107,13 @@ private:
 
   AliVEvent* Event() const;
 
-  void FillHistos(const char* eventSelection, const char* triggerClassName, const char* centrality, Float_t cent);
+  void FillHistos(const char* eventSelection, const char* triggerClassName, const char* centrality, Float_t cent, Int_t slot);
 
   void FillPoolsWithTracks(const char* eventSelection, const char* triggerClassName, Float_t cent);
 
   void FillCounters(const char* eventSelection, const char* triggerClassName, const char* centrality, Int_t currentRun);
 
-  void Fill(const char* eventSelection, const char* triggerClassName);
+  void Fill(const char* eventSelection, const char* triggerClassName, Int_t slot);
 
   void FillPools(const char* eventSelection, const char* triggerClassName);
 
@@ -130,6 +131,10 @@ private:
 
   Bool_t IsPP() const;
 
+  void ResolveSlots();
+
+  Int_t TriggerSlotIndex(const TString& triggerClassName);
+
 private:
 
   AliAnalysisTaskMuMu(const AliAnalysisTaskMuMu&); // not implemented (on purpose)
@@ -174,7 +179,17 @@ private:
 
   Int_t fMaxPoolSize; // pool size
 
-  ClassDef(AliAnalysisTaskMuMu,31) // a class to analyse muon pairs (and single also ;-) )
+  TObjArray* fCentralities; //! centrality bins, resolved at the first event
+
+  THashList* fSlotTriggers; //! trigger classes seen so far, unique id = trigger index in the slot numbering
+
+  Int_t fNofSlotEventSelections; //! number of event cut combinations
+
+  Int_t fNofSlotTrackCuts; //! number of track cut combinations
+
+  Int_t fNofSlotCuts; //! number of slots per (eventSelection,triggerClassName,centrality) : none + track cuts + pair cuts
+
+  ClassDef(AliAnalysisTaskMuMu,32) // a class to analyse muon pairs (and single also ;-) )
 };
 
 #endif
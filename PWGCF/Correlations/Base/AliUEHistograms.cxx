@@ -28,6 +28,7 @@
 #include "AliBasicParticle.h"
 #include "AliVParticle.h"
 #include "AliAODTrack.h"
+#include "AliLog.h"
 
 #include "TList.h"
 #include "TCanvas.h"
@@ -36,6 +37,13 @@
 #include "TH3F.h"
 #include "TMath.h"
 #include "TLorentzVector.h"
+#include "TObjArray.h"
+#include "TArrayC.h"
+#include "TArrayD.h"
+#include "TArrayF.h"
+#include "TArrayI.h"
+#include "TArrayL64.h"
+#include "TArrayS.h"
 
 ClassImp(AliUEHistograms)
 
@@ -540,6 +548,84 @@ void AliUEHistograms::Fill(AliVParticle* leadingMC, AliVParticle* leadingReco)
   }
 }
 
+//____________________________________________________________________
+// Packed (structure-of-arrays) copy of the particle properties used in the pair loop
+// of FillCorrelations. It is built once per call for the trigger particles and once
+// for the associated (or mixed-event) particles, so that the pair loop does not
+// call the virtual AliVParticle getters nor dynamic_cast for every pair.
+// The types are the ones of the original expressions (Pt() and Phi() are Double_t,
+// eta is cached as Float_t) so that the output is unchanged.
+struct AliUEHistogramsParticleBuffer
+{
+  AliUEHistogramsParticleBuffer() : fN(0), fPt(), fPhi(), fEta(), fCharge(), fFlag(), fEventIndex(), fUniqueID(), fObject(0) {}
+  
+  void Fill(TObjArray* array, Bool_t eventIndex)
+  {
+    fN = array->GetEntriesFast();
+    fPt.Set(fN);
+    fPhi.Set(fN);
+    fEta.Set(fN);
+    fCharge.Set(fN);
+    fFlag.Set(fN);
+    fUniqueID.Set(fN);
+    fObject = (TObject**) array->GetObjectRef();
+    if (eventIndex)
+      fEventIndex.Set(fN);
+    
+    for (Int_t i=0; i<fN; i++)
+    {
+      AliVParticle* particle = (AliVParticle*) array->UncheckedAt(i);
+      fPt[i] = particle->Pt();
+      fPhi[i] = particle->Phi();
+      fEta[i] = particle->Eta();
+      fCharge[i] = particle->Charge();
+      fFlag[i] = 0;
+      fUniqueID[i] = particle->GetUniqueID();
+      
+      if (eventIndex)
+      {
+        AliBasicParticle* particleBasic = dynamic_cast<AliBasicParticle*> (particle);
+        if (!particleBasic)
+        {
+          AliFatalGeneral("AliUEHistograms", "If fCheckEventNumberInCorrelation is set, particle must be derived from AliBasicParticle");
+          continue;
+        }
+        fEventIndex[i] = particleBasic->GetEventIndex();
+      }
+    }
+  }
+  
+  // to be called after the TObject bits have been changed
+  void UpdateFlags(UInt_t bit)
+  {
+    for (Int_t i=0; i<fN; i++)
+      fFlag[i] = fObject[i]->TestBit(bit);
+  }
+  
+  Int_t fN;              // number of particles
+  TArrayD fPt;           // Pt()
+  TArrayD fPhi;          // Phi()
+  TArrayF fEta;          // Eta()
+  TArrayS fCharge;       // Charge()
+  TArrayC fFlag;         // resonance daughter flag
+  TArrayL64 fEventIndex; // AliBasicParticle::GetEventIndex() (only if the event number is checked)
+  TArrayI fUniqueID;     // GetUniqueID()
+  TObject** fObject;     // the particles themselves
+};
+
+//____________________________________________________________________
+static Bool_t IsSameParticle(const AliUEHistogramsParticleBuffer& trig, Int_t i, const AliUEHistogramsParticleBuffer& assoc, Int_t j)
+{
+  // replaces triggerParticle->IsEqual(particle) in the pair loop
+  // the IsEqual implementations in use compare either the pointers (TObject) or the unique IDs (AliBasicParticle, AliCFParticle, ...)
+  // therefore the virtual call is only needed if one of the two is equal
+  
+  if (trig.fObject[i] != assoc.fObject[j] && trig.fUniqueID[i] != assoc.fUniqueID[j])
+    return kFALSE;
+  
+  return trig.fObject[i]->IsEqual(assoc.fObject[j]);
+}
+
 //____________________________________________________________________
 void AliUEHistograms::FillCorrelations(Double_t centrality, Float_t zVtx, AliUEHist::CFStep step, TObjArray* particles, TObjArray* mixed, Float_t weight, Bool_t firstTime, Bool_t twoTrackEfficiencyCut, Float_t bSign, Float_t twoTrackEfficiencyCutValue, Bool_t applyEfficiency)
 {
@@ -566,15 +652,23 @@ void AliUEHistograms::FillCorrelations(Double_t centrality, Float_t zVtx, AliUEH
     TH1::AddDirectory(oldStatus);
   }
 
-  // Eta() is extremely time consuming, therefore cache it for the inner loop here:
+  // Pt(), Eta(), Phi(), Charge() are virtual (and Eta() is extremely time consuming), therefore
+  // the particle properties are copied once into packed arrays for the inner loop here:
   TObjArray* input = (mixed) ? mixed : particles;
-  TArrayF eta(input->GetEntriesFast());
-  for (Int_t i=0; i<input->GetEntriesFast(); i++)
-    eta[i] = ((AliVParticle*) input->UncheckedAt(i))->Eta();
+  AliUEHistogramsParticleBuffer assocBuffer;
+  assocBuffer.Fill(input, fCheckEventNumberInCorrelation);
+  const TArrayF& eta = assocBuffer.fEta;
   
   // if particles is not set, just fill event statistics
   if (particles)
   {
+    AliUEHistogramsParticleBuffer triggerBuffer;
+    if (mixed)
+      triggerBuffer.Fill(particles, fCheckEventNumberInCorrelation);
+    // without mixing, triggers and associated are the same particles (and share the resonance daughter flags)
+    AliUEHistogramsParticleBuffer& trig = (mixed) ? triggerBuffer : assocBuffer;
+    AliUEHistogramsParticleBuffer& assoc = assocBuffer;
+    
     Int_t jMax = particles->GetEntriesFast();
     if (mixed)
       jMax = mixed->GetEntriesFast();
@@ -587,10 +681,8 @@ void AliUEHistograms::FillCorrelations(Double_t centrality, Float_t zVtx, AliUEH
     
       for (Int_t i=0; i<particles->GetEntriesFast(); i++)
       {
-	AliVParticle* triggerParticle = (AliVParticle*) particles->UncheckedAt(i);
-	
 	// some optimization
-	Float_t triggerEta = triggerParticle->Eta();
+	Float_t triggerEta = trig.fEta[i];
 
 	if (fTriggerRestrictEta > 0 && TMath::Abs(triggerEta) > fTriggerRestrictEta)
 	  continue;
@@ -602,10 +694,10 @@ void AliUEHistograms::FillCorrelations(Double_t centrality, Float_t zVtx, AliUEH
 	}
 	
 	if (fTriggerSelectCharge != 0)
-	  if (triggerParticle->Charge() * fTriggerSelectCharge < 0)
+	  if (trig.fCharge[i] * fTriggerSelectCharge < 0)
 	    continue;
 	
-	triggerWeighting->Fill(triggerParticle->Pt());
+	triggerWeighting->Fill(trig.fPt[i]);
       }
     }
     
@@ -635,63 +727,72 @@ void AliUEHistograms::FillCorrelations(Double_t centrality, Float_t zVtx, AliUEH
       
       for (Int_t i=0; i<particles->GetEntriesFast(); i++)
       {
-	AliVParticle* triggerParticle = (AliVParticle*) particles->UncheckedAt(i);
-	
 	for (Int_t j=0; j<jMax; j++)
 	{
 	  if (!mixed && i == j)
 	    continue;
 	
-	  AliVParticle* particle = 0;
-	  if (!mixed)
-	    particle = (AliVParticle*) particles->UncheckedAt(j);
-	  else
-	    particle = (AliVParticle*) mixed->UncheckedAt(j);
-	  
 	  // check if both particles point to the same element (does not occur for mixed events, but if subsets are mixed within the same event)
 	  if (fCheckEventNumberInCorrelation)
 	  {
-	    AliBasicParticle* triggerParticleBasic = dynamic_cast<AliBasicParticle*>(triggerParticle);
-	    AliBasicParticle* particleBasic        = dynamic_cast<AliBasicParticle*>(particle);
-	    if(!triggerParticleBasic || !particleBasic)
-	    {
-	      AliFatal("If fCheckEventNumberInCorrelation is set, particle must be derived from AliBasicParticle");
-	      continue;
-	    }
-	
-	    if(triggerParticleBasic->IsInSameEvent(particleBasic))
+	    if (trig.fEventIndex[i] == assoc.fEventIndex[j])
 	      continue;
 	  }
-	  else if (mixed && triggerParticle->IsEqual(particle))
+	  else if (mixed && IsSameParticle(trig, i, assoc, j))
 	    continue;
 	  
-	  if (triggerParticle->Charge() * particle->Charge() > 0)
+	  if (trig.fCharge[i] * assoc.fCharge[j] > 0)
 	    continue;
       
-	  Float_t mass = GetInvMassSquaredCheap(triggerParticle->Pt(), triggerParticle->Eta(), triggerParticle->Phi(), particle->Pt(), particle->Eta(), particle->Phi(), massDaughter1, massDaughter2);
+	  Float_t mass = GetInvMassSquaredCheap(trig.fPt[i], trig.fEta[i], trig.fPhi[i], assoc.fPt[j], assoc.fEta[j], assoc.fPhi[j], massDaughter1, massDaughter2);
 	      
 	  if (TMath::Abs(mass - resonanceMass*resonanceMass) < interval*5)
 	  {
-	    mass = GetInvMassSquared(triggerParticle->Pt(), triggerParticle->Eta(), triggerParticle->Phi(), particle->Pt(), particle->Eta(), particle->Phi(), massDaughter1, massDaughter2);
+	    mass = GetInvMassSquared(trig.fPt[i], trig.fEta[i], trig.fPhi[i], assoc.fPt[j], assoc.fEta[j], assoc.fPhi[j], massDaughter1, massDaughter2);
 
 	    if (mass > (resonanceMass-interval)*(resonanceMass-interval) && mass < (resonanceMass+interval)*(resonanceMass+interval))
 	    {
-	      triggerParticle->SetBit(kResonanceDaughterFlag);
-	      particle->SetBit(kResonanceDaughterFlag);
+	      trig.fObject[i]->SetBit(kResonanceDaughterFlag);
+	      assoc.fObject[j]->SetBit(kResonanceDaughterFlag);
 	      
 // 	      Printf("Flagged %d %d %f", i, j, TMath::Sqrt(mass));
 	    }
 	  }
 	}
       }
+      
+      // the bits are the reference (the same object can be in both arrays if subsets are mixed within the same event)
+      assoc.UpdateFlags(kResonanceDaughterFlag);
+      if (mixed)
+	trig.UpdateFlags(kResonanceDaughterFlag);
+    }
+    
+    // efficiency correction of the associated particles, depends only on the particle for a given event
+    TArrayD assocEfficiency;
+    if (applyEfficiency && fEfficiencyCorrectionAssociated)
+    {
+      assocEfficiency.Set(jMax);
+      Int_t effVars[4];
+      effVars[2] = fEfficiencyCorrectionAssociated->GetAxis(2)->FindBin(centrality);
+      effVars[3] = fEfficiencyCorrectionAssociated->GetAxis(3)->FindBin(zVtx);
+      for (Int_t j=0; j<jMax; j++)
+      {
+	effVars[0] = fEfficiencyCorrectionAssociated->GetAxis(0)->FindBin(eta[j]);
+	effVars[1] = fEfficiencyCorrectionAssociated->GetAxis(1)->FindBin(assoc.fPt[j]); //pt
+	assocEfficiency[j] = fEfficiencyCorrectionAssociated->GetBinContent(effVars);
+      }
     }
     
+    // per-pair selection mask, filled by a branch-free loop over the packed arrays for each trigger particle
+    TArrayC accept(jMax);
+    
     for (Int_t i=0; i<particles->GetEntriesFast(); i++)
     {
-      AliVParticle* triggerParticle = (AliVParticle*) particles->UncheckedAt(i);
-      
       // some optimization
-      Float_t triggerEta = triggerParticle->Eta();
+      Float_t triggerEta = trig.fEta[i];
+      const Double_t triggerPt = trig.fPt[i];
+      const Double_t triggerPhi = trig.fPhi[i];
+      const Short_t triggerCharge = trig.fCharge[i];
       
       if (fTriggerRestrictEta > 0 && TMath::Abs(triggerEta) > fTriggerRestrictEta)
 	continue;
@@ -703,83 +804,90 @@ void AliUEHistograms::FillCorrelations(Double_t centrality, Float_t zVtx, AliUEH
       }
       
       if (fTriggerSelectCharge != 0)
-	if (triggerParticle->Charge() * fTriggerSelectCharge < 0)
+	if (triggerCharge * fTriggerSelectCharge < 0)
 	  continue;
 	
       if (fRejectResonanceDaughters > 0)
-	if (triggerParticle->TestBit(kResonanceDaughterFlag))
+	if (trig.fFlag[i])
 	{
 // 	  Printf("Skipped i=%d", i);
 	  continue;
 	}
 	
-      for (Int_t j=0; j<jMax; j++)
+      // trigger efficiency and weighting do not depend on the associated particle
+      Double_t triggerEfficiency = 1;
+      if (applyEfficiency && fEfficiencyCorrectionTriggers)
       {
-        if (!mixed && i == j)
-          continue;
-      
-        AliVParticle* particle = 0;
-        if (!mixed)
-          particle = (AliVParticle*) particles->UncheckedAt(j);
-        else
-          particle = (AliVParticle*) mixed->UncheckedAt(j);
-        
-        // check if both particles point to the same element (does not occur for mixed events, but if subsets are mixed within the same event)
-        if (fCheckEventNumberInCorrelation)
-        {
-          AliBasicParticle* triggerParticleBasic = dynamic_cast<AliBasicParticle*>(triggerParticle);
-          AliBasicParticle* particleBasic        = dynamic_cast<AliBasicParticle*>(particle);
-          if(!triggerParticleBasic || !particleBasic)
-            AliFatal("If fCheckEventNumberInCorrelation is set, particle must be derived from AliBasicParticle");
-      
-          if(triggerParticleBasic->IsInSameEvent(particleBasic))
-            continue;
-        }
-        else if (mixed && triggerParticle->IsEqual(particle))
-          continue;
-        
-        if (fPtOrder)
-	  if (particle->Pt() >= triggerParticle->Pt())
-	    continue;
+	Int_t effVars[4];
+
+	effVars[0] = fEfficiencyCorrectionTriggers->GetAxis(0)->FindBin(triggerEta);
+	effVars[1] = fEfficiencyCorrectionTriggers->GetAxis(1)->FindBin(triggerPt); //pt
+	effVars[2] = fEfficiencyCorrectionTriggers->GetAxis(2)->FindBin(centrality); //centrality
+	effVars[3] = fEfficiencyCorrectionTriggers->GetAxis(3)->FindBin(zVtx); //zVtx
+	triggerEfficiency = fEfficiencyCorrectionTriggers->GetBinContent(effVars);
+      }
+      Double_t triggerWeight = 1;
+      if (fWeightPerEvent)
+	triggerWeight = triggerWeighting->GetBinContent(triggerWeighting->GetXaxis()->FindBin(triggerPt));
 	
+      // simple pair cuts (no side effects) on the packed arrays
+      const Short_t* charge = assoc.fCharge.GetArray();
+      const Double_t* pt = assoc.fPt.GetArray();
+      const Float_t* etaArr = eta.GetArray();
+      const Char_t* flag = assoc.fFlag.GetArray();
+      Char_t* acc = accept.GetArray();
+      for (Int_t j=0; j<jMax; j++)
+      {
+	Bool_t ok = kTRUE;
+	if (fPtOrder)
+	  ok &= (pt[j] < triggerPt);
 	if (fAssociatedSelectCharge != 0)
-	  if (particle->Charge() * fAssociatedSelectCharge < 0)
-	    continue;
-
-        if (fSelectCharge > 0)
-        {
-          // skip like sign
-          if (fSelectCharge == 1 && particle->Charge() * triggerParticle->Charge() > 0)
-            continue;
-            
-          // skip unlike sign
-          if (fSelectCharge == 2 && particle->Charge() * triggerParticle->Charge() < 0)
-            continue;
-        }
-        
+	  ok &= (charge[j] * fAssociatedSelectCharge >= 0);
+	if (fSelectCharge == 1) // skip like sign
+	  ok &= (charge[j] * triggerCharge <= 0);
+	else if (fSelectCharge == 2) // skip unlike sign
+	  ok &= (charge[j] * triggerCharge >= 0);
 	if (fEtaOrdering)
-	{
-	  if (triggerEta < 0 && eta[j] < triggerEta)
-	    continue;
-	  if (triggerEta > 0 && eta[j] > triggerEta)
-	    continue;
-	}
-
+	  ok &= !((triggerEta < 0 && etaArr[j] < triggerEta) || (triggerEta > 0 && etaArr[j] > triggerEta));
 	if (fRejectResonanceDaughters > 0)
-	  if (particle->TestBit(kResonanceDaughterFlag))
-	  {
-// 	    Printf("Skipped j=%d", j);
-	    continue;
-	  }
-
+	  ok &= !flag[j];
+	acc[j] = ok;
+      }
+      if (!mixed)
+	acc[i] = kFALSE;
+      
+      // check if both particles point to the same element (does not occur for mixed events, but if subsets are mixed within the same event)
+      if (fCheckEventNumberInCorrelation)
+      {
+	const Long64_t* eventIndex = assoc.fEventIndex.GetArray();
+	const Long64_t triggerEventIndex = trig.fEventIndex[i];
+	for (Int_t j=0; j<jMax; j++)
+	  acc[j] &= (eventIndex[j] != triggerEventIndex);
+      }
+      else if (mixed)
+      {
+	for (Int_t j=0; j<jMax; j++)
+	  if (acc[j] && IsSameParticle(trig, i, assoc, j))
+	    acc[j] = kFALSE;
+      }
+      
+      for (Int_t j=0; j<jMax; j++)
+      {
+	if (!acc[j])
+	  continue;
+	
+	const Double_t assocPt = pt[j];
+	const Double_t assocPhi = assoc.fPhi[j];
+	const Short_t assocCharge = charge[j];
+	
 	// conversions
-	if (fCutConversionsV > 0 && particle->Charge() * triggerParticle->Charge() < 0)
+	if (fCutConversionsV > 0 && assocCharge * triggerCharge < 0)
 	{
-	  Float_t mass = GetInvMassSquaredCheap(triggerParticle->Pt(), triggerEta, triggerParticle->Phi(), particle->Pt(), eta[j], particle->Phi(), 0.510e-3, 0.510e-3);
+	  Float_t mass = GetInvMassSquaredCheap(triggerPt, triggerEta, triggerPhi, assocPt, eta[j], assocPhi, 0.510e-3, 0.510e-3);
 	  
 	  if (mass < fCutConversionsV * 5)
 	  {
-	    mass = GetInvMassSquared(triggerParticle->Pt(), triggerEta, triggerParticle->Phi(), particle->Pt(), eta[j], particle->Phi(), 0.510e-3, 0.510e-3);
+	    mass = GetInvMassSquared(triggerPt, triggerEta, triggerPhi, assocPt, eta[j], assocPhi, 0.510e-3, 0.510e-3);
 	    
 	    fControlConvResoncances->Fill(0.0, mass);
 
@@ -789,15 +897,15 @@ void AliUEHistograms::FillCorrelations(Double_t centrality, Float_t zVtx, AliUEH
 	}
 	
 	// K0s
-	if (fCutResonancesV > 0 && particle->Charge() * triggerParticle->Charge() < 0)
+	if (fCutResonancesV > 0 && assocCharge * triggerCharge < 0)
 	{
-	  Float_t mass = GetInvMassSquaredCheap(triggerParticle->Pt(), triggerEta, triggerParticle->Phi(), particle->Pt(), eta[j], particle->Phi(), 0.1396, 0.1396);
+	  Float_t mass = GetInvMassSquaredCheap(triggerPt, triggerEta, triggerPhi, assocPt, eta[j], assocPhi, 0.1396, 0.1396);
 	  
 	  const Float_t kK0smass = 0.4976;
 	  
 	  if (TMath::Abs(mass - kK0smass*kK0smass) < fCutResonancesV * 5)
 	  {
-	    mass = GetInvMassSquared(triggerParticle->Pt(), triggerEta, triggerParticle->Phi(), particle->Pt(), eta[j], particle->Phi(), 0.1396, 0.1396);
+	    mass = GetInvMassSquared(triggerPt, triggerEta, triggerPhi, assocPt, eta[j], assocPhi, 0.1396, 0.1396);
 	    
 	    fControlConvResoncances->Fill(1, mass - kK0smass*kK0smass);
 
@@ -807,16 +915,16 @@ void AliUEHistograms::FillCorrelations(Double_t centrality, Float_t zVtx, AliUEH
 	}
 	
 	// Lambda
-	if (fCutResonancesV > 0 && particle->Charge() * triggerParticle->Charge() < 0)
+	if (fCutResonancesV > 0 && assocCharge * triggerCharge < 0)
 	{
-	  Float_t mass1 = GetInvMassSquaredCheap(triggerParticle->Pt(), triggerEta, triggerParticle->Phi(), particle->Pt(), eta[j], particle->Phi(), 0.1396, 0.9383);
-	  Float_t mass2 = GetInvMassSquaredCheap(triggerParticle->Pt(), triggerEta, triggerParticle->Phi(), particle->Pt(), eta[j], particle->Phi(), 0.9383, 0.1396);
+	  Float_t mass1 = GetInvMassSquaredCheap(triggerPt, triggerEta, triggerPhi, assocPt, eta[j], assocPhi, 0.1396, 0.9383);
+	  Float_t mass2 = GetInvMassSquaredCheap(triggerPt, triggerEta, triggerPhi, assocPt, eta[j], assocPhi, 0.9383, 0.1396);
 	  
 	  const Float_t kLambdaMass = 1.115;
 
 	  if (TMath::Abs(mass1 - kLambdaMass*kLambdaMass) < fCutResonancesV * 5)
 	  {
-	    mass1 = GetInvMassSquared(triggerParticle->Pt(), triggerEta, triggerParticle->Phi(), particle->Pt(), eta[j], particle->Phi(), 0.1396, 0.9383);
+	    mass1 = GetInvMassSquared(triggerPt, triggerEta, triggerPhi, assocPt, eta[j], assocPhi, 0.1396, 0.9383);
 
 	    fControlConvResoncances->Fill(2, mass1 - kLambdaMass*kLambdaMass);
 	    
@@ -825,7 +933,7 @@ void AliUEHistograms::FillCorrelations(Double_t centrality, Float_t zVtx, AliUEH
 	  }
 	  if (TMath::Abs(mass2 - kLambdaMass*kLambdaMass) < fCutResonancesV * 5)
 	  {
-	    mass2 = GetInvMassSquared(triggerParticle->Pt(), triggerEta, triggerParticle->Phi(), particle->Pt(), eta[j], particle->Phi(), 0.9383, 0.1396);
+	    mass2 = GetInvMassSquared(triggerPt, triggerEta, triggerPhi, assocPt, eta[j], assocPhi, 0.9383, 0.1396);
 
 	    fControlConvResoncances->Fill(2, mass2 - kLambdaMass*kLambdaMass);
 
@@ -839,13 +947,13 @@ void AliUEHistograms::FillCorrelations(Double_t centrality, Float_t zVtx, AliUEH
 	  // the variables & cuthave been developed by the HBT group 
 	  // see e.g. https://indico.cern.ch/materialDisplay.py?contribId=36&sessionId=6&materialId=slides&confId=142700
 
-	  Float_t phi1 = triggerParticle->Phi();
-	  Float_t pt1 = triggerParticle->Pt();
-	  Float_t charge1 = triggerParticle->Charge();
+	  Float_t phi1 = triggerPhi;
+	  Float_t pt1 = triggerPt;
+	  Float_t charge1 = triggerCharge;
 	    
-	  Float_t phi2 = particle->Phi();
-	  Float_t pt2 = particle->Pt();
-	  Float_t charge2 = particle->Charge();
+	  Float_t phi2 = assocPhi;
+	  Float_t pt2 = assocPt;
+	  Float_t charge2 = assocCharge;
 	      
 	  Float_t deta = triggerEta - eta[j];
 	      
@@ -890,10 +998,10 @@ void AliUEHistograms::FillCorrelations(Double_t centrality, Float_t zVtx, AliUEH
         
         Double_t vars[6];
         vars[0] = triggerEta - eta[j];
-        vars[1] = particle->Pt();
-        vars[2] = triggerParticle->Pt();
+        vars[1] = assocPt;
+        vars[2] = triggerPt;
         vars[3] = centrality;
-        vars[4] = triggerParticle->Phi() - particle->Phi();
+        vars[4] = triggerPhi - assocPhi;
         if (vars[4] > 1.5 * TMath::Pi()) 
           vars[4] -= TMath::TwoPi();
         if (vars[4] < -0.5 * TMath::Pi())
@@ -901,41 +1009,21 @@ void AliUEHistograms::FillCorrelations(Double_t centrality, Float_t zVtx, AliUEH
 	vars[5] = zVtx;
 	
 	if (fillpT)
-	  weight = particle->Pt();
+	  weight = assocPt;
 	
 	Double_t useWeight = weight;
 	if (applyEfficiency)
 	{
 	  if (fEfficiencyCorrectionAssociated)
-	  {
-	    Int_t effVars[4];
-	    // associated particle
-	    effVars[0] = fEfficiencyCorrectionAssociated->GetAxis(0)->FindBin(eta[j]);
-	    effVars[1] = fEfficiencyCorrectionAssociated->GetAxis(1)->FindBin(vars[1]); //pt
-	    effVars[2] = fEfficiencyCorrectionAssociated->GetAxis(2)->FindBin(vars[3]); //centrality
-	    effVars[3] = fEfficiencyCorrectionAssociated->GetAxis(3)->FindBin(vars[5]); //zVtx
-	    
-	    // 	  Printf("%d %d %d %d %f", effVars[0], effVars[1], effVars[2], effVars[3], fEfficiencyCorrectionAssociated->GetBinContent(effVars));
-	  
-	    useWeight *= fEfficiencyCorrectionAssociated->GetBinContent(effVars);
-	  }
+	    useWeight *= assocEfficiency[j];
 	  if (fEfficiencyCorrectionTriggers)
-	  {
-	    Int_t effVars[4];
-
-	    effVars[0] = fEfficiencyCorrectionTriggers->GetAxis(0)->FindBin(triggerEta);
-	    effVars[1] = fEfficiencyCorrectionTriggers->GetAxis(1)->FindBin(vars[2]); //pt
-	    effVars[2] = fEfficiencyCorrectionTriggers->GetAxis(2)->FindBin(vars[3]); //centrality
-	    effVars[3] = fEfficiencyCorrectionTriggers->GetAxis(3)->FindBin(vars[5]); //zVtx
-	    useWeight *= fEfficiencyCorrectionTriggers->GetBinContent(effVars);
-	  }
+	    useWeight *= triggerEfficiency;
 	}
 
 	if (fWeightPerEvent)
 	{
-	  Int_t weightBin = triggerWeighting->GetXaxis()->FindBin(vars[2]);
-// 	  Printf("Using weight %f", triggerWeighting->GetBinContent(weightBin));
-	  useWeight /= triggerWeighting->GetBinContent(weightBin);
+// 	  Printf("Using weight %f", triggerWeight);
+	  useWeight /= triggerWeight;
 	}
     
         // fill all in toward region and do not use the other regions
@@ -948,7 +1036,7 @@ void AliUEHistograms::FillCorrelations(Double_t centrality, Float_t zVtx, AliUEH
       {
         // once per trigger particle
         Double_t vars[3];
-        vars[0] = triggerParticle->Pt();
+        vars[0] = triggerPt;
         vars[1] = centrality;
 	vars[2] = zVtx;
 
@@ -965,8 +1053,8 @@ void AliUEHistograms::FillCorrelations(Double_t centrality, Float_t zVtx, AliUEH
 	  useWeight *= fEfficiencyCorrectionTriggers->GetBinContent(effVars);
 	}
 
-	if (TMath::Abs(triggerEta) < 0.8 && triggerParticle->Pt() > 0)
-	  fInvYield2->Fill(centrality, triggerParticle->Pt(), useWeight / triggerParticle->Pt());
+	if (TMath::Abs(triggerEta) < 0.8 && triggerPt > 0)
+	  fInvYield2->Fill(centrality, triggerPt, useWeight / triggerPt);
 
 	if (fWeightPerEvent)
 	{
@@ -979,13 +1067,13 @@ void AliUEHistograms::FillCorrelations(Double_t centrality, Float_t zVtx, AliUEH
         fNumberDensityPhi->GetEventHist()->Fill(vars, step, useWeight);
 
 	// QA
-        fCorrelationpT->Fill(centrality, triggerParticle->Pt());
+        fCorrelationpT->Fill(centrality, triggerPt);
         fCorrelationEta->Fill(centrality, triggerEta);
-        fCorrelationPhi->Fill(centrality, triggerParticle->Phi());
-	fYields->Fill(centrality, triggerParticle->Pt(), triggerEta);
+        fCorrelationPhi->Fill(centrality, triggerPhi);
+	fYields->Fill(centrality, triggerPt, triggerEta);
 	
-/*        if (dynamic_cast<AliAODTrack*>(triggerParticle))
-          fITSClusterMap->Fill(((AliAODTrack*) triggerParticle)->GetITSClusterMap(), centrality, triggerParticle->Pt());*/
+/*        if (dynamic_cast<AliAODTrack*>(trig.fObject[i]))
+          fITSClusterMap->Fill(((AliAODTrack*) trig.fObject[i])->GetITSClusterMap(), centrality, triggerPt);*/
       }
     }
     
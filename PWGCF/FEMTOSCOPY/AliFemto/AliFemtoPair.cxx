@@ -20,6 +20,13 @@ AliFemtoPair::AliFemtoPair():
   fTrack1(NULL),
   fTrack2(NULL),
   fPairAngleEP(0.0),
+  fKinematicsNotCalculated(1),
+  fQInvCalc(0.0),
+  fKTCalc(0.0),
+  fMTCalc(0.0),
+  fQOutCMSCalc(0.0),
+  fQSideCMSCalc(0.0),
+  fQLongCMSCalc(0.0),
   fNonIdParNotCalculated(0.0),
   fDKSide(0.0),
   fDKOut(0.0),
@@ -58,6 +65,13 @@ AliFemtoPair::AliFemtoPair(AliFemtoParticle* a, AliFemtoParticle* b):
   fTrack1(a),
   fTrack2(b),
   fPairAngleEP(0.0),
+  fKinematicsNotCalculated(1),
+  fQInvCalc(0.0),
+  fKTCalc(0.0),
+  fMTCalc(0.0),
+  fQOutCMSCalc(0.0),
+  fQSideCMSCalc(0.0),
+  fQLongCMSCalc(0.0),
   fNonIdParNotCalculated(0.0),
   fDKSide(0.0),
   fDKOut(0.0),
@@ -127,6 +141,13 @@ AliFemtoPair::AliFemtoPair(const AliFemtoPair &aPair):
   fTrack1(aPair.fTrack1),
   fTrack2(aPair.fTrack2),
   fPairAngleEP(aPair.fPairAngleEP),
+  fKinematicsNotCalculated(aPair.fKinematicsNotCalculated),
+  fQInvCalc(aPair.fQInvCalc),
+  fKTCalc(aPair.fKTCalc),
+  fMTCalc(aPair.fMTCalc),
+  fQOutCMSCalc(aPair.fQOutCMSCalc),
+  fQSideCMSCalc(aPair.fQSideCMSCalc),
+  fQLongCMSCalc(aPair.fQLongCMSCalc),
   fNonIdParNotCalculated(aPair.fNonIdParNotCalculated),
   fDKSide(aPair.fDKSide),
   fDKOut(aPair.fDKOut),
@@ -172,6 +193,14 @@ AliFemtoPair& AliFemtoPair::operator=(const AliFemtoPair &aPair)
 
   fPairAngleEP = aPair.fPairAngleEP;
 
+  fKinematicsNotCalculated = aPair.fKinematicsNotCalculated;
+  fQInvCalc = aPair.fQInvCalc;
+  fKTCalc = aPair.fKTCalc;
+  fMTCalc = aPair.fMTCalc;
+  fQOutCMSCalc = aPair.fQOutCMSCalc;
+  fQSideCMSCalc = aPair.fQSideCMSCalc;
+  fQLongCMSCalc = aPair.fQLongCMSCalc;
+
   fNonIdParNotCalculated = aPair.fNonIdParNotCalculated;
   fDKSide = aPair.fDKSide;
   fDKOut = aPair.fDKOut;
@@ -226,15 +255,6 @@ double AliFemtoPair::MInv() const
     return (tInvariantMass);
 }
 //_________________
-double AliFemtoPair::KT() const
-{
-  // transverse momentum
-  double tmp = (fTrack1->FourMomentum() + fTrack2->FourMomentum()).Perp();
-  tmp *= .5;
-
-  return (tmp);
-}
-//_________________
 double AliFemtoPair::Rap() const
 {
   // longitudinal pair rapidity : Y = 0.5 ::log( E1 + E2 + pz1 + pz2 / E1 + E2 - pz1 - pz2 )
@@ -353,65 +373,57 @@ void AliFemtoPair::QYKPPF(double& qP, double& qT, double& q0) const
   q0 = l.e();
 }
 //_________________
-double AliFemtoPair::QOutCMS() const
+void AliFemtoPair::CalcKinematics() const
 {
-  // relative momentum out component in lab frame
-    AliFemtoThreeVector tmp1 = fTrack1->FourMomentum().vect();
-    AliFemtoThreeVector tmp2 = fTrack2->FourMomentum().vect();
+  // Calculate the kinematic variables read by most correlation functions
+  // (qinv, kT, mT and the Bertsch-Pratt components in LCMS) once per pair.
+  // They are cached until one of the tracks is changed.
+  const AliFemtoLorentzVector &p1 = fTrack1->FourMomentum(),
+                              &p2 = fTrack2->FourMomentum();
 
-    double dx = tmp1.x() - tmp2.x();
-    double xt = tmp1.x() + tmp2.x();
+  // invariant relative momentum
+  AliFemtoLorentzVector tDiff = (p1 - p2);
+  fQInvCalc = -1.* tDiff.m();
 
-    double dy = tmp1.y() - tmp2.y();
-    double yt = tmp1.y() + tmp2.y();
+  // transverse momentum
+  fKTCalc = (p1 + p2).Perp();
+  fKTCalc *= .5;
 
-    double k1 = (::sqrt(xt*xt+yt*yt));
-    double k2 = (dx*xt+dy*yt);
-    double tmp;
+  // transverse mass for the average mass of the pair
+  const double avgMass = (p1.m() + p2.m()) / 2.0;
+  fMTCalc = TMath::Sqrt(avgMass * avgMass + fKTCalc * fKTCalc);
 
-    if(k1!=0) tmp= k2/k1;
-    else tmp=0;
+  // relative momentum out and side components in lab frame
+  const double x1 = p1.x(), y1 = p1.y(),
+               x2 = p2.x(), y2 = p2.y();
 
-    return (tmp);
-}
-//_________________
-double AliFemtoPair::QSideCMS() const
-{
-  // relative momentum side component in lab frame
-    AliFemtoThreeVector tmp1 = fTrack1->FourMomentum().vect();
-    AliFemtoThreeVector tmp2 = fTrack2->FourMomentum().vect();
+  const double dx = x1 - x2, xt = x1 + x2,
+               dy = y1 - y2, yt = y1 + y2;
 
-    double x1 = tmp1.x();  double y1 = tmp1.y();
-    double x2 = tmp2.x();  double y2 = tmp2.y();
+  const double k1 = (::sqrt(xt*xt+yt*yt));
+  const double k2 = (dx*xt+dy*yt);
 
-    double xt = x1+x2;  double yt = y1+y2;
-    double k1 = ::sqrt(xt*xt+yt*yt);
+  if (k1 != 0) {
+    fQOutCMSCalc = k2/k1;
+    fQSideCMSCalc = 2.0*(x2*y1-x1*y2)/k1;
+  } else {
+    fQOutCMSCalc = 0;
+    fQSideCMSCalc = 0;
+  }
 
-    double tmp;
-    if(k1!=0) tmp= 2.0*(x2*y1-x1*y2)/k1;
-    else tmp=0;
+  // relative momentum long component in LCMS
+  const double dz = p1.z() - p2.z();
+  const double zz = p1.z() + p2.z();
 
-    return (tmp);
-}
+  const double dt = p1.t() - p2.t();
+  const double tt = p1.t() + p2.t();
 
-//_________________________
-double AliFemtoPair::QLongCMS() const
-{
-  // relative momentum component in lab frame
-    AliFemtoLorentzVector tmp1 = fTrack1->FourMomentum();
-    AliFemtoLorentzVector tmp2 = fTrack2->FourMomentum();
+  const double beta = zz/tt;
+  const double gamma = 1.0/TMath::Sqrt((1.-beta)*(1.+beta));
 
-    double dz = tmp1.z() - tmp2.z();
-    double zz = tmp1.z() + tmp2.z();
-
-    double dt = tmp1.t() - tmp2.t();
-    double tt = tmp1.t() + tmp2.t();
-
-    double beta = zz/tt;
-    double gamma = 1.0/TMath::Sqrt((1.-beta)*(1.+beta));
+  fQLongCMSCalc = gamma*(dz - beta*dt);
 
-    double temp = gamma*(dz - beta*dt);
-    return (temp);
+  fKinematicsNotCalculated = 0;
 }
 
 //________________________________
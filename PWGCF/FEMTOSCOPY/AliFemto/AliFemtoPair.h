@@ -36,6 +36,7 @@ public:
   AliFemtoLorentzVector FourMomentumSum() const;
   double QInv() const;
   double KT()   const;
+  double MT()   const;
   double MInv() const;
   // pair rapidity
   double Rap() const;
@@ -164,6 +165,15 @@ private:
 
   double fPairAngleEP;	//Pair emission angle wrt EP
 
+  mutable short fKinematicsNotCalculated; // Set to 1 when the common kinematics (qinv, kT, mT, LCMS q) need to be calculated for this pair
+  mutable double fQInvCalc;     // cached QInv()
+  mutable double fKTCalc;       // cached KT()
+  mutable double fMTCalc;       // cached MT()
+  mutable double fQOutCMSCalc;  // cached QOutCMS()
+  mutable double fQSideCMSCalc; // cached QSideCMS()
+  mutable double fQLongCMSCalc; // cached QLongCMS()
+  void CalcKinematics() const;
+
   mutable short fNonIdParNotCalculated; // Set to 1 when NonId variables (kstar) have been already calculated for this pair
   mutable double fDKSide; // momemntum of first particle in PRF - k* side component
   mutable double fDKOut;  // momemntum of first particle in PRF - k* out component
@@ -227,6 +237,7 @@ private:
 };
 
 inline void AliFemtoPair::ResetParCalculated(){
+  fKinematicsNotCalculated=1;
   fNonIdParNotCalculated=1;
   fNonIdParNotCalculatedGlobal=1;
   fMergingParNotCalculated=1;
@@ -267,8 +278,28 @@ inline double AliFemtoPair::KStar() const{
   return fKStarCalc;
 }
 inline double AliFemtoPair::QInv() const {
-  AliFemtoLorentzVector tDiff = (fTrack1->FourMomentum()-fTrack2->FourMomentum());
-  return ( -1.* tDiff.m());
+  if(fKinematicsNotCalculated) CalcKinematics();
+  return fQInvCalc;
+}
+inline double AliFemtoPair::KT() const {
+  if(fKinematicsNotCalculated) CalcKinematics();
+  return fKTCalc;
+}
+inline double AliFemtoPair::MT() const {
+  if(fKinematicsNotCalculated) CalcKinematics();
+  return fMTCalc;
+}
+inline double AliFemtoPair::QOutCMS() const {
+  if(fKinematicsNotCalculated) CalcKinematics();
+  return fQOutCMSCalc;
+}
+inline double AliFemtoPair::QSideCMS() const {
+  if(fKinematicsNotCalculated) CalcKinematics();
+  return fQSideCMSCalc;
+}
+inline double AliFemtoPair::QLongCMS() const {
+  if(fKinematicsNotCalculated) CalcKinematics();
+  return fQLongCMSCalc;
 }
 
 // Fabrice private <<<
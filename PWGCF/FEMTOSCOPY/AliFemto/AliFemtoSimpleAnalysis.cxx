@@ -175,7 +175,10 @@ AliFemtoSimpleAnalysis::AliFemtoSimpleAnalysis():
   fMinSizePartCollection(0),
   fVerbose(kTRUE),
   fPerformSharedDaughterCut(kFALSE),
-  fEnablePairMonitors(kFALSE)
+  fEnablePairMonitors(kFALSE),
+  fPairLoopParticles1(),
+  fPairLoopParticles2(),
+  fPairLoopCorrFctns()
 {
   // Default constructor
   fCorrFctnCollection = new AliFemtoCorrFctnCollection;
@@ -197,7 +200,10 @@ AliFemtoSimpleAnalysis::AliFemtoSimpleAnalysis(const AliFemtoSimpleAnalysis& a):
   fMinSizePartCollection(a.fMinSizePartCollection),
   fVerbose(a.fVerbose),
   fPerformSharedDaughterCut(a.fPerformSharedDaughterCut),
-  fEnablePairMonitors(a.fEnablePairMonitors)
+  fEnablePairMonitors(a.fEnablePairMonitors),
+  fPairLoopParticles1(),
+  fPairLoopParticles2(),
+  fPairLoopCorrFctns()
 {
   /// Copy constructor
 
@@ -527,7 +533,7 @@ void AliFemtoSimpleAnalysis::ProcessEvent(const AliFemtoEvent* hbtEvent)
     collection2 = NULL;
   }
 
-  MakePairs("real", collection1, collection2, EnablePairMonitors());
+  MakePairs(kRealPairs, collection1, collection2, EnablePairMonitors());
 
   if (fVerbose) {
     cout << "AliFemtoSimpleAnalysis::ProcessEvent() - reals done ";
@@ -542,15 +548,15 @@ void AliFemtoSimpleAnalysis::ProcessEvent(const AliFemtoEvent* hbtEvent)
 
     // If identical - only mix the first particle collections
     if (AnalyzeIdenticalParticles()) {
-      MakePairs("mixed", collection1, storedEvent->FirstParticleCollection());
+      MakePairs(kMixedPairs, collection1, storedEvent->FirstParticleCollection());
 
     // If non-identical - mix both combinations of first and second particles
     } else {
-        MakePairs("mixed", collection1,
-                           storedEvent->SecondParticleCollection());
+        MakePairs(kMixedPairs, collection1,
+                               storedEvent->SecondParticleCollection());
 
-        MakePairs("mixed", storedEvent->FirstParticleCollection(),
-                           collection2);
+        MakePairs(kMixedPairs, storedEvent->FirstParticleCollection(),
+                               collection2);
     }
   }
 
@@ -572,110 +578,132 @@ void AliFemtoSimpleAnalysis::ProcessEvent(const AliFemtoEvent* hbtEvent)
 }
 
 //_________________________
-void AliFemtoSimpleAnalysis::MakePairs(const char* typeIn,
-                                       AliFemtoParticleCollection *partCollection1,
-                                       AliFemtoParticleCollection *partCollection2,
-                                       Bool_t enablePairMonitors)
+/// Pair loop of MakePairs(), instantiated for real (mixed = false) and
+/// mixed (mixed = true) pairs.
+///
+/// If particles2 is NULL, pairs are made within particles1 and the order of
+/// the two particles is swapped every pair, starting with swpart.
+template <bool mixed>
+static void MakePairsOfType(const std::vector<AliFemtoParticle*> &particles1,
+                            const std::vector<AliFemtoParticle*> *particles2,
+                            bool swpart,
+                            AliFemtoPair &pair,
+                            AliFemtoPairCut *pairCut,
+                            const std::vector<AliFemtoCorrFctn*> &corrFctns,
+                            Bool_t enablePairMonitors)
 {
-/// Build pairs, check pair cuts, and call CFs' AddRealPair() or
-/// AddMixedPair() methods. If no second particle collection is
-/// specfied, make pairs within first particle collection.
-
-  const string type = typeIn;
-
-  //  int swpart = ((long int) partCollection1) % 2;
+  const size_t nParticles1 = particles1.size(),
+               nCorrFctns = corrFctns.size();
 
-  // Used to swap particle 1 & 2 in identical-particle analysis
-  // to avoid any implicit ordering in the event collection
-  // "Seed" this here.
-  bool swpart = fNeventsProcessed % 2;
+  // If we are only iterating over one particle collection, the inner loop
+  // runs over all particles after the outer one, and the outer loop skips
+  // the last entry.
+  const size_t nOuter = particles2 ? nParticles1
+                                   : (nParticles1 > 0 ? nParticles1 - 1 : 0);
 
-  // Setup iterator ranges
-  //
-  // The outer loop alway starts at beginning of particle collection 1.
-  // * If we are iterating over both particle collections, then the loop simply
-  // runs through both from beginning to end.
-  // * If we are only iterating over one particle collection, the inner loop
-  // loops over all particles between the outer iterator and the end of the
-  // collection. The outer loop must skip the last entry of the list.
-  AliFemtoParticleConstIterator tStartOuterLoop = partCollection1->begin(),
-                                tEndOuterLoop = partCollection1->end(),
-                                tStartInnerLoop,
-                                tEndInnerLoop;
-
-  if (partCollection2) {                         // Two collections:
-    tStartInnerLoop = partCollection2->begin();  //   Full inner & outer loops
-    tEndInnerLoop   = partCollection2->end();    //
-  }
-  else {                                         // One collection:
-    tEndOuterLoop--;                             //   Outer loop goes to next-to-last particle
-    tEndInnerLoop = partCollection1->end() ;     //   Inner loop goes to last particle
-  }
-
-  // Create the pair outside the loop - only allocate once
-  AliFemtoPair* tPair = new AliFemtoPair;
-
-  // Begin the outer loop
-  for (AliFemtoParticleConstIterator tPartIter1 = tStartOuterLoop;
-                                     tPartIter1 != tEndOuterLoop;
-                                     ++tPartIter1) {
-
-    // If analyzing identical particles, start inner loop at the particle
-    // after the current outer loop position, (loops until end)
-    if (!partCollection2) {
-      tStartInnerLoop = tPartIter1;
-      tStartInnerLoop++;
-    }
+  for (size_t i = 0; i < nOuter; ++i) {
+    AliFemtoParticle *particle1 = particles1[i];
 
     // If we have two collections - set the first track
-    if (partCollection2 != NULL) {
-      tPair->SetTrack1(*tPartIter1);
+    if (particles2) {
+      pair.SetTrack1(particle1);
     }
 
-    // Begin the inner loop
-    for (AliFemtoParticleConstIterator tPartIter2 = tStartInnerLoop;
-                                       tPartIter2 != tEndInnerLoop;
-                                     ++tPartIter2) {
+    const std::vector<AliFemtoParticle*> &inner = particles2 ? *particles2 : particles1;
+    const size_t nInner = inner.size();
+
+    for (size_t j = particles2 ? 0 : i + 1; j < nInner; ++j) {
+      AliFemtoParticle *particle2 = inner[j];
+
       // If we have two collections - only set the second track
-      if (partCollection2 != NULL) {
-        tPair->SetTrack2(*tPartIter2);
+      if (particles2) {
+        pair.SetTrack2(particle2);
 
       // Swap between first and second particles to avoid biased ordering
       } else {
-        tPair->SetTrack1(swpart ? *tPartIter2 : *tPartIter1);
-        tPair->SetTrack2(swpart ? *tPartIter1 : *tPartIter2);
+        pair.SetTrack1(swpart ? particle2 : particle1);
+        pair.SetTrack2(swpart ? particle1 : particle2);
         swpart = !swpart;
       }
 
       // check if the pair passes the cut
-      bool tmpPassPair = fPairCut->Pass(tPair);
+      bool tmpPassPair = pairCut->Pass(&pair);
 
       // This is a condition for speed reasons
       if (enablePairMonitors) {
-        fPairCut->FillCutMonitor(tPair, tmpPassPair);
+        pairCut->FillCutMonitor(&pair, tmpPassPair);
       }
 
-      // If pair passes cut, loop over CF's and add pair to real/mixed
+      // If pair passes cut, loop over CF's and add pair to real/mixed;
+      // the pair caches its kinematics, so they are calculated only once
+      // for all CFs
       if (tmpPassPair) {
-        for (AliFemtoCorrFctnIterator tCorrFctnIter = fCorrFctnCollection->begin();
-                                      tCorrFctnIter != fCorrFctnCollection->end();
-                                    ++tCorrFctnIter) {
-
-          AliFemtoCorrFctn* tCorrFctn = *tCorrFctnIter;
-
-          if (type == "real")
-            tCorrFctn->AddRealPair(tPair);
-          else if(type == "mixed")
-            tCorrFctn->AddMixedPair(tPair);
+        for (size_t k = 0; k < nCorrFctns; ++k) {
+          if (mixed)
+            corrFctns[k]->AddMixedPair(&pair);
           else
-            cout << "Problem with pair type, type = " << type << endl;
-        } // loop over corellatoin functions
+            corrFctns[k]->AddRealPair(&pair);
+        }
       }
     }    // loop over second particle
   }      // loop over first particle
+}
+
+void AliFemtoSimpleAnalysis::MakePairs(const char* typeIn,
+                                       AliFemtoParticleCollection *partCollection1,
+                                       AliFemtoParticleCollection *partCollection2,
+                                       Bool_t enablePairMonitors)
+{
+/// Build pairs, check pair cuts, and call CFs' AddRealPair() or
+/// AddMixedPair() methods. If no second particle collection is
+/// specfied, make pairs within first particle collection.
+
+  const string type = typeIn;
+
+  if (type == "real") {
+    MakePairs(kRealPairs, partCollection1, partCollection2, enablePairMonitors);
+  } else if (type == "mixed") {
+    MakePairs(kMixedPairs, partCollection1, partCollection2, enablePairMonitors);
+  } else {
+    cout << "Problem with pair type, type = " << type << endl;
+  }
+}
+
+void AliFemtoSimpleAnalysis::MakePairs(AliFemtoPairType type,
+                                       AliFemtoParticleCollection *partCollection1,
+                                       AliFemtoParticleCollection *partCollection2,
+                                       Bool_t enablePairMonitors)
+{
+/// Build pairs, check pair cuts, and call CFs' AddRealPair() or
+/// AddMixedPair() methods. If no second particle collection is
+/// specfied, make pairs within first particle collection.
+///
+/// The particle collections and correlation functions are copied into
+/// contiguous buffers, which are reused between calls, before the pair loop.
+
+  // Used to swap particle 1 & 2 in identical-particle analysis
+  // to avoid any implicit ordering in the event collection
+  // "Seed" this here.
+  bool swpart = fNeventsProcessed % 2;
+
+  fPairLoopParticles1.assign(partCollection1->begin(), partCollection1->end());
+  if (partCollection2) {
+    fPairLoopParticles2.assign(partCollection2->begin(), partCollection2->end());
+  }
+  fPairLoopCorrFctns.assign(fCorrFctnCollection->begin(), fCorrFctnCollection->end());
+
+  // Create the pair outside the loop - only once per call
+  AliFemtoPair tPair;
 
-  // we are done with the pair
-  delete tPair;
+  const std::vector<AliFemtoParticle*> *particles2 = partCollection2 ? &fPairLoopParticles2 : NULL;
+
+  if (type == kMixedPairs) {
+    MakePairsOfType<true>(fPairLoopParticles1, particles2, swpart, tPair,
+                          fPairCut, fPairLoopCorrFctns, enablePairMonitors);
+  } else {
+    MakePairsOfType<false>(fPairLoopParticles1, particles2, swpart, tPair,
+                           fPairCut, fPairLoopCorrFctns, enablePairMonitors);
+  }
 }
 //_________________________
 void AliFemtoSimpleAnalysis::EventBegin(const AliFemtoEvent* ev)
@@ -16,6 +16,8 @@
 #include "AliFemtoV0SharedDaughterCut.h"
 #include "AliFemtoXiSharedDaughterCut.h"
 
+#include <vector>
+
 class AliFemtoPicoEventCollectionVectorHideAway;
 class AliFemtoPicoEvent;
 
@@ -159,6 +161,17 @@ protected:
                  AliFemtoParticleCollection* ParticlesPssingCut2=NULL,
                  Bool_t enablePairMonitors=kFALSE);
 
+  /// Which method of the correlation functions receives the pairs
+  enum AliFemtoPairType { kRealPairs, kMixedPairs };
+
+  /// Same as above, with the pair type given as an enum. The pair loop is
+  /// instantiated separately for real and mixed pairs, so the choice of
+  /// AddRealPair/AddMixedPair is not repeated for every pair and CF.
+  void MakePairs(AliFemtoPairType type,
+                 AliFemtoParticleCollection* ParticlesPassingCut1,
+                 AliFemtoParticleCollection* ParticlesPssingCut2=NULL,
+                 Bool_t enablePairMonitors=kFALSE);
+
   AliFemtoPicoEventCollectionVectorHideAway* fPicoEventCollectionVectorHideAway; //!<! Mixing Buffer used for Analyses which wrap this one
 
   AliFemtoPairCut*             fPairCut;             ///< cut applied to pairs
@@ -178,6 +191,10 @@ protected:
   Bool_t fPerformSharedDaughterCut;
   Bool_t fEnablePairMonitors;
 
+  std::vector<AliFemtoParticle*> fPairLoopParticles1; //!<! contiguous copy of the first collection used by MakePairs
+  std::vector<AliFemtoParticle*> fPairLoopParticles2; //!<! contiguous copy of the second collection used by MakePairs
+  std::vector<AliFemtoCorrFctn*> fPairLoopCorrFctns;  //!<! contiguous copy of fCorrFctnCollection used by MakePairs
+
 #ifdef __ROOT__
   /// \cond CLASSIMP
   ClassDef(AliFemtoSimpleAnalysis, 0);
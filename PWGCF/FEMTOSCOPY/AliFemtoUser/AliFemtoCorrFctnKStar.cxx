@@ -443,10 +443,8 @@ void AliFemtoCorrFctnKStar::Set3dBins(int aNbinsKStarOut,  double aKStarOutMin,
 //____________________________
 float AliFemtoCorrFctnKStar::CalcMt(const AliFemtoPair* aPair)
 {
-  const double mass_1 = aPair->Track1()->FourMomentum().m(),
-               mass_2 = aPair->Track2()->FourMomentum().m();
-  const double avg_mass = (mass_1 + mass_2) / 2.0;
-  return TMath::Sqrt(avg_mass * avg_mass + ::pow(aPair->KT(), 2));
+  // mT for the average mass of the pair, cached by the pair
+  return aPair->MT();
 }
 
 //____________________________
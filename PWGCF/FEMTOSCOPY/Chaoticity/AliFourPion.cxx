@@ -154,23 +154,6 @@ AliAnalysisTaskSE(),
   farrP1(),
   farrP2(),
   fIC(),
-  fDefaultsCharSwitch(),
-  fLowQPairSwitch_E0E0(),
-  fLowQPairSwitch_E0E1(),
-  fLowQPairSwitch_E0E2(),
-  fLowQPairSwitch_E0E3(),
-  fLowQPairSwitch_E1E1(),
-  fLowQPairSwitch_E1E2(),
-  fLowQPairSwitch_E1E3(),
-  fLowQPairSwitch_E2E3(),
-  fNormQPairSwitch_E0E0(),
-  fNormQPairSwitch_E0E1(),
-  fNormQPairSwitch_E0E2(),
-  fNormQPairSwitch_E0E3(),
-  fNormQPairSwitch_E1E1(),
-  fNormQPairSwitch_E1E2(),
-  fNormQPairSwitch_E1E3(),
-  fNormQPairSwitch_E2E3(),
   fMomResC2SC(0x0),
   fMomResC2MC(0x0),
   fWeightmuonCorrection(0x0),
@@ -179,6 +162,11 @@ AliAnalysisTaskSE(),
   fqLongFcn(0x0)
 {
   // Default constructor
+
+  for(Int_t comb=0; comb<kNPairCombs; comb++){
+    fPairN[0][comb]=0; fPairN[1][comb]=0;
+    fPairRows[comb]=0;
+  }
   for(Int_t mb=0; mb<fMbins; mb++){
     for(Int_t edB=0; edB<fEDbins; edB++){
       for(Int_t c1=0; c1<2; c1++){
@@ -371,23 +359,6 @@ AliFourPion::AliFourPion(const Char_t *name)
   farrP1(),
   farrP2(),
   fIC(),
-  fDefaultsCharSwitch(),
-  fLowQPairSwitch_E0E0(),
-  fLowQPairSwitch_E0E1(),
-  fLowQPairSwitch_E0E2(),
-  fLowQPairSwitch_E0E3(),
-  fLowQPairSwitch_E1E1(),
-  fLowQPairSwitch_E1E2(),
-  fLowQPairSwitch_E1E3(),
-  fLowQPairSwitch_E2E3(),
-  fNormQPairSwitch_E0E0(),
-  fNormQPairSwitch_E0E1(),
-  fNormQPairSwitch_E0E2(),
-  fNormQPairSwitch_E0E3(),
-  fNormQPairSwitch_E1E1(),
-  fNormQPairSwitch_E1E2(),
-  fNormQPairSwitch_E1E3(),
-  fNormQPairSwitch_E2E3(),
   fMomResC2SC(0x0),
   fMomResC2MC(0x0),
   fWeightmuonCorrection(0x0),
@@ -397,6 +368,11 @@ AliFourPion::AliFourPion(const Char_t *name)
 {
   // Main constructor
   fAODcase=kTRUE;
+
+  for(Int_t comb=0; comb<kNPairCombs; comb++){
+    fPairN[0][comb]=0; fPairN[1][comb]=0;
+    fPairRows[comb]=0;
+  }
   
   
 
@@ -593,23 +569,6 @@ AliFourPion::AliFourPion(const AliFourPion &obj)
     farrP1(),
     farrP2(),
     fIC(),
-    fDefaultsCharSwitch(),
-    fLowQPairSwitch_E0E0(),
-    fLowQPairSwitch_E0E1(),
-    fLowQPairSwitch_E0E2(),
-    fLowQPairSwitch_E0E3(),
-    fLowQPairSwitch_E1E1(),
-    fLowQPairSwitch_E1E2(),
-    fLowQPairSwitch_E1E3(),
-    fLowQPairSwitch_E2E3(),
-    fNormQPairSwitch_E0E0(),
-    fNormQPairSwitch_E0E1(),
-    fNormQPairSwitch_E0E2(),
-    fNormQPairSwitch_E0E3(),
-    fNormQPairSwitch_E1E1(),
-    fNormQPairSwitch_E1E2(),
-    fNormQPairSwitch_E1E3(),
-    fNormQPairSwitch_E2E3(),
     fMomResC2SC(obj.fMomResC2SC),
     fMomResC2MC(obj.fMomResC2MC),
     fWeightmuonCorrection(obj.fWeightmuonCorrection),
@@ -618,6 +577,11 @@ AliFourPion::AliFourPion(const AliFourPion &obj)
     fqLongFcn(obj.fqLongFcn)
 {
   // Copy Constructor
+
+  for(Int_t comb=0; comb<kNPairCombs; comb++){
+    fPairN[0][comb]=0; fPairN[1][comb]=0;
+    fPairRows[comb]=0;
+  }
   
   for(Int_t i=0; i<2; i++){
     fPbPbc3FitEA[i]=obj.fPbPbc3FitEA[i];
@@ -805,25 +769,6 @@ AliFourPion::~AliFourPion()
     if(fppc3FitEA[i]) delete fppc3FitEA[i];
   }
   
-  for(Int_t j=0; j<kMultLimitPbPb; j++){
-    if(fLowQPairSwitch_E0E0[j]) delete [] fLowQPairSwitch_E0E0[j];
-    if(fLowQPairSwitch_E0E1[j]) delete [] fLowQPairSwitch_E0E1[j];
-    if(fLowQPairSwitch_E0E2[j]) delete [] fLowQPairSwitch_E0E2[j];
-    if(fLowQPairSwitch_E0E3[j]) delete [] fLowQPairSwitch_E0E3[j];
-    if(fLowQPairSwitch_E1E1[j]) delete [] fLowQPairSwitch_E1E1[j];
-    if(fLowQPairSwitch_E1E2[j]) delete [] fLowQPairSwitch_E1E2[j];
-    if(fLowQPairSwitch_E1E3[j]) delete [] fLowQPairSwitch_E1E3[j];
-    if(fLowQPairSwitch_E2E3[j]) delete [] fLowQPairSwitch_E2E3[j];
-    //
-    if(fNormQPairSwitch_E0E0[j]) delete [] fNormQPairSwitch_E0E0[j];
-    if(fNormQPairSwitch_E0E1[j]) delete [] fNormQPairSwitch_E0E1[j];
-    if(fNormQPairSwitch_E0E2[j]) delete [] fNormQPairSwitch_E0E2[j];
-    if(fNormQPairSwitch_E0E3[j]) delete [] fNormQPairSwitch_E0E3[j];
-    if(fNormQPairSwitch_E1E1[j]) delete [] fNormQPairSwitch_E1E1[j];
-    if(fNormQPairSwitch_E1E2[j]) delete [] fNormQPairSwitch_E1E2[j];
-    if(fNormQPairSwitch_E1E3[j]) delete [] fNormQPairSwitch_E1E3[j];
-    if(fNormQPairSwitch_E2E3[j]) delete [] fNormQPairSwitch_E2E3[j];
-  }
   
   //
   for(Int_t mb=0; mb<fMbins; mb++){
@@ -1038,26 +983,13 @@ void AliFourPion::ParInit()
     }
   }
   
-  for(Int_t i=0; i<kMultLimitPbPb; i++) fDefaultsCharSwitch[i]='0';
-  for(Int_t i=0; i<kMultLimitPbPb; i++) {
-    fLowQPairSwitch_E0E0[i] = new TArrayC(kMultLimitPbPb,fDefaultsCharSwitch);
-    fLowQPairSwitch_E0E1[i] = new TArrayC(kMultLimitPbPb,fDefaultsCharSwitch);
-    fLowQPairSwitch_E0E2[i] = new TArrayC(kMultLimitPbPb,fDefaultsCharSwitch);
-    fLowQPairSwitch_E0E3[i] = new TArrayC(kMultLimitPbPb,fDefaultsCharSwitch);
-    fLowQPairSwitch_E1E1[i] = new TArrayC(kMultLimitPbPb,fDefaultsCharSwitch);
-    fLowQPairSwitch_E1E2[i] = new TArrayC(kMultLimitPbPb,fDefaultsCharSwitch);
-    fLowQPairSwitch_E1E3[i] = new TArrayC(kMultLimitPbPb,fDefaultsCharSwitch);
-    fLowQPairSwitch_E2E3[i] = new TArrayC(kMultLimitPbPb,fDefaultsCharSwitch);
-    //
-    fNormQPairSwitch_E0E0[i] = new TArrayC(kMultLimitPbPb,fDefaultsCharSwitch);
-    fNormQPairSwitch_E0E1[i] = new TArrayC(kMultLimitPbPb,fDefaultsCharSwitch);
-    fNormQPairSwitch_E0E2[i] = new TArrayC(kMultLimitPbPb,fDefaultsCharSwitch);
-    fNormQPairSwitch_E0E3[i] = new TArrayC(kMultLimitPbPb,fDefaultsCharSwitch);
-    fNormQPairSwitch_E1E1[i] = new TArrayC(kMultLimitPbPb,fDefaultsCharSwitch);
-    fNormQPairSwitch_E1E2[i] = new TArrayC(kMultLimitPbPb,fDefaultsCharSwitch);
-    fNormQPairSwitch_E1E3[i] = new TArrayC(kMultLimitPbPb,fDefaultsCharSwitch);
-    fNormQPairSwitch_E2E3[i] = new TArrayC(kMultLimitPbPb,fDefaultsCharSwitch);
+  // Pair partner lists, the pair lists grow with the number of close pairs
+  for(Int_t comb=0; comb<kNPairCombs; comb++) {
+    fPairFirst[0][comb].Set(kMultLimitPbPb+1);
+    fPairFirst[1][comb].Set(kMultLimitPbPb+1);
   }
+  fPairCandidates3.Set(kMultLimitPbPb);
+  fPairCandidates4.Set(kMultLimitPbPb);
   
   fTempStruct = new AliFourPionTrackStruct[fMultLimit];
   
@@ -2691,24 +2623,9 @@ void AliFourPion::UserExec(Option_t *)
   Int_t EDindex3=0, EDindex4=0;
 
   // reset to defaults
-  for(Int_t i=0; i<fMultLimit; i++) {
-    fLowQPairSwitch_E0E0[i]->Set(kMultLimitPbPb,fDefaultsCharSwitch);
-    fLowQPairSwitch_E0E1[i]->Set(kMultLimitPbPb,fDefaultsCharSwitch);
-    fLowQPairSwitch_E0E2[i]->Set(kMultLimitPbPb,fDefaultsCharSwitch);
-    fLowQPairSwitch_E0E3[i]->Set(kMultLimitPbPb,fDefaultsCharSwitch);
-    fLowQPairSwitch_E1E1[i]->Set(kMultLimitPbPb,fDefaultsCharSwitch);
-    fLowQPairSwitch_E1E2[i]->Set(kMultLimitPbPb,fDefaultsCharSwitch);
-    fLowQPairSwitch_E1E3[i]->Set(kMultLimitPbPb,fDefaultsCharSwitch);
-    fLowQPairSwitch_E2E3[i]->Set(kMultLimitPbPb,fDefaultsCharSwitch);
-    //
-    fNormQPairSwitch_E0E0[i]->Set(kMultLimitPbPb,fDefaultsCharSwitch);
-    fNormQPairSwitch_E0E1[i]->Set(kMultLimitPbPb,fDefaultsCharSwitch);
-    fNormQPairSwitch_E0E2[i]->Set(kMultLimitPbPb,fDefaultsCharSwitch);
-    fNormQPairSwitch_E0E3[i]->Set(kMultLimitPbPb,fDefaultsCharSwitch);
-    fNormQPairSwitch_E1E1[i]->Set(kMultLimitPbPb,fDefaultsCharSwitch);
-    fNormQPairSwitch_E1E2[i]->Set(kMultLimitPbPb,fDefaultsCharSwitch);
-    fNormQPairSwitch_E1E3[i]->Set(kMultLimitPbPb,fDefaultsCharSwitch);
-    fNormQPairSwitch_E2E3[i]->Set(kMultLimitPbPb,fDefaultsCharSwitch);
+  for(Int_t comb=0; comb<kNPairCombs; comb++) {
+    fPairN[0][comb]=0; fPairN[1][comb]=0;
+    fPairRows[comb]=0;
   }
  
   
@@ -2718,8 +2635,10 @@ void AliFourPion::UserExec(Option_t *)
   for(Int_t en1=0; en1<=2; en1++){// 1st event number (en1=0 is the same event as current event)
     for(Int_t en2=en1; en2<=3; en2++){// 2nd event number (en2=0 is the same event as current event)
       if(en1>1 && en1==en2) continue;
+      Int_t comb = en1==0 ? en2 : en1+en2+2;// kE0E0 ... kE2E3
       
       for (Int_t i=0; i<(fEvt+en1)->fNtracks; i++) {// 1st particle
+	StartPairRow(comb, i);
 	for (Int_t j=i+1; j<(fEvt+en2)->fNtracks; j++) {// 2nd particle
 	  
 	  
@@ -2842,29 +2761,12 @@ void AliFourPion::UserExec(Option_t *)
 	  
 	  //////////////////////////////////////////////////////////////////////////////
 	 
-	  if(qinv12 <= fQcut) {
-	    if(en1==0 && en2==0) {fLowQPairSwitch_E0E0[i]->AddAt('1',j);}
-	    if(en1==0 && en2==1) {fLowQPairSwitch_E0E1[i]->AddAt('1',j);}
-	    if(en1==0 && en2==2) {fLowQPairSwitch_E0E2[i]->AddAt('1',j);}
-	    if(en1==0 && en2==3) {fLowQPairSwitch_E0E3[i]->AddAt('1',j);}
-	    if(en1==1 && en2==1) {fLowQPairSwitch_E1E1[i]->AddAt('1',j);}
-	    if(en1==1 && en2==2) {fLowQPairSwitch_E1E2[i]->AddAt('1',j);}
-	    if(en1==1 && en2==3) {fLowQPairSwitch_E1E3[i]->AddAt('1',j);}
-	    if(en1==2 && en2==3) {fLowQPairSwitch_E2E3[i]->AddAt('1',j);}
-	  }
-	  if((qinv12 >= fNormQcutLow) && (qinv12 < fNormQcutHigh)) {
-	    if(en1==0 && en2==0) {fNormQPairSwitch_E0E0[i]->AddAt('1',j);}
-	    if(en1==0 && en2==1) {fNormQPairSwitch_E0E1[i]->AddAt('1',j);}
-	    if(en1==0 && en2==2) {fNormQPairSwitch_E0E2[i]->AddAt('1',j);}
-	    if(en1==0 && en2==3) {fNormQPairSwitch_E0E3[i]->AddAt('1',j);}
-	    if(en1==1 && en2==1) {fNormQPairSwitch_E1E1[i]->AddAt('1',j);}
-	    if(en1==1 && en2==2) {fNormQPairSwitch_E1E2[i]->AddAt('1',j);}
-	    if(en1==1 && en2==3) {fNormQPairSwitch_E1E3[i]->AddAt('1',j);}
-	    if(en1==2 && en2==3) {fNormQPairSwitch_E2E3[i]->AddAt('1',j);}
-	  }
+	  if(qinv12 <= fQcut) AddPair(0, comb, j);
+	  if((qinv12 >= fNormQcutLow) && (qinv12 < fNormQcutHigh)) AddPair(1, comb, j);
 	  
 	}
       }
+      EndPairRows(comb, (fEvt+en1)->fNtracks);
     }
   }
     
@@ -2904,26 +2806,22 @@ void AliFourPion::UserExec(Option_t *)
 	  pVect1[3]=(fEvt)->fTracks[i].fP[2];
 	  ch1 = Int_t(((fEvt)->fTracks[i].fCharge + 1)/2.);
 	  
-	  for (Int_t j=i+1; j<(fEvt+en2)->fNtracks; j++) {// 2nd particle
-	    if(en2==0) {if(fNormQPairSwitch_E0E0[i]->At(j)=='0') continue;}
-	    else {if(fNormQPairSwitch_E0E1[i]->At(j)=='0') continue;}
+	  Int_t nPartners2=0;
+	  const Int_t *partners2 = PairPartners(1, en2==0 ? kE0E0 : kE0E1, i, nPartners2);
+	  for (Int_t ij=0; ij<nPartners2; ij++) {// 2nd particle
+	    Int_t j = partners2[ij];
 	    
 	    pVect2[1]=(fEvt+en2)->fTracks[j].fP[0];
 	    pVect2[2]=(fEvt+en2)->fTracks[j].fP[1];
 	    pVect2[3]=(fEvt+en2)->fTracks[j].fP[2];
 	    ch2 = Int_t(((fEvt+en2)->fTracks[j].fCharge + 1)/2.);
 	   
-	    for (Int_t k=j+1; k<(fEvt+en3)->fNtracks; k++) {// 3rd particle
-	      if(en3==0) {
-		if(fNormQPairSwitch_E0E0[i]->At(k)=='0') continue;
-		if(fNormQPairSwitch_E0E0[j]->At(k)=='0') continue;
-	      }else if(en3==1){
-		if(fNormQPairSwitch_E0E1[i]->At(k)=='0') continue;
-		if(fNormQPairSwitch_E0E1[j]->At(k)=='0') continue;
-	      }else{
-		if(fNormQPairSwitch_E0E2[i]->At(k)=='0') continue;
-		if(fNormQPairSwitch_E1E2[j]->At(k)=='0') continue;
-	      }
+	    Int_t nPartners3=0;
+	    if(en3==0) nPartners3 = CommonPairPartners(1, kE0E0, i, kE0E0, j, fPairCandidates3);
+	    else if(en3==1) nPartners3 = CommonPairPartners(1, kE0E1, i, kE0E1, j, fPairCandidates3);
+	    else nPartners3 = CommonPairPartners(1, kE0E2, i, kE1E2, j, fPairCandidates3);
+	    for (Int_t ik=0; ik<nPartners3; ik++) {// 3rd particle
+	      Int_t k = fPairCandidates3[ik];
 	      
 	      pVect3[1]=(fEvt+en3)->fTracks[k].fP[0];
 	      pVect3[2]=(fEvt+en3)->fTracks[k].fP[1];
@@ -2952,30 +2850,15 @@ void AliFourPion::UserExec(Option_t *)
 	      }
 	      
 	      
-	      for (Int_t l=k+1; l<(fEvt+en4)->fNtracks; l++) {// 4th particle
-		if(en4==0){
-		  if(fNormQPairSwitch_E0E0[i]->At(l)=='0') continue;
-		  if(fNormQPairSwitch_E0E0[j]->At(l)=='0') continue;
-		  if(fNormQPairSwitch_E0E0[k]->At(l)=='0') continue;
-		}else if(en4==1){
-		  if(en3==0){
-		    if(fNormQPairSwitch_E0E1[i]->At(l)=='0') continue;
-		    if(fNormQPairSwitch_E0E1[j]->At(l)=='0') continue;
-		    if(fNormQPairSwitch_E0E1[k]->At(l)=='0') continue;
-		  }else{
-		    if(fNormQPairSwitch_E0E1[i]->At(l)=='0') continue;
-		    if(fNormQPairSwitch_E0E1[j]->At(l)=='0') continue;
-		    if(fNormQPairSwitch_E1E1[k]->At(l)=='0') continue;
-		  }
-		}else if(en4==2){
-		  if(fNormQPairSwitch_E0E2[i]->At(l)=='0') continue;
-		  if(fNormQPairSwitch_E0E2[j]->At(l)=='0') continue;
-		  if(fNormQPairSwitch_E1E2[k]->At(l)=='0') continue;
-		}else{
-		  if(fNormQPairSwitch_E0E3[i]->At(l)=='0') continue;
-		  if(fNormQPairSwitch_E1E3[j]->At(l)=='0') continue;
-		  if(fNormQPairSwitch_E2E3[k]->At(l)=='0') continue;
-		}
+	      Int_t nPartners4=0;
+	      if(en4==0) nPartners4 = CommonPairPartners(1, kE0E0, i, kE0E0, j, kE0E0, k, fPairCandidates4);
+	      else if(en4==1){
+		if(en3==0) nPartners4 = CommonPairPartners(1, kE0E1, i, kE0E1, j, kE0E1, k, fPairCandidates4);
+		else nPartners4 = CommonPairPartners(1, kE0E1, i, kE0E1, j, kE1E1, k, fPairCandidates4);
+	      }else if(en4==2) nPartners4 = CommonPairPartners(1, kE0E2, i, kE0E2, j, kE1E2, k, fPairCandidates4);
+	      else nPartners4 = CommonPairPartners(1, kE0E3, i, kE1E3, j, kE2E3, k, fPairCandidates4);
+	      for (Int_t il=0; il<nPartners4; il++) {// 4th particle
+		Int_t l = fPairCandidates4[il];
 		
 		pVect4[1]=(fEvt+en4)->fTracks[l].fP[0];
 		pVect4[2]=(fEvt+en4)->fTracks[l].fP[1];
@@ -3050,9 +2933,10 @@ void AliFourPion::UserExec(Option_t *)
 	    if((fEvt)->fTracks[i].fPt > fMaxPt) continue;
 
 	    /////////////////////////////////////////////////////////////
-	    for (Int_t j=i+1; j<(fEvt+en2)->fNtracks; j++) {// 2nd particle
-	      if(en2==0) {if(fLowQPairSwitch_E0E0[i]->At(j)=='0') continue;}
-	      else {if(fLowQPairSwitch_E0E1[i]->At(j)=='0') continue;}
+	    Int_t nPartners2=0;
+	    const Int_t *partners2 = PairPartners(0, en2==0 ? kE0E0 : kE0E1, i, nPartners2);
+	    for (Int_t ij=0; ij<nPartners2; ij++) {// 2nd particle
+	      Int_t j = partners2[ij];
 	      if((fEvt+en2)->fTracks[j].fPt < fMinPt) continue; 
 	      if((fEvt+en2)->fTracks[j].fPt > fMaxPt) continue;
 	      
@@ -3257,17 +3141,12 @@ void AliFourPion::UserExec(Option_t *)
 	     
 	     
 	      /////////////////////////////////////////////////////////////
-	      for (Int_t k=j+1; k<(fEvt+en3)->fNtracks; k++) {// 3rd particle
-		if(en3==0) {
-		  if(fLowQPairSwitch_E0E0[i]->At(k)=='0') continue;
-		  if(fLowQPairSwitch_E0E0[j]->At(k)=='0') continue;
-		}else if(en3==1){
-		  if(fLowQPairSwitch_E0E1[i]->At(k)=='0') continue;
-		  if(fLowQPairSwitch_E0E1[j]->At(k)=='0') continue;
-		}else{
-		  if(fLowQPairSwitch_E0E2[i]->At(k)=='0') continue;
-		  if(fLowQPairSwitch_E1E2[j]->At(k)=='0') continue;
-		}
+	      Int_t nPartners3=0;
+	      if(en3==0) nPartners3 = CommonPairPartners(0, kE0E0, i, kE0E0, j, fPairCandidates3);
+	      else if(en3==1) nPartners3 = CommonPairPartners(0, kE0E1, i, kE0E1, j, fPairCandidates3);
+	      else nPartners3 = CommonPairPartners(0, kE0E2, i, kE1E2, j, fPairCandidates3);
+	      for (Int_t ik=0; ik<nPartners3; ik++) {// 3rd particle
+		Int_t k = fPairCandidates3[ik];
 		if((fEvt+en3)->fTracks[k].fPt < fMinPt) continue; 
 		if((fEvt+en3)->fTracks[k].fPt > fMaxPt) continue;
 
@@ -3655,30 +3534,15 @@ void AliFourPion::UserExec(Option_t *)
 		
 		
 		/////////////////////////////////////////////////////////////
-		for (Int_t l=k+1; l<(fEvt+en4)->fNtracks; l++) {// 4th particle
-		  if(en4==0){
-		    if(fLowQPairSwitch_E0E0[i]->At(l)=='0') continue;
-		    if(fLowQPairSwitch_E0E0[j]->At(l)=='0') continue;
-		    if(fLowQPairSwitch_E0E0[k]->At(l)=='0') continue;
-		  }else if(en4==1){
-		    if(en3==0){
-		      if(fLowQPairSwitch_E0E1[i]->At(l)=='0') continue;
-		      if(fLowQPairSwitch_E0E1[j]->At(l)=='0') continue;
-		      if(fLowQPairSwitch_E0E1[k]->At(l)=='0') continue;
-		    }else{ 
-		      if(fLowQPairSwitch_E0E1[i]->At(l)=='0') continue;
-		      if(fLowQPairSwitch_E0E1[j]->At(l)=='0') continue;
-		      if(fLowQPairSwitch_E1E1[k]->At(l)=='0') continue;
-		    }
-		  }else if(en4==2){
-		    if(fLowQPairSwitch_E0E2[i]->At(l)=='0') continue;
-		    if(fLowQPairSwitch_E0E2[j]->At(l)=='0') continue;
-		    if(fLowQPairSwitch_E1E2[k]->At(l)=='0') continue;
-		  }else{
-		    if(fLowQPairSwitch_E0E3[i]->At(l)=='0') continue;
-		    if(fLowQPairSwitch_E1E3[j]->At(l)=='0') continue;
-		    if(fLowQPairSwitch_E2E3[k]->At(l)=='0') continue;
-		  }
+		Int_t nPartners4=0;
+		if(en4==0) nPartners4 = CommonPairPartners(0, kE0E0, i, kE0E0, j, kE0E0, k, fPairCandidates4);
+		else if(en4==1){
+		  if(en3==0) nPartners4 = CommonPairPartners(0, kE0E1, i, kE0E1, j, kE0E1, k, fPairCandidates4);
+		  else nPartners4 = CommonPairPartners(0, kE0E1, i, kE0E1, j, kE1E1, k, fPairCandidates4);
+		}else if(en4==2) nPartners4 = CommonPairPartners(0, kE0E2, i, kE0E2, j, kE1E2, k, fPairCandidates4);
+		else nPartners4 = CommonPairPartners(0, kE0E3, i, kE1E3, j, kE2E3, k, fPairCandidates4);
+		for (Int_t il=0; il<nPartners4; il++) {// 4th particle
+		  Int_t l = fPairCandidates4[il];
 		  if((fEvt+en4)->fTracks[l].fPt < fMinPt) continue; 
 		  if((fEvt+en4)->fTracks[l].fPt > fMaxPt) continue;
 		  
@@ -5369,6 +5233,65 @@ void AliFourPion::SetFSIindex(Float_t R){
   }
 }
 //________________________________________________________________________
+void AliFourPion::StartPairRow(Int_t comb, Int_t i){
+  // partners of track i of the 1st event start at the current end of the pair lists
+  fPairFirst[0][comb][i] = fPairN[0][comb];
+  fPairFirst[1][comb][i] = fPairN[1][comb];
+}
+//________________________________________________________________________
+void AliFourPion::EndPairRows(Int_t comb, Int_t nRows){
+  // close the last row, nRows = number of tracks of the 1st event
+  fPairFirst[0][comb][nRows] = fPairN[0][comb];
+  fPairFirst[1][comb][nRows] = fPairN[1][comb];
+  fPairRows[comb] = nRows;
+}
+//________________________________________________________________________
+void AliFourPion::AddPair(Int_t type, Int_t comb, Int_t j){
+  // append partner j to the current row (type 0: low-q, 1: normalization-q)
+  TArrayI &list = fPairList[type][comb];
+  if(fPairN[type][comb] >= list.GetSize()) list.Set(2*list.GetSize() + kMultLimitPbPb);
+  list[fPairN[type][comb]++] = j;
+}
+//________________________________________________________________________
+const Int_t *AliFourPion::PairPartners(Int_t type, Int_t comb, Int_t i, Int_t &n) const {
+  // partners of track i, increasing order, all >i
+  n=0;
+  if(i >= fPairRows[comb]) return 0x0;
+  Int_t first = fPairFirst[type][comb][i];
+  n = fPairFirst[type][comb][i+1] - first;
+  return fPairList[type][comb].GetArray() + first;
+}
+//________________________________________________________________________
+Int_t AliFourPion::CommonPairPartners(Int_t type, Int_t comb1, Int_t i1, Int_t comb2, Int_t i2, TArrayI &out) const {
+  // partners shared by track i1 (comb1 pairs) and track i2 (comb2 pairs), kept in increasing order
+  Int_t n1=0, n2=0;
+  const Int_t *p1 = PairPartners(type, comb1, i1, n1);
+  const Int_t *p2 = PairPartners(type, comb2, i2, n2);
+  Int_t *common = out.GetArray();
+  Int_t n=0, a=0, b=0;
+  while(a<n1 && b<n2){
+    if(p1[a] < p2[b]) a++;
+    else if(p1[a] > p2[b]) b++;
+    else {common[n++] = p1[a]; a++; b++;}
+  }
+  return n;
+}
+//________________________________________________________________________
+Int_t AliFourPion::CommonPairPartners(Int_t type, Int_t comb1, Int_t i1, Int_t comb2, Int_t i2, Int_t comb3, Int_t i3, TArrayI &out) const {
+  // partners shared by the three tracks, kept in increasing order
+  Int_t n12 = CommonPairPartners(type, comb1, i1, comb2, i2, out);
+  Int_t n3=0;
+  const Int_t *p3 = PairPartners(type, comb3, i3, n3);
+  Int_t *common = out.GetArray();
+  Int_t n=0, a=0, b=0;
+  while(a<n12 && b<n3){// in place, n<=a
+    if(common[a] < p3[b]) a++;
+    else if(common[a] > p3[b]) b++;
+    else {common[n++] = common[a]; a++; b++;}
+  }
+  return n;
+}
+//________________________________________________________________________
 void AliFourPion::SetMuonCorrections(Bool_t legoCase, TH2D *tempMuon){
   if(legoCase){
     cout<<"LEGO call to SetMuonCorrections"<<endl;
@@ -32,6 +32,7 @@ class AliESDpid;
 #include "AliAODPid.h"
 #include "AliFourPionEventCollection.h"
 #include "AliCentrality.h"
+#include "TArrayI.h"
 
 class AliFourPion : public AliAnalysisTaskSE {
  public:
@@ -61,6 +62,10 @@ class AliFourPion : public AliAnalysisTaskSE {
     kRcohsteps = 7,// number of steps for coherent source radius
     kDENtypes = 4 + kRcohsteps*kGsteps // = 4 + kGsteps*RcohSteps
   };
+  enum {// event combinations (1st event, 2nd event) of the stored low-q and normalization pairs
+    kE0E0 = 0, kE0E1, kE0E2, kE0E3, kE1E1, kE1E2, kE1E3, kE2E3,
+    kNPairCombs
+  };
 
   static const Int_t fKbinsT     = 7;// Set fKstep as well !!!!
   static const Int_t fKbinsTOneD = 28;// Set fKstep as well !!!!
@@ -147,6 +152,13 @@ class AliFourPion : public AliAnalysisTaskSE {
   void SetFillBins4(Int_t, Int_t, Int_t, Int_t, Int_t&, Int_t&, Int_t&, Int_t&, Int_t, Bool_t[13]);
   void SetFSIindex(Float_t);
   //
+  void StartPairRow(Int_t, Int_t);
+  void EndPairRows(Int_t, Int_t);
+  void AddPair(Int_t, Int_t, Int_t);
+  const Int_t *PairPartners(Int_t, Int_t, Int_t, Int_t&) const;
+  Int_t CommonPairPartners(Int_t, Int_t, Int_t, Int_t, Int_t, TArrayI&) const;
+  Int_t CommonPairPartners(Int_t, Int_t, Int_t, Int_t, Int_t, Int_t, Int_t, TArrayI&) const;
+  //
   Float_t cubicInterpolate(Float_t[4], Float_t);
   Float_t nCubicInterpolate(Int_t, Float_t*, Float_t[]);
   
@@ -379,24 +391,14 @@ class AliFourPion : public AliAnalysisTaskSE {
   Float_t fIC[5][7][20];
   
   //
-  Char_t fDefaultsCharSwitch[kMultLimitPbPb];//!
-  TArrayC *fLowQPairSwitch_E0E0[kMultLimitPbPb];//!
-  TArrayC *fLowQPairSwitch_E0E1[kMultLimitPbPb];//!
-  TArrayC *fLowQPairSwitch_E0E2[kMultLimitPbPb];//!
-  TArrayC *fLowQPairSwitch_E0E3[kMultLimitPbPb];//!
-  TArrayC *fLowQPairSwitch_E1E1[kMultLimitPbPb];//!
-  TArrayC *fLowQPairSwitch_E1E2[kMultLimitPbPb];//!
-  TArrayC *fLowQPairSwitch_E1E3[kMultLimitPbPb];//!
-  TArrayC *fLowQPairSwitch_E2E3[kMultLimitPbPb];//!
-  //
-  TArrayC *fNormQPairSwitch_E0E0[kMultLimitPbPb];//!
-  TArrayC *fNormQPairSwitch_E0E1[kMultLimitPbPb];//!
-  TArrayC *fNormQPairSwitch_E0E2[kMultLimitPbPb];//!
-  TArrayC *fNormQPairSwitch_E0E3[kMultLimitPbPb];//!
-  TArrayC *fNormQPairSwitch_E1E1[kMultLimitPbPb];//!
-  TArrayC *fNormQPairSwitch_E1E2[kMultLimitPbPb];//!
-  TArrayC *fNormQPairSwitch_E1E3[kMultLimitPbPb];//!
-  TArrayC *fNormQPairSwitch_E2E3[kMultLimitPbPb];//!
+  // Low-q (0) and normalization-q (1) pairs of each event combination, as sorted partner lists:
+  // partners j>i of track i are fPairList[t][comb][fPairFirst[t][comb][i] ... fPairFirst[t][comb][i+1]-1]
+  TArrayI fPairFirst[2][kNPairCombs];//!
+  TArrayI fPairList[2][kNPairCombs];//!
+  Int_t fPairN[2][kNPairCombs];//! number of stored pairs
+  Int_t fPairRows[kNPairCombs];//! number of tracks of the 1st event
+  TArrayI fPairCandidates3;//! 3rd particle candidates
+  TArrayI fPairCandidates4;//! 4th particle candidates
 
   TF1 *fqOutFcn; //!
   TF1 *fqSideFcn; //!
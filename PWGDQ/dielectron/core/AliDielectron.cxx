@@ -158,6 +158,8 @@ AliDielectron::AliDielectron() :
   fDontClearArrays(kFALSE),
   fEventProcess(kTRUE),
   fUseGammaTracks(kTRUE),
+  fUseOwnVarContext(kFALSE),
+  fVarContext(0x0),
   fEstimatorFilename(""),
   fEstimatorObjArray(0x0),
   fTRDpidCorrectionFilename(""),
@@ -233,6 +235,8 @@ AliDielectron::AliDielectron(const char* name, const char* title) :
   fDontClearArrays(kFALSE),
   fEventProcess(kTRUE),
   fUseGammaTracks(kTRUE),
+  fUseOwnVarContext(kFALSE),
+  fVarContext(0x0),
   fEstimatorFilename(""),
   fEstimatorObjArray(0x0),
   fTRDpidCorrectionFilename(""),
@@ -268,11 +272,23 @@ AliDielectron::~AliDielectron()
   if (fPairCandidates && fEventProcess) delete fPairCandidates;
   if (fDebugTree) delete fDebugTree;
   if (fMixing) delete fMixing;
+  if (fVarContext) delete fVarContext;
   if (fSignalsMC) delete fSignalsMC;
   if (fCfManagerPair) delete fCfManagerPair;
   if (fHistoArray) delete fHistoArray;
 }
 
+//________________________________________________________________
+AliDielectronVarManager::VarContext* AliDielectron::GetVarContext()
+{
+  //
+  // Own variable context, created on first use; 0x0 if the shared context is used
+  //
+  if (!fUseOwnVarContext) return 0x0;
+  if (!fVarContext) fVarContext=new AliDielectronVarManager::VarContext;
+  return fVarContext;
+}
+
 //________________________________________________________________
 void AliDielectron::Init()
 {
@@ -348,6 +364,9 @@ void AliDielectron::Process(TObjArray *arr)
   // Process the pair array
   //
 
+  // use the own variable context, if requested; the previous one is restored on return
+  AliDielectronVarManager::ContextGuard varContextGuard(GetVarContext());
+
   // set pair arrays
   fPairCandidates = arr;
 
@@ -377,6 +396,9 @@ Bool_t AliDielectron::Process(AliVEvent *ev1, AliVEvent *ev2)
     return 0;
   }
 
+  // use the own variable context, if requested; the previous one is restored on return
+  AliDielectronVarManager::ContextGuard varContextGuard(GetVarContext());
+
   // modify event numbers in MC so that we can identify new events
   // in AliDielectronV0Cuts (not neeeded for collision data)
   if(GetHasMC()) {
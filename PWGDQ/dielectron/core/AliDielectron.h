@@ -143,6 +143,11 @@ public:
   void SetStoreRotatedPairs(Bool_t storeTR) {fStoreRotatedPairs = storeTR;}
   void SetDontClearArrays(Bool_t dontClearArrays=kTRUE) { fDontClearArrays=dontClearArrays; }
   Bool_t DontClearArrays() const { return fDontClearArrays; }
+  // Process with an own AliDielectronVarManager context instead of the shared one, so that several
+  // instances can process events concurrently. The event data are then not visible to the caller
+  // via the static AliDielectronVarManager interface after Process() returns.
+  void SetUseOwnVarContext(Bool_t useOwnVarContext=kTRUE) { fUseOwnVarContext=useOwnVarContext; }
+  Bool_t GetUseOwnVarContext() const { return fUseOwnVarContext; }
 
   void AddSignalMC(AliDielectronSignalMC* signal);
 
@@ -264,6 +269,8 @@ private:
   Bool_t fDontClearArrays;      //Don't clear the arrays at the end of the Process function, needed for external use of pair and tracks
   Bool_t fEventProcess;         //Process event (or pair array)
   Bool_t fUseGammaTracks;       // use function SetGammaTracks for MCtruth photons
+  Bool_t fUseOwnVarContext;     // process with an own variable context
+  AliDielectronVarManager::VarContext *fVarContext; //! own variable context
 
   void FillTrackArrays(AliVEvent * const ev, Int_t eventNr=0);
   void EventPlanePreFilter(Int_t arr1, Int_t arr2, TObjArray arrTracks1, TObjArray arrTracks2, const AliVEvent *ev);
@@ -274,6 +281,7 @@ private:
   Int_t GetPairIndex(Int_t arr1, Int_t arr2) const {return arr1>=arr2?arr1*(arr1+1)/2+arr2:arr2*(arr2+1)/2+arr1;}
 
   void InitPairCandidateArrays();
+  AliDielectronVarManager::VarContext* GetVarContext();
   void ClearArrays();
 
   TObjArray* PairArray(Int_t i);
@@ -303,7 +311,7 @@ private:
   AliDielectron(const AliDielectron &c);
   AliDielectron &operator=(const AliDielectron &c);
 
-  ClassDef(AliDielectron,17);
+  ClassDef(AliDielectron,18);
 };
 
 inline void AliDielectron::InitPairCandidateArrays()
@@ -47,6 +47,9 @@ AliDielectronEvent::AliDielectronEvent() :
   fNTracksN(0),
   fIsAOD(kFALSE),
   fEventData(),
+  fIsCompact(kFALSE),
+  fLegsP(),
+  fLegsN(),
   fPID(0x0),
   fPIDIndex(0)
 {
@@ -67,6 +70,9 @@ AliDielectronEvent::AliDielectronEvent(const char* name, const char* title) :
   fNTracksN(0),
   fIsAOD(kFALSE),
   fEventData(),
+  fIsCompact(kFALSE),
+  fLegsP(),
+  fLegsN(),
   fPID(0x0),
   fPIDIndex(0)
 {
@@ -95,6 +101,13 @@ void AliDielectronEvent::SetTracks(const TObjArray &arrP, const TObjArray &arrN,
   // assumes that the objects in arrP and arrN are AliVTracks
   //
 
+  // compact store: only keep what is needed to rebuild the legs
+  if (fIsCompact){
+    fNTracksP=FillCompactLegs(arrP,fLegsP);
+    fNTracksN=FillCompactLegs(arrN,fLegsN);
+    return;
+  }
+
   //Clear out old entries before filling new ones
   Clear();
   // we keep the tracks buffered to minimise new / delete operations
@@ -205,6 +218,10 @@ void AliDielectronEvent::Clear(Option_t *opt)
   }
 
   fArrPairs.Clear(opt);
+
+  // keep the capacity of the compact buffers
+  fLegsP.clear();
+  fLegsN.clear();
 }
 
 //______________________________________________
@@ -235,6 +252,107 @@ void AliDielectronEvent::SetESD(Int_t sizeP, Int_t sizeN)
   fIsAOD=kFALSE;
 }
 
+//______________________________________________
+void AliDielectronEvent::SetCompact(Bool_t isAOD, Int_t sizeP, Int_t sizeN)
+{
+  //
+  // use the compact store: instead of full track copies only the leg parameters
+  // needed for pairing are kept. The buffers are reserved once and reused
+  // each time the event is overwritten in the ring buffer
+  //
+  fIsCompact=kTRUE;
+  fIsAOD=isAOD;
+  fLegsP.reserve(sizeP);
+  fLegsN.reserve(sizeN);
+}
+
+//______________________________________________
+Int_t AliDielectronEvent::FillCompactLegs(const TObjArray &arr, std::vector<CompactLeg> &legs) const
+{
+  //
+  // fill the compact leg records from the tracks in 'arr'
+  // returns the number of stored legs
+  //
+  legs.clear();
+  CompactLeg leg;
+  for (Int_t itrack=0; itrack<arr.GetEntriesFast(); ++itrack){
+    if (!fIsAOD){
+      const AliESDtrack *track=dynamic_cast<const AliESDtrack*>(arr.At(itrack));
+      if (!track) continue;
+      leg.fPar[0]=track->GetX();
+      leg.fPar[1]=track->GetAlpha();
+      for (Int_t i=0; i<5;  ++i) leg.fPar[i+2]=track->GetParameter()[i];
+      for (Int_t i=0; i<15; ++i) leg.fCov[i]=track->GetCovariance()[i];
+      leg.fFilterMap=0;
+    } else {
+      const AliAODTrack *track=dynamic_cast<const AliAODTrack*>(arr.At(itrack));
+      if (!track) continue;
+      Double_t pos[3]={0.};
+      Double_t cov[21]={0.};
+      Bool_t isDCA=track->GetPosition(pos);
+      track->GetCovMatrix(cov);
+      leg.fPar[0]=track->Pt();
+      leg.fPar[1]=track->Phi();
+      leg.fPar[2]=track->Theta();
+      for (Int_t i=0; i<3;  ++i) leg.fPar[i+3]=pos[i];
+      leg.fPar[6]=isDCA;
+      for (Int_t i=0; i<21; ++i) leg.fCov[i]=cov[i];
+      leg.fFilterMap=track->GetFilterMap();
+    }
+    const AliVTrack *vtrack=static_cast<const AliVTrack*>(arr.At(itrack));
+    leg.fStatus=vtrack->GetStatus();
+    leg.fLabel=vtrack->GetLabel();
+    leg.fID=vtrack->GetID();
+    leg.fCharge=vtrack->Charge();
+    leg.fITSClusterMap=vtrack->GetITSClusterMap();
+    legs.push_back(leg);
+  }
+  return legs.size();
+}
+
+//______________________________________________
+void AliDielectronEvent::GetCompactTrack(Bool_t positive, Int_t itrack, AliVTrack *track, Double_t dz) const
+{
+  //
+  // set up 'track' from the compact leg record 'itrack'
+  // 'track' must be of the type of the stored event (AliESDtrack or AliAODTrack)
+  // it is meant to be reused, so all stored properties are overwritten
+  // dz is the z-shift to move ESD tracks to the vertex of another event
+  //
+  const CompactLeg &leg=positive ? fLegsP[itrack] : fLegsN[itrack];
+
+  if (!fIsAOD){
+    AliESDtrack *esdTrack=static_cast<AliESDtrack*>(track);
+    Double_t param[5] = {0};
+    Double_t cov[15]  = {0};
+    for (Int_t i=0; i<5;  ++i) param[i]=leg.fPar[i+2];
+    for (Int_t i=0; i<15; ++i) cov[i]=leg.fCov[i];
+    param[1]-=dz;
+    esdTrack->Set(leg.fPar[0], leg.fPar[1], param, cov);
+    esdTrack->ResetStatus(esdTrack->GetStatus());
+    esdTrack->SetStatus(leg.fStatus);
+    esdTrack->SetLabel(leg.fLabel);
+    esdTrack->SetID(leg.fID);
+    esdTrack->SetITSClusterMap(leg.fITSClusterMap);
+  } else {
+    AliAODTrack *aodTrack=static_cast<AliAODTrack*>(track);
+    Double_t cov[21]={0.};
+    for (Int_t i=0; i<21; ++i) cov[i]=leg.fCov[i];
+    aodTrack->SetPt(leg.fPar[0]);
+    aodTrack->SetPhi(leg.fPar[1]);
+    aodTrack->SetTheta(leg.fPar[2]);
+    aodTrack->SetPosition(&leg.fPar[3], leg.fPar[6]>0.5);
+    aodTrack->SetCovMatrix(cov);
+    aodTrack->SetCharge(leg.fCharge);
+    aodTrack->ResetStatus(aodTrack->GetStatus());
+    aodTrack->SetStatus(leg.fStatus);
+    aodTrack->SetFilterMap(leg.fFilterMap);
+    aodTrack->SetLabel(leg.fLabel);
+    aodTrack->SetID(leg.fID);
+    aodTrack->SetITSClusterMap(leg.fITSClusterMap);
+  }
+}
+
 //______________________________________________
 void AliDielectronEvent::SetEventData(const Double_t data[AliDielectronVarManager::kNMaxValues])
 {
@@ -13,6 +13,8 @@
 //#                                                           #
 //#############################################################
 
+#include <vector>
+
 #include <TNamed.h>
 #include <TClonesArray.h>
 
@@ -21,6 +23,7 @@
 
 class TObjArray;
 class TProcessID;
+class AliVTrack;
 
 class AliDielectronEvent : public TNamed {
 public:
@@ -33,6 +36,10 @@ public:
   void SetAOD(Int_t sizeP=1000, Int_t sizeN=1000);
   Bool_t IsAOD() const { return fIsAOD; }
 
+  void SetCompact(Bool_t isAOD, Int_t sizeP=100, Int_t sizeN=100);
+  Bool_t IsCompact() const { return fIsCompact; }
+  void GetCompactTrack(Bool_t positive, Int_t itrack, AliVTrack *track, Double_t dz=0.) const;
+
   void SetTracks(const TObjArray &arrP, const TObjArray &arrN, const TObjArray &arrPairs);
   void SetEventData(const Double_t data[AliDielectronVarManager::kNMaxValues]);
   const Double_t* GetEventData() const {return fEventData;}
@@ -64,6 +71,22 @@ private:
 
   Double_t fEventData[AliDielectronVarManager::kNMaxValues]; // event informaion from the var manager
 
+  // compact leg record, keeps only what is needed to rebuild the leg for pairing
+  struct CompactLeg {
+    Double_t fPar[7];         // ESD: x, alpha, y, z, snp, tgl, 1/pt; AOD: pt, phi, theta, x, y, z, isDCA
+    Float_t  fCov[21];        // ESD: 15 local covariance elements; AOD: 21 global covariance elements
+    ULong_t  fStatus;         // track status bits
+    UInt_t   fFilterMap;      // AOD filter map
+    Int_t    fLabel;          // MC label
+    Short_t  fID;             // track ID
+    Short_t  fCharge;         // charge
+    UChar_t  fITSClusterMap;  // ITS cluster map
+  };
+
+  Bool_t fIsCompact;                  // store compact leg records instead of full track copies
+  std::vector<CompactLeg> fLegsP;     //! compact positive legs
+  std::vector<CompactLeg> fLegsN;     //! compact negative legs
+
   TProcessID *fPID;             //! internal PID for references to buffered objects
   UInt_t      fPIDIndex;        //! index of PID
 
@@ -71,8 +94,9 @@ private:
   AliDielectronEvent &operator=(const AliDielectronEvent &c);
 
   void AssignID(TObject *obj);
+  Int_t FillCompactLegs(const TObjArray &arr, std::vector<CompactLeg> &legs) const;
   
-  ClassDef(AliDielectronEvent,1)         // Dielectron Event
+  ClassDef(AliDielectronEvent,2)         // Dielectron Event
 };
 
 
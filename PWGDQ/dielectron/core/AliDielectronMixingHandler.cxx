@@ -44,12 +44,16 @@ ClassImp(AliDielectronMixingHandler)
 AliDielectronMixingHandler::AliDielectronMixingHandler() :
   TNamed(),
   fDepth(10),
+  fBinDepth(),
   fArrPools("TClonesArray"),
   fAxes(kMaxCuts),
   fMixType(kOSonly),
   fMixIncomplete(kTRUE),
   fMoveToSameVertex(kFALSE),
   fSkipFirstEvt(kFALSE),
+  fCompactStore(kFALSE),
+  fCompactTracks(),
+  fNCompactTracks(0),
   fPID(0x0)
 {
   //
@@ -65,12 +69,16 @@ AliDielectronMixingHandler::AliDielectronMixingHandler() :
 AliDielectronMixingHandler::AliDielectronMixingHandler(const char* name, const char* title) :
   TNamed(name, title),
   fDepth(10),
+  fBinDepth(),
   fArrPools("TClonesArray"),
   fAxes(kMaxCuts),
   fMixType(kOSonly),
   fMixIncomplete(kTRUE),
   fMoveToSameVertex(kFALSE),
   fSkipFirstEvt(kFALSE),
+  fCompactStore(kFALSE),
+  fCompactTracks(),
+  fNCompactTracks(0),
   fPID(0x0)
 {
   //
@@ -89,6 +97,7 @@ AliDielectronMixingHandler::~AliDielectronMixingHandler()
   // Default Destructor
   //
   fAxes.Delete();
+  fCompactTracks.Delete();
   delete fPID;
 }
 
@@ -171,6 +180,11 @@ void AliDielectronMixingHandler::Fill(const AliVEvent *ev, AliDielectron *diele)
 
   // get mixing pool, create it if it does not yet exist.
   TClonesArray *poolp=static_cast<TClonesArray*>(fArrPools.At(bin));
+  const UShort_t depth=GetDepth(bin);
+  const Bool_t isAOD=(ev->IsA() == AliAODEvent::Class());
+
+  // tracks rebuilt from the compact store are of the input type
+  if (fCompactStore && !fCompactTracks.GetClass()) fCompactTracks.SetClass(isAOD ? "AliAODTrack" : "AliESDtrack",1000);
 
   // do mixing
   if (poolp) {
@@ -183,11 +197,18 @@ void AliDielectronMixingHandler::Fill(const AliVEvent *ev, AliDielectron *diele)
     AliDebug(10,Form("New pool at %d (%s)\n",bin,dim.Data()));
     //printf("New pool at %d (%s)\n",bin,dim.Data());
     // TODO: check with Julian fDepth <> 1
-    poolp=new(fArrPools[bin]) TClonesArray("AliDielectronEvent",fDepth);
+    poolp=new(fArrPools[bin]) TClonesArray("AliDielectronEvent",depth);
     poolp->SetUniqueID(0); // use unique id for the ring buffering
+    // compact store: preallocate the full ring buffer of this bin
+    if (fCompactStore){
+      for (Int_t i=0; i<depth; ++i){
+        AliDielectronEvent *evt=new((*poolp)[i]) AliDielectronEvent();
+        evt->SetCompact(isAOD,diele->GetTrackArray(0)->GetEntriesFast(),diele->GetTrackArray(1)->GetEntriesFast());
+      }
+    }
   } else {
     // one count further in the ring buffer
-    index1=(poolp->GetUniqueID()+1)%fDepth;
+    index1=(poolp->GetUniqueID()+1)%depth;
   }
 
   //printf("index1: %d, poolp: %p\n",index1, poolp);
@@ -198,7 +219,7 @@ void AliDielectronMixingHandler::Fill(const AliVEvent *ev, AliDielectron *diele)
     AliDebug(10,Form("new event at %d: %d",bin,index1));
      //printf("new event at %d: %d\n",bin,index1);
     event = new(pool[index1]) AliDielectronEvent();
-    if(ev->IsA() == AliAODEvent::Class()) {
+    if(isAOD) {
       event->SetAOD(diele->GetTrackArray(0)->GetEntriesFast(),diele->GetTrackArray(1)->GetEntriesFast());
     } else {
         event->SetESD(diele->GetTrackArray(0)->GetEntriesFast(),diele->GetTrackArray(1)->GetEntriesFast());
@@ -273,13 +294,20 @@ void AliDielectronMixingHandler::DoMixing(TClonesArray &pool, AliDielectron *die
   // TIter ev1N(ev1->GetTrackArrayN());
   TIter ev1P(&arrTrDummy[0]);
   TIter ev1N(&arrTrDummy[1]);
-  
+
+  // tracks of the compact store, rebuilt for each event in the pool
+  TObjArray arrCompactP;
+  TObjArray arrCompactN;
+  fNCompactTracks=0;
+
 
   for (Int_t i1=0; i1<pool.GetEntriesFast(); ++i1){
     const AliDielectronEvent *ev2=static_cast<AliDielectronEvent*>(pool.At(i1));
     // don't mix with itself
     if (!ev2) continue;
     // if (!ev1 || !ev2 || ev1==ev2) continue;
+    // not yet filled or empty event
+    if (ev2->GetNTracksP()+ev2->GetNTracksN()==0) continue;
     
     //clear arryas
     diele->fTracks[0].Clear();
@@ -290,13 +318,26 @@ void AliDielectronMixingHandler::DoMixing(TClonesArray &pool, AliDielectron *die
     //setup track arrays
     ev1P.Reset();
     ev1N.Reset();
-    TIter ev2P(ev2->GetTrackArrayP());
-    TIter ev2N(ev2->GetTrackArrayN());
+    const TObjArray *arrEv2P=ev2->GetTrackArrayP();
+    const TObjArray *arrEv2N=ev2->GetTrackArrayN();
+    if (ev2->IsCompact()){
+      // the vertex shift is applied while rebuilding the tracks
+      Double_t dz=0.;
+      if (fMoveToSameVertex && !ev2->IsAOD())
+        dz=ev2->GetEventData()[AliDielectronVarManager::kZvPrim]-values[AliDielectronVarManager::kZvPrim];
+      arrCompactP.Clear();
+      arrCompactN.Clear();
+      GetCompactTracks(*ev2,arrCompactP,arrCompactN,dz);
+      arrEv2P=&arrCompactP;
+      arrEv2N=&arrCompactN;
+    }
+    TIter ev2P(arrEv2P);
+    TIter ev2N(arrEv2N);
 
     //
     //move tracks to the same vertex (vertex of the first event), if requested
     //
-    if (fMoveToSameVertex){
+    if (fMoveToSameVertex && !ev2->IsCompact()){
       const Double_t *varsFirst=values;
       const Double_t *varsMix=ev2->GetEventData();
 
@@ -357,6 +398,25 @@ void AliDielectronMixingHandler::DoMixing(TClonesArray &pool, AliDielectron *die
   AliDielectronVarManager::SetEventData(values);
 }
 
+//______________________________________________
+void AliDielectronMixingHandler::GetCompactTracks(const AliDielectronEvent &ev, TObjArray &arrP, TObjArray &arrN, Double_t dz)
+{
+  //
+  // rebuild the legs of the compact event 'ev' in the reusable track buffer
+  // the tracks are kept until the next mixing, since the mixed pairs reference them
+  //
+  for (Int_t itrack=0; itrack<ev.GetNTracksP(); ++itrack){
+    AliVTrack *track=static_cast<AliVTrack*>(fCompactTracks.ConstructedAt(fNCompactTracks++));
+    ev.GetCompactTrack(kTRUE,itrack,track,dz);
+    arrP.Add(track);
+  }
+  for (Int_t itrack=0; itrack<ev.GetNTracksN(); ++itrack){
+    AliVTrack *track=static_cast<AliVTrack*>(fCompactTracks.ConstructedAt(fNCompactTracks++));
+    ev.GetCompactTrack(kFALSE,itrack,track,dz);
+    arrN.Add(track);
+  }
+}
+
 //______________________________________________
 Bool_t AliDielectronMixingHandler::MixRemaining(AliDielectron */*diele*/, Int_t /*ipool*/)
 {
@@ -445,6 +505,32 @@ void AliDielectronMixingHandler::Init(const AliDielectron *diele)
   AliDebug(10,values.Data());
 }
 
+//______________________________________________
+void AliDielectronMixingHandler::SetDepth(Int_t bin, UShort_t depth)
+{
+  //
+  // set the pool depth of a single mixing bin, 0 means the default depth
+  // the mixing variables need to be added before, since they define the number of bins
+  //
+  Int_t size=GetNumberOfBins();
+  if (bin<0 || bin>=size){
+    AliError(Form("Bin %d outside of the %d mixing bins",bin,size));
+    return;
+  }
+  if (fBinDepth.GetSize()<size) fBinDepth.Set(size);
+  fBinDepth[bin]=(Short_t)depth;
+}
+
+//______________________________________________
+UShort_t AliDielectronMixingHandler::GetDepth(Int_t bin) const
+{
+  //
+  // pool depth of mixing bin 'bin'
+  //
+  if (bin>=0 && bin<fBinDepth.GetSize() && fBinDepth[bin]>0) return (UShort_t)fBinDepth[bin];
+  return fDepth;
+}
+
 //______________________________________________
 Int_t AliDielectronMixingHandler::GetNumberOfBins() const
 {
@@ -16,12 +16,14 @@
 #include <TNamed.h>
 #include <TObjArray.h>
 #include <TClonesArray.h>
+#include <TArrayS.h>
 
 #include "AliDielectronVarManager.h"
 
 class AliDielectron;
 class AliVTrack;
 class AliVEvent;
+class AliDielectronEvent;
 
 class AliDielectronMixingHandler : public TNamed {
 public:
@@ -43,6 +45,11 @@ public:
 
   void SetDepth(UShort_t depth) { fDepth=depth; }
   UShort_t GetDepth()     const { return fDepth; }
+  void SetDepth(Int_t bin, UShort_t depth);
+  UShort_t GetDepth(Int_t bin) const;
+
+  void SetCompactStore(Bool_t compact=kTRUE) { fCompactStore=compact; }
+  Bool_t GetCompactStore() const { return fCompactStore; }
 
   void SetMixType(EMixType type) { fMixType=type; }
   EMixType GetMixType() const    { return fMixType; }
@@ -66,6 +73,7 @@ public:
 
 private:
   UShort_t     fDepth;     //Number of events per bin to start the merging
+  TArrayS      fBinDepth;  //Depth per bin, 0 means fDepth
   TClonesArray fArrPools; //Array of events in bins
 
   UShort_t  fEventCuts[kMaxCuts]; //cut variables
@@ -76,16 +84,21 @@ private:
   Bool_t fMixIncomplete;  // whether to mix uncomplete bins at the end of the processing
   Bool_t fMoveToSameVertex; //whether to move the mixed tracks to the same vertex position
   Bool_t fSkipFirstEvt;   //whether to skip the first event in the pool
+  Bool_t fCompactStore;   //whether to store compact leg records instead of full track copies
+
+  TClonesArray fCompactTracks;  //! reusable tracks rebuilt from the compact leg records
+  Int_t        fNCompactTracks; //! number of tracks in use in the current mixing
 
   TProcessID *fPID;             //! internal PID for references to buffered objects
   
   void DoMixing(TClonesArray &pool, AliDielectron *diele);
+  void GetCompactTracks(const AliDielectronEvent &ev, TObjArray &arrP, TObjArray &arrN, Double_t dz);
 
   AliDielectronMixingHandler(const AliDielectronMixingHandler &c);
   AliDielectronMixingHandler &operator=(const AliDielectronMixingHandler &c);
 
   
-  ClassDef(AliDielectronMixingHandler,1)         // Dielectron MixingHandler
+  ClassDef(AliDielectronMixingHandler,2)         // Dielectron MixingHandler
 };
 
 
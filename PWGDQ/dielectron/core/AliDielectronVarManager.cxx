@@ -641,26 +641,122 @@ const char* AliDielectronVarManager::fgkParticleNames[AliDielectronVarManager::k
 };
 
 AliPIDResponse* AliDielectronVarManager::fgPIDResponse      = 0x0;
-AliVEvent*      AliDielectronVarManager::fgEvent            = 0x0;
-AliEventplane*  AliDielectronVarManager::fgTPCEventPlane    = 0x0;
-AliKFVertex*    AliDielectronVarManager::fgKFVertex         = 0x0;
 TProfile*       AliDielectronVarManager::fgMultEstimatorAvg[7][9] = {{0x0}};
 TH3D*           AliDielectronVarManager::fgTRDpidEff[10][4] = {{0x0}};
-TObject*        AliDielectronVarManager::fgLegEffMap           = 0x0;
-TObject*        AliDielectronVarManager::fgPairEffMap          = 0x0;
-TBits*          AliDielectronVarManager::fgFillMap          = 0x0;
 Double_t        AliDielectronVarManager::fgTRDpidEffCentRanges[10][4] = {{0.0}};
 TString         AliDielectronVarManager::fgVZEROCalibrationFile = "";
 TString         AliDielectronVarManager::fgVZERORecenteringFile = "";
 TString         AliDielectronVarManager::fgZDCRecenteringFile = "";
-TProfile2D*     AliDielectronVarManager::fgVZEROCalib[64] = {0x0};
-TProfile2D*     AliDielectronVarManager::fgVZERORecentering[2][2] = {{0x0,0x0},{0x0,0x0}};
-TProfile3D*     AliDielectronVarManager::fgZDCRecentering[3][2] = {{0x0,0x0},{0x0,0x0},{0x0,0x0}};
 AliDielectronQnEPcorrection* AliDielectronVarManager::fgQnEPacRemoval = 0x0;
 Bool_t          AliDielectronVarManager::fgEventPlaneACremoval = kFALSE;
 TString         AliDielectronVarManager::fgQnVectorNorm = "";
-Int_t           AliDielectronVarManager::fgCurrentRun = -1;
-Double_t        AliDielectronVarManager::fgData[AliDielectronVarManager::kNMaxValues] = {0.};
+AliDielectronVarManager::VarContext AliDielectronVarManager::fgDefaultContext;
+thread_local AliDielectronVarManager::VarContext* AliDielectronVarManager::fgContext = &AliDielectronVarManager::fgDefaultContext;
+
+//________________________________________________________________
+AliDielectronVarManager::VarContext::VarContext() :
+  fEvent(0x0),
+  fTPCEventPlane(0x0),
+  fKFVertex(0x0),
+  fLegEffMap(0x0),
+  fPairEffMap(0x0),
+  fFillMap(0x0),
+  fCurrentRun(-1)
+{
+  //
+  // Default constructor
+  //
+  for (Int_t i=0; i<AliDielectronVarManager::kNMaxValues;++i) fData[i]=0.;
+  for (Int_t i=0; i<64; ++i) fVZEROCalib[i]=0x0;
+  for (Int_t i=0; i<2; ++i)
+    for (Int_t j=0; j<2; ++j) fVZERORecentering[i][j]=0x0;
+  for (Int_t i=0; i<3; ++i)
+    for (Int_t j=0; j<2; ++j) fZDCRecentering[i][j]=0x0;
+}
+
+//________________________________________________________________
+AliDielectronVarManager::VarContext::~VarContext()
+{
+  //
+  // Default destructor
+  //
+  delete fKFVertex;
+  for (Int_t i=0; i<64; ++i) delete fVZEROCalib[i];
+  for (Int_t i=0; i<2; ++i)
+    for (Int_t j=0; j<2; ++j) delete fVZERORecentering[i][j];
+  for (Int_t i=0; i<3; ++i)
+    for (Int_t j=0; j<2; ++j) delete fZDCRecentering[i][j];
+}
+
+//________________________________________________________________
+AliDielectronVarManager::VarContext* AliDielectronVarManager::SetContext(VarContext *context)
+{
+  //
+  // Activate a context in the calling thread, 0x0 activates the default context.
+  // Returns the context which was active before.
+  //
+  VarContext *previous=fgContext;
+  fgContext=(context ? context : &fgDefaultContext);
+  return previous;
+}
+
+//________________________________________________________________
+AliDielectronVarManager::VarContext* AliDielectronVarManager::GetContext()
+{
+  //
+  // Context active in the calling thread
+  //
+  return fgContext;
+}
+
+//________________________________________________________________
+void AliDielectronVarManager::SetLegEffMap(TObject *map)
+{
+  fgContext->fLegEffMap=map;
+}
+
+//________________________________________________________________
+void AliDielectronVarManager::SetPairEffMap(TObject *map)
+{
+  fgContext->fPairEffMap=map;
+}
+
+//________________________________________________________________
+void AliDielectronVarManager::SetFillMap(TBits *map)
+{
+  fgContext->fFillMap=map;
+}
+
+//________________________________________________________________
+const AliKFVertex* AliDielectronVarManager::GetKFVertex()
+{
+  return fgContext->fKFVertex;
+}
+
+//________________________________________________________________
+const Double_t* AliDielectronVarManager::GetData()
+{
+  return fgContext->fData;
+}
+
+//________________________________________________________________
+AliVEvent* AliDielectronVarManager::GetCurrentEvent()
+{
+  return fgContext->fEvent;
+}
+
+//________________________________________________________________
+Double_t AliDielectronVarManager::GetValue(ValueTypes var)
+{
+  return fgContext->fData[var];
+}
+
+//________________________________________________________________
+void AliDielectronVarManager::SetValue(ValueTypes var, Double_t val)
+{
+  fgContext->fData[var]=val;
+}
+
 //________________________________________________________________
 AliDielectronVarManager::AliDielectronVarManager() :
   TNamed("AliDielectronVarManager","AliDielectronVarManager")
@@ -674,12 +770,6 @@ AliDielectronVarManager::AliDielectronVarManager() :
   for(Int_t i=0; i<10; ++i)
     for(Int_t j=0; j<4; ++j)
       fgTRDpidEff[i][j] = 0x0;
-  for(Int_t i=0; i<64; ++i) fgVZEROCalib[i] = 0x0;
-  for(Int_t i=0; i<2; ++i) {
-    for(Int_t j=0; j<2; ++j) fgVZERORecentering[i][j] = 0x0;
-  }
-  for(Int_t i=0; i<3; ++i)
-    for(Int_t j=0; j<2; ++j) fgZDCRecentering[i][j] = 0x0;
 
   gRandom->SetSeed();
 }
@@ -697,13 +787,6 @@ AliDielectronVarManager::AliDielectronVarManager(const char* name, const char* t
   for(Int_t i=0; i<10; ++i)
     for(Int_t j=0; j<4; ++j)
       fgTRDpidEff[i][j] = 0x0;
-  for(Int_t i=0; i<64; ++i) fgVZEROCalib[i] = 0x0;
-  for(Int_t i=0; i<2; ++i)
-    for(Int_t j=0; j<2; ++j)
-      fgVZERORecentering[i][j] = 0x0;
-  for(Int_t i=0; i<3; ++i)
-    for(Int_t j=0; j<2; ++j) fgZDCRecentering[i][j] = 0x0;
-
 
   gRandom->SetSeed();
 }
@@ -720,14 +803,6 @@ AliDielectronVarManager::~AliDielectronVarManager()
   for(Int_t i=0; i<10; ++i)
     for(Int_t j=0; j<4; ++j)
       if(fgTRDpidEff[i][j]) delete fgTRDpidEff[i][j];
-  for(Int_t i=0; i<64; ++i)
-    if(fgVZEROCalib[i]) delete fgVZEROCalib[i];
-  for(Int_t i=0; i<2; ++i)
-    for(Int_t j=0; j<2; ++j)
-      if(fgVZERORecentering[i][j]) delete fgVZERORecentering[i][j];
-  for(Int_t i=0; i<3; ++i)
-    for(Int_t j=0; j<2; ++j)
-      if(fgZDCRecentering[i][j]) delete fgZDCRecentering[i][j];
 
 }
 
@@ -670,6 +670,45 @@ public:
     // TODO: (for A+A) ZDCEnergy, impact parameter, Iflag??
   };
 
+  // State of the variable filling which belongs to one event and one user, e.g. one AliDielectron.
+  // The static interface works on the context which is active in the calling thread (see SetContext).
+  // By default this is one context shared by the whole process, as with the former static members.
+  // The run-wise VZERO/ZDC calibrations are loaded into the context, so that contexts processing
+  // different runs do not share them.
+  class VarContext {
+  public:
+    VarContext();
+    ~VarContext();
+
+    AliVEvent       *fEvent;              // current event pointer
+    AliEventplane   *fTPCEventPlane;      // current event tpc plane pointer
+    AliKFVertex     *fKFVertex;           // kf vertex (owned)
+    TObject         *fLegEffMap;          // single electron efficiencies
+    TObject         *fPairEffMap;         // pair efficiencies
+    TBits           *fFillMap;            // map for requested variable filling
+    Double_t         fData[kNMaxValues];  // event data
+    Int_t            fCurrentRun;               // run of the calibration histograms below
+    TProfile2D      *fVZEROCalib[64];           // 1 histogram per VZERO channel (owned)
+    TProfile2D      *fVZERORecentering[2][2];   // 2 VZERO sides x 2 Q-vector components (owned)
+    TProfile3D      *fZDCRecentering[3][2];     // 3 ZDC planes x 2 Q-vector components (owned)
+
+  private:
+    VarContext(const VarContext &c);
+    VarContext &operator=(const VarContext &c);
+  };
+
+  // Activates a context for the lifetime of the guard and restores the previous one afterwards.
+  // A guard on 0x0 does nothing.
+  class ContextGuard {
+  public:
+    ContextGuard(VarContext *context) : fPrevious(context ? SetContext(context) : 0x0) {}
+    ~ContextGuard() { if (fPrevious) SetContext(fPrevious); }
+  private:
+    VarContext *fPrevious;                // context active before the guard
+    ContextGuard(const ContextGuard &c);
+    ContextGuard &operator=(const ContextGuard &c);
+  };
+
 
   AliDielectronVarManager();
   AliDielectronVarManager(const char* name, const char* title);
@@ -683,9 +722,12 @@ public:
   static void InitEstimatorAvg(const Char_t* filename);
   static void InitEstimatorObjArrayAvg(const TObjArray* array);
   static void InitTRDpidEffHistograms(const Char_t* filename);
-  static void SetLegEffMap( TObject *map) { fgLegEffMap=map; }
-  static void SetPairEffMap(TObject *map) { fgPairEffMap=map; }
-  static void SetFillMap(   TBits   *map) { fgFillMap=map; }
+  static VarContext* SetContext(VarContext *context);   // activate a context in the calling thread, 0x0 for the default one; returns the previous one
+  static VarContext* GetContext();
+  static VarContext* GetDefaultContext() { return &fgDefaultContext; }
+  static void SetLegEffMap( TObject *map);
+  static void SetPairEffMap(TObject *map);
+  static void SetFillMap(   TBits   *map);
   static void SetVZEROCalibrationFile(const Char_t* filename) {fgVZEROCalibrationFile = filename;}
 
   static void SetVZERORecenteringFile(const Char_t* filename) {fgVZERORecenteringFile = filename;}
@@ -706,24 +748,25 @@ public:
   static Double_t GetSingleLegEff(Double_t * const values);
   static Double_t GetPairEff(Double_t * const values);
 
-  static const AliKFVertex* GetKFVertex() {return fgKFVertex;}
+  static const AliKFVertex* GetKFVertex();
 
   static const char* GetValueName(Int_t i) { return (i>=0&&i<kNMaxValues)?fgkParticleNames[i][0]:""; }
   static const char* GetValueLabel(Int_t i) { return (i>=0&&i<kNMaxValues)?fgkParticleNames[i][1]:""; }
   static const char* GetValueUnit(Int_t i) { return (i>=0&&i<kNMaxValues)?fgkParticleNames[i][2]:""; }
   static UInt_t GetValueType(const char* valname);
-  static const Double_t* GetData() {return fgData;}
-  static AliVEvent* GetCurrentEvent() {return fgEvent;}
+  static const Double_t* GetData();
+  static AliVEvent* GetCurrentEvent();
 
-  static Double_t GetValue(ValueTypes var) {return fgData[var];}
-  static void SetValue(ValueTypes var, Double_t val) { fgData[var]=val; }
+  static Double_t GetValue(ValueTypes var);
+  static void SetValue(ValueTypes var, Double_t val);
 
 
 private:
 
   static const char* fgkParticleNames[kNMaxValues][3];  //variable names
 
-  static Bool_t Req(ValueTypes var) { return (fgFillMap ? fgFillMap->TestBitNumber(var) : kTRUE); }
+  static Bool_t Req(ValueTypes var) { return (fgContext->fFillMap ? fgContext->fFillMap->TestBitNumber(var) : kTRUE); }
+  static void FillVarEventData(Double_t * const values);
   static void FillVarESDtrack(const AliESDtrack *particle,           Double_t * const values);
   static void FillVarAODTrack(const AliAODTrack *particle,           Double_t * const values);
   static void FillVarVTrdTrack(const AliVParticle *particle,         Double_t * const values);
@@ -744,23 +787,15 @@ private:
   static void InitZDCRecenteringHistograms(Int_t runNo);
 
   static AliPIDResponse  *fgPIDResponse;        // PID response object
-  static AliVEvent       *fgEvent;              // current event pointer
-  static AliEventplane   *fgTPCEventPlane;      // current event tpc plane pointer
-  static AliKFVertex     *fgKFVertex;           // kf vertex
+  static VarContext       fgDefaultContext;     // context shared by all threads which did not activate their own
+  static thread_local VarContext *fgContext;    // context active in the current thread
   static TProfile        *fgMultEstimatorAvg[7][9];  // multiplicity estimator averages (7 periods x 18 estimators)
   static Double_t         fgTRDpidEffCentRanges[10][4];   // centrality ranges for the TRD pid efficiency histograms
   static TH3D            *fgTRDpidEff[10][4];   // TRD pid efficiencies from conversion electrons
-  static TObject         *fgLegEffMap;             // single electron efficiencies
-  static TObject         *fgPairEffMap;             // pair efficiencies
-  static TBits           *fgFillMap;             // map for requested variable filling
   static TString          fgVZEROCalibrationFile;  // file with VZERO channel-by-channel calibrations
   static TString          fgVZERORecenteringFile;  // file with VZERO Q-vector averages needed for event plane recentering
-  static TProfile2D      *fgVZEROCalib[64];           // 1 histogram per VZERO channel
-  static TProfile2D      *fgVZERORecentering[2][2];   // 2 VZERO sides x 2 Q-vector components
-  static Int_t            fgCurrentRun;               // current run number
 
   static TString          fgZDCRecenteringFile; // file with ZDC Q-vector averages needed for event plane recentering
-  static TProfile3D      *fgZDCRecentering[3][2];   // 2 VZERO sides x 2 Q-vector components
 
   static AliDielectronQnEPcorrection *fgQnEPacRemoval; //! filter for auto correlation removal within Qn Framework
   static Bool_t fgEventPlaneACremoval;
@@ -770,8 +805,6 @@ private:
   static Double_t CalculateEPDiff(Double_t detArp, Double_t detBrp);
 
 
-  static Double_t fgData[kNMaxValues];        //! data
-
   AliDielectronVarManager(const AliDielectronVarManager &c);
   AliDielectronVarManager &operator=(const AliDielectronVarManager &c);
 
@@ -849,9 +882,8 @@ inline void AliDielectronVarManager::FillVarVParticle(const AliVParticle *partic
     }
   }
 
-//   if ( fgEvent ) AliDielectronVarManager::Fill(fgEvent, values);
-  for (Int_t i=AliDielectronVarManager::kPairMax; i<AliDielectronVarManager::kNMaxValues; ++i)
-    values[i]=fgData[i];
+//   if ( fgContext->fEvent ) AliDielectronVarManager::Fill(fgContext->fEvent, values);
+  FillVarEventData(values);
 }
 
 inline void AliDielectronVarManager::FillVarESDtrack(const AliESDtrack *particle, Double_t * const values)
@@ -1020,15 +1052,15 @@ inline void AliDielectronVarManager::FillVarESDtrack(const AliESDtrack *particle
   const AliExternalTrackParam *out=particle->GetOuterParam();
   if(out) values[AliDielectronVarManager::kPOut] = out->GetP();
   else values[AliDielectronVarManager::kPOut] = mom;
-  if(out && fgEvent) {
+  if(out && fgContext->fEvent) {
     Double_t localCoord[3]={0.0};
-    Bool_t localCoordGood = out->GetXYZAt(298.0, ((AliESDEvent*)fgEvent)->GetMagneticField(), localCoord);
+    Bool_t localCoordGood = out->GetXYZAt(298.0, ((AliESDEvent*)fgContext->fEvent)->GetMagneticField(), localCoord);
     values[AliDielectronVarManager::kTRDphi] = (localCoordGood && TMath::Abs(localCoord[0])>1.0e-6 && TMath::Abs(localCoord[1])>1.0e-6 ? TMath::ATan2(localCoord[1], localCoord[0]) : -999.);
   }
   if(mc->HasMC() && fgTRDpidEff[0][0]) {
-    Int_t runNo = (fgEvent ? fgEvent->GetRunNumber() : -1);
+    Int_t runNo = (fgContext->fEvent ? fgContext->fEvent->GetRunNumber() : -1);
     Float_t centrality=-1.0;
-    AliCentrality *esdCentrality = (fgEvent ? fgEvent->GetCentrality() : 0x0);
+    AliCentrality *esdCentrality = (fgContext->fEvent ? fgContext->fEvent->GetCentrality() : 0x0);
     if(esdCentrality) centrality = esdCentrality->GetCentralityPercentile("V0M");
     Double_t effErr=0.0;
     values[kTRDpidEffLeg] = GetTRDpidEfficiency(runNo, centrality, values[AliDielectronVarManager::kEta],
@@ -1116,19 +1148,19 @@ inline void AliDielectronVarManager::FillVarESDtrack(const AliESDtrack *particle
   if(Req(kTRDonlineA)||Req(kTRDonlineLayerMask)||Req(kTRDonlinePID)||Req(kTRDonlinePt)||Req(kTRDonlineStack)||Req(kTRDonlineTrackInTime)||Req(kTRDonlineSector)||Req(kTRDonlineFlagsTiming)||Req(kTRDonlineLabel)||Req(kTRDonlineNTracklets)||Req(kTRDonlineFirstLayer))
     FillVarVTrdTrack(particle,values);
 
-  if( fgEvent && fgEvent->GetMagneticField() ){
+  if( fgContext->fEvent && fgContext->fEvent->GetMagneticField() ){
     if(out){
       AliExternalTrackParam out_tmp(*out);
-      out_tmp.PropagateTo(AliTRDgeometry::GetXtrdBeg(), fgEvent->GetMagneticField());
+      out_tmp.PropagateTo(AliTRDgeometry::GetXtrdBeg(), fgContext->fEvent->GetMagneticField());
       values[AliDielectronVarManager::kTRDeta] = out_tmp.Eta();
     }
     else{
       AliESDtrack particle_tmp(*particle);
-      particle_tmp.PropagateTo(AliTRDgeometry::GetXtrdBeg(), fgEvent->GetMagneticField());
+      particle_tmp.PropagateTo(AliTRDgeometry::GetXtrdBeg(), fgContext->fEvent->GetMagneticField());
       values[AliDielectronVarManager::kTRDeta] = particle_tmp.Eta();
     }
     int mode = particle->GetInnerParam() ? 1:0;
-    values[kTPCActiveLength] = particle->GetLengthInActiveZone(mode, 2., 220., fgEvent->GetMagneticField());
+    values[kTPCActiveLength] = particle->GetLengthInActiveZone(mode, 2., 220., fgContext->fEvent->GetMagneticField());
     values[kTPCGeomLength] = values[kTPCActiveLength] / ( 130 - TMath::Power( TMath::Abs( particle->GetSigned1Pt() ),1.5 ) );
     values[AliDielectronVarManager::kInTRDacceptance] = TMath::Abs( values[AliDielectronVarManager::kTRDeta] )<0.85 && (  (values[AliDielectronVarManager::kCharge]<0&&(  values[AliDielectronVarManager::kPhi]<1.32 || (values[AliDielectronVarManager::kPhi]>1.98 && values[AliDielectronVarManager::kPhi]<4.10)||  ( values[AliDielectronVarManager::kPhi]>5.12  && values[AliDielectronVarManager::kPhi]<5.48  && TMath::Abs( values[AliDielectronVarManager::kTRDeta] )>0.155 )  || values[AliDielectronVarManager::kPhi]>5.48 )) ||   (values[AliDielectronVarManager::kCharge]>0&&(  values[AliDielectronVarManager::kPhi]<1.52 || (values[AliDielectronVarManager::kPhi]>2.20 && values[AliDielectronVarManager::kPhi]<4.32)||  ( values[AliDielectronVarManager::kPhi]>5.32  && values[AliDielectronVarManager::kPhi]<5.68  && TMath::Abs( values[AliDielectronVarManager::kTRDeta]  )>0.155 )  || values[AliDielectronVarManager::kPhi]>5.68 )) )  ? 1: 0;
   }
@@ -1289,7 +1321,7 @@ inline void AliDielectronVarManager::FillVarAODTrack(const AliAODTrack *particle
       Double_t l  = TMath::C()* expt[0]*1e-12;    // m
       Double_t t  = pid->GetTOFsignal();          // ps start time subtracted (until v5-02-Rev09)
       AliTOFHeader* tofH=0x0;                     // from v5-02-Rev10 on subtract the start time
-      if(fgEvent) tofH = (AliTOFHeader*)fgEvent->GetTOFHeader();
+      if(fgContext->fEvent) tofH = (AliTOFHeader*)fgContext->fEvent->GetTOFHeader();
       if(tofH) t -= fgPIDResponse->GetTOFResponse().GetStartTime(particle->P()); // ps
 
     if( (l < 360.e-2 || l > 800.e-2) || (t <= 0.) ) {
@@ -1651,7 +1683,7 @@ inline void AliDielectronVarManager::FillVarMCParticle2(const AliVParticle *p1,
   values[AliDielectronVarManager::kMMC] = values[AliDielectronVarManager::kM];
   values[AliDielectronVarManager::kPtMC] = values[AliDielectronVarManager::kPt];
 
-  if ( fgEvent ) AliDielectronVarManager::Fill(fgEvent, values);
+  if ( fgContext->fEvent ) AliDielectronVarManager::Fill(fgContext->fEvent, values);
 
   values[AliDielectronVarManager::kThetaHE]   = AliDielectronPair::ThetaPhiCM(p1,p2,kTRUE,  kTRUE);
   values[AliDielectronVarManager::kPhiHE]     = AliDielectronPair::ThetaPhiCM(p1,p2,kTRUE,  kFALSE);
@@ -1725,7 +1757,7 @@ inline void AliDielectronVarManager::FillVarAODMCParticle(const AliAODMCParticle
   values[AliDielectronVarManager::kNumberOfDaughters]=mc->NumberOfDaughters(particle);
 
   // using AODMCHEader information
-  AliAODMCHeader *mcHeader = (AliAODMCHeader*)fgEvent->FindListObject(AliAODMCHeader::StdBranchName());
+  AliAODMCHeader *mcHeader = (AliAODMCHeader*)fgContext->fEvent->FindListObject(AliAODMCHeader::StdBranchName());
   if(mcHeader) {
     values[AliDielectronVarManager::kImpactParZ]  = mcHeader->GetVtxZ()-particle->Zv();
     values[AliDielectronVarManager::kImpactParXY] = TMath::Sqrt(TMath::Power(mcHeader->GetVtxX()-particle->Xv(),2) +
@@ -1791,7 +1823,7 @@ inline void AliDielectronVarManager::FillVarDielectronPair(const AliDielectronPa
   if(Req(kOpeningAngle))     values[AliDielectronVarManager::kOpeningAngle]     = pair->OpeningAngle();
   if(Req(kOpeningAngleXY))     values[AliDielectronVarManager::kOpeningAngleXY] = pair->OpeningAngleXY();
   if(Req(kOpeningAngleRZ))     values[AliDielectronVarManager::kOpeningAngleRZ] = pair->OpeningAngleRZ();
-  if(Req(kCosPointingAngle)) values[AliDielectronVarManager::kCosPointingAngle] = fgEvent ? pair->GetCosPointingAngle(fgEvent->GetPrimaryVertex()) : -1;
+  if(Req(kCosPointingAngle)) values[AliDielectronVarManager::kCosPointingAngle] = fgContext->fEvent ? pair->GetCosPointingAngle(fgContext->fEvent->GetPrimaryVertex()) : -1;
 
   if(Req(kLegDist))   values[AliDielectronVarManager::kLegDist]      = pair->DistanceDaughters();
   if(Req(kLegDistXY)) values[AliDielectronVarManager::kLegDistXY]    = pair->DistanceDaughtersXY();
@@ -1804,20 +1836,20 @@ inline void AliDielectronVarManager::FillVarDielectronPair(const AliDielectronPa
   if(Req(kArmAlpha)) values[AliDielectronVarManager::kArmAlpha]     = pair->GetArmAlpha();
   if(Req(kArmPt))    values[AliDielectronVarManager::kArmPt]        = pair->GetArmPt();
 
-  if(Req(kPsiPair))  values[AliDielectronVarManager::kPsiPair]      = fgEvent ? pair->PsiPair(fgEvent->GetMagneticField()) : -5;
-  if(Req(kPhivPair)) values[AliDielectronVarManager::kPhivPair]      = fgEvent ? pair->PhivPair(fgEvent->GetMagneticField()) : -5;
+  if(Req(kPsiPair))  values[AliDielectronVarManager::kPsiPair]      = fgContext->fEvent ? pair->PsiPair(fgContext->fEvent->GetMagneticField()) : -5;
+  if(Req(kPhivPair)) values[AliDielectronVarManager::kPhivPair]      = fgContext->fEvent ? pair->PhivPair(fgContext->fEvent->GetMagneticField()) : -5;
   if(Req(kDeltaCotTheta)) values[kDeltaCotTheta] =  pair->DeltaCotTheta();
-  if(Req(kTriangularConversionCut)) values[AliDielectronVarManager::kTriangularConversionCut] = fgEvent ? pair->PhivPair(fgEvent->GetMagneticField()) - 21. * pair->M() : -999.;
+  if(Req(kTriangularConversionCut)) values[AliDielectronVarManager::kTriangularConversionCut] = fgContext->fEvent ? pair->PhivPair(fgContext->fEvent->GetMagneticField()) - 21. * pair->M() : -999.;
   if(Req(kPseudoProperTime) || Req(kPseudoProperTimeErr)) {
     values[AliDielectronVarManager::kPseudoProperTime] =
-      fgEvent ? kfPair.GetPseudoProperDecayTime(*(fgEvent->GetPrimaryVertex()), TDatabasePDG::Instance()->GetParticle(443)->Mass(), &errPseudoProperTime2 ) : -1e10;
-  // values[AliDielectronVarManager::kPseudoProperTime] = fgEvent ? pair->GetPseudoProperTime(fgEvent->GetPrimaryVertex()): -1e10;
+      fgContext->fEvent ? kfPair.GetPseudoProperDecayTime(*(fgContext->fEvent->GetPrimaryVertex()), TDatabasePDG::Instance()->GetParticle(443)->Mass(), &errPseudoProperTime2 ) : -1e10;
+  // values[AliDielectronVarManager::kPseudoProperTime] = fgContext->fEvent ? pair->GetPseudoProperTime(fgContext->fEvent->GetPrimaryVertex()): -1e10;
     values[AliDielectronVarManager::kPseudoProperTimeErr] = (errPseudoProperTime2 > 0) ? TMath::Sqrt(errPseudoProperTime2) : -1e10;
   }
 
   // impact parameter
   Double_t d0z0[2]={-999., -999.};
-  if( (Req(kImpactParXY) || Req(kImpactParZ)) && fgEvent) pair->GetDCA(fgEvent->GetPrimaryVertex(), d0z0);
+  if( (Req(kImpactParXY) || Req(kImpactParZ)) && fgContext->fEvent) pair->GetDCA(fgContext->fEvent->GetPrimaryVertex(), d0z0);
   values[AliDielectronVarManager::kImpactParXY]   = d0z0[0];
   values[AliDielectronVarManager::kImpactParZ]    = d0z0[1];
 
@@ -1986,7 +2018,7 @@ inline void AliDielectronVarManager::FillVarDielectronPair(const AliDielectronPa
 	values[AliDielectronVarManager::kDeltaEta]     = TMath::Abs(feta1 -feta2 );
 	values[AliDielectronVarManager::kDeltaPhi]     = lv1.DeltaPhi(lv2);
 
-       if( Req(kDeltaPhiChargeOrdered) && fgEvent ) values[AliDielectronVarManager::kDeltaPhiChargeOrdered] = fD1.GetQ() * fgEvent->GetMagneticField() > 0 ? lv1.Phi() - lv2.Phi() :lv2.Phi() - lv1.Phi() ;
+       if( Req(kDeltaPhiChargeOrdered) && fgContext->fEvent ) values[AliDielectronVarManager::kDeltaPhiChargeOrdered] = fD1.GetQ() * fgContext->fEvent->GetMagneticField() > 0 ? lv1.Phi() - lv2.Phi() :lv2.Phi() - lv1.Phi() ;
 	values[AliDielectronVarManager::kPairType]     = pair->GetType();
 
         // Calculate pair variables for corresponding generated pair
@@ -2061,15 +2093,15 @@ inline void AliDielectronVarManager::FillVarDielectronPair(const AliDielectronPa
   if(Req(kSinPhiH2)) values[AliDielectronVarManager::kSinPhiH2] = TMath::Sin(2*phi);
   Double_t delta=0.0;
   // v2 with respect to VZERO-A event plane
-  delta = TVector2::Phi_mpi_pi(phi - fgData[AliDielectronVarManager::kV0ArpH2]);
+  delta = TVector2::Phi_mpi_pi(phi - fgContext->fData[AliDielectronVarManager::kV0ArpH2]);
   if(Req(kV0ArpH2FlowV2))   values[AliDielectronVarManager::kV0ArpH2FlowV2] = TMath::Cos(2.0*delta);  // 2nd harmonic flow coefficient
   if(Req(kDeltaPhiV0ArpH2)) values[AliDielectronVarManager::kDeltaPhiV0ArpH2] = delta;
   // v2 with respect to VZERO-C event plane
-  delta = TVector2::Phi_mpi_pi(phi - fgData[AliDielectronVarManager::kV0CrpH2]);
+  delta = TVector2::Phi_mpi_pi(phi - fgContext->fData[AliDielectronVarManager::kV0CrpH2]);
   if(Req(kV0CrpH2FlowV2))   values[AliDielectronVarManager::kV0CrpH2FlowV2] = TMath::Cos(2.0*delta);  // 2nd harmonic flow coefficient
   if(Req(kDeltaPhiV0CrpH2)) values[AliDielectronVarManager::kDeltaPhiV0CrpH2] = delta;
   // v2 with respect to the combined VZERO-A and VZERO-C event plane
-  delta = TVector2::Phi_mpi_pi(phi - fgData[AliDielectronVarManager::kV0ACrpH2]);
+  delta = TVector2::Phi_mpi_pi(phi - fgContext->fData[AliDielectronVarManager::kV0ACrpH2]);
   if(Req(kV0ACrpH2FlowV2))   values[AliDielectronVarManager::kV0ACrpH2FlowV2] = TMath::Cos(2.0*delta);  // 2nd harmonic flow coefficient
   if(Req(kDeltaPhiV0ACrpH2)) values[AliDielectronVarManager::kDeltaPhiV0ACrpH2] = delta;
 
@@ -2156,11 +2188,11 @@ inline void AliDielectronVarManager::FillVarDielectronPair(const AliDielectronPa
     // fill kPseudoProperTimeResolution
     values[AliDielectronVarManager::kPseudoProperTimeResolution] = -1e10;
     // values[AliDielectronVarManager::kPseudoProperTimePull] = -1e10;
-    if(samemother && fgEvent) {
+    if(samemother && fgContext->fEvent) {
       if(pair->GetFirstDaughterP()->GetLabel() > 0) {
         const AliVParticle *motherMC = 0x0;
-        if(fgEvent->IsA() == AliESDEvent::Class())  motherMC = (AliMCParticle*)mc->GetMCTrackMother((AliESDtrack*)pair->GetFirstDaughterP());
-        else if(fgEvent->IsA() == AliAODEvent::Class())  motherMC = (AliAODMCParticle*)mc->GetMCTrackMother((AliAODTrack*)pair->GetFirstDaughterP());
+        if(fgContext->fEvent->IsA() == AliESDEvent::Class())  motherMC = (AliMCParticle*)mc->GetMCTrackMother((AliESDtrack*)pair->GetFirstDaughterP());
+        else if(fgContext->fEvent->IsA() == AliAODEvent::Class())  motherMC = (AliAODMCParticle*)mc->GetMCTrackMother((AliAODTrack*)pair->GetFirstDaughterP());
         Double_t vtxX, vtxY, vtxZ;
 	if(motherMC && mc->GetPrimaryVertex(vtxX,vtxY,vtxZ)) {
 	  Int_t motherLbl = motherMC->GetLabel();
@@ -2207,15 +2239,15 @@ inline void AliDielectronVarManager::FillVarDielectronPair(const AliDielectronPa
   values[AliDielectronVarManager::kPairEff]=0.0;
   values[AliDielectronVarManager::kOneOverPairEff]=0.0;
   values[AliDielectronVarManager::kOneOverPairEffSq]=0.0;
-  if (leg1 && leg2 && fgLegEffMap) {
+  if (leg1 && leg2 && fgContext->fLegEffMap) {
     Fill(leg1, valuesLeg1);
     Fill(leg2, valuesLeg2);
     values[AliDielectronVarManager::kPairEff] = valuesLeg1[AliDielectronVarManager::kLegEff] *valuesLeg2[AliDielectronVarManager::kLegEff];
   }
-  else if(fgPairEffMap) {
+  else if(fgContext->fPairEffMap) {
     values[AliDielectronVarManager::kPairEff] = GetPairEff(values);
   }
-  if(fgLegEffMap || fgPairEffMap) {
+  if(fgContext->fLegEffMap || fgContext->fPairEffMap) {
     values[AliDielectronVarManager::kOneOverPairEff] = (values[AliDielectronVarManager::kPairEff]>0.0 ? 1./values[AliDielectronVarManager::kPairEff] : 1.0);
     values[AliDielectronVarManager::kOneOverPairEffSq] = (values[AliDielectronVarManager::kPairEff]>0.0 ? 1./values[AliDielectronVarManager::kPairEff]/values[AliDielectronVarManager::kPairEff] : 1.0);
   }
@@ -2288,9 +2320,8 @@ inline void AliDielectronVarManager::FillVarKFParticle(const AliKFParticle *part
   values[AliDielectronVarManager::kHasCocktailMother]=0;
   values[AliDielectronVarManager::kHasCocktailGrandMother]=0;
 
-//   if ( fgEvent ) AliDielectronVarManager::Fill(fgEvent, values);
-  for (Int_t i=AliDielectronVarManager::kPairMax; i<AliDielectronVarManager::kNMaxValues; ++i)
-    values[i]=fgData[i];
+//   if ( fgContext->fEvent ) AliDielectronVarManager::Fill(fgContext->fEvent, values);
+  FillVarEventData(values);
 
 }
 
@@ -2300,11 +2331,11 @@ inline void AliDielectronVarManager::FillVarVEvent(const AliVEvent *event, Doubl
   // Fill event information available for histogramming into an array
   //
   values[AliDielectronVarManager::kRunNumber]    = event->GetRunNumber();
-  if(fgCurrentRun!=event->GetRunNumber()) {
+  if(fgContext->fCurrentRun!=event->GetRunNumber()) {
     if(fgVZEROCalibrationFile.Contains(".root")) InitVZEROCalibrationHistograms(event->GetRunNumber());
     if(fgVZERORecenteringFile.Contains(".root")) InitVZERORecenteringHistograms(event->GetRunNumber());
     if(fgZDCRecenteringFile.Contains(".root")) InitZDCRecenteringHistograms(event->GetRunNumber());
-    fgCurrentRun=event->GetRunNumber();
+    fgContext->fCurrentRun=event->GetRunNumber();
   }
   values[AliDielectronVarManager::kMixingBin]=0;
 
@@ -3070,10 +3101,10 @@ inline Double_t AliDielectronVarManager::GetSingleLegEff(Double_t * const values
   //
   // get the single leg efficiency for a given particle
   //
-  if(!fgLegEffMap) return -1.;
+  if(!fgContext->fLegEffMap) return -1.;
 
-  if(fgLegEffMap->InheritsFrom(THnBase::Class())) {
-    THnBase *eff = static_cast<THnBase*>(fgLegEffMap);
+  if(fgContext->fLegEffMap->InheritsFrom(THnBase::Class())) {
+    THnBase *eff = static_cast<THnBase*>(fgContext->fLegEffMap);
     Int_t dim=eff->GetNdimensions();
     Int_t idx[dim];
     for(Int_t idim=0; idim<dim; idim++) {
@@ -3091,10 +3122,10 @@ inline Double_t AliDielectronVarManager::GetPairEff(Double_t * const values) {
   //
   // get the pair efficiency for given pair kinematics
   //
-  if(!fgPairEffMap) return -1.;
+  if(!fgContext->fPairEffMap) return -1.;
 
-  if(fgPairEffMap->IsA()== THnBase::Class()) {
-    THnBase *eff = static_cast<THnBase*>(fgPairEffMap);
+  if(fgContext->fPairEffMap->IsA()== THnBase::Class()) {
+    THnBase *eff = static_cast<THnBase*>(fgContext->fPairEffMap);
     Int_t dim=eff->GetNdimensions();
     Int_t idx[dim];
     for(Int_t idim=0; idim<dim; idim++) {
@@ -3105,8 +3136,8 @@ inline Double_t AliDielectronVarManager::GetPairEff(Double_t * const values) {
     const Double_t ret=(eff->GetBinContent(idx));
     return ret;
   }
-  if(fgPairEffMap->IsA()== TSpline3::Class()) {
-    TSpline3 *eff = static_cast<TSpline3*>(fgPairEffMap);
+  if(fgContext->fPairEffMap->IsA()== TSpline3::Class()) {
+    TSpline3 *eff = static_cast<TSpline3*>(fgContext->fPairEffMap);
     if(!eff->GetHistogram()) { printf("no histogram added to the spline\n"); return -1.;}
     UInt_t var = GetValueType(eff->GetHistogram()->GetXaxis()->GetName());
     return (eff->Eval(values[var]));
@@ -3118,87 +3149,81 @@ inline Double_t AliDielectronVarManager::GetPairEff(Double_t * const values) {
 
 inline void AliDielectronVarManager::InitVZEROCalibrationHistograms(Int_t runNo) {
   //
-  // Initialize the VZERO channel-by-channel calibration histograms
+  // Load the VZERO channel-by-channel calibration histograms of the run into the active context
   //
 
-  //initialize only once
-  if(fgVZEROCalib[0]) return;
-
   for(Int_t i=0; i<64; ++i)
-    if(fgVZEROCalib[i]) {
-      delete fgVZEROCalib[i];
-      fgVZEROCalib[i] = 0x0;
+    if(fgContext->fVZEROCalib[i]) {
+      delete fgContext->fVZEROCalib[i];
+      fgContext->fVZEROCalib[i] = 0x0;
     }
 
   TFile file(fgVZEROCalibrationFile.Data());
 
   for(Int_t i=0; i<64; ++i){
-    fgVZEROCalib[i] = (TProfile2D*)(file.Get(Form("RUN%d_ch%d_VtxCent", runNo, i)));
-    if (fgVZEROCalib[i]) fgVZEROCalib[i]->SetDirectory(0x0);
+    fgContext->fVZEROCalib[i] = (TProfile2D*)(file.Get(Form("RUN%d_ch%d_VtxCent", runNo, i)));
+    if (fgContext->fVZEROCalib[i]) fgContext->fVZEROCalib[i]->SetDirectory(0x0);
   }
 }
 
 
 inline void AliDielectronVarManager::InitVZERORecenteringHistograms(Int_t runNo) {
   //
-  // Initialize the VZERO event plane recentering histograms
+  // Load the VZERO event plane recentering histograms of the run into the active context
   //
 
-  //initialize only once
-  if(fgVZERORecentering[0][0]) return;
-
   for(Int_t i=0; i<2; ++i)
     for(Int_t j=0; j<2; ++j)
-      if(fgVZERORecentering[i][j]) {
-        delete fgVZERORecentering[i][j];
-        fgVZERORecentering[i][j] = 0x0;
+      if(fgContext->fVZERORecentering[i][j]) {
+        delete fgContext->fVZERORecentering[i][j];
+        fgContext->fVZERORecentering[i][j] = 0x0;
       }
 
   TFile file(fgVZERORecenteringFile.Data());
   if (!file.IsOpen()) return;
 
-  fgVZERORecentering[0][0] = (TProfile2D*)(file.Get(Form("RUN%d_QxA_CentVtx", runNo)));
-  fgVZERORecentering[0][1] = (TProfile2D*)(file.Get(Form("RUN%d_QyA_CentVtx", runNo)));
-  fgVZERORecentering[1][0] = (TProfile2D*)(file.Get(Form("RUN%d_QxC_CentVtx", runNo)));
-  fgVZERORecentering[1][1] = (TProfile2D*)(file.Get(Form("RUN%d_QyC_CentVtx", runNo)));
+  fgContext->fVZERORecentering[0][0] = (TProfile2D*)(file.Get(Form("RUN%d_QxA_CentVtx", runNo)));
+  fgContext->fVZERORecentering[0][1] = (TProfile2D*)(file.Get(Form("RUN%d_QyA_CentVtx", runNo)));
+  fgContext->fVZERORecentering[1][0] = (TProfile2D*)(file.Get(Form("RUN%d_QxC_CentVtx", runNo)));
+  fgContext->fVZERORecentering[1][1] = (TProfile2D*)(file.Get(Form("RUN%d_QyC_CentVtx", runNo)));
 
-  if (fgVZERORecentering[0][0]) fgVZERORecentering[0][0]->SetDirectory(0x0);
-  if (fgVZERORecentering[0][1]) fgVZERORecentering[0][1]->SetDirectory(0x0);
-  if (fgVZERORecentering[1][0]) fgVZERORecentering[1][0]->SetDirectory(0x0);
-  if (fgVZERORecentering[1][1]) fgVZERORecentering[1][1]->SetDirectory(0x0);
+  if (fgContext->fVZERORecentering[0][0]) fgContext->fVZERORecentering[0][0]->SetDirectory(0x0);
+  if (fgContext->fVZERORecentering[0][1]) fgContext->fVZERORecentering[0][1]->SetDirectory(0x0);
+  if (fgContext->fVZERORecentering[1][0]) fgContext->fVZERORecentering[1][0]->SetDirectory(0x0);
+  if (fgContext->fVZERORecentering[1][1]) fgContext->fVZERORecentering[1][1]->SetDirectory(0x0);
 
 }
 
 inline void AliDielectronVarManager::InitZDCRecenteringHistograms(Int_t runNo) {
+  //
+  // Load the ZDC event plane recentering histograms of the run into the active context
+  //
 
-  //initialize only once
-  if(fgZDCRecentering[0][0]) return;
-
-  for(Int_t i=0; i<2; ++i)
+  for(Int_t i=0; i<3; ++i)
     for(Int_t j=0; j<2; ++j)
-      if(fgZDCRecentering[i][j]) {
-        delete fgZDCRecentering[i][j];
-        fgZDCRecentering[i][j] = 0x0;
+      if(fgContext->fZDCRecentering[i][j]) {
+        delete fgContext->fZDCRecentering[i][j];
+        fgContext->fZDCRecentering[i][j] = 0x0;
       }
 
   TFile* file=TFile::Open(fgZDCRecenteringFile.Data());
   if(!file) return;
 
 
-  fgZDCRecentering[0][0] = (TProfile3D*)file->Get(Form("RUN%06d_QxA_Recent", runNo));
-  fgZDCRecentering[0][1] = (TProfile3D*)file->Get(Form("RUN%06d_QyA_Recent", runNo));
-  fgZDCRecentering[1][0] = (TProfile3D*)file->Get(Form("RUN%06d_QxC_Recent", runNo));
-  fgZDCRecentering[1][1] = (TProfile3D*)file->Get(Form("RUN%06d_QyC_Recent", runNo));
-  fgZDCRecentering[2][0] = (TProfile3D*)file->Get(Form("RUN%06d_QxAC_Recent", runNo));
-  fgZDCRecentering[2][1] = (TProfile3D*)file->Get(Form("RUN%06d_QyAC_Recent", runNo));
+  fgContext->fZDCRecentering[0][0] = (TProfile3D*)file->Get(Form("RUN%06d_QxA_Recent", runNo));
+  fgContext->fZDCRecentering[0][1] = (TProfile3D*)file->Get(Form("RUN%06d_QyA_Recent", runNo));
+  fgContext->fZDCRecentering[1][0] = (TProfile3D*)file->Get(Form("RUN%06d_QxC_Recent", runNo));
+  fgContext->fZDCRecentering[1][1] = (TProfile3D*)file->Get(Form("RUN%06d_QyC_Recent", runNo));
+  fgContext->fZDCRecentering[2][0] = (TProfile3D*)file->Get(Form("RUN%06d_QxAC_Recent", runNo));
+  fgContext->fZDCRecentering[2][1] = (TProfile3D*)file->Get(Form("RUN%06d_QyAC_Recent", runNo));
 
 
-  if (fgZDCRecentering[0][0]) fgZDCRecentering[0][0]->SetDirectory(0x0);
-  if (fgZDCRecentering[0][1]) fgZDCRecentering[0][1]->SetDirectory(0x0);
-  if (fgZDCRecentering[1][0]) fgZDCRecentering[1][0]->SetDirectory(0x0);
-  if (fgZDCRecentering[1][1]) fgZDCRecentering[1][1]->SetDirectory(0x0);
-  if (fgZDCRecentering[2][0]) fgZDCRecentering[2][0]->SetDirectory(0x0);
-  if (fgZDCRecentering[2][1]) fgZDCRecentering[2][1]->SetDirectory(0x0);
+  if (fgContext->fZDCRecentering[0][0]) fgContext->fZDCRecentering[0][0]->SetDirectory(0x0);
+  if (fgContext->fZDCRecentering[0][1]) fgContext->fZDCRecentering[0][1]->SetDirectory(0x0);
+  if (fgContext->fZDCRecentering[1][0]) fgContext->fZDCRecentering[1][0]->SetDirectory(0x0);
+  if (fgContext->fZDCRecentering[1][1]) fgContext->fZDCRecentering[1][1]->SetDirectory(0x0);
+  if (fgContext->fZDCRecentering[2][0]) fgContext->fZDCRecentering[2][0]->SetDirectory(0x0);
+  if (fgContext->fZDCRecentering[2][1]) fgContext->fZDCRecentering[2][1]->SetDirectory(0x0);
 
   delete file;
 
@@ -3258,20 +3283,39 @@ inline Double_t AliDielectronVarManager::GetTRDpidEfficiency(Int_t runNo, Double
 inline void AliDielectronVarManager::SetEvent(AliVEvent * const ev)
 {
 
-  fgEvent = ev;
-  if (fgKFVertex) delete fgKFVertex;
-  fgKFVertex=0x0;
+  fgContext->fEvent = ev;
+  if (fgContext->fKFVertex) delete fgContext->fKFVertex;
+  fgContext->fKFVertex=0x0;
   if (!ev) return;
-  if (ev->GetPrimaryVertex()) fgKFVertex=new AliKFVertex(*ev->GetPrimaryVertex());
+  if (ev->GetPrimaryVertex()) fgContext->fKFVertex=new AliKFVertex(*ev->GetPrimaryVertex());
+
+  for (Int_t i=0; i<AliDielectronVarManager::kNMaxValues;++i) fgContext->fData[i]=0.;
+  AliDielectronVarManager::Fill(fgContext->fEvent, fgContext->fData);
+}
 
-  for (Int_t i=0; i<AliDielectronVarManager::kNMaxValues;++i) fgData[i]=0.;
-  AliDielectronVarManager::Fill(fgEvent, fgData);
+inline void AliDielectronVarManager::FillVarEventData(Double_t * const values)
+{
+  //
+  // Copy the event variables of the active context into the array.
+  // With a fill map only the requested event variables are copied,
+  // the other slots of the array are left untouched.
+  //
+  const Double_t *data=fgContext->fData;
+  const TBits *fillMap=fgContext->fFillMap;
+  if (!fillMap) {
+    for (Int_t i=AliDielectronVarManager::kPairMax; i<AliDielectronVarManager::kNMaxValues; ++i)
+      values[i]=data[i];
+    return;
+  }
+  const UInt_t nMax=TMath::Min((UInt_t)AliDielectronVarManager::kNMaxValues, fillMap->GetNbits());
+  for (UInt_t i=fillMap->FirstSetBit(AliDielectronVarManager::kPairMax); i<nMax; i=fillMap->FirstSetBit(i+1))
+    values[i]=data[i];
 }
 
 inline void AliDielectronVarManager::SetEventData(const Double_t data[AliDielectronVarManager::kNMaxValues])
 {
-  for (Int_t i=0; i<kNMaxValues;++i) fgData[i]=0.;
-  for (Int_t i=kPairMax; i<kNMaxValues;++i) fgData[i]=data[i];
+  for (Int_t i=0; i<kNMaxValues;++i) fgContext->fData[i]=0.;
+  for (Int_t i=kPairMax; i<kNMaxValues;++i) fgContext->fData[i]=data[i];
 }
 
 
@@ -3286,7 +3330,7 @@ inline Bool_t AliDielectronVarManager::GetDCA(const AliAODTrack *track, Double_t
   }
 
   Bool_t ok=kFALSE;
-  if(fgEvent) {
+  if(fgContext->fEvent) {
     AliExternalTrackParam etp; etp.CopyFromVTrack(track);
 
     Float_t xstart = etp.GetX();
@@ -3296,8 +3340,8 @@ inline Bool_t AliDielectronVarManager::GetDCA(const AliAODTrack *track, Double_t
       return kFALSE;
     }
 
-    AliAODVertex *vtx =(AliAODVertex*)(fgEvent->GetPrimaryVertex());
-    Double_t fBzkG = fgEvent->GetMagneticField(); // z componenent of field in kG
+    AliAODVertex *vtx =(AliAODVertex*)(fgContext->fEvent->GetPrimaryVertex());
+    Double_t fBzkG = fgContext->fEvent->GetMagneticField(); // z componenent of field in kG
     ok = etp.PropagateToDCA(vtx,fBzkG,kVeryBig,d0z0,covd0z0);
   }
   if(!ok){
@@ -3310,10 +3354,10 @@ inline Bool_t AliDielectronVarManager::GetDCA(const AliAODTrack *track, Double_t
 inline void AliDielectronVarManager::SetTPCEventPlane(AliEventplane *const evplane)
 {
 
-  fgTPCEventPlane = evplane;
-  FillVarTPCEventPlane(evplane,fgData);
-  //  for (Int_t i=0; i<AliDielectronVarManager::kNMaxValues;++i) fgData[i]=0.;
-  //  AliDielectronVarManager::Fill(fgEvent, fgData);
+  fgContext->fTPCEventPlane = evplane;
+  FillVarTPCEventPlane(evplane,fgContext->fData);
+  //  for (Int_t i=0; i<AliDielectronVarManager::kNMaxValues;++i) fgContext->fData[i]=0.;
+  //  AliDielectronVarManager::Fill(fgContext->fEvent, fgContext->fData);
 }
 
 
@@ -3373,9 +3417,9 @@ inline void AliDielectronVarManager::GetVzeroRP(const AliVEvent* event, Double_t
   if(centralitySPD<0. || centralitySPD>80.) return;
 
   Int_t binCent = -1; Int_t binVtx = -1;
-  if(fgVZEROCalib[0]) {
-    binVtx = fgVZEROCalib[0]->GetXaxis()->FindBin(vtxZ);
-    binCent = fgVZEROCalib[0]->GetYaxis()->FindBin(centralitySPD);
+  if(fgContext->fVZEROCalib[0]) {
+    binVtx = fgContext->fVZEROCalib[0]->GetXaxis()->FindBin(vtxZ);
+    binCent = fgContext->fVZEROCalib[0]->GetYaxis()->FindBin(centralitySPD);
   }
   AliVVZERO* vzero = event->GetVZEROData();
   Double_t average = 0.0;
@@ -3384,8 +3428,8 @@ inline void AliDielectronVarManager::GetVzeroRP(const AliVEvent* event, Double_t
     if(iChannel>=32 && sideOption==1) continue;
     phi=iChannel%8;
     mult = vzero->GetMultiplicity(iChannel);
-    if(fgVZEROCalib[iChannel])
-      average = fgVZEROCalib[iChannel]->GetBinContent(binVtx, binCent);
+    if(fgContext->fVZEROCalib[iChannel])
+      average = fgContext->fVZEROCalib[iChannel]->GetBinContent(binVtx, binCent);
     if(average>1.0e-10 && mult>0.5)
       mult /= average;
     else
@@ -3396,24 +3440,24 @@ inline void AliDielectronVarManager::GetVzeroRP(const AliVEvent* event, Double_t
   }    // end loop over channels
 
   // do recentering
-  if(fgVZERORecentering[0][0]) {
-//     printf("vzero: %p\n",fgVZERORecentering[0][0]);
+  if(fgContext->fVZERORecentering[0][0]) {
+//     printf("vzero: %p\n",fgContext->fVZERORecentering[0][0]);
     Int_t binCentRecenter = -1; Int_t binVtxRecenter = -1;
-    binCentRecenter = fgVZERORecentering[0][0]->GetXaxis()->FindBin(centralitySPD);
-    binVtxRecenter = fgVZERORecentering[0][0]->GetYaxis()->FindBin(vtxZ);
+    binCentRecenter = fgContext->fVZERORecentering[0][0]->GetXaxis()->FindBin(centralitySPD);
+    binVtxRecenter = fgContext->fVZERORecentering[0][0]->GetYaxis()->FindBin(vtxZ);
     if(sideOption==0) {  // side A
-      qvec[0] -= fgVZERORecentering[0][0]->GetBinContent(binCentRecenter, binVtxRecenter);
-      qvec[1] -= fgVZERORecentering[0][1]->GetBinContent(binCentRecenter, binVtxRecenter);
+      qvec[0] -= fgContext->fVZERORecentering[0][0]->GetBinContent(binCentRecenter, binVtxRecenter);
+      qvec[1] -= fgContext->fVZERORecentering[0][1]->GetBinContent(binCentRecenter, binVtxRecenter);
     }
     if(sideOption==1) {  // side C
-      qvec[0] -= fgVZERORecentering[1][0]->GetBinContent(binCentRecenter, binVtxRecenter);
-      qvec[1] -= fgVZERORecentering[1][1]->GetBinContent(binCentRecenter, binVtxRecenter);
+      qvec[0] -= fgContext->fVZERORecentering[1][0]->GetBinContent(binCentRecenter, binVtxRecenter);
+      qvec[1] -= fgContext->fVZERORecentering[1][1]->GetBinContent(binCentRecenter, binVtxRecenter);
     }
     if(sideOption==2) {  // side A and C together
-      qvec[0] -= fgVZERORecentering[0][0]->GetBinContent(binCentRecenter, binVtxRecenter);
-      qvec[0] -= fgVZERORecentering[1][0]->GetBinContent(binCentRecenter, binVtxRecenter);
-      qvec[1] -= fgVZERORecentering[0][1]->GetBinContent(binCentRecenter, binVtxRecenter);
-      qvec[1] -= fgVZERORecentering[1][1]->GetBinContent(binCentRecenter, binVtxRecenter);
+      qvec[0] -= fgContext->fVZERORecentering[0][0]->GetBinContent(binCentRecenter, binVtxRecenter);
+      qvec[0] -= fgContext->fVZERORecentering[1][0]->GetBinContent(binCentRecenter, binVtxRecenter);
+      qvec[1] -= fgContext->fVZERORecentering[0][1]->GetBinContent(binCentRecenter, binVtxRecenter);
+      qvec[1] -= fgContext->fVZERORecentering[1][1]->GetBinContent(binCentRecenter, binVtxRecenter);
     }
   }
 
@@ -3488,7 +3532,7 @@ inline void AliDielectronVarManager::GetZDCRP(const AliVEvent* event, Double_t q
 
   }
 
-  if(fgZDCRecentering[0][0]){
+  if(fgContext->fZDCRecentering[0][0]){
     const AliAODEvent* aodEv = static_cast<const AliAODEvent*>(event);
     AliAODHeader *header = dynamic_cast<AliAODHeader*>(aodEv->GetHeader());
     if(!header) return;
@@ -3505,8 +3549,8 @@ inline void AliDielectronVarManager::GetZDCRP(const AliVEvent* event, Double_t q
 
     for(int j = 0; j < nZDCplanes; j++)
       if(qvecDEN[j] != 0){
-        qvec[j][0] -= fgZDCRecentering[j][0] -> GetBinContent(multiBin, vtxXBin, vtxYBin);
-        qvec[j][1] -= fgZDCRecentering[j][1] -> GetBinContent(multiBin, vtxXBin, vtxYBin);
+        qvec[j][0] -= fgContext->fZDCRecentering[j][0] -> GetBinContent(multiBin, vtxXBin, vtxYBin);
+        qvec[j][1] -= fgContext->fZDCRecentering[j][1] -> GetBinContent(multiBin, vtxXBin, vtxYBin);
       }
   }
 
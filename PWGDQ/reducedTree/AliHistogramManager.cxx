@@ -48,7 +48,13 @@ AliHistogramManager::AliHistogramManager() :
   fBinsAllocated(0),
   fVariableNames(),
   fVariableUnits(),
-  fNVars(0)
+  fNVars(0),
+  fFillPlansCompiled(kFALSE),
+  fFillPlanOffsets(),
+  fFillPlanHistograms(),
+  fFillPlanKinds(),
+  fFillPlanVars(),
+  fFillPlanTHnVars()
 {
   //
   // Constructor
@@ -70,7 +76,13 @@ AliHistogramManager::AliHistogramManager(const Char_t* name, Int_t nvars) :
   fBinsAllocated(0),
   fVariableNames(),
   fVariableUnits(),
-  fNVars(nvars)
+  fNVars(nvars),
+  fFillPlansCompiled(kFALSE),
+  fFillPlanOffsets(),
+  fFillPlanHistograms(),
+  fFillPlanKinds(),
+  fFillPlanVars(),
+  fFillPlanTHnVars()
 {
   //
   // Constructor
@@ -130,6 +142,7 @@ void AliHistogramManager::AddHistClass(const Char_t* histClass) {
   hList->SetOwner(kTRUE);
   hList->SetName(histClass);
   fMainList.Add(hList);
+  fFillPlansCompiled = kFALSE;
 }
 
 //_________________________________________________________________
@@ -153,6 +166,7 @@ void AliHistogramManager::AddHistogram(const Char_t* histClass,
     cout << "Warning in AliHistogramManager::AddHistogram(): Histogram " << name << " already exists" << endl;
     return;
   }
+  fFillPlansCompiled = kFALSE;
   TString hname = name;
   
   Int_t dimension = 1;
@@ -289,6 +303,7 @@ void AliHistogramManager::AddHistogram(const Char_t* histClass,
     cout << "Warning in AliHistogramManager::AddHistogram(): Histogram " << name << " already exists" << endl;
     return;
   }
+  fFillPlansCompiled = kFALSE;
   TString hname = name;
   
   Int_t dimension = 1;
@@ -427,6 +442,7 @@ void AliHistogramManager::AddHistogram(const Char_t* histClass,
     cout << "Warning in AliHistogramManager::AddHistogram(): Histogram " << name << " already exists" << endl;
     return;
   }
+  fFillPlansCompiled = kFALSE;
   TString hname = name;
   
   TString titleStr(title);
@@ -476,6 +492,7 @@ void AliHistogramManager::AddHistogram(const Char_t* histClass,
     cout << "Warning in AliHistogramManager::AddHistogram(): Histogram " << name << " already exists" << endl;
     return;
   }
+  fFillPlansCompiled = kFALSE;
   TString hname = name;
   
   TString titleStr(title);
@@ -599,140 +616,169 @@ THnF* AliHistogramManager::CreateHistogram( const Char_t* name, const Char_t* ti
 
 
 //__________________________________________________________________
-void AliHistogramManager::FillHistClass(const Char_t* className, Float_t* values) {
-  //
-  //  fill a class of histograms
-  //
-  THashList* hList = (THashList*)fMainList.FindObject(className);
-  if(!hList) {
-    /*cout << "Warning in AliHistogramManager::FillHistClass(): Histogram list " << className << " not found!" << endl;
-    cout << "         Histogram list not filled" << endl; */
-    return;
-  }
-  if(!hList) {
-    return;
-  }
+void AliHistogramManager::CompileFillPlans() {
+  //
+  //  Decode once, for all histogram classes, what FillHistClass() needs for each histogram:
+  //  the fill kind and the variables, as encoded in the unique IDs of the histograms and axes.
+  //  Histograms which use a variable not flagged in fUsedVars are never filled and are left out.
+  //  The handle of a class is its position in fMainList, which is also stored in the unique ID of its list.
+  //
+  fFillPlanOffsets.clear();
+  fFillPlanHistograms.clear();
+  fFillPlanKinds.clear();
+  fFillPlanVars.clear();
+  fFillPlanTHnVars.clear();
+  
+  for(Int_t iclass=0; iclass<fMainList.GetEntries(); ++iclass) {
+    THashList* hList = (THashList*)fMainList.At(iclass);
+    hList->SetUniqueID(iclass+1);
+    fFillPlanOffsets.push_back(fFillPlanHistograms.size());
     
-  TIter next(hList);
-  TObject* h=0x0;
-  Bool_t isProfile;
-  Bool_t isTHn;
-  Int_t thnDim=0;
-  Double_t fillValues[20]={0.0};
-  Int_t uid = 0;
-  Int_t varX=-1, varY=-1, varZ=-1, varT=-1, varW=-1;
-  Int_t dimension=0;
-  while((h=next())) {
-    Bool_t allVarsGood = kTRUE;
-    uid = h->GetUniqueID();
-    isProfile = (uid%10==1 ? kTRUE : kFALSE);   // units digit encodes the isProfile
-    isTHn = ((uid%100)>10 ? kTRUE : kFALSE);      
-    if(isTHn) thnDim = (uid%100)-10;        // the excess over 10 from the last 2 digits give the dimension of the THn
-    dimension = 0;
-    if(!isTHn) dimension = ((TH1*)h)->GetDimension();
-        
-    uid = (uid-(uid%100))/100;
-    varX = -1;
-    varY = -1;
-    varZ = -1;
-    varT = -1;
-    varW = -1;
-    if(uid>0) {
-      varW = uid%(fNVars+1)-1;
-      if(varW==0) varW=AliReducedVarManager::kNothing;
-      uid = (uid-(uid%(fNVars+1)))/(fNVars+1);
-      if(uid>0) varT = uid - 1;
-      //cout << "Filling " << h->GetName() << " with varT " << varT << endl;
-    }
-        
-    if(!isTHn) {
-      varX = ((TH1*)h)->GetXaxis()->GetUniqueID();
-      if(fUsedVars[varX]) {
+    TIter next(hList);
+    TObject* h=0x0;
+    while((h=next())) {
+      Int_t uid = h->GetUniqueID();
+      Bool_t isProfile = (uid%10==1 ? kTRUE : kFALSE);   // units digit encodes the isProfile
+      Bool_t isTHn = ((uid%100)>10 ? kTRUE : kFALSE);
+      Int_t thnDim = 0;
+      if(isTHn) thnDim = (uid%100)-10;        // the excess over 10 from the last 2 digits give the dimension of the THn
+      Int_t dimension = 0;
+      if(!isTHn) dimension = ((TH1*)h)->GetDimension();
+      
+      uid = (uid-(uid%100))/100;
+      Int_t vars[kNPlanVars] = {-1, -1, -1, -1, -1};
+      if(uid>0) {
+        vars[kPlanVarW] = uid%(fNVars+1)-1;
+        if(vars[kPlanVarW]==0) vars[kPlanVarW]=AliReducedVarManager::kNothing;
+        uid = (uid-(uid%(fNVars+1)))/(fNVars+1);
+        if(uid>0) vars[kPlanVarT] = uid - 1;
+      }
+      if(vars[kPlanVarW]>AliReducedVarManager::kNothing && !fUsedVars[vars[kPlanVarW]]) continue;
+      
+      Int_t kind = kNFillKinds;
+      if(!isTHn) {
+        vars[kPlanVarX] = ((TH1*)h)->GetXaxis()->GetUniqueID();
+        if(!fUsedVars[vars[kPlanVarX]]) continue;
+        if(dimension>1 || isProfile) {
+          vars[kPlanVarY] = ((TH1*)h)->GetYaxis()->GetUniqueID();
+          if(!fUsedVars[vars[kPlanVarY]]) continue;
+        }
+        if(dimension>2 || (dimension==2 && isProfile)) {
+          vars[kPlanVarZ] = ((TH1*)h)->GetZaxis()->GetUniqueID();
+          if(!fUsedVars[vars[kPlanVarZ]]) continue;
+        }
+        if(dimension==3 && isProfile && !fUsedVars[vars[kPlanVarT]]) continue;
         switch(dimension) {
           case 1:
-            if(isProfile) {
-              varY = ((TH1*)h)->GetYaxis()->GetUniqueID();
-              if(!fUsedVars[varY]) break;
-              if(varW>AliReducedVarManager::kNothing) { 
-                if(!fUsedVars[varW]) break;
-                ((TProfile*)h)->Fill(values[varX],values[varY],values[varW]);
-              }
-              else 
-                ((TProfile*)h)->Fill(values[varX],values[varY]);
-            }
-            else {
-              if(varW>AliReducedVarManager::kNothing) {
-                if(!fUsedVars[varW]) break;
-                ((TH1F*)h)->Fill(values[varX],values[varW]);
-              }
-              else
-                ((TH1F*)h)->Fill(values[varX]);
-            }
-          break;
+            kind = (isProfile ? kFillProfile : kFillTH1);
+            break;
           case 2:
-            varY = ((TH1*)h)->GetYaxis()->GetUniqueID();
-            if(!fUsedVars[varY]) break;
-            if(isProfile) {
-              varZ = ((TH1*)h)->GetZaxis()->GetUniqueID();
-              if(!fUsedVars[varZ]) break;
-              if(varW>AliReducedVarManager::kNothing) {
-                if(!fUsedVars[varW]) break;
-                ((TProfile2D*)h)->Fill(values[varX],values[varY],values[varZ],values[varW]);
-              }
-              else
-                ((TProfile2D*)h)->Fill(values[varX],values[varY],values[varZ]);        
-            }
-            else {
-              if(varW>AliReducedVarManager::kNothing) {
-                if(!fUsedVars[varW]) break;
-                ((TH2F*)h)->Fill(values[varX],values[varY], values[varW]);
-              }
-              else
-                ((TH2F*)h)->Fill(values[varX],values[varY]);
-            }
-          break;
+            kind = (isProfile ? kFillProfile2D : kFillTH2);
+            break;
           case 3:
-            varY = ((TH1*)h)->GetYaxis()->GetUniqueID();
-            if(!fUsedVars[varY]) break;
-            varZ = ((TH1*)h)->GetZaxis()->GetUniqueID();
-            if(!fUsedVars[varZ]) break;
-            if(isProfile) {
-              if(!fUsedVars[varT]) break;
-              if(varW>AliReducedVarManager::kNothing) {
-                if(!fUsedVars[varW]) break;
-                ((TProfile3D*)h)->Fill(values[varX],values[varY],values[varZ],values[varT],values[varW]);
-              }
-              else
-                ((TProfile3D*)h)->Fill(values[varX],values[varY],values[varZ],values[varT]);
-            }
-            else {
-              if(varW>AliReducedVarManager::kNothing) {
-                if(!fUsedVars[varW]) break;
-                ((TH3F*)h)->Fill(values[varX],values[varY],values[varZ],values[varW]);
-              }
-              else
-                ((TH3F*)h)->Fill(values[varX],values[varY],values[varZ]);
-            }
-          break;
+            kind = (isProfile ? kFillProfile3D : kFillTH3);
+            break;
           default:
-          break;
-        }  // end switch
-      }
-    }  // end if(!isTHn)
-    else {
-      for(Int_t idim=0;idim<thnDim;++idim) {
-        allVarsGood &= fUsedVars[((THnF*)h)->GetAxis(idim)->GetUniqueID()];
-        fillValues[idim] = values[((THnF*)h)->GetAxis(idim)->GetUniqueID()];
+            break;
+        }
+        if(kind==kNFillKinds) continue;
       }
-      if(allVarsGood) {
-        if(varW>AliReducedVarManager::kNothing) {
-          if(fUsedVars[varW])
-            ((THnF*)h)->Fill(fillValues,values[varW]);
+      else {
+        Bool_t allVarsGood = kTRUE;
+        vars[kPlanVarX] = fFillPlanTHnVars.size();
+        vars[kPlanVarY] = thnDim;
+        for(Int_t idim=0;idim<thnDim;++idim) {
+          Int_t var = ((THnF*)h)->GetAxis(idim)->GetUniqueID();
+          allVarsGood &= fUsedVars[var];
+          fFillPlanTHnVars.push_back(var);
         }
-        else
-          ((THnF*)h)->Fill(fillValues);
+        if(!allVarsGood) {
+          fFillPlanTHnVars.resize(vars[kPlanVarX]);
+          continue;
+        }
+        kind = kFillTHn;
       }
-    }
+      
+      fFillPlanHistograms.push_back(h);
+      fFillPlanKinds.push_back(kind);
+      for(Int_t ivar=0; ivar<kNPlanVars; ++ivar) fFillPlanVars.push_back(vars[ivar]);
+    }  // end loop over histograms
+  }  // end loop over classes
+  fFillPlanOffsets.push_back(fFillPlanHistograms.size());
+  fFillPlansCompiled = kTRUE;
+}
+
+//__________________________________________________________________
+Int_t AliHistogramManager::GetHistClassHandle(const Char_t* className) {
+  //
+  //  Get the handle of a histogram class, to be used instead of its name in FillHistClass().
+  //  Handles stay valid when further classes or histograms are booked.
+  //
+  THashList* hList = (THashList*)fMainList.FindObject(className);
+  if(!hList) return -1;
+  if(!fFillPlansCompiled) CompileFillPlans();
+  return hList->GetUniqueID()-1;
+}
+
+//__________________________________________________________________
+void AliHistogramManager::FillHistClass(const Char_t* className, Float_t* values) {
+  //
+  //  fill a class of histograms
+  //
+  FillHistClass(GetHistClassHandle(className), values);
+}
+
+//__________________________________________________________________
+void AliHistogramManager::FillHistClass(Int_t classHandle, Float_t* values) {
+  //
+  //  fill a class of histograms, using its fill plan
+  //
+  if(classHandle<0) return;
+  if(!fFillPlansCompiled) CompileFillPlans();
+  if(classHandle>=(Int_t)fFillPlanOffsets.size()-1) return;
+  
+  Double_t fillValues[20]={0.0};
+  for(Int_t ientry=fFillPlanOffsets[classHandle]; ientry<fFillPlanOffsets[classHandle+1]; ++ientry) {
+    TObject* h = fFillPlanHistograms[ientry];
+    const Int_t* vars = &fFillPlanVars[ientry*kNPlanVars];
+    const Int_t varX = vars[kPlanVarX], varY = vars[kPlanVarY], varZ = vars[kPlanVarZ], varT = vars[kPlanVarT], varW = vars[kPlanVarW];
+    const Bool_t isWeighted = (varW>AliReducedVarManager::kNothing);
+    
+    switch(fFillPlanKinds[ientry]) {
+      case kFillTH1:
+        if(isWeighted) ((TH1F*)h)->Fill(values[varX],values[varW]);
+        else ((TH1F*)h)->Fill(values[varX]);
+        break;
+      case kFillProfile:
+        if(isWeighted) ((TProfile*)h)->Fill(values[varX],values[varY],values[varW]);
+        else ((TProfile*)h)->Fill(values[varX],values[varY]);
+        break;
+      case kFillTH2:
+        if(isWeighted) ((TH2F*)h)->Fill(values[varX],values[varY], values[varW]);
+        else ((TH2F*)h)->Fill(values[varX],values[varY]);
+        break;
+      case kFillProfile2D:
+        if(isWeighted) ((TProfile2D*)h)->Fill(values[varX],values[varY],values[varZ],values[varW]);
+        else ((TProfile2D*)h)->Fill(values[varX],values[varY],values[varZ]);
+        break;
+      case kFillTH3:
+        if(isWeighted) ((TH3F*)h)->Fill(values[varX],values[varY],values[varZ],values[varW]);
+        else ((TH3F*)h)->Fill(values[varX],values[varY],values[varZ]);
+        break;
+      case kFillProfile3D:
+        if(isWeighted) ((TProfile3D*)h)->Fill(values[varX],values[varY],values[varZ],values[varT],values[varW]);
+        else ((TProfile3D*)h)->Fill(values[varX],values[varY],values[varZ],values[varT]);
+        break;
+      case kFillTHn:
+        // for THn, X and Y give the offset and number of the axis variables
+        for(Int_t idim=0;idim<varY;++idim)
+          fillValues[idim] = values[fFillPlanTHnVars[varX+idim]];
+        if(isWeighted) ((THnF*)h)->Fill(fillValues,values[varW]);
+        else ((THnF*)h)->Fill(fillValues);
+        break;
+      default:
+        break;
+    }  // end switch
   }
 }
 
@@ -14,6 +14,8 @@
 #include <TList.h>
 #include <THashList.h>
 
+#include <vector>
+
 #include "AliReducedVarManager.h"
 
 class TAxis;
@@ -65,6 +67,9 @@ class AliHistogramManager : public TObject {
                         TAxis* axis);
   
   void FillHistClass(const Char_t* className, Float_t* values);
+  void FillHistClass(Int_t classHandle, Float_t* values);
+  Int_t GetHistClassHandle(const Char_t* className);    // handle to be used in FillHistClass(Int_t, Float_t*); -1 if the class does not exist
+  void CompileFillPlans();                              // called automatically on the first fill after booking
   
   void SetUseDefaultVariableNames(Bool_t flag) {fUseDefaultVariableNames = flag;};
   void SetDefaultVarNames(TString* vars, TString* units);
@@ -101,9 +106,25 @@ class AliHistogramManager : public TObject {
   TString fVariableUnits[AliReducedVarManager::kNVars];               //! variable units
   Int_t fNVars;                          // maximum number of variables
   
+  // Fill plans: the histograms of each class, with their fill kind and variables decoded once
+  enum FillKinds {
+    kFillTH1=0, kFillProfile, kFillTH2, kFillProfile2D, kFillTH3, kFillProfile3D, kFillTHn,
+    kNFillKinds
+  };
+  enum FillPlanVars {
+    kPlanVarX=0, kPlanVarY, kPlanVarZ, kPlanVarT, kPlanVarW,
+    kNPlanVars
+  };
+  Bool_t fFillPlansCompiled;                  //! the fill plans are up to date with the booked histograms
+  std::vector<Int_t> fFillPlanOffsets;        //! first fill plan entry of each histogram class, last element is the total number of entries
+  std::vector<TObject*> fFillPlanHistograms;  //! histogram of each entry
+  std::vector<Int_t> fFillPlanKinds;          //! fill kind of each entry
+  std::vector<Int_t> fFillPlanVars;           //! kNPlanVars variables of each entry; for THn, X and Y are the offset and number of its axis variables
+  std::vector<Int_t> fFillPlanTHnVars;        //! axis variables of the THn entries
+  
   void MakeAxisLabels(TAxis* ax, const Char_t* labels);
   
-  ClassDef(AliHistogramManager, 3)
+  ClassDef(AliHistogramManager, 4)
 };
 
 #endif
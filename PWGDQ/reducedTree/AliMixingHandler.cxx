@@ -18,6 +18,7 @@ using std::flush;
 #include <TMath.h>
 #include <TTimeStamp.h>
 #include <TRandom.h>
+#include <TArrayI.h>
 
 #include "AliReducedVarManager.h"
 #include "AliReducedBaseTrack.h"
@@ -391,7 +392,12 @@ void AliMixingHandler::RunEventMixing(TClonesArray* leg1Pool, TClonesArray* leg2
   Int_t entries = leg1Pool->GetEntries();
   if(entries<2) return;
   
+  // resolve the histogram classes once, instead of looking them up by name for every pair
   TObjArray* histClassArr = fHistClassNames.Tokenize(";");
+  TArrayI histClassHandles(histClassArr->GetEntries());
+  for(Int_t iclass=0; iclass<histClassArr->GetEntries(); ++iclass)
+    histClassHandles[iclass] = fHistos->GetHistClassHandle(histClassArr->At(iclass)->GetName());
+  delete histClassArr;
   
   TIter iterEv1Leg1Pool(leg1Pool);
   TIter iterEv1Leg2Pool(leg2Pool);
@@ -436,7 +442,7 @@ void AliMixingHandler::RunEventMixing(TClonesArray* leg1Pool, TClonesArray* leg2
           //cout << "######## cross-pair (mass): " << values[AliReducedVarManager::kMass] << endl;
 	  for(Int_t ibit=0; ibit<fNParallelCuts; ++ibit) {
             if((testFlags2)&(ULong_t(1)<<ibit)) 
-              fHistos->FillHistClass(histClassArr->At(ibit*3+1)->GetName(), values);
+              fHistos->FillHistClass(histClassHandles[ibit*3+1], values);
           }  
 	}  // end loop over the ev2-leg2 list
 	
@@ -456,7 +462,7 @@ void AliMixingHandler::RunEventMixing(TClonesArray* leg1Pool, TClonesArray* leg2
           //cout << "######## like-pair leg1-leg1 (mass): " << values[AliReducedVarManager::kMass] << endl;
 	  for(Int_t ibit=0; ibit<fNParallelCuts; ++ibit) {
             if((testFlags2)&(ULong_t(1)<<ibit)) 
-              fHistos->FillHistClass(histClassArr->At(ibit*3+0)->GetName(), values);
+              fHistos->FillHistClass(histClassHandles[ibit*3+0], values);
           }  
 	}  // end loop over the ev2-leg1 list
       }  // end loop over the ev1-leg1 list
@@ -487,7 +493,7 @@ void AliMixingHandler::RunEventMixing(TClonesArray* leg1Pool, TClonesArray* leg2
           //cout << "######## like-pair leg2-leg2 (mass): " << values[AliReducedVarManager::kMass] << endl;
 	  for(Int_t ibit=0; ibit<fNParallelCuts; ++ibit) {
             if((testFlags2)&(ULong_t(1)<<ibit)) 
-              fHistos->FillHistClass(histClassArr->At(ibit*3+2)->GetName(), values);
+              fHistos->FillHistClass(histClassHandles[ibit*3+2], values);
           }  
 	}  // end loop over the ev2-leg2 list
       }  // end loop over the ev1-leg2 list
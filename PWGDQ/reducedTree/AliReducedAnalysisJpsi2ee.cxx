@@ -10,6 +10,7 @@ using std::endl;
 
 #include <TClonesArray.h>
 #include <TIterator.h>
+#include <TObjString.h>
 
 #include "AliReducedVarManager.h"
 #include "AliReducedEventInfo.h"
@@ -41,11 +42,14 @@ AliReducedAnalysisJpsi2ee::AliReducedAnalysisJpsi2ee() :
   fNegTracks(),
   fPrefilterPosTracks(),
   fPrefilterNegTracks(),
-  fEventCounter(0)
+  fEventCounter(0),
+  fPairHistClassHandles(),
+  fPairHistClassNames()
 {
   //
   // default constructor
   //
+   fPairHistClassNames.SetOwner(kTRUE);
 }
 
 
@@ -68,7 +72,9 @@ AliReducedAnalysisJpsi2ee::AliReducedAnalysisJpsi2ee(const Char_t* name, const C
   fNegTracks(),
   fPrefilterPosTracks(),
   fPrefilterNegTracks(),
-  fEventCounter(0)
+  fEventCounter(0),
+  fPairHistClassHandles(),
+  fPairHistClassNames()
 {
   //
   // named constructor
@@ -82,6 +88,7 @@ AliReducedAnalysisJpsi2ee::AliReducedAnalysisJpsi2ee(const Char_t* name, const C
    fNegTracks.SetOwner(kFALSE);
    fPrefilterPosTracks.SetOwner(kFALSE);
    fPrefilterNegTracks.SetOwner(kFALSE);
+   fPairHistClassNames.SetOwner(kTRUE);
 }
 
 
@@ -354,11 +361,31 @@ void AliReducedAnalysisJpsi2ee::FillPairHistograms(ULong_t mask, Int_t pairType,
    //
    // fill pair level histograms
    // NOTE: pairType can be 0,1 or 2 corresponding to ++, +- or -- pairs
-   TString typeStr[3] = {"PP", "PM", "MM"};
-   for(Int_t icut=0; icut<fTrackCuts.GetEntries(); ++icut) {
+   Int_t nCuts = fTrackCuts.GetEntries();
+   // the handles of each pair class are resolved once, at the first pair of that class, instead of
+   // formatting and looking up the histogram class names for every pair; start over if the cuts changed
+   if(fPairHistClassHandles.GetSize()!=6*nCuts*fPairHistClassNames.GetEntries()) {
+      fPairHistClassNames.Clear();
+      fPairHistClassHandles.Set(0);
+   }
+   TObject* classObj = fPairHistClassNames.FindObject(pairClass.Data());
+   Int_t iPairClass = (classObj ? fPairHistClassNames.IndexOf(classObj) : fPairHistClassNames.GetEntries());
+   if(!classObj) {
+      TString typeStr[3] = {"PP", "PM", "MM"};
+      fPairHistClassNames.Add(new TObjString(pairClass));
+      fPairHistClassHandles.Set(6*nCuts*fPairHistClassNames.GetEntries());
+      for(Int_t itype=0; itype<3; ++itype) {
+         for(Int_t icut=0; icut<nCuts; ++icut) {
+            fPairHistClassHandles[(iPairClass*6+2*itype)*nCuts+icut] = fHistosManager->GetHistClassHandle(Form("%s%s_%s", pairClass.Data(), typeStr[itype].Data(), fTrackCuts.At(icut)->GetName()));
+            fPairHistClassHandles[(iPairClass*6+2*itype+1)*nCuts+icut] = fHistosManager->GetHistClassHandle(Form("%s%s_%s_MCTruth", pairClass.Data(), typeStr[itype].Data(), fTrackCuts.At(icut)->GetName()));
+         }
+      }
+   }
+   const Int_t* handles = fPairHistClassHandles.GetArray() + iPairClass*6*nCuts;
+   for(Int_t icut=0; icut<nCuts; ++icut) {
       if(mask & (ULong_t(1)<<icut)) {
-         fHistosManager->FillHistClass(Form("%s%s_%s", pairClass.Data(), typeStr[pairType].Data(), fTrackCuts.At(icut)->GetName()), fValues);
-         if(isMCTruth && pairType==1) fHistosManager->FillHistClass(Form("%s%s_%s_MCTruth", pairClass.Data(), typeStr[pairType].Data(), fTrackCuts.At(icut)->GetName()), fValues);
+         fHistosManager->FillHistClass(handles[(2*pairType)*nCuts+icut], fValues);
+         if(isMCTruth && pairType==1) fHistosManager->FillHistClass(handles[(2*pairType+1)*nCuts+icut], fValues);
       }
          
    }  // end loop over cuts
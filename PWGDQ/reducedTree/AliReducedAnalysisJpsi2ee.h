@@ -6,6 +6,7 @@
 #define ALIREDUCEDANALYSISJPSI2EE_H
 
 #include <TList.h>
+#include <TArrayI.h>
 
 #include "AliReducedAnalysisTaskSE.h"
 #include "AliReducedInfoCut.h"
@@ -80,6 +81,9 @@ protected:
    
    ULong_t fEventCounter;   // event counter
    
+   TArrayI fPairHistClassHandles;      //! histogram manager handles of the pair histogram classes, [(iPairClass*6+2*pairType+isMCTruth)*nTrackCuts+icut]
+   TList   fPairHistClassNames;        //! pair classes (e.g. PairSE, PairMEPM) resolved in fPairHistClassHandles, in order of iPairClass
+   
   Bool_t IsEventSelected(AliReducedBaseEvent* event, Float_t* values=0x0);
   Bool_t IsTrackSelected(AliReducedBaseTrack* track, Float_t* values=0x0);
   Bool_t IsTrackPrefilterSelected(AliReducedBaseTrack* track, Float_t* values=0x0);
@@ -97,7 +101,7 @@ protected:
   void FillPairHistograms(ULong_t mask, Int_t pairType, TString pairClass = "PairSE", Bool_t isMCTruth = kFALSE);
   void FillMCTruthHistograms();
   
-  ClassDef(AliReducedAnalysisJpsi2ee,3);
+  ClassDef(AliReducedAnalysisJpsi2ee,5);
 };
 
 #endif
@@ -157,7 +157,9 @@ fMassDplus(0.),
 fMassDs(0.),
 fMassLambdaC(0.),
 fMassDstar(0.),
-fMassJpsi(0.)
+fMassJpsi(0.),
+fVertexArena(new TObjArray()),
+fEventPrimVtxAOD(0x0)
 {
   /// Default constructor
 
@@ -252,7 +254,9 @@ fMassDplus(source.fMassDplus),
 fMassDs(source.fMassDs),
 fMassLambdaC(source.fMassLambdaC),
 fMassDstar(source.fMassDstar),
-fMassJpsi(source.fMassJpsi)
+fMassJpsi(source.fMassJpsi),
+fVertexArena(new TObjArray()),
+fEventPrimVtxAOD(0x0)
 {
   ///
   /// Copy constructor
@@ -371,6 +375,8 @@ AliAnalysisVertexingHF::~AliAnalysisVertexingHF() {
   if(fMassCalc2) { delete fMassCalc2; fMassCalc2=0; }
   if(fMassCalc3) { delete fMassCalc3; fMassCalc3=0; }
   if(fMassCalc4) { delete fMassCalc4; fMassCalc4=0; }
+  if(fVertexArena) { fVertexArena->Delete(); delete fVertexArena; fVertexArena=0; }
+  if(fEventPrimVtxAOD) { delete fEventPrimVtxAOD; fEventPrimVtxAOD=0; }
 }
 //----------------------------------------------------------------------------
 TList *AliAnalysisVertexingHF::FillListOfCuts() {
@@ -618,6 +624,10 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
   AliDebug(1,Form(" Selected tracks: %d",nSeleTrks));
   fnSeleTrksTotal += nSeleTrks;
 
+  // if it is not refitted per candidate, the primary vertex is the same for all candidates of the event
+  if(fEventPrimVtxAOD) { delete fEventPrimVtxAOD; fEventPrimVtxAOD=NULL; }
+  if(fV1 && !fRecoPrimVtxSkippingTrks && !fRmTrksFromPrimVtx) fEventPrimVtxAOD=PrimaryVertex();
+
 
   TObjArray *twoTrackArray1    = new TObjArray(2);
   TObjArray *twoTrackArray2    = new TObjArray(2);
@@ -1194,7 +1204,6 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
 		rd->SetPrimaryVtxRef((AliAODVertex*)event->GetPrimaryVertex());
                 ((AliAODRecoDecayHF3Prong*)rd)->DeleteRecoD();
 	      }else{
-                v3Prong = new (verticesHFRef[iVerticesHF++])AliAODVertex(*secVert3PrAOD);
 		rd->SetSecondaryVtx(v3Prong);
 		v3Prong->SetParent(rd);
 		AddRefs(v3Prong,rd,event,threeTrackArray);
@@ -1219,7 +1228,7 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
 
 	  }
 	  if(io3Prong) {delete io3Prong; io3Prong=NULL;}
-	  if(secVert3PrAOD) {delete secVert3PrAOD; secVert3PrAOD=NULL;}
+	  RecycleVertex(secVert3PrAOD); secVert3PrAOD=NULL;
 	}
 
 	// 4 prong candidates
@@ -1314,19 +1323,19 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
             }
 
 	    if(io4Prong) {delete io4Prong; io4Prong=NULL;}
-	    if(secVert4PrAOD) {delete secVert4PrAOD; secVert4PrAOD=NULL;}
+	    RecycleVertex(secVert4PrAOD); secVert4PrAOD=NULL;
 	    fourTrackArray->Clear();
 	    negtrack2 = 0;
 
 	  } // end loop on negative tracks
 
           threeTrackArray->Clear();
-	  delete vertexp1n1p2;
+	  RecycleVertex(vertexp1n1p2);
 
 	}
 
 	postrack2 = 0;
-	delete vertexp2n1;
+	RecycleVertex(vertexp2n1);
 
       } // end 2nd loop on positive tracks
 
@@ -1483,11 +1492,11 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
 	    }
 	  }
 	  if(io3Prong) {delete io3Prong; io3Prong=NULL;}
-	  if(secVert3PrAOD) {delete secVert3PrAOD; secVert3PrAOD=NULL;}
+	  RecycleVertex(secVert3PrAOD); secVert3PrAOD=NULL;
 	}
 	threeTrackArray->Clear();
 	negtrack2 = 0;
-	delete vertexp1n2;
+	RecycleVertex(vertexp1n2);
 
       } // end 2nd loop on negative tracks
 
@@ -1547,6 +1556,7 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
   delete [] seleFlags; seleFlags=NULL;
   if(evtNumber) {delete [] evtNumber; evtNumber=NULL;}
   tracksAtVertex.Delete();
+  if(fEventPrimVtxAOD) { delete fEventPrimVtxAOD; fEventPrimVtxAOD=NULL; }
 
   if(fInputAOD) {
     seleTrksArray.Delete();
@@ -2326,7 +2336,7 @@ AliAODRecoDecayHF2Prong *AliAnalysisVertexingHF::Make2Prong(
     }
   }
   // primary vertex to be used by this candidate
-  AliAODVertex *primVertexAOD  = PrimaryVertex(twoTrackArray,event);
+  AliAODVertex *primVertexAOD  = CandidatePrimaryVertex(twoTrackArray,event);
   if(!primVertexAOD) return 0x0;
 
   Double_t d0z0[2],covd0z0[3];
@@ -2377,7 +2387,7 @@ AliAODRecoDecayHF2Prong *AliAnalysisVertexingHF::Make2Prong(
     the2Prong->Setd0errProngs(2,d0err);
     the2Prong->SetCharge(0);
   }
-  delete primVertexAOD; primVertexAOD=NULL;
+  DeleteCandidatePrimaryVertex(primVertexAOD); primVertexAOD=NULL;
 
   // remove the primary vertex (was used only for selection)
   if(!fRecoPrimVtxSkippingTrks && !fRmTrksFromPrimVtx && !fMixEvent) {
@@ -2447,7 +2457,7 @@ AliAODRecoDecayHF3Prong* AliAnalysisVertexingHF::Make3Prong(
   }
 
   // primary vertex to be used by this candidate
-  AliAODVertex *primVertexAOD  = PrimaryVertex(threeTrackArray,event);
+  AliAODVertex *primVertexAOD  = CandidatePrimaryVertex(threeTrackArray,event);
   if(!primVertexAOD) return 0x0;
 
   Double_t d0z0[2],covd0z0[3];
@@ -2479,7 +2489,7 @@ AliAODRecoDecayHF3Prong* AliAnalysisVertexingHF::Make3Prong(
   UShort_t id[3]={(UShort_t)postrack1->GetID(),(UShort_t)negtrack->GetID(),(UShort_t)postrack2->GetID()};
   the3Prong->SetProngIDs(3,id);
 
-  delete primVertexAOD; primVertexAOD=NULL;
+  DeleteCandidatePrimaryVertex(primVertexAOD); primVertexAOD=NULL;
 
   // disable PID, which requires the TRefs to the daughter tracks
   fCutsDplustoKpipi->SetUsePID(kFALSE);
@@ -2577,7 +2587,7 @@ AliAODRecoDecayHF3Prong* AliAnalysisVertexingHF::Make3Prong(
   postrack2->GetPxPyPz(momentum);
   px[2] = momentum[0]; py[2] = momentum[1]; pz[2] = momentum[2];
   // primary vertex to be used by this candidate
-  AliAODVertex *primVertexAOD  = PrimaryVertex(threeTrackArray,event);
+  AliAODVertex *primVertexAOD  = CandidatePrimaryVertex(threeTrackArray,event);
   if(!primVertexAOD) return 0x0;
   Double_t d0z0[2],covd0z0[3];
   postrack1->PropagateToDCA(primVertexAOD,fBzkG,kVeryBig,d0z0,covd0z0);
@@ -2605,7 +2615,7 @@ AliAODRecoDecayHF3Prong* AliAnalysisVertexingHF::Make3Prong(
   rd->SetCharge(charge);
   rd->SetOwnPrimaryVtx(primVertexAOD);
   rd->SetSigmaVert(dispersion);
-  delete primVertexAOD; primVertexAOD=NULL;
+  DeleteCandidatePrimaryVertex(primVertexAOD); primVertexAOD=NULL;
 
   if(!fRecoPrimVtxSkippingTrks && !fRmTrksFromPrimVtx && !fMixEvent) {
     rd->UnsetOwnPrimaryVtx();
@@ -2686,7 +2696,7 @@ AliAODRecoDecayHF4Prong* AliAnalysisVertexingHF::Make4Prong(
   }
 
   // primary vertex to be used by this candidate
-  AliAODVertex *primVertexAOD  = PrimaryVertex(fourTrackArray,event);
+  AliAODVertex *primVertexAOD  = CandidatePrimaryVertex(fourTrackArray,event);
   if(!primVertexAOD) return 0x0;
 
   Double_t d0z0[2],covd0z0[3];
@@ -2716,7 +2726,7 @@ AliAODRecoDecayHF4Prong* AliAnalysisVertexingHF::Make4Prong(
   UShort_t id[4]={(UShort_t)postrack1->GetID(),(UShort_t)negtrack1->GetID(),(UShort_t)postrack2->GetID(),(UShort_t)negtrack2->GetID()};
   the4Prong->SetProngIDs(4,id);
 
-  delete primVertexAOD; primVertexAOD=NULL;
+  DeleteCandidatePrimaryVertex(primVertexAOD); primVertexAOD=NULL;
 
   ok4Prong=(Bool_t)fCutsD0toKpipipi->IsSelected(the4Prong,AliRDHFCuts::kCandidate);
 
@@ -2784,12 +2794,16 @@ AliAODVertex* AliAnalysisVertexingHF::PrimaryVertex(const TObjArray *trkArray,
 
   AliESDVertex *vertexESD = 0;
   AliAODVertex *vertexAOD = 0;
+  Double_t pos[3],cov[6],chi2perNDF;
 
 
   if(!fRecoPrimVtxSkippingTrks && !fRmTrksFromPrimVtx) {
-    // primary vertex from the input event
-
-    vertexESD = new AliESDVertex(*fV1);
+    // primary vertex from the input event, no need to copy it
+    fV1->GetXYZ(pos); // position
+    fV1->GetCovMatrix(cov); //covariance matrix
+    chi2perNDF = fV1->GetChi2toNDF();
+    vertexAOD = new AliAODVertex(pos,cov,chi2perNDF);
+    return vertexAOD;
 
   } else {
     // primary vertex specific to this candidate
@@ -2874,7 +2888,6 @@ AliAODVertex* AliAnalysisVertexingHF::PrimaryVertex(const TObjArray *trkArray,
   }
 
   // convert to AliAODVertex
-  Double_t pos[3],cov[6],chi2perNDF;
   vertexESD->GetXYZ(pos); // position
   vertexESD->GetCovMatrix(cov); //covariance matrix
   chi2perNDF = vertexESD->GetChi2toNDF();
@@ -2885,6 +2898,36 @@ AliAODVertex* AliAnalysisVertexingHF::PrimaryVertex(const TObjArray *trkArray,
   return vertexAOD;
 }
 //-----------------------------------------------------------------------------
+AliAODVertex* AliAnalysisVertexingHF::CandidatePrimaryVertex(const TObjArray *trkArray,
+							      AliVEvent *event) const
+{
+  /// Primary vertex for a candidate in FindCandidates: the one of the event,
+  /// unless it is refitted for each candidate.
+  /// To be released with DeleteCandidatePrimaryVertex
+  if(fEventPrimVtxAOD) return fEventPrimVtxAOD;
+  return PrimaryVertex(trkArray,event);
+}
+//-----------------------------------------------------------------------------
+void AliAnalysisVertexingHF::DeleteCandidatePrimaryVertex(AliAODVertex *vtx) const
+{
+  /// Delete a vertex from CandidatePrimaryVertex, unless it is the one of the event
+  if(vtx!=fEventPrimVtxAOD) delete vtx;
+}
+//-----------------------------------------------------------------------------
+void AliAnalysisVertexingHF::RecycleVertex(AliAODVertex *vtx) const
+{
+  /// Give back a vertex from ReconstructSecondaryVertex (with TRefArray for
+  /// the daughters) for reuse in the next combinations.
+  /// Vertices referenced by a candidate are deleted, as before, to invalidate the TRefs
+  if(!vtx) return;
+  if(vtx->TestBit(kIsReferenced) || fVertexArena->GetEntriesFast()>=1000) {
+    delete vtx;
+    return;
+  }
+  vtx->RemoveDaughters();
+  fVertexArena->AddLast(vtx);
+}
+//-----------------------------------------------------------------------------
 void AliAnalysisVertexingHF::PrintStatus() const {
   /// Print parameters being used
 
@@ -2998,7 +3041,15 @@ AliAODVertex* AliAnalysisVertexingHF::ReconstructSecondaryVertex(TObjArray *trkA
   delete vertexESD; vertexESD=NULL;
 
   Int_t nprongs= (useTRefArray ? 0 : trkArray->GetEntriesFast());
-  vertexAOD = new AliAODVertex(pos,cov,chi2perNDF,0x0,-1,AliAODVertex::kUndef,nprongs);
+  if(useTRefArray && fVertexArena->GetEntriesFast()>0) {
+    // reuse a vertex of a rejected combination
+    vertexAOD = (AliAODVertex*)fVertexArena->RemoveLast();
+    vertexAOD->SetPosition(pos[0],pos[1],pos[2]);
+    vertexAOD->SetCovMatrix(cov);
+    vertexAOD->SetChi2perNDF(chi2perNDF);
+  } else {
+    vertexAOD = new AliAODVertex(pos,cov,chi2perNDF,0x0,-1,AliAODVertex::kUndef,nprongs);
+  }
 
   return vertexAOD;
 }
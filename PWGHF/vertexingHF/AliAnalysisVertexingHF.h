@@ -348,6 +348,9 @@ class AliAnalysisVertexingHF : public TNamed {
   Double_t fMassDstar;
   Double_t fMassJpsi;
 
+  TObjArray *fVertexArena;        //!<! recycled secondary vertices of rejected combinations
+  AliAODVertex *fEventPrimVtxAOD; //!<! primary vertex shared by all candidates of the event, if not refitted per candidate
+
 
   //
   void AddRefs(AliAODVertex *v,AliAODRecoDecayHF *rd,const AliVEvent *event,
@@ -393,6 +396,9 @@ class AliAnalysisVertexingHF : public TNamed {
   void MapAODtracks(AliVEvent *aod);
   AliAODVertex* PrimaryVertex(const TObjArray *trkArray=0x0,AliVEvent *event=0x0) const;
   AliAODVertex* ReconstructSecondaryVertex(TObjArray *trkArray,Double_t &dispersion,Bool_t useTRefArray=kTRUE) const;
+  AliAODVertex* CandidatePrimaryVertex(const TObjArray *trkArray,AliVEvent *event) const;
+  void DeleteCandidatePrimaryVertex(AliAODVertex *vtx) const;
+  void RecycleVertex(AliAODVertex *vtx) const;
 
   Bool_t SelectInvMassAndPt3prong(Double_t *px,Double_t *py,Double_t *pz, Int_t pidLcStatus=3);
   Bool_t SelectInvMassAndPt4prong(Double_t *px,Double_t *py,Double_t *pz);
@@ -420,7 +426,7 @@ class AliAnalysisVertexingHF : public TNamed {
 				  TObjArray *twoTrackArrayV0);
 
   /// \cond CLASSIMP
-  ClassDef(AliAnalysisVertexingHF,27);  // Reconstruction of HF decay candidates
+  ClassDef(AliAnalysisVertexingHF,28);  // Reconstruction of HF decay candidates
   /// \endcond
 };
 
@@ -22,6 +22,13 @@
 #include <TF1.h>
 #include <TLatex.h>
 #include <TFile.h>
+#include <TStopwatch.h>
+#include <TVectorD.h>
+#include <RVersion.h>
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6,10,0)
+#include <ROOT/TProcessExecutor.hxx>
+#endif
+#include "AliLog.h"
 #include "AliHFMassFitter.h"
 #include "AliHFMassFitterVAR.h"
 #include "AliHFMultiTrials.h"
@@ -90,7 +97,11 @@ AliHFMultiTrials::AliHFMultiTrials() :
   fNtupleMultiTrials(0x0),
   fMinYieldGlob(0),
   fMaxYieldGlob(0),
-  fMassFitters()
+  fMassFitters(),
+  fNWorkers(1),
+  fProgressInterval(0),
+  fWallTime(0.),
+  fSummedFitTime(0.)
 {
   // constructor
   Int_t rebinStep[4]={3,4,5,6};
@@ -186,34 +197,79 @@ Bool_t AliHFMultiTrials::CreateHistos(){
 
 }
 
+//________________________________________________________________________
+struct AliHFMultiTrials::TrialConfig {
+  Int_t fRebinConf;     /// index of the rebinned histogram
+  Int_t fRebin;         /// rebin value
+  Int_t fFirstBin;      /// first bin used for rebin
+  Double_t fMinMassForFit; /// low limit for fit
+  Double_t fMaxMassForFit; /// up limit for fit
+  Double_t fHmin;       /// low limit for fit inside the histogram range
+  Double_t fHmax;       /// up limit for fit inside the histogram range
+  Int_t fTypeb;         /// background function
+  Int_t fIgs;           /// sigma/mean configuration
+  Int_t fItrial;        /// trial number
+  Int_t fTheCase;       /// background function and sigma/mean case
+  Int_t fGlobBin;       /// bin in the histograms of all trials
+};
+
+//________________________________________________________________________
+struct AliHFMultiTrials::TrialResult {
+  Float_t fXnt[15];     /// entry of the ntuple
+  Bool_t fOut;          /// fit status
+  Double_t fChisq;
+  Double_t fSigma;
+  Double_t fEsigma;
+  Double_t fPos;
+  Double_t fEpos;
+  Double_t fRy;
+  Double_t fEry;
+  Double_t fSignificance;
+  Double_t fErSignif;
+  Double_t fBkg;
+  Double_t fErbkg;
+  Double_t fBkgBEdge;
+  Double_t fErbkgBEdge;
+  std::vector<Double_t> fCounts;  /// bin counts for each nsigma step
+  std::vector<Double_t> fECounts; /// errors of the bin counts
+  std::vector<Bool_t> fOKCounts;  /// whether the bin count range is valid
+  Double_t fFitTime;    /// time spent in this trial
+};
+
 //________________________________________________________________________
 Bool_t AliHFMultiTrials::DoMultiTrials(TH1D* hInvMassHisto, TPad* thePad){
   // perform the multiple fits
+  // the trials are listed first, then fitted and filled in the output
+  // in the order of the list. With SetNumberOfWorkers(n>1) the list is
+  // fitted by n processes (fork), the output does not depend on n
 
   Bool_t hOK=CreateHistos();
   if(!hOK) return kFALSE;
 
+  TStopwatch timer;
+  timer.Start();
+
   Int_t itrial=0;
-  Int_t types=0;
-  Int_t itrialBC=0;
   Int_t totTrials=fNumOfRebinSteps*fNumOfFirstBinSteps*fNumOfLowLimFitSteps*fNumOfUpLimFitSteps;
 
   fMinYieldGlob=999999.;
   fMaxYieldGlob=0.;
-  Float_t xnt[15];
 
+  std::vector<TH1F*> hRebinned;
+  std::vector<TrialConfig> trials;
   for(Int_t ir=0; ir<fNumOfRebinSteps; ir++){
     Int_t rebin=fRebinSteps[ir];
     for(Int_t iFirstBin=1; iFirstBin<=fNumOfFirstBinSteps; iFirstBin++) {
-      TH1F* hRebinned=0x0;
-      if(fNumOfFirstBinSteps==1) hRebinned=RebinHisto(hInvMassHisto,rebin,-1);
-      else hRebinned=RebinHisto(hInvMassHisto,rebin,iFirstBin);
+      TH1F* hReb=0x0;
+      if(fNumOfFirstBinSteps==1) hReb=RebinHisto(hInvMassHisto,rebin,-1);
+      else hReb=RebinHisto(hInvMassHisto,rebin,iFirstBin);
+      hRebinned.push_back(hReb);
       for(Int_t iMinMass=0; iMinMass<fNumOfLowLimFitSteps; iMinMass++){
         Double_t minMassForFit=fLowLimFitSteps[iMinMass];
-        Double_t hmin=TMath::Max(minMassForFit,hRebinned->GetBinLowEdge(2));
+        Double_t hmin=TMath::Max(minMassForFit,hReb->GetBinLowEdge(2));
         for(Int_t iMaxMass=0; iMaxMass<fNumOfUpLimFitSteps; iMaxMass++){
           Double_t maxMassForFit=fUpLimFitSteps[iMaxMass];
-          Double_t hmax=TMath::Min(maxMassForFit,hRebinned->GetBinLowEdge(hRebinned->GetNbinsX()));
+          Double_t hmax=TMath::Min(maxMassForFit,hReb->GetBinLowEdge(hReb->GetNbinsX()));
           ++itrial;
           for(Int_t typeb=0; typeb<kNBkgFuncCases; typeb++){
             if(typeb==kExpoBkg && !fUseExpoBkg) continue;
@@ -231,206 +287,380 @@ Bool_t AliHFMultiTrials::DoMultiTrials(TH1D* hInvMassHisto, TPad* thePad){
               if (igs==kFreeSigFreeMean  && !fUseFreeS) continue;
               if (igs==kFixSigFreeMean  && !fUseFixSigFreeMean) continue;
               if (igs==kFixSigFixMean   && !fUseFixSigFixMean) continue;
-              Int_t theCase=igs*kNBkgFuncCases+typeb;
-              Int_t globBin=itrial+theCase*totTrials;
-              for(Int_t j=0; j<15; j++) xnt[j]=0.;
-
-              Bool_t mustDeleteFitter = kTRUE;
-              AliHFMassFitterVAR*  fitter=0x0;
-              //if D0 Reflection
-              if(fhTemplRefl){
-                fitter=new AliHFMassFitterVAR(hRebinned,hmin,hmax,1,typeb,2);
-                fitter->SetTemplateReflections(fhTemplRefl);
-                fitter->SetFixReflOverS(fFixRefloS,kTRUE);
-              }
-              else {
-                if(typeb<=kPol2Bkg){
-                  fitter=new AliHFMassFitterVAR(hRebinned,hmin, hmax,1,typeb,types);
-                }else if(typeb==kPowBkg){
-                  fitter=new AliHFMassFitterVAR(hRebinned,hmin, hmax,1,4,types);
-                }else if(typeb==kPowTimesExpoBkg){
-                  fitter=new AliHFMassFitterVAR(hRebinned,hmin, hmax,1,5,types);
-                }else{
-                  fitter=new AliHFMassFitterVAR(hRebinned,hmin, hmax,1,6,types);
-                  if(typeb==kPol3Bkg) fitter->SetBackHighPolDegree(3);
-                  if(typeb==kPol4Bkg) fitter->SetBackHighPolDegree(4);
-                  if(typeb==kPol5Bkg) fitter->SetBackHighPolDegree(5);
-                }
-                fitter->SetReflectionSigmaFactor(0);
-              }
-              if(fFitOption==1) fitter->SetUseChi2Fit();
-              fitter->SetInitialGaussianMean(fMassD);
-              fitter->SetInitialGaussianSigma(fSigmaGausMC);
-              xnt[0]=rebin;
-              xnt[1]=iFirstBin;
-              xnt[2]=minMassForFit;
-              xnt[3]=maxMassForFit;
-              xnt[4]=typeb;
-              xnt[6]=0;
-              if(igs==kFixSigFreeMean){
-                fitter->SetFixGaussianSigma(fSigmaGausMC,kTRUE);
-                xnt[5]=1;
-              }else if(igs==kFixSigUpFreeMean){
-                fitter->SetFixGaussianSigma(fSigmaGausMC*(1.+fSigmaMCVariation),kTRUE);
-                xnt[5]=2;
-              }else if(igs==kFixSigDownFreeMean){
-                fitter->SetFixGaussianSigma(fSigmaGausMC*(1.-fSigmaMCVariation),kTRUE);
-                xnt[5]=3;
-              }else if(igs==kFreeSigFreeMean){
-                xnt[5]=0;
-              }else if(igs==kFixSigFixMean){
-                fitter->SetFixGaussianSigma(fSigmaGausMC,kTRUE);
-                fitter->SetFixGaussianMean(fMassD,kTRUE);
-                xnt[5]=1;
-                xnt[6]=1;
-              }else if(igs==kFreeSigFixMean){
-                fitter->SetFixGaussianMean(fMassD,kTRUE);
-                xnt[5]=0;
-                xnt[6]=1;
-              }
-              Bool_t out=kFALSE;
-              Double_t chisq=-1.;
-              Double_t sigma=0.;
-              Double_t esigma=0.;
-              Double_t pos=.0;
-              Double_t epos=.0;
-              Double_t ry=.0;
-              Double_t ery=.0;
-              Double_t significance=0.;
-              Double_t erSignif=0.;
-              Double_t bkg=0.;
-              Double_t erbkg=0.;
-              Double_t bkgBEdge=0;
-              Double_t erbkgBEdge=0;
-              TF1* fB1=0x0;
-              if(typeb<kNBkgFuncCases){
-                printf("****** START FIT OF HISTO %s WITH REBIN %d FIRST BIN %d MASS RANGE %f-%f BACKGROUND FIT FUNCTION=%d CONFIG SIGMA/MEAN=%d\n",hInvMassHisto->GetName(),rebin,iFirstBin,minMassForFit,maxMassForFit,typeb,igs);
-                out=fitter->MassFitter(0);
-                chisq=fitter->GetReducedChiSquare();
-                fitter->Significance(fnSigmaForBkgEval,significance,erSignif);
-                sigma=fitter->GetSigma();
-                pos=fitter->GetMean();
-                esigma=fitter->GetSigmaUncertainty();
-                if(esigma<0.00001) esigma=0.0001;
-                epos=fitter->GetMeanUncertainty();
-                if(epos<0.00001) epos=0.0001;
-                ry=fitter->GetRawYield();
-                ery=fitter->GetRawYieldError();
-                fB1=fitter->GetBackgroundFullRangeFunc();
-                fitter->Background(fnSigmaForBkgEval,bkg,erbkg);
-                Double_t minval = hInvMassHisto->GetXaxis()->GetBinLowEdge(hInvMassHisto->FindBin(pos-fnSigmaForBkgEval*sigma));
-                Double_t maxval = hInvMassHisto->GetXaxis()->GetBinUpEdge(hInvMassHisto->FindBin(pos+fnSigmaForBkgEval*sigma));
-                fitter->Background(minval,maxval,bkgBEdge,erbkgBEdge);
-                if(out && fDrawIndividualFits && thePad){
-                  thePad->Clear();
-                  fitter->DrawHere(thePad, fnSigmaForBkgEval);
-                  fMassFitters.push_back(fitter);
-                  mustDeleteFitter = kFALSE;
-                  for (auto format : fInvMassFitSaveAsFormats) {
-                    thePad->SaveAs(Form("FitOutput_%s_Trial%d.%s",hInvMassHisto->GetName(),globBin, format.c_str()));
-                  }
-                }
-              }
-              // else{
-              //   out=DoFitWithPol3Bkg(hRebinned,hmin,hmax,igs);
-              //   if(out && thePad){
-              // 	thePad->Clear();
-              // 	hRebinned->Draw();
-              // 	TF1* fSB=(TF1*)hRebinned->GetListOfFunctions()->FindObject("fSB");
-              // 	fB1=new TF1("fB1","[0]+[1]*x+[2]*x*x+[3]*x*x*x",hmin,hmax);
-              // 	for(Int_t j=0; j<4; j++) fB1->SetParameter(j,fSB->GetParameter(3+j));
-              // 	fB1->SetLineColor(2);
-              // 	fB1->Draw("same");
-              // 	fSB->SetLineColor(4);
-              // 	fSB->Draw("same");
-              // 	thePad->Update();
-              // 	chisq=fSB->GetChisquare()/fSB->GetNDF();;
-              // 	sigma=fSB->GetParameter(2);
-              // 	esigma=fSB->GetParError(2);
-              // 	if(esigma<0.00001) esigma=0.0001;
-              // 	pos=fSB->GetParameter(1);
-              // 	epos=fSB->GetParError(1);
-              // 	if(epos<0.00001) epos=0.0001;
-              // 	ry=fSB->GetParameter(0)/hRebinned->GetBinWidth(1);
-              // 	ery=fSB->GetParError(0)/hRebinned->GetBinWidth(1);
-              //   }
-              // }
-              xnt[7]=chisq;
-              if(out && chisq>0. && sigma>0.5*fSigmaGausMC && sigma<2.0*fSigmaGausMC){
-                xnt[8]=significance;
-                xnt[9]=pos;
-                xnt[10]=epos;
-                xnt[11]=sigma;
-                xnt[12]=esigma;
-                xnt[13]=ry;
-                xnt[14]=ery;
-                fHistoRawYieldDistAll->Fill(ry);
-                fHistoRawYieldTrialAll->SetBinContent(globBin,ry);
-                fHistoRawYieldTrialAll->SetBinError(globBin,ery);
-                fHistoSigmaTrialAll->SetBinContent(globBin,sigma);
-                fHistoSigmaTrialAll->SetBinError(globBin,esigma);
-                fHistoMeanTrialAll->SetBinContent(globBin,pos);
-                fHistoMeanTrialAll->SetBinError(globBin,epos);
-                fHistoChi2TrialAll->SetBinContent(globBin,chisq);
-                fHistoChi2TrialAll->SetBinError(globBin,0.00001);
-                fHistoSignifTrialAll->SetBinContent(globBin,significance);
-                fHistoSignifTrialAll->SetBinError(globBin,erSignif);
-                if(fSaveBkgVal) {
-                  fHistoBkgTrialAll->SetBinContent(globBin,bkg);
-                  fHistoBkgTrialAll->SetBinError(globBin,erbkg);
-                  fHistoBkgInBinEdgesTrialAll->SetBinContent(globBin,bkgBEdge);
-                  fHistoBkgInBinEdgesTrialAll->SetBinError(globBin,erbkgBEdge);
-                }
-
-                if(ry<fMinYieldGlob) fMinYieldGlob=ry;
-                if(ry>fMaxYieldGlob) fMaxYieldGlob=ry;
-                fHistoRawYieldDist[theCase]->Fill(ry);
-                fHistoRawYieldTrial[theCase]->SetBinContent(itrial,ry);
-                fHistoRawYieldTrial[theCase]->SetBinError(itrial,ery);
-                fHistoSigmaTrial[theCase]->SetBinContent(itrial,sigma);
-                fHistoSigmaTrial[theCase]->SetBinError(itrial,esigma);
-                fHistoMeanTrial[theCase]->SetBinContent(itrial,pos);
-                fHistoMeanTrial[theCase]->SetBinError(itrial,epos);
-                fHistoChi2Trial[theCase]->SetBinContent(itrial,chisq);
-                fHistoChi2Trial[theCase]->SetBinError(itrial,0.00001);
-                fHistoSignifTrial[theCase]->SetBinContent(itrial,significance);
-                fHistoSignifTrial[theCase]->SetBinError(itrial,erSignif);
-                if(fSaveBkgVal) {
-                  fHistoBkgTrial[theCase]->SetBinContent(itrial,bkg);
-                  fHistoBkgTrial[theCase]->SetBinError(itrial,erbkg);
-                  fHistoBkgInBinEdgesTrial[theCase]->SetBinContent(itrial,bkgBEdge);
-                  fHistoBkgInBinEdgesTrial[theCase]->SetBinError(itrial,erbkgBEdge);
-                }
-
-                for(Int_t iStepBC=0; iStepBC<fNumOfnSigmaBinCSteps; iStepBC++){
-                  Double_t minMassBC=fMassD-fnSigmaBinCSteps[iStepBC]*sigma;
-                  Double_t maxMassBC=fMassD+fnSigmaBinCSteps[iStepBC]*sigma;
-                  if(minMassBC>minMassForFit &&
-                      maxMassBC<maxMassForFit &&
-                      minMassBC>(hRebinned->GetXaxis()->GetXmin()) &&
-                      maxMassBC<(hRebinned->GetXaxis()->GetXmax())){
-                    Double_t cnts,ecnts;
-                    BinCount(hRebinned,fB1,1,minMassBC,maxMassBC,cnts,ecnts);
-                    ++itrialBC;
-                    fHistoRawYieldDistBinCAll->Fill(cnts);
-                    fHistoRawYieldTrialBinCAll->SetBinContent(globBin,iStepBC+1,cnts);
-                    fHistoRawYieldTrialBinCAll->SetBinError(globBin,iStepBC+1,ecnts);
-                    fHistoRawYieldTrialBinC[theCase]->SetBinContent(itrial,iStepBC+1,cnts);
-                    fHistoRawYieldTrialBinC[theCase]->SetBinError(itrial,iStepBC+1,ecnts);
-                    fHistoRawYieldDistBinC[theCase]->Fill(cnts);
-                  }
-                }
-              }
-              if (mustDeleteFitter) delete fitter;
-              fNtupleMultiTrials->Fill(xnt);
+              TrialConfig conf;
+              conf.fRebinConf=hRebinned.size()-1;
+              conf.fRebin=rebin;
+              conf.fFirstBin=iFirstBin;
+              conf.fMinMassForFit=minMassForFit;
+              conf.fMaxMassForFit=maxMassForFit;
+              conf.fHmin=hmin;
+              conf.fHmax=hmax;
+              conf.fTypeb=typeb;
+              conf.fIgs=igs;
+              conf.fItrial=itrial;
+              conf.fTheCase=igs*kNBkgFuncCases+typeb;
+              conf.fGlobBin=itrial+conf.fTheCase*totTrials;
+              trials.push_back(conf);
             }
           }
         }
       }
-      delete hRebinned;
     }
   }
-  return kTRUE;
+
+  fSummedFitTime=0.;
+  Int_t nWorkers=TMath::Min(fNWorkers,(Int_t)trials.size());
+  if(nWorkers>1 && fDrawIndividualFits && thePad){
+    AliInfo("Individual fits are drawn, the trials are fitted sequentially");
+    nWorkers=1;
+  }
+#if ROOT_VERSION_CODE < ROOT_VERSION(6,10,0)
+  if(nWorkers>1){
+    AliWarning("Fitting the trials in parallel needs ROOT6 (TProcessExecutor), they are fitted sequentially");
+    nWorkers=1;
+  }
+#endif
+  Bool_t retOK=kTRUE;
+  if(nWorkers>1){
+    retOK=RunTrialsInProcesses(trials,hRebinned,hInvMassHisto,nWorkers);
+  }else{
+    for(size_t it=0; it<trials.size(); it++){
+      TrialResult res;
+      RunTrial(trials[it],hRebinned[trials[it].fRebinConf],hInvMassHisto,thePad,res);
+      FillTrialResult(trials[it],res);
+      fSummedFitTime+=res.fFitTime;
+      if(fProgressInterval>0 && (it+1)%fProgressInterval==0) AliInfo(Form("%d/%d trials done",(Int_t)(it+1),(Int_t)trials.size()));
+    }
+  }
+  for(size_t ih=0; ih<hRebinned.size(); ih++) delete hRebinned[ih];
+
+  timer.Stop();
+  fWallTime=timer.RealTime();
+  AliDebug(1,Form("%d trials with %d worker(s) in %.1f s (summed fit time %.1f s)",(Int_t)trials.size(),nWorkers,fWallTime,fSummedFitTime));
+  return retOK;
+}
+
+//________________________________________________________________________
+Bool_t AliHFMultiTrials::RunTrialsInProcesses(std::vector<TrialConfig>& trials, std::vector<TH1F*>& hRebinned, TH1D* hInvMassHisto, Int_t nWorkers){
+  // fit the trials with nWorkers processes: the list is split in chunks of
+  // consecutive trials (a few per worker, to balance the load), each chunk is
+  // fitted in a child process with its own clones of the rebinned histograms
+  // and its own fitters, and returns its results packed in a TVectorD.
+  // The chunks come back in the order of the list, so the trials are filled
+  // in the same order as in the sequential case
+
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6,10,0)
+  const Int_t nTrials=trials.size();
+  const Int_t nChunks=TMath::Min(nTrials,4*nWorkers);
+  const Int_t recSize=GetTrialRecordSize();
+  std::vector<Int_t> chunks(nChunks);
+  for(Int_t ic=0; ic<nChunks; ic++) chunks[ic]=ic;
+
+  auto fitChunk = [&](Int_t ic) {
+    Int_t first=(Long64_t)nTrials*ic/nChunks;
+    Int_t last=(Long64_t)nTrials*(ic+1)/nChunks;
+    TVectorD* rec=new TVectorD((last-first)*recSize);
+    std::vector<TH1F*> hClones(hRebinned.size(),(TH1F*)0x0);
+    for(Int_t it=first; it<last; it++){
+      Int_t ir=trials[it].fRebinConf;
+      if(!hClones[ir]){
+        hClones[ir]=(TH1F*)hRebinned[ir]->Clone();
+        hClones[ir]->SetDirectory(0);
+      }
+      TrialResult res;
+      RunTrial(trials[it],hClones[ir],hInvMassHisto,0x0,res);
+      PackTrialResult(res,*rec,(it-first)*recSize);
+    }
+    for(size_t ih=0; ih<hClones.size(); ih++) delete hClones[ih];
+    return rec;
+  };
+
+  ROOT::TProcessExecutor pool(nWorkers);
+  std::vector<TVectorD*> recs=pool.Map(fitChunk,chunks);
+
+  Bool_t retOK=kTRUE;
+  Int_t nDone=0;
+  for(Int_t ic=0; ic<nChunks; ic++){
+    Int_t first=(Long64_t)nTrials*ic/nChunks;
+    Int_t last=(Long64_t)nTrials*(ic+1)/nChunks;
+    if(ic>=(Int_t)recs.size() || !recs[ic] || recs[ic]->GetNrows()!=(last-first)*recSize){
+      AliError(Form("No result from the worker for trials %d-%d",first,last-1));
+      retOK=kFALSE;
+      continue;
+    }
+    for(Int_t it=first; it<last; it++){
+      TrialResult res;
+      UnpackTrialResult(*recs[ic],(it-first)*recSize,res);
+      FillTrialResult(trials[it],res);
+      fSummedFitTime+=res.fFitTime;
+    }
+    nDone+=last-first;
+    if(fProgressInterval>0) AliInfo(Form("%d/%d trials done",nDone,nTrials));
+  }
+  for(size_t ic=0; ic<recs.size(); ic++) delete recs[ic];
+  return retOK;
+#else
+  AliError("Fitting the trials in parallel needs ROOT6 (TProcessExecutor)");
+  return kFALSE;
+#endif
+}
+
+//________________________________________________________________________
+void AliHFMultiTrials::PackTrialResult(const TrialResult& res, TVectorD& rec, Int_t offset) const{
+  // copy the result of one trial to rec, from offset on (GetTrialRecordSize() values)
+
+  Double_t* r=rec.GetMatrixArray()+offset;
+  for(Int_t j=0; j<15; j++) *r++=res.fXnt[j];
+  *r++=res.fOut;
+  *r++=res.fChisq;
+  *r++=res.fSigma;
+  *r++=res.fEsigma;
+  *r++=res.fPos;
+  *r++=res.fEpos;
+  *r++=res.fRy;
+  *r++=res.fEry;
+  *r++=res.fSignificance;
+  *r++=res.fErSignif;
+  *r++=res.fBkg;
+  *r++=res.fErbkg;
+  *r++=res.fBkgBEdge;
+  *r++=res.fErbkgBEdge;
+  *r++=res.fFitTime;
+  for(Int_t j=0; j<fNumOfnSigmaBinCSteps; j++){
+    *r++=res.fCounts[j];
+    *r++=res.fECounts[j];
+    *r++=res.fOKCounts[j];
+  }
+}
+
+//________________________________________________________________________
+void AliHFMultiTrials::UnpackTrialResult(const TVectorD& rec, Int_t offset, TrialResult& res) const{
+  // inverse of PackTrialResult
+
+  const Double_t* r=rec.GetMatrixArray()+offset;
+  for(Int_t j=0; j<15; j++) res.fXnt[j]=*r++;
+  res.fOut=(*r++!=0.);
+  res.fChisq=*r++;
+  res.fSigma=*r++;
+  res.fEsigma=*r++;
+  res.fPos=*r++;
+  res.fEpos=*r++;
+  res.fRy=*r++;
+  res.fEry=*r++;
+  res.fSignificance=*r++;
+  res.fErSignif=*r++;
+  res.fBkg=*r++;
+  res.fErbkg=*r++;
+  res.fBkgBEdge=*r++;
+  res.fErbkgBEdge=*r++;
+  res.fFitTime=*r++;
+  res.fCounts.resize(fNumOfnSigmaBinCSteps);
+  res.fECounts.resize(fNumOfnSigmaBinCSteps);
+  res.fOKCounts.resize(fNumOfnSigmaBinCSteps);
+  for(Int_t j=0; j<fNumOfnSigmaBinCSteps; j++){
+    res.fCounts[j]=*r++;
+    res.fECounts[j]=*r++;
+    res.fOKCounts[j]=(*r++!=0.);
+  }
+}
+
+//________________________________________________________________________
+void AliHFMultiTrials::RunTrial(const TrialConfig& conf, TH1F* hRebinned, TH1D* hInvMassHisto, TPad* thePad, TrialResult& res){
+  // fit one trial, the fitter is owned by the trial unless it is kept for drawing
+
+  TStopwatch timer;
+  timer.Start();
+
+  const Int_t typeb=conf.fTypeb;
+  const Int_t igs=conf.fIgs;
+  const Int_t types=0;
+  Float_t* xnt=res.fXnt;
+  for(Int_t j=0; j<15; j++) xnt[j]=0.;
+
+  Bool_t mustDeleteFitter = kTRUE;
+  AliHFMassFitterVAR*  fitter=0x0;
+  //if D0 Reflection
+  if(fhTemplRefl){
+    fitter=new AliHFMassFitterVAR(hRebinned,conf.fHmin,conf.fHmax,1,typeb,2);
+    fitter->SetTemplateReflections(fhTemplRefl);
+    fitter->SetFixReflOverS(fFixRefloS,kTRUE);
+  }
+  else {
+    if(typeb<=kPol2Bkg){
+      fitter=new AliHFMassFitterVAR(hRebinned,conf.fHmin,conf.fHmax,1,typeb,types);
+    }else if(typeb==kPowBkg){
+      fitter=new AliHFMassFitterVAR(hRebinned,conf.fHmin,conf.fHmax,1,4,types);
+    }else if(typeb==kPowTimesExpoBkg){
+      fitter=new AliHFMassFitterVAR(hRebinned,conf.fHmin,conf.fHmax,1,5,types);
+    }else{
+      fitter=new AliHFMassFitterVAR(hRebinned,conf.fHmin,conf.fHmax,1,6,types);
+      if(typeb==kPol3Bkg) fitter->SetBackHighPolDegree(3);
+      if(typeb==kPol4Bkg) fitter->SetBackHighPolDegree(4);
+      if(typeb==kPol5Bkg) fitter->SetBackHighPolDegree(5);
+    }
+    fitter->SetReflectionSigmaFactor(0);
+  }
+  if(fFitOption==1) fitter->SetUseChi2Fit();
+  fitter->SetInitialGaussianMean(fMassD);
+  fitter->SetInitialGaussianSigma(fSigmaGausMC);
+  xnt[0]=conf.fRebin;
+  xnt[1]=conf.fFirstBin;
+  xnt[2]=conf.fMinMassForFit;
+  xnt[3]=conf.fMaxMassForFit;
+  xnt[4]=typeb;
+  xnt[6]=0;
+  if(igs==kFixSigFreeMean){
+    fitter->SetFixGaussianSigma(fSigmaGausMC,kTRUE);
+    xnt[5]=1;
+  }else if(igs==kFixSigUpFreeMean){
+    fitter->SetFixGaussianSigma(fSigmaGausMC*(1.+fSigmaMCVariation),kTRUE);
+    xnt[5]=2;
+  }else if(igs==kFixSigDownFreeMean){
+    fitter->SetFixGaussianSigma(fSigmaGausMC*(1.-fSigmaMCVariation),kTRUE);
+    xnt[5]=3;
+  }else if(igs==kFreeSigFreeMean){
+    xnt[5]=0;
+  }else if(igs==kFixSigFixMean){
+    fitter->SetFixGaussianSigma(fSigmaGausMC,kTRUE);
+    fitter->SetFixGaussianMean(fMassD,kTRUE);
+    xnt[5]=1;
+    xnt[6]=1;
+  }else if(igs==kFreeSigFixMean){
+    fitter->SetFixGaussianMean(fMassD,kTRUE);
+    xnt[5]=0;
+    xnt[6]=1;
+  }
+  res.fOut=kFALSE;
+  res.fChisq=-1.;
+  res.fSigma=0.;
+  res.fEsigma=0.;
+  res.fPos=.0;
+  res.fEpos=.0;
+  res.fRy=.0;
+  res.fEry=.0;
+  res.fSignificance=0.;
+  res.fErSignif=0.;
+  res.fBkg=0.;
+  res.fErbkg=0.;
+  res.fBkgBEdge=0;
+  res.fErbkgBEdge=0;
+  TF1* fB1=0x0;
+  if(typeb<kNBkgFuncCases){
+    printf("****** START FIT OF HISTO %s WITH REBIN %d FIRST BIN %d MASS RANGE %f-%f BACKGROUND FIT FUNCTION=%d CONFIG SIGMA/MEAN=%d\n",hInvMassHisto->GetName(),conf.fRebin,conf.fFirstBin,conf.fMinMassForFit,conf.fMaxMassForFit,typeb,igs);
+    res.fOut=fitter->MassFitter(0);
+    res.fChisq=fitter->GetReducedChiSquare();
+    fitter->Significance(fnSigmaForBkgEval,res.fSignificance,res.fErSignif);
+    res.fSigma=fitter->GetSigma();
+    res.fPos=fitter->GetMean();
+    res.fEsigma=fitter->GetSigmaUncertainty();
+    if(res.fEsigma<0.00001) res.fEsigma=0.0001;
+    res.fEpos=fitter->GetMeanUncertainty();
+    if(res.fEpos<0.00001) res.fEpos=0.0001;
+    res.fRy=fitter->GetRawYield();
+    res.fEry=fitter->GetRawYieldError();
+    fB1=fitter->GetBackgroundFullRangeFunc();
+    fitter->Background(fnSigmaForBkgEval,res.fBkg,res.fErbkg);
+    Double_t minval = hInvMassHisto->GetXaxis()->GetBinLowEdge(hInvMassHisto->GetXaxis()->FindFixBin(res.fPos-fnSigmaForBkgEval*res.fSigma));
+    Double_t maxval = hInvMassHisto->GetXaxis()->GetBinUpEdge(hInvMassHisto->GetXaxis()->FindFixBin(res.fPos+fnSigmaForBkgEval*res.fSigma));
+    fitter->Background(minval,maxval,res.fBkgBEdge,res.fErbkgBEdge);
+    if(res.fOut && fDrawIndividualFits && thePad){
+      thePad->Clear();
+      fitter->DrawHere(thePad, fnSigmaForBkgEval);
+      fMassFitters.push_back(fitter);
+      mustDeleteFitter = kFALSE;
+      for (auto format : fInvMassFitSaveAsFormats) {
+        thePad->SaveAs(Form("FitOutput_%s_Trial%d.%s",hInvMassHisto->GetName(),conf.fGlobBin, format.c_str()));
+      }
+    }
+  }
+  xnt[7]=res.fChisq;
+  res.fCounts.assign(fNumOfnSigmaBinCSteps,0.);
+  res.fECounts.assign(fNumOfnSigmaBinCSteps,0.);
+  res.fOKCounts.assign(fNumOfnSigmaBinCSteps,kFALSE);
+  if(res.fOut && res.fChisq>0. && res.fSigma>0.5*fSigmaGausMC && res.fSigma<2.0*fSigmaGausMC){
+    xnt[8]=res.fSignificance;
+    xnt[9]=res.fPos;
+    xnt[10]=res.fEpos;
+    xnt[11]=res.fSigma;
+    xnt[12]=res.fEsigma;
+    xnt[13]=res.fRy;
+    xnt[14]=res.fEry;
+    for(Int_t iStepBC=0; iStepBC<fNumOfnSigmaBinCSteps; iStepBC++){
+      Double_t minMassBC=fMassD-fnSigmaBinCSteps[iStepBC]*res.fSigma;
+      Double_t maxMassBC=fMassD+fnSigmaBinCSteps[iStepBC]*res.fSigma;
+      if(minMassBC>conf.fMinMassForFit &&
+          maxMassBC<conf.fMaxMassForFit &&
+          minMassBC>(hRebinned->GetXaxis()->GetXmin()) &&
+          maxMassBC<(hRebinned->GetXaxis()->GetXmax())){
+        BinCount(hRebinned,fB1,1,minMassBC,maxMassBC,res.fCounts[iStepBC],res.fECounts[iStepBC]);
+        res.fOKCounts[iStepBC]=kTRUE;
+      }
+    }
+  }
+  if (mustDeleteFitter) delete fitter;
+  timer.Stop();
+  res.fFitTime=timer.RealTime();
+}
+
+//________________________________________________________________________
+void AliHFMultiTrials::FillTrialResult(const TrialConfig& conf, const TrialResult& res){
+  // fill the output histograms and the ntuple with the result of one trial
+
+  const Int_t theCase=conf.fTheCase;
+  const Int_t globBin=conf.fGlobBin;
+  const Int_t itrial=conf.fItrial;
+  if(res.fOut && res.fChisq>0. && res.fSigma>0.5*fSigmaGausMC && res.fSigma<2.0*fSigmaGausMC){
+    fHistoRawYieldDistAll->Fill(res.fRy);
+    fHistoRawYieldTrialAll->SetBinContent(globBin,res.fRy);
+    fHistoRawYieldTrialAll->SetBinError(globBin,res.fEry);
+    fHistoSigmaTrialAll->SetBinContent(globBin,res.fSigma);
+    fHistoSigmaTrialAll->SetBinError(globBin,res.fEsigma);
+    fHistoMeanTrialAll->SetBinContent(globBin,res.fPos);
+    fHistoMeanTrialAll->SetBinError(globBin,res.fEpos);
+    fHistoChi2TrialAll->SetBinContent(globBin,res.fChisq);
+    fHistoChi2TrialAll->SetBinError(globBin,0.00001);
+    fHistoSignifTrialAll->SetBinContent(globBin,res.fSignificance);
+    fHistoSignifTrialAll->SetBinError(globBin,res.fErSignif);
+    if(fSaveBkgVal) {
+      fHistoBkgTrialAll->SetBinContent(globBin,res.fBkg);
+      fHistoBkgTrialAll->SetBinError(globBin,res.fErbkg);
+      fHistoBkgInBinEdgesTrialAll->SetBinContent(globBin,res.fBkgBEdge);
+      fHistoBkgInBinEdgesTrialAll->SetBinError(globBin,res.fErbkgBEdge);
+    }
+
+    if(res.fRy<fMinYieldGlob) fMinYieldGlob=res.fRy;
+    if(res.fRy>fMaxYieldGlob) fMaxYieldGlob=res.fRy;
+    fHistoRawYieldDist[theCase]->Fill(res.fRy);
+    fHistoRawYieldTrial[theCase]->SetBinContent(itrial,res.fRy);
+    fHistoRawYieldTrial[theCase]->SetBinError(itrial,res.fEry);
+    fHistoSigmaTrial[theCase]->SetBinContent(itrial,res.fSigma);
+    fHistoSigmaTrial[theCase]->SetBinError(itrial,res.fEsigma);
+    fHistoMeanTrial[theCase]->SetBinContent(itrial,res.fPos);
+    fHistoMeanTrial[theCase]->SetBinError(itrial,res.fEpos);
+    fHistoChi2Trial[theCase]->SetBinContent(itrial,res.fChisq);
+    fHistoChi2Trial[theCase]->SetBinError(itrial,0.00001);
+    fHistoSignifTrial[theCase]->SetBinContent(itrial,res.fSignificance);
+    fHistoSignifTrial[theCase]->SetBinError(itrial,res.fErSignif);
+    if(fSaveBkgVal) {
+      fHistoBkgTrial[theCase]->SetBinContent(itrial,res.fBkg);
+      fHistoBkgTrial[theCase]->SetBinError(itrial,res.fErbkg);
+      fHistoBkgInBinEdgesTrial[theCase]->SetBinContent(itrial,res.fBkgBEdge);
+      fHistoBkgInBinEdgesTrial[theCase]->SetBinError(itrial,res.fErbkgBEdge);
+    }
+
+    for(Int_t iStepBC=0; iStepBC<fNumOfnSigmaBinCSteps; iStepBC++){
+      if(!res.fOKCounts[iStepBC]) continue;
+      Double_t cnts=res.fCounts[iStepBC];
+      Double_t ecnts=res.fECounts[iStepBC];
+      fHistoRawYieldDistBinCAll->Fill(cnts);
+      fHistoRawYieldTrialBinCAll->SetBinContent(globBin,iStepBC+1,cnts);
+      fHistoRawYieldTrialBinCAll->SetBinError(globBin,iStepBC+1,ecnts);
+      fHistoRawYieldTrialBinC[theCase]->SetBinContent(itrial,iStepBC+1,cnts);
+      fHistoRawYieldTrialBinC[theCase]->SetBinError(itrial,iStepBC+1,ecnts);
+      fHistoRawYieldDistBinC[theCase]->Fill(cnts);
+    }
+  }
+  fNtupleMultiTrials->Fill(res.fXnt);
 }
 
 //________________________________________________________________________
@@ -6,10 +6,16 @@
 #include <TNamed.h>
 #include <TString.h>
 #include <TPad.h>
+#include <TVectorDfwd.h>
 #include <set>
 #include <vector>
 
 class TNtuple;
+class TF1;
+class TH1F;
+class TH1D;
+class TH2F;
+class TCanvas;
 class AliHFMassFitterVAR;
 
 /// \class AliHFMultiTrials
@@ -86,6 +92,11 @@ class AliHFMultiTrials : public TNamed {
 
   void SetDrawIndividualFits(Bool_t opt=kTRUE){fDrawIndividualFits=opt;}
 
+  void SetNumberOfWorkers(Int_t nWorkers){fNWorkers=nWorkers;}
+  void SetProgressInterval(Int_t nTrials){fProgressInterval=nTrials;}
+  Double_t GetWallTime() const {return fWallTime;}
+  Double_t GetSummedFitTime() const {return fSummedFitTime;}
+
   Bool_t DoMultiTrials(TH1D* hInvMassHisto, TPad* thePad=0x0);
   void SaveToRoot(TString fileName, TString option="recreate") const;
   void DrawHistos(TCanvas* cry) const;
@@ -102,7 +113,16 @@ class AliHFMultiTrials : public TNamed {
 
  private:
 
+  struct TrialConfig;
+  struct TrialResult;
+
   Bool_t CreateHistos();
+  void RunTrial(const TrialConfig& conf, TH1F* hRebinned, TH1D* hInvMassHisto, TPad* thePad, TrialResult& res);
+  void FillTrialResult(const TrialConfig& conf, const TrialResult& res);
+  Bool_t RunTrialsInProcesses(std::vector<TrialConfig>& trials, std::vector<TH1F*>& hRebinned, TH1D* hInvMassHisto, Int_t nWorkers);
+  Int_t GetTrialRecordSize() const {return 30+3*fNumOfnSigmaBinCSteps;}
+  void PackTrialResult(const TrialResult& res, TVectorD& rec, Int_t offset) const;
+  void UnpackTrialResult(const TVectorD& rec, Int_t offset, TrialResult& res) const;
   TH1F* RebinHisto(TH1D* hOrig, Int_t reb, Int_t firstUse) const;
   void BinCount(TH1F* h, TF1* fB, Int_t rebin, Double_t minMass, Double_t maxMass, Double_t& count, Double_t& ecount) const;
   Bool_t DoFitWithPol3Bkg(TH1F* histoToFit, Double_t  hmin, Double_t  hmax,
@@ -179,8 +199,13 @@ class AliHFMultiTrials : public TNamed {
 
   std::vector<AliHFMassFitterVAR*> fMassFitters; //!<! Mass fitters
 
+  Int_t fNWorkers;          /// number of processes fitting the trials (TProcessExecutor, ROOT6 only), 1 = sequential
+  Int_t fProgressInterval;  /// report progress (AliInfo) every this number of trials (0 = never)
+  Double_t fWallTime;       //!<! wall time of the last DoMultiTrials
+  Double_t fSummedFitTime;  //!<! fit time summed over the trials of the last DoMultiTrials
+
   /// \cond CLASSIMP
-  ClassDef(AliHFMultiTrials,5); /// class for multiple trials of invariant mass fit
+  ClassDef(AliHFMultiTrials,7); /// class for multiple trials of invariant mass fit
   /// \endcond
 };
 
@@ -45,6 +45,12 @@
 ClassImp(AliNormalizationCounter);
 /// \endcond
 
+const char* AliNormalizationCounter::fgkCounterNames[AliNormalizationCounter::kNCounterSlots]={
+  "triggered","V0AND","PileUp","PbPbC0SMH-B-NOPF-ALLNOTRD","Candles0.3","PrimaryV","countForNorm",
+  "noPrimaryV","zvtxGT10","!V0A&Candle03","!V0A&PrimaryV",
+  "Candid(Filter)","Candid(Analysis)","NCandid(Filter)","NCandid(Analysis)"
+};
+
 //____________________________________________
 AliNormalizationCounter::AliNormalizationCounter(): 
 TNamed(),
@@ -57,7 +63,10 @@ fSpherocitySteps(100.),
 fHistTrackFilterEvMult(0),
 fHistTrackAnaEvMult(0),
 fHistTrackFilterSpdMult(0),
-fHistTrackAnaSpdMult(0)
+fHistTrackAnaSpdMult(0),
+fPendingCounts(),
+fPendingRun(-1),
+fNPending(0)
 {
   // empty constructor
 }
@@ -74,7 +83,10 @@ fSpherocitySteps(100.),
 fHistTrackFilterEvMult(0),
 fHistTrackAnaEvMult(0),
 fHistTrackFilterSpdMult(0),
-fHistTrackAnaSpdMult(0)
+fHistTrackAnaSpdMult(0),
+fPendingCounts(),
+fPendingRun(-1),
+fNPending(0)
 {
   ;
 }
@@ -105,7 +117,9 @@ AliNormalizationCounter::~AliNormalizationCounter()
 void AliNormalizationCounter::Init()
 {
   //variables initialization
-  fCounters.AddRubric("Event","triggered/V0AND/PileUp/PbPbC0SMH-B-NOPF-ALLNOTRD/Candles0.3/PrimaryV/countForNorm/noPrimaryV/zvtxGT10/!V0A&Candle03/!V0A&PrimaryV/Candid(Filter)/Candid(Analysis)/NCandid(Filter)/NCandid(Analysis)");
+  TString keyWords=fgkCounterNames[0];
+  for(Int_t i=1; i<kNCounterSlots; i++) keyWords+=Form("/%s",fgkCounterNames[i]);
+  fCounters.AddRubric("Event",keyWords.Data());
   if(fMultiplicity)  fCounters.AddRubric("Multiplicity", 5000);
   if(fSpherocity)  fCounters.AddRubric("Spherocity", (Int_t)fSpherocitySteps+1);
   fCounters.AddRubric("Run", 1000000);
@@ -148,6 +162,8 @@ Long64_t AliNormalizationCounter::Merge(TCollection* list){
 }
 //_______________________________________
 void AliNormalizationCounter::Add(const AliNormalizationCounter *norm){
+  FlushCounters();
+  const_cast<AliNormalizationCounter*>(norm)->FlushCounters();
   fCounters.Add(&(norm->fCounters));
   fHistTrackFilterEvMult->Add(norm->fHistTrackFilterEvMult);
   fHistTrackAnaEvMult->Add(norm->fHistTrackAnaEvMult);
@@ -186,7 +202,7 @@ void AliNormalizationCounter::StoreEvent(AliVEvent *event,AliRDHFCuts *rdCut,Boo
   //event must be either physics or MC
   if(!(event->GetEventType() == 7||event->GetEventType() == 0))return;
   
-  FillCounters("triggered",runNumber,multiplicity,spherocity);
+  Count(kTriggered,runNumber,multiplicity,spherocity);
 
   //Find V0AND
   AliTriggerAnalysis trAn; /// Trigger Analysis
@@ -197,7 +213,7 @@ void AliNormalizationCounter::StoreEvent(AliVEvent *event,AliRDHFCuts *rdCut,Boo
     v0B = trAn.IsOfflineTriggerFired(eventESD , AliTriggerAnalysis::kV0C);
     v0A = trAn.IsOfflineTriggerFired(eventESD , AliTriggerAnalysis::kV0A);
   }
-  if(v0A&&v0B) FillCounters("V0AND",runNumber,multiplicity,spherocity);
+  if(v0A&&v0B) Count(kV0AND,runNumber,multiplicity,spherocity);
   
   //FindPrimary vertex  
   // AliVVertex *vtrc =  (AliVVertex*)event->GetPrimaryVertex();
@@ -210,30 +226,30 @@ void AliNormalizationCounter::StoreEvent(AliVEvent *event,AliRDHFCuts *rdCut,Boo
   AliAODEvent *eventAOD = (AliAODEvent*)event;
   TString trigclass=eventAOD->GetFiredTriggerClasses();
   if(trigclass.Contains("C0SMH-B-NOPF-ALLNOTRD")||trigclass.Contains("C0SMH-B-NOPF-ALL")){
-    FillCounters("PbPbC0SMH-B-NOPF-ALLNOTRD",runNumber,multiplicity,spherocity);
+    Count(kPbPbC0SMH,runNumber,multiplicity,spherocity);
   }
 
   //FindPrimary vertex  
   if(isEventSelected){
-    FillCounters("PrimaryV",runNumber,multiplicity,spherocity);
+    Count(kPrimaryV,runNumber,multiplicity,spherocity);
     flagPV=kTRUE;
   }else{
     if(rdCut->GetWhyRejection()==0){
-      FillCounters("noPrimaryV",runNumber,multiplicity,spherocity);
+      Count(kNoPrimaryV,runNumber,multiplicity,spherocity);
     }
     //find good vtx outside range
     if(rdCut->GetWhyRejection()==6){
-      FillCounters("zvtxGT10",runNumber,multiplicity,spherocity);
-      FillCounters("PrimaryV",runNumber,multiplicity,spherocity);
+      Count(kZvtxGT10,runNumber,multiplicity,spherocity);
+      Count(kPrimaryV,runNumber,multiplicity,spherocity);
       flagPV=kTRUE;
     }
     if(rdCut->GetWhyRejection()==1){
-      FillCounters("PileUp",runNumber,multiplicity,spherocity);
+      Count(kPileUp,runNumber,multiplicity,spherocity);
     }
   }
   //to be counted for normalization
   if(rdCut->CountEventForNormalization()){
-    FillCounters("countForNorm",runNumber,multiplicity,spherocity);
+    Count(kCountForNorm,runNumber,multiplicity,spherocity);
   }
 
 
@@ -242,17 +258,17 @@ void AliNormalizationCounter::StoreEvent(AliVEvent *event,AliRDHFCuts *rdCut,Boo
   for(Int_t i=0;i<trkEntries&&!flag03;i++){
     AliAODTrack *track=(AliAODTrack*)event->GetTrack(i);
     if((track->Pt()>0.3)&&(!flag03)){
-      FillCounters("Candles0.3",runNumber,multiplicity,spherocity);
+      Count(kCandles03,runNumber,multiplicity,spherocity);
       flag03=kTRUE;
       break;
     }
   }
   
   if(!(v0A&&v0B)&&(flag03)){ 
-    FillCounters("!V0A&Candle03",runNumber,multiplicity,spherocity);
+    Count(kNoV0ACandle03,runNumber,multiplicity,spherocity);
   }
   if(!(v0A&&v0B)&&flagPV){
-    FillCounters("!V0A&PrimaryV",runNumber,multiplicity,spherocity);
+    Count(kNoV0APrimaryV,runNumber,multiplicity,spherocity);
   }
   
   return;
@@ -281,33 +297,18 @@ void AliNormalizationCounter::StoreCandidates(AliVEvent *event,Int_t nCand,Bool_
   Int_t multiplicity = Multiplicity(event);
   if(nCand==0)return;
   if(flagFilter){
-    if(fMultiplicity) 
-      fCounters.Count(Form("Event:Candid(Filter)/Run:%d/Multiplicity:%d",runNumber,multiplicity));
-    else 
-      fCounters.Count(Form("Event:Candid(Filter)/Run:%d",runNumber));
-    for(Int_t i=0;i<nCand;i++){ 
-      if(fMultiplicity) 
-	fCounters.Count(Form("Event:NCandid(Filter)/Run:%d/Multiplicity:%d",runNumber,multiplicity));
-      else 
-	fCounters.Count(Form("Event:NCandid(Filter)/Run:%d",runNumber));
-    }
+    Count(kCandidFilter,runNumber,multiplicity);
+    Count(kNCandidFilter,runNumber,multiplicity,-99.,nCand);
   }else{
-    if(fMultiplicity) 
-      fCounters.Count(Form("Event:Candid(Analysis)/Run:%d/Multiplicity:%d",runNumber,multiplicity));
-    else
-      fCounters.Count(Form("Event:Candid(Analysis)/Run:%d",runNumber));
-    for(Int_t i=0;i<nCand;i++){ 
-      if(fMultiplicity) 
-	fCounters.Count(Form("Event:NCandid(Analysis)/Run:%d/Multiplicity:%d",runNumber,multiplicity));
-      else
-	fCounters.Count(Form("Event:NCandid(Analysis)/Run:%d",runNumber));
-    }
+    Count(kCandidAnalysis,runNumber,multiplicity);
+    Count(kNCandidAnalysis,runNumber,multiplicity,-99.,nCand);
   }
   return;
 }
 //_______________________________________________________________________
 TH1D* AliNormalizationCounter::DrawAgainstRuns(TString candle,Bool_t drawHist){
   //
+  FlushCounters();
   fCounters.SortRubric("Run");
   TString selection;
   selection.Form("event:%s",candle.Data());
@@ -337,10 +338,12 @@ TH1D* AliNormalizationCounter::DrawRatio(TString candle1,TString candle2){
 }
 //___________________________________________________________________________
 void AliNormalizationCounter::PrintRubrics(){
+  FlushCounters();
   fCounters.PrintKeyWords();
 }
 //___________________________________________________________________________
 Double_t AliNormalizationCounter::GetSum(TString candle){
+  FlushCounters();
   TString selection="event:";
   selection.Append(candle);
   return fCounters.GetSum(selection.Data());
@@ -372,6 +375,7 @@ Double_t AliNormalizationCounter::GetNEventsForNorm(){
 }
 //___________________________________________________________________________
 Double_t AliNormalizationCounter::GetNEventsForNorm(Int_t runnumber){
+  FlushCounters();
   TString listofruns = fCounters.GetKeyWords("RUN");
   if(!listofruns.Contains(Form("%d",runnumber))){
     printf("WARNING: %d is not a valid run number\n",runnumber);
@@ -395,6 +399,7 @@ Double_t AliNormalizationCounter::GetNEventsForNorm(Int_t minmultiplicity, Int_t
     return 0.;
   }
 
+  FlushCounters();
   TString listofruns = fCounters.GetKeyWords("Multiplicity");
 
   Int_t nmultbins = maxmultiplicity - minmultiplicity;
@@ -426,6 +431,7 @@ Double_t AliNormalizationCounter::GetNEventsForNorm(Int_t minmultiplicity, Int_t
     return 0.;
   }
 
+  FlushCounters();
   TString listofruns = fCounters.GetKeyWords("Multiplicity");
   TString listofruns2 = fCounters.GetKeyWords("Spherocity");
   TObjArray* arr=listofruns2.Tokenize(",");
@@ -467,6 +473,7 @@ Double_t AliNormalizationCounter::GetNEventsForNormSpheroOnly(Double_t minsphero
     return 0.;
   }
 
+  FlushCounters();
   TString listofruns = fCounters.GetKeyWords("Spherocity");
   TObjArray* arr=listofruns.Tokenize(",");
   Int_t nSphVals=arr->GetEntries();
@@ -503,6 +510,7 @@ Double_t AliNormalizationCounter::GetSum(TString candle,Int_t minmultiplicity, I
     return 0.;
   }
 
+  FlushCounters();
   TString listofruns = fCounters.GetKeyWords("Multiplicity");
   Double_t sum=0.;
   for (Int_t ibin=minmultiplicity; ibin<=maxmultiplicity; ibin++) {
@@ -521,6 +529,7 @@ Double_t AliNormalizationCounter::GetSum(TString candle,Int_t minmultiplicity, I
 //___________________________________________________________________________
 TH1D* AliNormalizationCounter::DrawNEventsForNorm(Bool_t drawRatio){
   //usare algebra histos
+  FlushCounters();
   fCounters.SortRubric("Run");
   TString selection;
 
@@ -575,17 +584,74 @@ Int_t AliNormalizationCounter::Multiplicity(AliVEvent* event){
 }
 
 //___________________________________________________________________________
-void AliNormalizationCounter::FillCounters(TString name, Int_t runNumber, Int_t multiplicity, Double_t spherocity){
-
-
-  Int_t sphToInteger=spherocity*fSpherocitySteps;
-  if(fMultiplicity  && !fSpherocity) 
-    fCounters.Count(Form("Event:%s/Run:%d/Multiplicity:%d",name.Data(),runNumber,multiplicity));
-  else if(fMultiplicity  && fSpherocity) 
-    fCounters.Count(Form("Event:%s/Run:%d/Multiplicity:%d/Spherocity:%d",name.Data(),runNumber,multiplicity,sphToInteger));
-  else if(!fMultiplicity  && fSpherocity) 
-    fCounters.Count(Form("Event:%s/Run:%d/Spherocity:%d",name.Data(),runNumber,sphToInteger));
-  else 
-    fCounters.Count(Form("Event:%s/Run:%d",name.Data(),runNumber));
-  return;
+Int_t AliNormalizationCounter::GetCounterHandle(const char* eventKey){
+  // index of a keyword of the "Event" rubric, to be resolved once and
+  // passed to Count() for each event (-1 if not found)
+
+  for(Int_t i=0; i<kNCounterSlots; i++){
+    if(!strcmp(eventKey,fgkCounterNames[i])) return i;
+  }
+  return -1;
+}
+
+//___________________________________________________________________________
+void AliNormalizationCounter::Count(Int_t handle, Int_t runNumber, Int_t multiplicity, Double_t spherocity, Int_t value){
+  // count "value" entries for the given Event keyword, run, multiplicity
+  // and spherocity. The counts are kept in memory and passed to the
+  // AliCounterCollection once per distinct key, when the run changes or
+  // when the counters are read, merged or written
+
+  if(handle<0 || handle>=kNCounterSlots) return;
+  if(runNumber!=fPendingRun){
+    FlushCounters();
+    fPendingRun=runNumber;
+  }
+  Int_t mult=fMultiplicity ? multiplicity : 0;
+  Int_t sphToInteger=fSpherocity ? (Int_t)(spherocity*fSpherocitySteps) : 0;
+  Long64_t key=((Long64_t)mult<<32)|(UInt_t)sphToInteger;
+  std::pair<std::map<Long64_t,Int_t>::iterator,Bool_t> ins=fPendingCounts[handle].insert(std::make_pair(key,value));
+  if(ins.second) fNPending++;
+  else ins.first->second+=value;
+}
+
+//___________________________________________________________________________
+void AliNormalizationCounter::FlushCounters(){
+  // pass the pending counts to the AliCounterCollection
+  // the candidate counters are not binned in spherocity (see StoreCandidates)
+
+  if(fNPending==0) return;
+  TString key;
+  for(Int_t i=0; i<kNCounterSlots; i++){
+    Bool_t useSph = fSpherocity && i<kCandidFilter;
+    for(std::map<Long64_t,Int_t>::const_iterator it=fPendingCounts[i].begin(); it!=fPendingCounts[i].end(); ++it){
+      Int_t mult=(Int_t)(it->first>>32);
+      Int_t sphToInteger=(Int_t)(UInt_t)(it->first&0xffffffff);
+      if(fMultiplicity && !useSph)
+        key.Form("Event:%s/Run:%d/Multiplicity:%d",fgkCounterNames[i],fPendingRun,mult);
+      else if(fMultiplicity && useSph)
+        key.Form("Event:%s/Run:%d/Multiplicity:%d/Spherocity:%d",fgkCounterNames[i],fPendingRun,mult,sphToInteger);
+      else if(!fMultiplicity && useSph)
+        key.Form("Event:%s/Run:%d/Spherocity:%d",fgkCounterNames[i],fPendingRun,sphToInteger);
+      else
+        key.Form("Event:%s/Run:%d",fgkCounterNames[i],fPendingRun);
+      fCounters.Count(key,it->second);
+    }
+    fPendingCounts[i].clear();
+  }
+  fNPending=0;
+}
+
+//___________________________________________________________________________
+void AliNormalizationCounter::Streamer(TBuffer &R__b)
+{
+  //
+  // Stream an object of class AliNormalizationCounter.
+  // The pending counts are transient: pass them to fCounters before writing
+  //
+  if (R__b.IsReading()) {
+    R__b.ReadClassBuffer(AliNormalizationCounter::Class(),this);
+  } else {
+    FlushCounters();
+    R__b.WriteClassBuffer(AliNormalizationCounter::Class(),this);
+  }
 }
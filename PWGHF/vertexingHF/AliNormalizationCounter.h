@@ -43,18 +43,24 @@
 #include "AliAnalysisDataSlot.h"
 #include "AliAnalysisDataContainer.h"
 #include "AliRDHFCuts.h"
+#include <map>
 //#include "AliAnalysisVertexingHF.h"
 
 class AliNormalizationCounter : public TNamed
 {
  public:
 
+  /// keywords of the "Event" rubric, to be used as counter handles
+  enum ECounterSlot {kTriggered, kV0AND, kPileUp, kPbPbC0SMH, kCandles03, kPrimaryV, kCountForNorm,
+                     kNoPrimaryV, kZvtxGT10, kNoV0ACandle03, kNoV0APrimaryV,
+                     kCandidFilter, kCandidAnalysis, kNCandidFilter, kNCandidAnalysis, kNCounterSlots};
+
   AliNormalizationCounter();
   AliNormalizationCounter(const char *name);
   virtual ~AliNormalizationCounter();
   Long64_t Merge(TCollection* list);
 
-  AliCounterCollection* GetCounter(){return &fCounters;}
+  AliCounterCollection* GetCounter(){FlushCounters(); return &fCounters;}
   void Init();
   void Add(const AliNormalizationCounter*);
   void SetESD(Bool_t flag){fESD=flag;}
@@ -79,11 +85,14 @@ class AliNormalizationCounter : public TNamed
   Double_t GetNEventsForNorm(Int_t minmultiplicity, Int_t maxmultiplicity, Double_t minspherocity, Double_t maxspherocity);
   TH1D* DrawNEventsForNorm(Bool_t drawRatio=kFALSE);
 
+  static Int_t GetCounterHandle(const char* eventKey);
+  void Count(Int_t handle, Int_t runNumber, Int_t multiplicity=-9999, Double_t spherocity=-99., Int_t value=1);
+  void FlushCounters();
+
  private:
   AliNormalizationCounter(const AliNormalizationCounter &source);
   AliNormalizationCounter& operator=(const AliNormalizationCounter& source);
   Int_t Multiplicity(AliVEvent* event);
-  void FillCounters(TString name, Int_t runNumber, Int_t multiplicity, Double_t spherocity);
 
 
   AliCounterCollection fCounters; /// internal counter
@@ -97,8 +106,13 @@ class AliNormalizationCounter : public TNamed
   TH2F *fHistTrackFilterSpdMult; /// hist to store no of filter candidates vs  SPD multiplicity
   TH2F *fHistTrackAnaSpdMult;/// hist to store no of analysis candidates vs SPD multiplicity 
 
+  static const char* fgkCounterNames[kNCounterSlots]; /// keywords of the "Event" rubric
+  std::map<Long64_t,Int_t> fPendingCounts[kNCounterSlots]; //!<! counts not yet passed to fCounters, keyed by multiplicity and spherocity
+  Int_t fPendingRun; //!<! run of the pending counts
+  Int_t fNPending;   //!<! number of pending entries
+
   /// \cond CLASSIMP    
-  ClassDef(AliNormalizationCounter,7);
+  ClassDef(AliNormalizationCounter,8);
   /// \endcond
 };
 #endif
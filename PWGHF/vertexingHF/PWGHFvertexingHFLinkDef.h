@@ -78,7 +78,7 @@
 #pragma link C++ class AliHFMassFitter+;
 #pragma link C++ class AliHFPtSpectrum+;
 #pragma link C++ class AliHFsubtractBFDcuts+;
-#pragma link C++ class AliNormalizationCounter+;
+#pragma link C++ class AliNormalizationCounter-;
 #pragma link C++ class AliAnalysisTaskSEMonitNorm+;
 #pragma link C++ class AliAnalysisTaskSEBkgLikeSignD0+;
 #pragma link C++ class AliAnalysisTaskSEImproveITS+;
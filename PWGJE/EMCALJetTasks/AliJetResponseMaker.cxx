@@ -19,11 +19,15 @@
 
 #include "AliJetResponseMaker.h"
 
+#include <algorithm>
+
 #include <TClonesArray.h>
 #include <TH2F.h>
 #include <THnSparse.h>
+#include <TStopwatch.h>
 
 #include "AliTLorentzVector.h"
+#include "AliEtaPhiGrid.h"
 #include "AliAnalysisManager.h"
 #include "AliVCluster.h"
 #include "AliVTrack.h"
@@ -45,6 +49,8 @@ AliJetResponseMaker::AliJetResponseMaker() :
   fMatchingPar1(0),
   fMatchingPar2(0),
   fUseCellsToMatch(kFALSE),
+  fUseFastMatching(kTRUE),
+  fBenchmarkMatching(kFALSE),
   fMinJetMCPt(1),
   fEmbeddingQA(),
   fHistoType(0),
@@ -63,6 +69,8 @@ AliJetResponseMaker::AliJetResponseMaker() :
   fIsJet2Rho(kFALSE),
   fHistRejectionReason1(0),
   fHistRejectionReason2(0),
+  fHistMatchingTimeAllPairs(0),
+  fHistMatchingTimeFast(0),
   fHistJets1(0),
   fHistJets2(0),
   fHistMatching(0),
@@ -134,6 +142,8 @@ AliJetResponseMaker::AliJetResponseMaker(const char *name) :
   fMatchingPar1(0),
   fMatchingPar2(0),
   fUseCellsToMatch(kFALSE),
+  fUseFastMatching(kTRUE),
+  fBenchmarkMatching(kFALSE),
   fMinJetMCPt(1),
   fEmbeddingQA(),
   fHistoType(0),
@@ -152,6 +162,8 @@ AliJetResponseMaker::AliJetResponseMaker(const char *name) :
   fIsJet2Rho(kFALSE),
   fHistRejectionReason1(0),
   fHistRejectionReason2(0),
+  fHistMatchingTimeAllPairs(0),
+  fHistMatchingTimeFast(0),
   fHistJets1(0),
   fHistJets2(0),
   fHistMatching(0),
@@ -1020,6 +1032,20 @@ void AliJetResponseMaker::UserCreateOutputObjects()
   SetRejectionReasonLabels(fHistRejectionReason2->GetXaxis());
   fOutput->Add(fHistRejectionReason2);
 
+  if (fBenchmarkMatching) {
+    fHistMatchingTimeAllPairs = new TH2F("fHistMatchingTimeAllPairs", "fHistMatchingTimeAllPairs", 100, 0, 10000, 200, 0, 2000);
+    fHistMatchingTimeAllPairs->GetXaxis()->SetTitle("N_{jet1} #times N_{jet2}");
+    fHistMatchingTimeAllPairs->GetYaxis()->SetTitle("time (#mus)");
+    fHistMatchingTimeAllPairs->GetZaxis()->SetTitle("events");
+    fOutput->Add(fHistMatchingTimeAllPairs);
+
+    fHistMatchingTimeFast = new TH2F("fHistMatchingTimeFast", "fHistMatchingTimeFast", 100, 0, 10000, 200, 0, 2000);
+    fHistMatchingTimeFast->GetXaxis()->SetTitle("N_{jet1} #times N_{jet2}");
+    fHistMatchingTimeFast->GetYaxis()->SetTitle("time (#mus)");
+    fHistMatchingTimeFast->GetZaxis()->SetTitle("events");
+    fOutput->Add(fHistMatchingTimeFast);
+  }
+
   if (fHistoType==0)
     AllocateTH2();
   else 
@@ -1426,22 +1452,315 @@ void AliJetResponseMaker::DoJetLoop()
   AliEmcalJet* jet1 = 0;
   AliEmcalJet* jet2 = 0;
 
+  // Jets are collected in the container order: the closest/second-closest assignment
+  // depends on the order in which the pairs are evaluated when two distances are equal
+  std::vector<AliEmcalJet*> jetList1;
+  std::vector<AliEmcalJet*> jetList2;
+
   jets2->ResetCurrentID();
-  while ((jet2 = jets2->GetNextJet())) jet2->ResetMatching();
+  while ((jet2 = jets2->GetNextJet())) {
+    jet2->ResetMatching();
+    jetList2.push_back(jet2);
+  }
 
   jets1->ResetCurrentID();
   while ((jet1 = jets1->GetNextJet())) {
     jet1->ResetMatching();
-
     if (jet1->MCPt() < fMinJetMCPt) continue;
+    jetList1.push_back(jet1);
+  }
+
+  if (!fBenchmarkMatching) {
+    if (!fUseFastMatching || !DoJetLoopFast(jetList1, jetList2)) DoJetLoopAllPairs(jetList1, jetList2);
+    return;
+  }
+
+  // Benchmark mode: both methods are run and their assignments compared. The method
+  // selected with SetUseFastMatching runs last, so that its assignments are the ones used
+  const Double_t nPairs = jetList1.size() * jetList2.size();
+  TStopwatch watch;
+
+  std::vector<AliEmcalJet*> refJets;
+  std::vector<Double_t> refDist;
+  std::vector<AliEmcalJet*> allJets(jetList1);
+  allJets.insert(allJets.end(), jetList2.begin(), jetList2.end());
+
+  for (Int_t iRun = 0; iRun < 2; iRun++) {
+    Bool_t fast = (iRun == 1) == fUseFastMatching;
+
+    if (iRun == 1) {
+      for (std::vector<AliEmcalJet*>::iterator it = allJets.begin(); it != allJets.end(); ++it) {
+        refJets.push_back((*it)->ClosestJet());
+        refJets.push_back((*it)->SecondClosestJet());
+        refDist.push_back((*it)->ClosestJetDistance());
+        refDist.push_back((*it)->SecondClosestJetDistance());
+        (*it)->ResetMatching();
+      }
+    }
 
-    jets2->ResetCurrentID();
-    while ((jet2 = jets2->GetNextJet())) {
-      SetMatchingLevel(jet1, jet2, fMatching);
+    watch.Start(kTRUE);
+    Bool_t done = kTRUE;
+    if (fast) done = DoJetLoopFast(jetList1, jetList2);
+    else DoJetLoopAllPairs(jetList1, jetList2);
+    watch.Stop();
+
+    if (!done) {
+      // nothing was evaluated by the fast matching, the jets are reset
+      AliWarning("Fast matching not available for the current configuration, using the all-pairs loop.");
+      DoJetLoopAllPairs(jetList1, jetList2);
+      return;
+    }
+    (fast ? fHistMatchingTimeFast : fHistMatchingTimeAllPairs)->Fill(nPairs, watch.RealTime() * 1e6);
+  }
+
+  // With geometrical matching only jets within the matching radius are considered,
+  // so assignments beyond the radius (never used for the matching) are not compared
+  const char *refName = fUseFastMatching ? "all-pairs" : "fast";
+  const char *newName = fUseFastMatching ? "fast" : "all-pairs";
+  const Double_t maxDist = fMatching == kGeometrical ? TMath::Max(fMatchingPar1, fMatchingPar2) : 999;
+  for (UInt_t i = 0; i < allJets.size(); i++) {
+    AliEmcalJet *jet = allJets[i];
+    if (TMath::Min(refDist[2*i], jet->ClosestJetDistance()) <= maxDist &&
+        (refJets[2*i] != jet->ClosestJet() || refDist[2*i] != jet->ClosestJetDistance())) {
+      AliError(Form("Closest jet mismatch between %s and %s matching: jet pt = %f, eta = %f, phi = %f, d = %f / %f",
+          refName, newName, jet->Pt(), jet->Eta(), jet->Phi(), refDist[2*i], jet->ClosestJetDistance()));
+    }
+    if (TMath::Min(refDist[2*i+1], jet->SecondClosestJetDistance()) <= maxDist &&
+        (refJets[2*i+1] != jet->SecondClosestJet() || refDist[2*i+1] != jet->SecondClosestJetDistance())) {
+      AliError(Form("Second closest jet mismatch between %s and %s matching: jet pt = %f, eta = %f, phi = %f, d = %f / %f",
+          refName, newName, jet->Pt(), jet->Eta(), jet->Phi(), refDist[2*i+1], jet->SecondClosestJetDistance()));
+    }
+  }
+}
+
+//________________________________________________________________________
+void AliJetResponseMaker::DoJetLoopAllPairs(const std::vector<AliEmcalJet*> &jets1, const std::vector<AliEmcalJet*> &jets2)
+{
+  // Evaluate the matching level for every (jet1, jet2) pair.
+
+  for (UInt_t i = 0; i < jets1.size(); i++) {
+    for (UInt_t j = 0; j < jets2.size(); j++) {
+      SetMatchingLevel(jets1[i], jets2[j], fMatching);
     } // jet2 loop
   } // jet1 loop
 }
 
+//________________________________________________________________________
+Bool_t AliJetResponseMaker::DoJetLoopFast(const std::vector<AliEmcalJet*> &jets1, const std::vector<AliEmcalJet*> &jets2)
+{
+  // Evaluate the matching level only for the candidate pairs.
+  //
+  // SetMatchingLevel keeps, for each jet, the first two jets with the smallest distance
+  // in the order in which they are evaluated. Evaluating an ordered subset of the pairs
+  // (jet1-major, jet2 ascending) which contains those two jets for every jet
+  // therefore gives the same closest/second-closest assignments as the full loop.
+  //  - geometrical matching: jet2 candidates come from an eta-phi grid with the matching
+  //    radius as cell size; jets outside the radius cannot be matched anyway.
+  //  - MC label/same collections: jets not sharing any constituent always have the same
+  //    matching level (1 or -1), so besides the jets sharing constituents it is enough
+  //    to evaluate the first two unrelated jets of each jet.
+  // Returns kFALSE if the configuration is not supported (the caller falls back to the all-pairs loop).
+
+  std::vector<std::vector<Int_t> > cand(jets1.size());
+
+  if (fMatching == kGeometrical) {
+    if (TMath::Max(fMatchingPar1, fMatchingPar2) <= 0) return kFALSE;
+    FindGeometricalCandidates(jets1, jets2, cand);
+  }
+  else if (fMatching == kMCLabel || fMatching == kSameCollections) {
+    AliJetContainer *jetCont2 = static_cast<AliJetContainer*>(fJetCollArray.At(1));
+    if (fMatching == kMCLabel && !jetCont2->GetParticleContainer()) return kFALSE;
+
+    FindConstituentCandidates(jets1, jets2, cand);
+
+    // add the first two unrelated jet2 for each jet1 ...
+    std::vector<std::vector<Int_t> > cand2(jets2.size());
+    for (UInt_t i = 0; i < jets1.size(); i++) {
+      for (UInt_t k = 0; k < cand[i].size(); k++) cand2[cand[i][k]].push_back(i);
+    }
+
+    std::vector<std::vector<Int_t> > extra(jets1.size());
+    for (UInt_t i = 0; i < jets1.size(); i++) {
+      Int_t nAdded = 0;
+      for (UInt_t j = 0; j < jets2.size() && nAdded < 2; j++) {
+        if (std::binary_search(cand[i].begin(), cand[i].end(), (Int_t)j)) continue;
+        extra[i].push_back(j);
+        nAdded++;
+      }
+    }
+
+    // ... and the first two unrelated jet1 for each jet2
+    for (UInt_t j = 0; j < jets2.size(); j++) {
+      Int_t nAdded = 0;
+      for (UInt_t i = 0; i < jets1.size() && nAdded < 2; i++) {
+        if (std::binary_search(cand2[j].begin(), cand2[j].end(), (Int_t)i)) continue;
+        extra[i].push_back(j);
+        nAdded++;
+      }
+    }
+
+    for (UInt_t i = 0; i < jets1.size(); i++) {
+      if (extra[i].empty()) continue;
+      cand[i].insert(cand[i].end(), extra[i].begin(), extra[i].end());
+      std::sort(cand[i].begin(), cand[i].end());
+      cand[i].erase(std::unique(cand[i].begin(), cand[i].end()), cand[i].end());
+    }
+  }
+  else {
+    return kFALSE;
+  }
+
+  for (UInt_t i = 0; i < jets1.size(); i++) {
+    for (UInt_t k = 0; k < cand[i].size(); k++) {
+      SetMatchingLevel(jets1[i], jets2[cand[i][k]], fMatching);
+    }
+  }
+
+  return kTRUE;
+}
+
+//________________________________________________________________________
+void AliJetResponseMaker::FindGeometricalCandidates(const std::vector<AliEmcalJet*> &jets1, const std::vector<AliEmcalJet*> &jets2,
+                                                    std::vector<std::vector<Int_t> > &cand) const
+{
+  // Bucket jets2 in an eta-phi grid whose cells are at least as large as the matching radius
+  // and, for each jet1, take the jets2 in the neighbouring cells (with phi wrap-around).
+  // The candidate lists are sorted in the container order.
+
+  if (jets2.empty()) return;
+
+  const Double_t radius = TMath::Max(fMatchingPar1, fMatchingPar2);
+
+  Double_t etaMin = jets2[0]->Eta();
+  Double_t etaMax = etaMin;
+  for (UInt_t j = 1; j < jets2.size(); j++) {
+    etaMin = TMath::Min(etaMin, jets2[j]->Eta());
+    etaMax = TMath::Max(etaMax, jets2[j]->Eta());
+  }
+
+  const Int_t nEta = TMath::Min(Int_t((etaMax - etaMin) / radius) + 1, 1000);
+  const Int_t nPhi = TMath::Max(Int_t(TMath::TwoPi() / radius), 1);
+  const Double_t etaWidth = TMath::Max(radius, (etaMax - etaMin) / nEta);
+
+  AliEtaPhiGrid grid;
+  grid.SetBinning(nEta, etaMin, etaWidth, nPhi);
+  std::vector<Int_t> cellOfJet(jets2.size());
+  for (UInt_t j = 0; j < jets2.size(); j++) cellOfJet[j] = grid.GetCell(jets2[j]->Eta(), jets2[j]->Phi());
+  grid.Sort(jets2.size(), &cellOfJet[0]);
+
+  for (UInt_t i = 0; i < jets1.size(); i++) grid.GetNeighbours(jets1[i]->Eta(), jets1[i]->Phi(), cand[i]);
+}
+
+//________________________________________________________________________
+void AliJetResponseMaker::FindConstituentCandidates(const std::vector<AliEmcalJet*> &jets1, const std::vector<AliEmcalJet*> &jets2,
+                                                    std::vector<std::vector<Int_t> > &cand) const
+{
+  // Find the pairs of jets that share at least one constituent (track/cluster index or cell id,
+  // or, for MC label matching, a MC particle), intersecting the sorted constituent keys
+  // of each jet1 with the sorted (key, jet2) list. The candidate lists are sorted in the container order.
+
+  std::vector<std::pair<Long64_t, Int_t> > keyToJet2;
+  std::vector<Long64_t> keys;
+  for (UInt_t j = 0; j < jets2.size(); j++) {
+    keys.clear();
+    GetConstituentKeys(jets2[j], 2, keys);
+    for (UInt_t k = 0; k < keys.size(); k++) keyToJet2.push_back(std::make_pair(keys[k], (Int_t)j));
+  }
+  std::sort(keyToJet2.begin(), keyToJet2.end());
+
+  for (UInt_t i = 0; i < jets1.size(); i++) {
+    keys.clear();
+    GetConstituentKeys(jets1[i], 1, keys);
+    std::sort(keys.begin(), keys.end());
+    keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+
+    std::vector<std::pair<Long64_t, Int_t> >::const_iterator it = keyToJet2.begin();
+    for (UInt_t k = 0; k < keys.size() && it != keyToJet2.end(); k++) {
+      it = std::lower_bound(it, keyToJet2.end(), std::make_pair(keys[k], (Int_t)-1));
+      for (; it != keyToJet2.end() && it->first == keys[k]; ++it) cand[i].push_back(it->second);
+    }
+    std::sort(cand[i].begin(), cand[i].end());
+    cand[i].erase(std::unique(cand[i].begin(), cand[i].end()), cand[i].end());
+  }
+}
+
+//________________________________________________________________________
+void AliJetResponseMaker::GetConstituentKeys(AliEmcalJet *jet, Int_t set, std::vector<Long64_t> &keys) const
+{
+  // Get the keys of the constituents used by the MC label/same collections matching levels.
+  // The constituent type is encoded in the upper 32 bits:
+  // 0 = track index (MC particle index for MC label matching), 1 = cluster index, 2 = cell id.
+  // A pair of jets can only have a matching level different from the one of two unrelated jets
+  // if they share at least one key.
+
+  AliJetContainer *jets1 = static_cast<AliJetContainer*>(fJetCollArray.At(0));
+  AliJetContainer *jets2 = static_cast<AliJetContainer*>(fJetCollArray.At(1));
+
+  AliParticleContainer *tracks1   = jets1->GetParticleContainer();
+  AliClusterContainer  *clusters1 = jets1->GetClusterContainer();
+  AliParticleContainer *tracks2   = jets2->GetParticleContainer();
+  AliClusterContainer  *clusters2 = jets2->GetClusterContainer();
+
+  const Long64_t kTrackKey = 0;
+  const Long64_t kClusterKey = Long64_t(1) << 32;
+  const Long64_t kCellKey = Long64_t(2) << 32;
+
+  if (fMatching == kMCLabel) {
+    if (set == 2) {
+      for (Int_t iTrack = 0; iTrack < jet->GetNumberOfTracks(); iTrack++) keys.push_back(kTrackKey + jet->TrackAt(iTrack));
+      return;
+    }
+
+    for (Int_t iTrack = 0; iTrack < jet->GetNumberOfTracks(); iTrack++) {
+      AliVParticle *track = jet->Track(iTrack);
+      if (!track) continue;
+      Int_t MClabel = TMath::Abs(track->GetLabel()) - fMCLabelShift;
+      if (MClabel <= 0) continue;
+      Int_t index = tracks2->GetIndexFromLabel(MClabel);
+      if (index >= 0) keys.push_back(kTrackKey + index);
+    }
+
+    for (Int_t iClus = 0; iClus < jet->GetNumberOfClusters(); iClus++) {
+      AliVCluster *clus = jet->Cluster(iClus);
+      if (!clus) continue;
+      if (fUseCellsToMatch && fCaloCells) {
+        for (Int_t iCell = 0; iCell < clus->GetNCells(); iCell++) {
+          Int_t MClabel = TMath::Abs(fCaloCells->GetCellMCLabel(clus->GetCellAbsId(iCell))) - fMCLabelShift;
+          if (MClabel <= 0) continue;
+          Int_t index = tracks2->GetIndexFromLabel(MClabel);
+          if (index >= 0) keys.push_back(kTrackKey + index);
+        }
+      }
+      else {
+        Int_t MClabel = TMath::Abs(clus->GetLabel()) - fMCLabelShift;
+        if (MClabel <= 0) continue;
+        Int_t index = tracks2->GetIndexFromLabel(MClabel);
+        if (index >= 0) keys.push_back(kTrackKey + index);
+      }
+    }
+    return;
+  }
+
+  // same collections
+  if (tracks1 && tracks2) {
+    for (Int_t iTrack = 0; iTrack < jet->GetNumberOfTracks(); iTrack++) keys.push_back(kTrackKey + jet->TrackAt(iTrack));
+  }
+
+  if (clusters1 && clusters2) {
+    if (fUseCellsToMatch && fCaloCells) {
+      AliClusterContainer *clusters = set == 1 ? clusters1 : clusters2;
+      for (Int_t iClus = 0; iClus < jet->GetNumberOfClusters(); iClus++) {
+        AliVCluster *clus = clusters->GetCluster(jet->ClusterAt(iClus));
+        if (!clus) continue;
+        for (Int_t iCell = 0; iCell < clus->GetNCells(); iCell++) keys.push_back(kCellKey + clus->GetCellAbsId(iCell));
+      }
+    }
+    else {
+      for (Int_t iClus = 0; iClus < jet->GetNumberOfClusters(); iClus++) keys.push_back(kClusterKey + jet->ClusterAt(iClus));
+    }
+  }
+}
+
 //________________________________________________________________________
 void AliJetResponseMaker::GetGeometricalMatchingLevel(AliEmcalJet *jet1, AliEmcalJet *jet2, Double_t &d) const
 {
@@ -24,6 +24,8 @@ class TH2;
 class THnSparse;
 class AliNamedArrayI;
 
+#include <vector>
+
 #include "AliEmcalJet.h"
 #include "AliAnalysisTaskEmcalJet.h"
 #include "AliEmcalEmbeddingQA.h"
@@ -46,6 +48,8 @@ class AliJetResponseMaker : public AliAnalysisTaskEmcalJet {
   void                        SetMatching(MatchingType t, Double_t p1=1, Double_t p2=1)       { fMatching = t; fMatchingPar1 = p1; fMatchingPar2 = p2; }
   void                        SetPtHardBin(Int_t b)                                           { fSelectPtHardBin   = b         ; }
   void                        SetUseCellsToMatch(Bool_t i)                                    { fUseCellsToMatch   = i         ; }
+  void                        SetUseFastMatching(Bool_t b)                                    { fUseFastMatching   = b         ; }
+  void                        SetBenchmarkMatching(Bool_t b)                                  { fBenchmarkMatching = b         ; }
   void                        SetMinJetMCPt(Float_t pt)                                       { fMinJetMCPt        = pt        ; }
   void                        SetHistoType(Int_t b)                                           { fHistoType         = b         ; }
   void                        SetDeltaPtAxis(Int_t b)                                         { fDeltaPtAxis       = b         ; }
@@ -63,6 +67,13 @@ class AliJetResponseMaker : public AliAnalysisTaskEmcalJet {
  protected:
   void                        ExecOnce();
   void                        DoJetLoop();
+  void                        DoJetLoopAllPairs(const std::vector<AliEmcalJet*> &jets1, const std::vector<AliEmcalJet*> &jets2);
+  Bool_t                      DoJetLoopFast(const std::vector<AliEmcalJet*> &jets1, const std::vector<AliEmcalJet*> &jets2);
+  void                        FindGeometricalCandidates(const std::vector<AliEmcalJet*> &jets1, const std::vector<AliEmcalJet*> &jets2,
+                                                        std::vector<std::vector<Int_t> > &cand) const;
+  void                        FindConstituentCandidates(const std::vector<AliEmcalJet*> &jets1, const std::vector<AliEmcalJet*> &jets2,
+                                                        std::vector<std::vector<Int_t> > &cand) const;
+  void                        GetConstituentKeys(AliEmcalJet *jet, Int_t set, std::vector<Long64_t> &keys) const;
   Bool_t                      FillHistograms();
   Bool_t                      Run();
   Bool_t                      DoJetMatching();
@@ -80,6 +91,8 @@ class AliJetResponseMaker : public AliAnalysisTaskEmcalJet {
   Double_t                    fMatchingPar1;                           // matching parameter for jet1-jet2 matching
   Double_t                    fMatchingPar2;                           // matching parameter for jet2-jet1 matching
   Bool_t                      fUseCellsToMatch;                        // use cells instead of clusters to match jets (slower but sometimes needed)
+  Bool_t                      fUseFastMatching;                        ///< only evaluate the matching level for candidate pairs (eta-phi grid / shared constituents)
+  Bool_t                      fBenchmarkMatching;                      ///< run both the all-pairs and the fast matching (the one selected by fUseFastMatching last), compare them and fill timing histograms
   Double_t                    fMinJetMCPt;                             // minimum jet MC pt
   AliEmcalEmbeddingQA         fEmbeddingQA;                            //!<! Embedding QA hists (will only be added if embedding)
   Int_t                       fHistoType;                              // histogram type (0=TH2, 1=THnSparse)
@@ -100,6 +113,8 @@ class AliJetResponseMaker : public AliAnalysisTaskEmcalJet {
 
   TH2                        *fHistRejectionReason1;                   //!Rejection reason vs. jet pt
   TH2                        *fHistRejectionReason2;                   //!Rejection reason vs. jet pt
+  TH2                        *fHistMatchingTimeAllPairs;               //!<! time spent in the all-pairs matching loop vs. number of jet pairs (benchmark only)
+  TH2                        *fHistMatchingTimeFast;                   //!<! time spent in the fast matching vs. number of jet pairs (benchmark only)
 
   // THnSparse
   THnSparse                  *fHistJets1;                              //!jet1 THnSparse
@@ -174,6 +189,6 @@ class AliJetResponseMaker : public AliAnalysisTaskEmcalJet {
   AliJetResponseMaker(const AliJetResponseMaker&);            // not implemented
   AliJetResponseMaker &operator=(const AliJetResponseMaker&); // not implemented
 
-  ClassDef(AliJetResponseMaker, 29) // Jet response matrix producing task
+  ClassDef(AliJetResponseMaker, 30) // Jet response matrix producing task
 };
 #endif
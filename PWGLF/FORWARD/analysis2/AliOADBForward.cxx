@@ -8,6 +8,9 @@
 #include <TFile.h>
 #include <TError.h>
 #include <TSystem.h>
+#include <TBranch.h>
+#include <algorithm>
+#include <vector>
 
 #ifndef ALIROOT_SVN_REVISION
 # define ALIROOT_SVN_REVISION 0
@@ -146,7 +149,16 @@ AliOADBForward::Entry::Print(Option_t* /*option*/) const
 }
 //====================================================================
 AliOADBForward::Table::Table(TTree* tree, Bool_t isNew, ERunSelectMode mode)
-  : fTree(tree), fEntry(0), fVerbose(false), fMode(mode), fFallBack(false)
+  : fTree(tree), 
+    fEntry(0), 
+    fVerbose(false), 
+    fMode(mode), 
+    fFallBack(false),
+    fUseIndex(true),
+    fIndexed(false),
+    fIdxRun(),
+    fIdxEntry(),
+    fIdxConf()
 {
   if (!tree) return;
 
@@ -177,7 +189,12 @@ AliOADBForward::Table::Table(const Table& o)
     fEntry(o.fEntry), 
     fVerbose(o.fVerbose),
     fMode(o.fMode), 
-    fFallBack(o.fFallBack)
+    fFallBack(o.fFallBack),
+    fUseIndex(o.fUseIndex),
+    fIndexed(false),
+    fIdxRun(),
+    fIdxEntry(),
+    fIdxConf()
 {
   //
   // Copy constructor 
@@ -205,6 +222,8 @@ AliOADBForward::Table::operator=(const Table& o)
   fEntry   = o.fEntry;
   fVerbose = o.fVerbose;
   fMode    = o.fMode;
+  fUseIndex = o.fUseIndex;
+  ResetIndex();
   if (fTree) fTree->SetBranchAddress("e", &fEntry);
 
   return *this;
@@ -269,6 +288,7 @@ AliOADBForward::Table::Close()
   
   // if (fTree)  delete fTree; 
   // if (fEntry) delete fEntry;
+  ResetIndex();
   fTree  = 0;
   fEntry = 0;
   return true;
@@ -286,6 +306,9 @@ AliOADBForward::Table::Query(ULong_t        runNo,
   // 
   // Query the tree 
   //
+  if (fUseIndex && IsOpen() && (fIndexed || BuildIndex())) 
+    return IndexQuery(runNo, mode, sys, sNN, fld, mc, sat);
+
   return Query(runNo, mode, Conditions(sys, sNN, fld, mc, sat));
 }
 
@@ -407,6 +430,214 @@ AliOADBForward::Table::Query(ULong_t        runNo,
   return entry;
 }
 
+//____________________________________________________________________
+void
+AliOADBForward::Table::ResetIndex() const
+{
+  // 
+  // Drop the in-memory index 
+  //
+  fIndexed = false;
+  fIdxRun.Set(0);
+  fIdxEntry.Set(0);
+  fIdxConf.Set(0);
+}
+
+namespace {
+  // Row of the index while it is being built 
+  struct IndexRow 
+  {
+    Int_t   fConf;
+    Long_t  fRun;
+    Int_t   fEntry;
+    bool operator<(const IndexRow& o) const 
+    {
+      if (fConf != o.fConf) return fConf < o.fConf;
+      if (fRun  != o.fRun)  return fRun  < o.fRun;
+      return fEntry < o.fEntry;
+    }
+  };
+  // Keep the candidate with the highest score, and the latest entry
+  // among candidates with equal score 
+  void Consider(Long64_t s, Int_t ent, Long64_t& score, Int_t& entry)
+  {
+    if (entry >= 0 && (s < score || (s == score && ent < entry))) return;
+    score = s;
+    entry = ent;
+  }
+}
+
+//____________________________________________________________________
+Bool_t
+AliOADBForward::Table::BuildIndex() const
+{
+  // 
+  // Read the selection columns of all entries and build the index 
+  //
+  ResetIndex();
+  if (!IsOpen()) return false;
+
+  // Do not stream the correction objects while scanning 
+  Bool_t   noData   = (fTree->GetBranch("fData") != 0);
+  if (noData) fTree->SetBranchStatus("fData", 0);
+
+  Long64_t              nEntries = fTree->GetEntries();
+  std::vector<IndexRow> rows;
+  std::vector<Int_t>    confs; // kConfFlags+1 fields per configuration
+  Bool_t                ok       = true;
+  rows.reserve(nEntries);
+  for (Long64_t i = 0; i < nEntries; i++) { 
+    if (fTree->GetEntry(i) <= 0 || !fEntry) { 
+      ok = false;
+      break;
+    }
+    Int_t flags = (fEntry->fMC ? 0x1 : 0) | (fEntry->fSatellite ? 0x2 : 0);
+    Int_t nConf = confs.size() / (kConfFlags+1);
+    Int_t conf  = 0;
+    for (; conf < nConf; conf++) { 
+      const Int_t* c = &(confs[conf * (kConfFlags+1)]);
+      if (c[kConfSys]   == fEntry->fSys   && 
+	  c[kConfSNN]   == fEntry->fSNN   && 
+	  c[kConfField] == fEntry->fField && 
+	  c[kConfFlags] == flags) break;
+    }
+    if (conf == nConf) { 
+      confs.push_back(fEntry->fSys);
+      confs.push_back(fEntry->fSNN);
+      confs.push_back(fEntry->fField);
+      confs.push_back(flags);
+    }
+    IndexRow r = { conf, Long_t(fEntry->fRunNo), Int_t(i) };
+    rows.push_back(r);
+  }
+  if (noData) fTree->SetBranchStatus("fData", 1);
+  if (!ok) { 
+    Warning("BuildIndex", "Failed to read entries of %s, "
+	    "falling back to TTree::Draw queries", GetName());
+    return false;
+  }
+
+  std::sort(rows.begin(), rows.end());
+
+  Int_t nRows = rows.size();
+  Int_t nConf = confs.size() / (kConfFlags+1);
+  fIdxRun.Set(nRows);
+  fIdxEntry.Set(nRows);
+  fIdxConf.Set(nConf * kConfSize);
+  for (Int_t i = 0; i < nConf; i++) { 
+    Int_t* c = fIdxConf.GetArray() + i * kConfSize;
+    for (Int_t f = 0; f <= kConfFlags; f++) c[f] = confs[i*(kConfFlags+1)+f];
+    c[kConfBegin] = nRows;
+    c[kConfEnd]   = 0;
+    c[kConfLast]  = -1;
+  }
+  for (Int_t i = 0; i < nRows; i++) { 
+    const IndexRow& r = rows[i];
+    Int_t*          c = fIdxConf.GetArray() + r.fConf * kConfSize;
+    fIdxRun[i]        = r.fRun;
+    fIdxEntry[i]      = r.fEntry;
+    c[kConfBegin]     = TMath::Min(c[kConfBegin], i);
+    c[kConfEnd]       = i + 1;
+    c[kConfLast]      = TMath::Max(c[kConfLast], r.fEntry);
+  }
+  fIndexed = true;
+
+  if (fVerbose) 
+    Printf("%s: Indexed %d entries in %d configurations", 
+	   GetName(), nRows, nConf);
+  return true;
+}
+
+//____________________________________________________________________
+Int_t
+AliOADBForward::Table::IndexQuery(ULong_t        runNo,
+				  ERunSelectMode mode,
+				  UShort_t       sys,
+				  UShort_t       sNN, 
+				  Short_t        fld,
+				  Bool_t         mc,
+				  Bool_t         sat) const
+{
+  // 
+  // Run a query against the in-memory index.  This selects the same
+  // entry as the TTree::Draw based Query: among the matching rows,
+  // the best run according to the mode, and the latest entry among
+  // rows with equally good runs.
+  //
+  if (runNo > 0) {
+    if (mode <= kDefault || mode > kNewer) mode = fMode;
+    if (mode == kDefault) Fatal("Query", "Mode should never be 'default'");
+  }
+  
+  // How to rank the rows of a configuration 
+  enum { kLatest, kEqual, kMaxRun, kMinRun, kNearest } rank = kLatest;
+  switch (mode) { 
+  case kExact:  rank = (runNo > 0 ? kEqual : kLatest); break;
+  case kNewest: // Fall-through 
+  case kOlder:  rank = kMaxRun;                         break;
+  case kNewer:  rank = kMinRun;                         break;
+  case kNear:   rank = (runNo > 0 ? kNearest : kLatest); break;
+  case kDefault:                                         break;
+  }
+  Long_t run   = Long_t(runNo);
+  Bool_t limit = (runNo > 0 && (mode == kOlder || mode == kNewer));
+  Int_t  flags = (mc ? 0x1 : 0) | (sat ? 0x2 : 0);
+
+  const Int_t*  conf  = fIdxConf.GetArray();
+  const Long_t* runs  = fIdxRun.GetArray();
+  const Int_t*  ents  = fIdxEntry.GetArray();
+  Int_t         nConf = fIdxConf.GetSize() / kConfSize;
+  Int_t         entry = -1;
+  Long64_t      score = 0;
+  for (Int_t i = 0; i < nConf; i++, conf += kConfSize) { 
+    if (conf[kConfFlags] != flags)                            continue;
+    if (sys > 0 && conf[kConfSys] != sys)                     continue;
+    if (sNN > 0 && TMath::Abs(conf[kConfSNN] - sNN) >= 11)    continue;
+    if (TMath::Abs(fld) < 10 && conf[kConfField] != fld)      continue;
+
+    const Long_t* b = runs + conf[kConfBegin];
+    const Long_t* e = runs + conf[kConfEnd];
+    const Long_t* u = 0;
+    switch (rank) { 
+    case kLatest: 
+      Consider(0, conf[kConfLast], score, entry);
+      break;
+    case kEqual: 
+      u = std::upper_bound(b, e, run);
+      if (u != b && u[-1] == run) 
+	Consider(0, ents[u - 1 - runs], score, entry);
+      break;
+    case kMaxRun: 
+      u = (limit ? std::upper_bound(b, e, run) : e);
+      if (u != b) 
+	Consider(u[-1], ents[u - 1 - runs], score, entry);
+      break;
+    case kMinRun: 
+      u = (limit ? std::lower_bound(b, e, run) : b);
+      if (u != e) {
+	const Long_t* l = std::upper_bound(u, e, *u);
+	Consider(-*u, ents[l - 1 - runs], score, entry);
+      }
+      break;
+    case kNearest: 
+      u = std::upper_bound(b, e, run);
+      if (u != b && run - u[-1] <= kMaxNearDistance) 
+	Consider(u[-1] - run, ents[u - 1 - runs], score, entry);
+      if (u != e && *u - run <= kMaxNearDistance) { 
+	const Long_t* l = std::upper_bound(u, e, *u);
+	Consider(run - *u, ents[l - 1 - runs], score, entry);
+      }
+      break;
+    }
+  }
+
+  if (fVerbose) 
+    Printf("%s: Indexed query run=%lu mode=%s sys=%hu sNN=%hu fld=%hd "
+	   "mc=%d sat=%d -> entry # %d", GetName(), runNo, 
+	   Mode2String(mode), sys, sNN, fld, mc, sat, entry);
+  return entry;
+}
+
 //____________________________________________________________________
 Bool_t
 AliOADBForward::Table::Insert(TObject* o, 
@@ -460,6 +691,7 @@ AliOADBForward::Table::Insert(TObject* o,
   fEntry->fTimestamp       = now.Convert(true);
 
   // Fill into tree 
+  ResetIndex();
   Int_t nBytes = fTree->Fill();
   if (nBytes <= 0) {
     Warning("Insert", "Failed to insert new entry");
@@ -4,6 +4,8 @@
 #include <TNamed.h>
 #include <TString.h>
 #include <TMap.h>
+#include <TArrayI.h>
+#include <TArrayL.h>
 class TFile;
 class TTree;
 class TBrowser;
@@ -206,6 +208,13 @@ public:
      * @param use If true, enable fall-back queries
      */
     void SetEnableFallBack(Bool_t use=true) { fFallBack = use; }
+    /** 
+     * Set whether to resolve queries through the in-memory index
+     * (default) or through TTree::Draw.  Both give the same result.
+     * 
+     * @param use If true, use the index 
+     */
+    void SetUseIndex(Bool_t use=true) { fUseIndex = use; }
     // -----------------------------------------------------------------
     /** 
      * Get the name of the tree 
@@ -418,14 +427,68 @@ public:
      * @return true if everything is dandy
      */
     Bool_t IsOpen(Bool_t rw=false) const; 
+    /** 
+     * Drop the in-memory index.  It is rebuilt on the next query.
+     */
+    void ResetIndex() const;
 
     TTree*         fTree;     // Our tree
     Entry*         fEntry;    // Entry cache 
     Bool_t         fVerbose;  // To be verbose or not 
     ERunSelectMode fMode;     // Run query mode 
     Bool_t         fFallBack; // Enable fall-back
+    Bool_t         fUseIndex; // Use in-memory index for queries
+  protected:
+    /** 
+     * Fields of a configuration in the index 
+     */
+    enum { 
+      kConfSys,   // Collision system 
+      kConfSNN,   // Center of mass energy 
+      kConfField, // L3 magnetic field 
+      kConfFlags, // Bit 0: MC, bit 1: satellite 
+      kConfBegin, // First row of configuration 
+      kConfEnd,   // One past last row of configuration
+      kConfLast,  // Largest tree entry of configuration
+      kConfSize   // Number of fields 
+    };
+    /** 
+     * Read the (run, system, energy, field, MC, satellite) columns of
+     * all entries (but not the data objects) and build the index.
+     * Rows are grouped by configuration, and sorted by run number and
+     * entry number within each configuration.
+     * 
+     * @return true on success 
+     */
+    Bool_t BuildIndex() const;
+    /** 
+     * Same as Query, but resolved through the in-memory index.  Each
+     * matching configuration is looked up with binary searches, so
+     * the cost is logarithmic in the number of entries.
+     * 
+     * @param runNo  Run number 
+     * @param mode   Run selection mode 
+     * @param sys    Collision system (1: pp, 2: PbPb, 3: pPb)
+     * @param sNN    Center of mass energy (GeV)
+     * @param fld    L3 magnetic field (kG)
+     * @param mc     For MC only 
+     * @param sat    For satellite events
+     * 
+     * @return Found entry number or negative number in case of problems
+     */
+    Int_t IndexQuery(ULong_t        runNo,
+		     ERunSelectMode mode,
+		     UShort_t       sys,
+		     UShort_t       sNN, 
+		     Short_t        fld,
+		     Bool_t         mc,
+		     Bool_t         sat) const;
+    mutable Bool_t  fIndexed;  //! Whether the index is up-to-date
+    mutable TArrayL fIdxRun;   //! Run number of each row
+    mutable TArrayI fIdxEntry; //! Tree entry of each row
+    mutable TArrayI fIdxConf;  //! Configurations (kConfSize fields each)
 
-    ClassDef(Table,1); 
+    ClassDef(Table,2); 
   };
   // === Interface ===================================================
   /** 
@@ -19,6 +19,12 @@
 #include <TList.h>
 #include <TTree.h>
 #include <TStopwatch.h>
+#include <TFile.h>
+#include <TSystem.h>
+#include <TObjArray.h>
+#include <vector>
+#include <map>
+#include <algorithm>
 #include "TRandom.h"
 
 #include "AliLog.h"
@@ -100,7 +106,10 @@ AliRsnMiniAnalysisTask::AliRsnMiniAnalysisTask() :
    fRejectIfNoQuark(kFALSE),
    fMotherAcceptanceCutMinPt(0.0),
    fMotherAcceptanceCutMaxEta(0.9),
-   fKeepMotherInAcceptance(kFALSE) 
+   fKeepMotherInAcceptance(kFALSE),
+   fMixMaxEventsInMemory(0),
+   fMixBufferFile(""),
+   fEvBufferFile(0x0)
 {
 //
 // Dummy constructor ALWAYS needed for I/O.
@@ -156,7 +165,10 @@ AliRsnMiniAnalysisTask::AliRsnMiniAnalysisTask(const char *name, Bool_t useMC) :
    fRejectIfNoQuark(kFALSE),
    fMotherAcceptanceCutMinPt(0.0),
    fMotherAcceptanceCutMaxEta(0.9),
-   fKeepMotherInAcceptance(kFALSE)
+   fKeepMotherInAcceptance(kFALSE),
+   fMixMaxEventsInMemory(0),
+   fMixBufferFile(""),
+   fEvBufferFile(0x0)
 {
 //
 // Default constructor.
@@ -217,7 +229,10 @@ AliRsnMiniAnalysisTask::AliRsnMiniAnalysisTask(const AliRsnMiniAnalysisTask &cop
    fRejectIfNoQuark(copy.fRejectIfNoQuark),
    fMotherAcceptanceCutMinPt(copy.fMotherAcceptanceCutMinPt),
    fMotherAcceptanceCutMaxEta(copy.fMotherAcceptanceCutMaxEta),
-   fKeepMotherInAcceptance(copy.fKeepMotherInAcceptance)
+   fKeepMotherInAcceptance(copy.fKeepMotherInAcceptance),
+   fMixMaxEventsInMemory(copy.fMixMaxEventsInMemory),
+   fMixBufferFile(copy.fMixBufferFile),
+   fEvBufferFile(0x0)
 {
 //
 // Copy constructor.
@@ -281,6 +296,8 @@ AliRsnMiniAnalysisTask &AliRsnMiniAnalysisTask::operator=(const AliRsnMiniAnalys
    fMotherAcceptanceCutMinPt = copy.fMotherAcceptanceCutMinPt;
    fMotherAcceptanceCutMaxEta = copy.fMotherAcceptanceCutMaxEta;
    fKeepMotherInAcceptance = copy.fKeepMotherInAcceptance;
+   fMixMaxEventsInMemory = copy.fMixMaxEventsInMemory;
+   fMixBufferFile = copy.fMixBufferFile;
    return (*this);
 }
 
@@ -296,7 +313,26 @@ AliRsnMiniAnalysisTask::~AliRsnMiniAnalysisTask()
 
    if (fOutput && !AliAnalysisManager::GetAnalysisManager()->IsProofMode()) {
       delete fOutput;
-      delete fEvBuffer;
+      DeleteEventBuffer();
+   }
+}
+
+//__________________________________________________________________________________________________
+void AliRsnMiniAnalysisTask::DeleteEventBuffer()
+{
+//
+// Delete the mini-event buffer and remove its scratch file, if any.
+// Called once the buffer has been processed in FinishTaskOutput.
+//
+
+   delete fEvBuffer;
+   fEvBuffer = 0x0;
+   if (fEvBufferFile) {
+      TString name = fEvBufferFile->GetName();
+      fEvBufferFile->Close();
+      delete fEvBufferFile;
+      fEvBufferFile = 0x0;
+      gSystem->Unlink(name.Data());
    }
 }
 
@@ -399,9 +435,22 @@ void AliRsnMiniAnalysisTask::UserCreateOutputObjects()
    }
 
    // create temporary tree for filtered events
+   // (in a scratch file if requested, so that large buffers are spilled to disk)
    if (fMiniEvent) delete fMiniEvent;
+   TDirectory *savedDir = gDirectory;
+   if (!fMixBufferFile.IsNull()) {
+      fEvBufferFile = TFile::Open(fMixBufferFile.Data(), "RECREATE");
+      if (!fEvBufferFile || fEvBufferFile->IsZombie()) {
+         AliError(Form("Cannot open mini-event buffer file %s, buffering in memory", fMixBufferFile.Data()));
+         delete fEvBufferFile;
+         fEvBufferFile = 0x0;
+      } else {
+         fEvBufferFile->cd();
+      }
+   }
    fEvBuffer = new TTree("EventBuffer", "Temporary buffer for mini events");
    fEvBuffer->Branch("events", "AliRsnMiniEvent", &fMiniEvent);
+   if (savedDir) savedDir->cd();
 
    // create one histogram per each stored definition (event histograms)
    Int_t i, ndef = fHistograms.GetEntries();
@@ -478,6 +527,9 @@ void AliRsnMiniAnalysisTask::FinishTaskOutput()
 // Here a loop is done on each of these events, and both single-event and mixing are computed
 //
 
+   // the buffer is deleted once processed
+   if (!fEvBuffer) return;
+
    // security code: reassign the buffer to the mini-event cursor
    fEvBuffer->SetBranchAddress("events", &fMiniEvent);
    TStopwatch timer;
@@ -495,6 +547,16 @@ void AliRsnMiniAnalysisTask::FinishTaskOutput()
       else printNum = 0;
    }
 
+   // mixing variables of all events, and the events kept in memory for mixing
+   std::vector<Float_t> mixVz, mixMult, mixAngle;
+   TObjArray mixStore(fNMix > 0 ? nEvents : 0);
+   mixStore.SetOwner();
+   if (fNMix > 0) {
+      mixVz.resize(nEvents);
+      mixMult.resize(nEvents);
+      mixAngle.resize(nEvents);
+   }
+
    // loop on events, and for each one fill all outputs
    // using the appropriate procedure depending on its type
    // only mother-related histograms are filled in UserExec,
@@ -503,6 +565,13 @@ void AliRsnMiniAnalysisTask::FinishTaskOutput()
    for (ievt = 0; ievt < nEvents; ievt++) {
       // get next entry
       fEvBuffer->GetEntry(ievt);
+      if (fNMix > 0) {
+         mixVz[ievt]    = fMiniEvent->Vz();
+         mixMult[ievt]  = fMiniEvent->Mult();
+         mixAngle[ievt] = fMiniEvent->Angle();
+         if (fMixMaxEventsInMemory < 0 || ievt < fMixMaxEventsInMemory)
+            mixStore.AddAt(new AliRsnMiniEvent(*fMiniEvent), ievt);
+      }
       if (printNum&&(ievt%printNum==0)) {
          AliInfo(Form("[%s] Std.Event %d/%d",GetName(), ievt,nEvents));
          timer.Stop(); timer.Print(); fflush(stdout); timer.Start(kFALSE);
@@ -548,18 +617,33 @@ void AliRsnMiniAnalysisTask::FinishTaskOutput()
    // if no mixing is required, stop here and post the output
    if (fNMix < 1) {
       AliDebugClass(2, "Stopping here, since no mixing is required");
+      DeleteEventBuffer();
       PostData(1, fOutput);
       return;
    }
 
-   // initialize mixing counter
-   Int_t    nmatched[nEvents];
-   TString *smatched = new TString[nEvents];
-   for (ievt = 0; ievt < nEvents; ievt++) {
-      smatched[ievt] = "|";
-      nmatched[ievt] = 0;
+   // index the events by their mixing cell: good matchings are searched only
+   // among the events of the same cell (binned mixing) or of the neighbouring
+   // cells (continuous mixing); the candidates are visited in the same order
+   // as in a scan of the whole buffer, so the chosen matchings are the same
+   typedef std::vector<Long64_t> CellKey;
+   std::map<CellKey, std::vector<Int_t> > cells, neighbours;
+   std::vector<CellKey> cellOf(nEvents, CellKey(3));
+   std::vector<Int_t>   allEvents;
+   Bool_t useIndex = kTRUE;
+   for (ievt = 0; ievt < nEvents && useIndex; ievt++) {
+      useIndex = MixingCell(mixVz[ievt], mixMult[ievt], mixAngle[ievt], &cellOf[ievt][0]);
+      cells[cellOf[ievt]].push_back(ievt);
+   }
+   if (!useIndex) {
+      AliWarning("Mixing variables cannot be indexed, scanning the whole buffer");
+      allEvents.resize(nEvents);
+      for (ievt = 0; ievt < nEvents; ievt++) allEvents[ievt] = ievt;
    }
 
+   // initialize mixing counter
+   std::vector<Int_t> nmatched(nEvents, 0);
+   std::vector< std::vector<Int_t> > smatched(nEvents);
 
    AliInfo(Form("[%s] Std.Event %d/%d",GetName(), nEvents,nEvents));
    timer.Stop(); timer.Print(); timer.Start(); fflush(stdout);
@@ -571,64 +655,85 @@ void AliRsnMiniAnalysisTask::FinishTaskOutput()
          timer.Stop(); timer.Print(); timer.Start(kFALSE); fflush(stdout);
       }
       if (nmatched[ievt] >= fNMix) continue;
-      fEvBuffer->GetEntry(ievt);
-      AliRsnMiniEvent evMain(*fMiniEvent);
-      for (iloop = 1; iloop < nEvents; iloop++) {
-         imix = ievt + iloop;
-         if (imix >= nEvents) imix -= nEvents;
+      // candidates, sorted by position in the buffer
+      const std::vector<Int_t> *cand = &allEvents;
+      if (useIndex && !fContinuousMix) {
+         cand = &cells[cellOf[ievt]];
+      } else if (useIndex) {
+         std::vector<Int_t> &near = neighbours[cellOf[ievt]];
+         if (near.empty()) {
+            CellKey key(3);
+            for (Int_t i = 0; i < 27; i++) {
+               key[0] = cellOf[ievt][0] + i % 3 - 1;
+               key[1] = cellOf[ievt][1] + (i / 3) % 3 - 1;
+               key[2] = cellOf[ievt][2] + i / 9 - 1;
+               std::map<CellKey, std::vector<Int_t> >::const_iterator it = cells.find(key);
+               if (it != cells.end()) near.insert(near.end(), it->second.begin(), it->second.end());
+            }
+            std::sort(near.begin(), near.end());
+         }
+         cand = &near;
+      }
+      Int_t nCand = cand->size();
+      Int_t start = std::upper_bound(cand->begin(), cand->end(), ievt) - cand->begin();
+      for (iloop = 0; iloop < nCand; iloop++) {
+         imix = (*cand)[(start + iloop) % nCand];
          if (imix == ievt) continue;
-         // text next entry
-         fEvBuffer->GetEntry(imix);
          // skip if events are not matched
-         if (!EventsMatch(&evMain, fMiniEvent)) continue;
+         if (!ValuesMatch(mixVz[ievt], mixMult[ievt], mixAngle[ievt], mixVz[imix], mixMult[imix], mixAngle[imix])) continue;
          // check that the array of good matches for mixed does not already contain main event
-         if (smatched[imix].Contains(Form("|%d|", ievt))) continue;
+         if (std::find(smatched[imix].begin(), smatched[imix].end(), ievt) != smatched[imix].end()) continue;
          // check that the found good events has not enough matches already
          if (nmatched[imix] >= fNMix) continue;
          // add new mixing candidate
-         smatched[ievt].Append(Form("%d|", imix));
+         smatched[ievt].push_back(imix);
          nmatched[ievt]++;
          nmatched[imix]++;
          if (nmatched[ievt] >= fNMix) break;
       }
-      AliDebugClass(1, Form("Matches for event %5d = %d [%s] (missing are declared above)", evMain.ID(), nmatched[ievt], smatched[ievt].Data()));
+      AliDebugClass(1, Form("Matches for event %5d = %d (missing are declared above)", ievt, nmatched[ievt]));
    }
 
    AliInfo(Form("[%s] EventMixing searching %d/%d",GetName(),nEvents,nEvents));
    timer.Stop(); timer.Print(); fflush(stdout); timer.Start();
 
    // perform mixing
-   TObjArray *list = 0x0;
-   TObjString *os = 0x0;
+   // events kept in memory are used directly, the others are read back from the buffer
+   AliRsnMiniEvent *evMain = 0x0, *evMix = 0x0;
+   AliRsnMiniEvent  evMainCopy;
    for (ievt = 0; ievt < nEvents; ievt++) {
       if (printNum&&(ievt%printNum==0)) {
          AliInfo(Form("[%s] EventMixing %d/%d",GetName(),ievt,nEvents));
          timer.Stop(); timer.Print(); timer.Start(kFALSE); fflush(stdout);
       }
       ifill = 0;
-      fEvBuffer->GetEntry(ievt);
-      AliRsnMiniEvent evMain(*fMiniEvent);
-      list = smatched[ievt].Tokenize("|");
-      TObjArrayIter next(list);
-      while ( (os = (TObjString *)next()) ) {
-         imix = os->GetString().Atoi();
-         fEvBuffer->GetEntry(imix);
+      if (smatched[ievt].empty()) continue;
+      evMain = (AliRsnMiniEvent *)mixStore.At(ievt);
+      if (!evMain) {
+         fEvBuffer->GetEntry(ievt);
+         evMainCopy = *fMiniEvent;
+         evMain = &evMainCopy;
+      }
+      for (iloop = 0; iloop < (Int_t)smatched[ievt].size(); iloop++) {
+         imix = smatched[ievt][iloop];
+         evMix = (AliRsnMiniEvent *)mixStore.At(imix);
+         if (!evMix) {
+            fEvBuffer->GetEntry(imix);
+            evMix = fMiniEvent;
+         }
          for (idef = 0; idef < nDefs; idef++) {
             def = (AliRsnMiniOutput *)fHistograms[idef];
             if (!def) continue;
             if (!def->IsTrackPairMix()) continue;
-            ifill += def->FillPair(&evMain, fMiniEvent, &fValues, kTRUE);
+            ifill += def->FillPair(evMain, evMix, &fValues, kTRUE);
             if (!def->IsSymmetric()) {
                AliDebugClass(2, "Reflecting non symmetric pair");
-               ifill += def->FillPair(fMiniEvent, &evMain, &fValues, kFALSE);
+               ifill += def->FillPair(evMix, evMain, &fValues, kFALSE);
             }
          }
       }
-      delete list;
    }
 
-   delete [] smatched;
-
    AliInfo(Form("[%s] EventMixing %d/%d",GetName(),nEvents,nEvents));
    timer.Stop(); timer.Print(); fflush(stdout);
 
@@ -665,6 +770,10 @@ void AliRsnMiniAnalysisTask::FinishTaskOutput()
    }
    */
 
+   // the buffer is not needed any more: free it before the output is merged
+   mixStore.Delete();
+   DeleteEventBuffer();
+
    // post computed data
    PostData(1, fOutput);
 }
@@ -1422,13 +1531,23 @@ Bool_t AliRsnMiniAnalysisTask::EventsMatch(AliRsnMiniEvent *event1, AliRsnMiniEv
 //
 
    if (!event1 || !event2) return kFALSE;
+   return ValuesMatch(event1->Vz(), event1->Mult(), event1->Angle(), event2->Vz(), event2->Mult(), event2->Angle());
+}
+
+//__________________________________________________________________________________________________
+Bool_t AliRsnMiniAnalysisTask::ValuesMatch(Float_t vz1, Float_t mult1, Float_t angle1, Float_t vz2, Float_t mult2, Float_t angle2) const
+{
+//
+// Check if two events with the given mixing variables are compatible (see EventsMatch).
+//
+
    Int_t ivz1, ivz2, imult1, imult2, iangle1, iangle2;
    Double_t dv, dm, da;
 
    if (fContinuousMix) {
-      dv = TMath::Abs(event1->Vz()    - event2->Vz()   );
-      dm = TMath::Abs(event1->Mult()  - event2->Mult() );
-      da = TMath::Abs(event1->Angle() - event2->Angle());
+      dv = TMath::Abs(vz1    - vz2   );
+      dm = TMath::Abs(mult1  - mult2 );
+      da = TMath::Abs(angle1 - angle2);
       if (dv > fMaxDiffVz) {
          //AliDebugClass(2, Form("Events #%4d and #%4d don't match due to a too large diff in Vz = %f", event1->ID(), event2->ID(), dv));
          return kFALSE;
@@ -1443,12 +1562,12 @@ Bool_t AliRsnMiniAnalysisTask::EventsMatch(AliRsnMiniEvent *event1, AliRsnMiniEv
       }
       return kTRUE;
    } else {
-      ivz1 = (Int_t)(event1->Vz() / fMaxDiffVz);
-      ivz2 = (Int_t)(event2->Vz() / fMaxDiffVz);
-      imult1 = (Int_t)(event1->Mult() / fMaxDiffMult);
-      imult2 = (Int_t)(event2->Mult() / fMaxDiffMult);
-      iangle1 = (Int_t)(event1->Angle() / fMaxDiffAngle);
-      iangle2 = (Int_t)(event2->Angle() / fMaxDiffAngle);
+      ivz1 = (Int_t)(vz1 / fMaxDiffVz);
+      ivz2 = (Int_t)(vz2 / fMaxDiffVz);
+      imult1 = (Int_t)(mult1 / fMaxDiffMult);
+      imult2 = (Int_t)(mult2 / fMaxDiffMult);
+      iangle1 = (Int_t)(angle1 / fMaxDiffAngle);
+      iangle2 = (Int_t)(angle2 / fMaxDiffAngle);
       if (ivz1 != ivz2) return kFALSE;
       if (imult1 != imult2) return kFALSE;
       if (iangle1 != iangle2) return kFALSE;
@@ -1456,6 +1575,33 @@ Bool_t AliRsnMiniAnalysisTask::EventsMatch(AliRsnMiniEvent *event1, AliRsnMiniEv
    }
 }
 
+//__________________________________________________________________________________________________
+Bool_t AliRsnMiniAnalysisTask::MixingCell(Float_t vz, Float_t mult, Float_t angle, Long64_t *cell) const
+{
+//
+// Compute the mixing cell of an event, used to index the buffer for the mixing.
+// For binned mixing, this is the bin used in EventsMatch, so that only events
+// in the same cell can match. For continuous mixing, the cells are (slightly
+// more than) one maximum difference wide, so that matching events are always
+// in neighbouring cells.
+// Returns kFALSE if the variables cannot be indexed.
+//
+
+   Double_t val[3]  = {vz, mult, angle};
+   Double_t diff[3] = {fMaxDiffVz, fMaxDiffMult, fMaxDiffAngle};
+   for (Int_t i = 0; i < 3; i++) {
+      if (!(diff[i] > 0.0)) return kFALSE;
+      Double_t q = val[i] / (fContinuousMix ? diff[i] * (1.0 + 1E-6) : diff[i]);
+      if (!(TMath::Abs(q) < 1E9)) {
+         // binned cells must be the ones of EventsMatch
+         if (!fContinuousMix || TMath::IsNaN(q)) return kFALSE;
+         q = (q > 0.0 ? 1E9 : -1E9);
+      }
+      cell[i] = (fContinuousMix ? (Long64_t)TMath::Floor(q) : (Long64_t)(Int_t)q);
+   }
+   return kTRUE;
+}
+
 //---------------------------------------------------------------------
 Double_t AliRsnMiniAnalysisTask::ApplyCentralityPatchPbPb2011(){
   //This part rejects randomly events such that the centrality gets flat for LHC11h Pb-Pb data
@@ -24,6 +24,7 @@
 #include "AliRsnCutPrimaryVertex.h"
 
 class TList;
+class TFile;
 
 class AliTriggerAnalysis;
 class AliRsnMiniEvent;
@@ -59,6 +60,8 @@ public:
    void                SetMaxDiffAngle(Double_t val)      {fMaxDiffAngle = val;}
    void                SetEventCuts(AliRsnCutSet *cuts)   {fEventCuts    = cuts;}
    void                SetMixPrintRefresh(Int_t n)        {fMixPrintRefresh = n;}
+   void                SetMixMaxEventsInMemory(Int_t n)   {fMixMaxEventsInMemory = n;}
+   void                SetMixBufferFile(const char *name) {fMixBufferFile = name;}
    void                SetCheckDecay(Bool_t checkDecay = kTRUE) {fCheckDecay = checkDecay;}
    void                SetMaxNDaughters(Short_t n)        {fMaxNDaughters = n;}
    void                SetCheckMomentumConservation(Bool_t checkP) {fCheckP = checkP;}
@@ -100,6 +103,9 @@ private:
    void     FillTrueMotherAOD(AliRsnMiniEvent *event);
    void     StoreTrueMother(AliRsnMiniPair *pair, AliRsnMiniEvent *event);
    Bool_t   EventsMatch(AliRsnMiniEvent *event1, AliRsnMiniEvent *event2);
+   Bool_t   ValuesMatch(Float_t vz1, Float_t mult1, Float_t angle1, Float_t vz2, Float_t mult2, Float_t angle2) const;
+   Bool_t   MixingCell(Float_t vz, Float_t mult, Float_t angle, Long64_t *cell) const;
+   void     DeleteEventBuffer();
    AliQnCorrectionsQnVector * GetQnVectorFromList(const TList *list,
                                                         const char *subdetector,
                                                         const char *expectedstep) const;
@@ -155,8 +161,11 @@ private:
    Float_t              fMotherAcceptanceCutMinPt;              // cut value to apply when selecting the mothers inside a defined acceptance
    Float_t              fMotherAcceptanceCutMaxEta;             // cut value to apply when selecting the mothers inside a defined acceptance
    Bool_t               fKeepMotherInAcceptance;                // flag to keep also mothers in acceptance
+   Int_t                fMixMaxEventsInMemory; //  mixing --> max number of mini-events kept in memory for mixing (def=0: read back from the buffer, <0: all)
+   TString              fMixBufferFile;   //  mixing --> if set, file to which the mini-event buffer is spilled
+   TFile               *fEvBufferFile;    //! file holding the mini-event buffer
 
-   ClassDef(AliRsnMiniAnalysisTask, 13);   // AliRsnMiniAnalysisTask
+   ClassDef(AliRsnMiniAnalysisTask, 14);   // AliRsnMiniAnalysisTask
 };
 
 
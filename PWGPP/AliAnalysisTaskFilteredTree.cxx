@@ -110,6 +110,16 @@ ClassImp(AliAnalysisTaskFilteredTree)
   , fTrigger(AliTriggerAnalysis::kMB1) 
   , fAnalysisMode(kTPCAnalysisMode) 
   , fTreeSRedirector(0)
+  , fHighPtStream(0)
+  , fV0Stream(0)
+  , fdEdxStream(0)
+  , fLaserStream(0)
+  , fMCEffStream(0)
+  , fCosmicPairsStream(0)
+  , fCompactOutput(kFALSE)
+  , fHighPtSchema(0)
+  , fV0Schema(0)
+  , fdEdxSchema(0)
   , fCentralityEstimator(0)
   , fLowPtTrackDownscaligF(0)
   , fLowPtV0DownscaligF(0)
@@ -157,6 +167,161 @@ AliAnalysisTaskFilteredTree::~AliAnalysisTaskFilteredTree()
   delete fFilteredTreeAcceptanceCuts;
   delete fFilteredTreeRecAcceptanceCuts;
   delete fEsdTrackCuts;
+  delete fHighPtSchema;
+  delete fV0Schema;
+  delete fdEdxSchema;
+}
+
+//_____________________________________________________________________________
+void AliAnalysisTaskFilteredTree::SetCompactOutput(Bool_t compact, const char *columns, Int_t nBits)
+{
+  //
+  // Write the highPt, V0s and dEdx trees with the compact schema writer:
+  // flat columns with fixed handles instead of the full objects
+  //   columns - column selection applied to the three trees, e.g. "* !*_C*" (see AliFilteredTreeSchema::IsSelected)
+  //   nBits   - mantissa bits kept for all float columns, <0 - full float precision
+  // Finer settings can be done on the schemas returned by GetHighPtSchema(), GetV0Schema(), GetdEdxSchema()
+  //
+  fCompactOutput = compact;
+  if (!compact) return;
+  if (!fHighPtSchema) fHighPtSchema = new AliFilteredTreeSchema("highPt","compact highPt tree");
+  if (!fV0Schema)     fV0Schema     = new AliFilteredTreeSchema("V0s","compact V0s tree");
+  if (!fdEdxSchema)   fdEdxSchema   = new AliFilteredTreeSchema("dEdx","compact dEdx tree");
+  AliFilteredTreeSchema *schemas[3]={fHighPtSchema,fV0Schema,fdEdxSchema};
+  for (Int_t i=0; i<3; i++) {
+    if (columns && columns[0]) schemas[i]->SetSelection(columns);
+    if (nBits>=0) schemas[i]->SetPrecision(nBits,"*");
+  }
+}
+
+//_____________________________________________________________________________
+void AliAnalysisTaskFilteredTree::DefineCompactSchemas()
+{
+  //
+  // Register the columns of the compact trees
+  // The order has to follow the EHighPtColumn, EV0Column and EdEdxColumn handles
+  //
+  typedef AliFilteredTreeSchema S;
+  //
+  // highPt
+  //
+  AliFilteredTreeSchema *hp=fHighPtSchema;
+  hp->AddColumn("downscaleCounter",S::kInt);
+  hp->AddColumn("gid",S::kLong);
+  hp->AddColumn("fileName",S::kString);
+  hp->AddColumn("runNumber",S::kInt);
+  hp->AddColumn("evtTimeStamp",S::kInt);
+  hp->AddColumn("evtNumberInFile",S::kInt);
+  hp->AddColumn("triggerClass",S::kString);
+  hp->AddColumn("Bz");
+  hp->AddVector("vtxESD",3);
+  hp->AddColumn("IRtot",S::kInt);
+  hp->AddColumn("IRint2",S::kInt);
+  hp->AddColumn("mult",S::kInt);
+  hp->AddColumn("ntracks",S::kInt);
+  hp->AddColumn("contTPC",S::kInt);
+  hp->AddColumn("contSPD",S::kInt);
+  hp->AddVector("vertexPosTPC",3);
+  hp->AddVector("vertexPosSPD",3);
+  hp->AddColumn("ntracksTPC",S::kInt);
+  hp->AddColumn("ntracksITS",S::kInt);
+  hp->AddColumn("centralityF");
+  hp->AddTrack("esdTrack");
+  hp->AddVector("tofClInfo",5);
+  hp->AddVector("tofNsigma",AliPID::kSPECIES);
+  hp->AddVector("tpcNsigma",AliPID::kSPECIES);
+  hp->AddVector("tofPID",AliPID::kSPECIES);
+  hp->AddVector("tpcPID",AliPID::kSPECIES);
+  hp->AddParam("extTPCInnerC");
+  hp->AddParam("extInnerParamV");
+  hp->AddParam("extInnerParamC");
+  hp->AddParam("extInnerParam");
+  hp->AddParam("extOuterITS");
+  hp->AddParam("extInnerParamRef");
+  hp->AddColumn("chi2TPCInnerC");
+  hp->AddColumn("chi2InnerC");
+  hp->AddColumn("chi2OuterITS");
+  hp->AddParam("paramITS");
+  hp->AddParam("paramITSC");
+  hp->AddParam("paramComb");
+  hp->AddColumn("indexNearestITS",S::kInt);
+  hp->AddColumn("indexNearestITSC",S::kInt);
+  hp->AddColumn("indexNearestComb",S::kInt);
+  hp->AddColumn("multMCTrueTracks",S::kInt);
+  hp->AddColumn("nrefITS",S::kInt);
+  hp->AddColumn("nrefTPC",S::kInt);
+  hp->AddColumn("nrefTRD",S::kInt);
+  hp->AddColumn("nrefTOF",S::kInt);
+  hp->AddColumn("nrefEMCAL",S::kInt);
+  hp->AddColumn("nrefPHOS",S::kInt);
+  hp->AddParticle("particle");
+  hp->AddParticle("particleMother");
+  hp->AddParticle("particleTPC");
+  hp->AddParticle("particleMotherTPC");
+  hp->AddParticle("particleITS");
+  hp->AddParticle("particleMotherITS");
+  const char *suffix[3]={"","TPC","ITS"};
+  for (Int_t i=0; i<3; i++) {
+    hp->AddColumn(Form("mech%s",suffix[i]),S::kInt);
+    hp->AddColumn(Form("isPrim%s",suffix[i]),S::kInt);
+    hp->AddColumn(Form("isFromStrangess%s",suffix[i]),S::kInt);
+    hp->AddColumn(Form("isFromConversion%s",suffix[i]),S::kInt);
+    hp->AddColumn(Form("isFromMaterial%s",suffix[i]),S::kInt);
+  }
+  if (hp->GetNColumns()!=kHPNColumns) AliFatal(Form("highPt schema: %d columns, %d handles",hp->GetNColumns(),kHPNColumns));
+  //
+  // V0s
+  //
+  AliFilteredTreeSchema *v0=fV0Schema;
+  v0->AddColumn("gid",S::kLong);
+  v0->AddColumn("isDownscaled",S::kInt);
+  v0->AddColumn("triggerClass",S::kString);
+  v0->AddColumn("Bz");
+  v0->AddColumn("fileName",S::kString);
+  v0->AddColumn("runNumber",S::kInt);
+  v0->AddColumn("evtTimeStamp",S::kInt);
+  v0->AddColumn("evtNumberInFile",S::kInt);
+  v0->AddColumn("type",S::kInt);
+  v0->AddColumn("ntracks",S::kInt);
+  v0->AddVector("v0_XYZ",3);
+  v0->AddVector("v0_PxPyPz",3);
+  v0->AddColumn("v0_DcaDaughters");
+  v0->AddColumn("v0_CosPA");
+  v0->AddColumn("v0_Chi2");
+  v0->AddColumn("v0_OnFly",S::kInt);
+  v0->AddColumn("kf_Mass");
+  v0->AddColumn("kf_MassErr");
+  v0->AddColumn("kf_Chi2");
+  v0->AddColumn("kf_NDF",S::kInt);
+  v0->AddVector("kf_XYZ",3);
+  v0->AddVector("kf_PxPyPz",3);
+  v0->AddTrack("track0");
+  v0->AddTrack("track1");
+  v0->AddVector("tofClInfo0",5);
+  v0->AddVector("tofClInfo1",5);
+  v0->AddVector("tofNsigma0",AliPID::kSPECIES);
+  v0->AddVector("tofNsigma1",AliPID::kSPECIES);
+  v0->AddVector("tpcNsigma0",AliPID::kSPECIES);
+  v0->AddVector("tpcNsigma1",AliPID::kSPECIES);
+  v0->AddColumn("centralityF");
+  if (v0->GetNColumns()!=kV0NColumns) AliFatal(Form("V0s schema: %d columns, %d handles",v0->GetNColumns(),kV0NColumns));
+  //
+  // dEdx
+  //
+  AliFilteredTreeSchema *de=fdEdxSchema;
+  de->AddColumn("gid",S::kLong);
+  de->AddColumn("fileName",S::kString);
+  de->AddColumn("runNumber",S::kInt);
+  de->AddColumn("evtTimeStamp",S::kInt);
+  de->AddColumn("evtNumberInFile",S::kInt);
+  de->AddColumn("triggerClass",S::kString);
+  de->AddColumn("Bz");
+  de->AddVector("vtxESD",3);
+  de->AddColumn("mult",S::kInt);
+  de->AddTrack("esdTrack");
+  de->AddVector("tofNsigma",AliPID::kSPECIES);
+  de->AddVector("tpcNsigma",AliPID::kSPECIES);
+  if (de->GetNColumns()!=kDENColumns) AliFatal(Form("dEdx schema: %d columns, %d handles",de->GetNColumns(),kDENColumns));
 }
 
 //____________________________________________________________________________
@@ -199,13 +364,27 @@ void AliAnalysisTaskFilteredTree::UserCreateOutputObjects()
   fTreeSRedirector = new TTreeSRedirector();
 
   //
-  // Create trees
-  fV0Tree = ((*fTreeSRedirector)<<"V0s").GetTree();
-  fHighPtTree = ((*fTreeSRedirector)<<"highPt").GetTree();
-  fdEdxTree = ((*fTreeSRedirector)<<"dEdx").GetTree();
-  fLaserTree = ((*fTreeSRedirector)<<"Laser").GetTree();
-  fMCEffTree = ((*fTreeSRedirector)<<"MCEffTree").GetTree();
-  fCosmicPairsTree = ((*fTreeSRedirector)<<"CosmicPairs").GetTree();
+  // Create trees - the stream handles are kept to avoid the lookup by name at each fill
+  if (fCompactOutput) {
+    DefineCompactSchemas();
+    fV0Tree = fV0Schema->MakeTree();
+    fHighPtTree = fHighPtSchema->MakeTree();
+    fdEdxTree = fdEdxSchema->MakeTree();
+  }
+  else {
+    fV0Stream = &((*fTreeSRedirector)<<"V0s");
+    fHighPtStream = &((*fTreeSRedirector)<<"highPt");
+    fdEdxStream = &((*fTreeSRedirector)<<"dEdx");
+    fV0Tree = fV0Stream->GetTree();
+    fHighPtTree = fHighPtStream->GetTree();
+    fdEdxTree = fdEdxStream->GetTree();
+  }
+  fLaserStream = &((*fTreeSRedirector)<<"Laser");
+  fMCEffStream = &((*fTreeSRedirector)<<"MCEffTree");
+  fCosmicPairsStream = &((*fTreeSRedirector)<<"CosmicPairs");
+  fLaserTree = fLaserStream->GetTree();
+  fMCEffTree = fMCEffStream->GetTree();
+  fCosmicPairsTree = fCosmicPairsStream->GetTree();
 
   if (!fDummyTrack)  {
     fDummyTrack=new AliESDtrack();
@@ -489,8 +668,8 @@ void AliAnalysisTaskFilteredTree::ProcessCosmics(AliESDEvent *const event, AliES
 	}
       }
       if (fFriendDownscaling<=0){
-	if (((*fTreeSRedirector)<<"CosmicPairs").GetTree()){
-	  TTree * tree = ((*fTreeSRedirector)<<"CosmicPairs").GetTree();
+	if (fCosmicPairsStream){
+	  TTree * tree = fCosmicPairsStream->GetTree();
 	  if (tree){
 	    Double_t sizeAll=tree->GetZipBytes();
 	    TBranch * br= tree->GetBranch("friendTrack0.fPoints");
@@ -506,7 +685,7 @@ void AliAnalysisTaskFilteredTree::ProcessCosmics(AliESDEvent *const event, AliES
       }
       if(!fFillTree) return;
       if(!fTreeSRedirector) return;
-      (*fTreeSRedirector)<<"CosmicPairs"<<
+      (*fCosmicPairsStream)<<
         "gid="<<gid<<                         // global id of track
         "fileName.="<<&fCurrentFileName<<     // file name
         "runNumber="<<runNumber<<             // run number	    
@@ -673,7 +852,11 @@ void AliAnalysisTaskFilteredTree::Process(AliESDEvent *const esdEvent, AliMCEven
     ULong64_t bunchCrossID = (ULong64_t)esdEvent->GetBunchCrossNumber();
     ULong64_t periodID     = (ULong64_t)esdEvent->GetPeriodNumber();
     ULong64_t gid          = ((periodID << 36) | (orbitID << 12) | bunchCrossID); 
-    
+    if (fCompactOutput) {
+      // string columns are not cleared by Reset(), set them once per event
+      fHighPtSchema->SetS(kHPfileName,fCurrentFileName.GetName());
+      fHighPtSchema->SetS(kHPtriggerClass,esdEvent->GetFiredTriggerClasses().Data());
+    }
 
     // high pT tracks
     for (Int_t iTrack = 0; iTrack < esdEvent->GetNumberOfTracks(); iTrack++)
@@ -703,11 +886,34 @@ void AliAnalysisTaskFilteredTree::Process(AliESDEvent *const esdEvent, AliMCEven
       // vertex
       // TPC-ITS tracks
       //
-      TObjString triggerClass = esdEvent->GetFiredTriggerClasses().Data();
       if(!fFillTree) return;
       if(!fTreeSRedirector) return;
       downscaleCounter++;
-      (*fTreeSRedirector)<<"highPt"<<
+      if (fCompactOutput) {
+        AliFilteredTreeSchema *hp=fHighPtSchema;
+        hp->Reset();
+        hp->SetI(kHPdownscaleCounter,downscaleCounter);
+        hp->SetL(kHPgid,gid);
+        hp->SetI(kHPrunNumber,runNumber);
+        hp->SetI(kHPevtTimeStamp,evtTimeStamp);
+        hp->SetI(kHPevtNumberInFile,evtNumberInFile);
+        hp->SetF(kHPBz,bz);
+        hp->SetF(kHPvtxESD,vtxESD->GetX());
+        hp->SetF(kHPvtxESD+1,vtxESD->GetY());
+        hp->SetF(kHPvtxESD+2,vtxESD->GetZ());
+        hp->SetI(kHPIRtot,ir1);
+        hp->SetI(kHPIRint2,ir2);
+        hp->SetI(kHPmult,mult);
+        hp->SetI(kHPntracks,ntracks);
+        hp->SetI(kHPcontTPC,multTPC);
+        hp->SetI(kHPcontSPD,multSPD);
+        hp->SetTrack(kHPesdTrack,track);
+        hp->SetF(kHPcentralityF,centralityF);
+        hp->Fill();
+        continue;
+      }
+      TObjString triggerClass = esdEvent->GetFiredTriggerClasses().Data();
+      (*fHighPtStream)<<
         "gid="<<gid<<
         "fileName.="<<&fCurrentFileName<<            
         "runNumber="<<runNumber<<
@@ -764,7 +970,7 @@ void AliAnalysisTaskFilteredTree::ProcessLaser(AliESDEvent *const esdEvent, AliM
       Bool_t skipTrack=gRandom->Rndm()>1/(1+TMath::Abs(fFriendDownscaling));
       if (skipTrack) continue;
       if (esdFriend) {if (!esdFriend->TestSkipBit()) friendTrack = esdFriend->GetTrack(iTrack);} //this guy can be NULL      
-      (*fTreeSRedirector)<<"Laser"<<
+      (*fLaserStream)<<
         "gid="<<gid<<                          // global identifier of event
         "fileName.="<<&fCurrentFileName<<              //
         "runNumber="<<runNumber<<
@@ -968,6 +1174,11 @@ void AliAnalysisTaskFilteredTree::ProcessAll(AliESDEvent *const esdEvent, AliMCE
     vert[2] = vtxESD->GetZ();
     Int_t mult = vtxESD->GetNContributors();
     Int_t numberOfTracks=esdEvent->GetNumberOfTracks();
+    if (fCompactOutput) {
+      // string columns are not cleared by Reset(), set them once per event
+      fHighPtSchema->SetS(kHPfileName,fCurrentFileName.GetName());
+      fHighPtSchema->SetS(kHPtriggerClass,esdEvent->GetFiredTriggerClasses().Data());
+    }
     // high pT tracks
     for (Int_t iTrack = 0; iTrack < numberOfTracks; iTrack++)
     {
@@ -1374,8 +1585,8 @@ void AliAnalysisTaskFilteredTree::ProcessAll(AliESDEvent *const esdEvent, AliMCE
 	  friendTrackStore = (gRandom->Rndm()<1./fFriendDownscaling)? friendTrack:0;
 	}
 	if (fFriendDownscaling<=0){
-	  if (((*fTreeSRedirector)<<"highPt").GetTree()){
-	    TTree * tree = ((*fTreeSRedirector)<<"highPt").GetTree();
+	  if (fHighPtStream){
+	    TTree * tree = fHighPtStream->GetTree();
 	    if (tree){
 	      Double_t sizeAll=tree->GetZipBytes();
 	      TBranch * br= tree->GetBranch("friendTrack.fPoints");
@@ -1428,9 +1639,73 @@ void AliAnalysisTaskFilteredTree::ProcessAll(AliESDEvent *const esdEvent, AliMCE
 	  pidResponse->ComputePIDProbability(AliPIDResponse::kTPC, track, nSpecies, tpcPID.GetMatrixArray());
 	  pidResponse->ComputePIDProbability(AliPIDResponse::kTOF, track, nSpecies, tofPID.GetMatrixArray());	    
 	}
-        if(fTreeSRedirector && dumpToTree && fFillTree) {
+        if(fTreeSRedirector && dumpToTree && fFillTree && fCompactOutput) {
+	  downscaleCounter++;
+          AliFilteredTreeSchema *hp=fHighPtSchema;
+          hp->SetI(kHPdownscaleCounter,downscaleCounter);
+          hp->SetL(kHPgid,gid);
+          hp->SetI(kHPrunNumber,runNumber);
+          hp->SetI(kHPevtTimeStamp,evtTimeStamp);
+          hp->SetI(kHPevtNumberInFile,evtNumberInFile);
+          hp->SetF(kHPBz,bz);
+          hp->SetVector(kHPvtxESD,vert,3);
+          hp->SetI(kHPIRtot,ir1);
+          hp->SetI(kHPIRint2,ir2);
+          hp->SetI(kHPmult,mult);
+          hp->SetI(kHPntracks,ntracks);
+          hp->SetI(kHPcontTPC,contTPC);
+          hp->SetI(kHPcontSPD,contSPD);
+          hp->SetVector(kHPvertexPosTPC,vertexPosTPC.GetMatrixArray(),3);
+          hp->SetVector(kHPvertexPosSPD,vertexPosSPD.GetMatrixArray(),3);
+          hp->SetI(kHPntracksTPC,ntracksTPC);
+          hp->SetI(kHPntracksITS,ntracksITS);
+          hp->SetF(kHPcentralityF,centralityF);
+          hp->SetTrack(kHPesdTrack,track);
+          hp->SetVector(kHPtofClInfo,tofClInfo.GetMatrixArray(),5);
+          hp->SetVector(kHPtofNsigma,tofNsigma.GetMatrixArray(),nSpecies);
+          hp->SetVector(kHPtpcNsigma,tpcNsigma.GetMatrixArray(),nSpecies);
+          hp->SetVector(kHPtofPID,tofPID.GetMatrixArray(),nSpecies);
+          hp->SetVector(kHPtpcPID,tpcPID.GetMatrixArray(),nSpecies);
+          hp->SetParam(kHPextTPCInnerC,tpcInnerC);
+          hp->SetParam(kHPextInnerParamV,trackInnerV);
+          hp->SetParam(kHPextInnerParamC,trackInnerC);
+          hp->SetParam(kHPextInnerParam,trackInnerC2);
+          hp->SetParam(kHPextOuterITS,outerITSc);
+          hp->SetParam(kHPextInnerParamRef,trackInnerC3);
+          hp->SetF(kHPchi2TPCInnerC,chi2(0,0));
+          hp->SetF(kHPchi2InnerC,chi2trackC(0,0));
+          hp->SetF(kHPchi2OuterITS,chi2OuterITS(0,0));
+          hp->SetParam(kHPparamITS,&paramITS);
+          hp->SetParam(kHPparamITSC,&paramITSC);
+          hp->SetParam(kHPparamComb,&paramComb);
+          hp->SetI(kHPindexNearestITS,indexNearestITS);
+          hp->SetI(kHPindexNearestITSC,indexNearestITSC);
+          hp->SetI(kHPindexNearestComb,indexNearestComb);
+          if (mcEvent){
+            downscaleCounter++;
+            hp->SetI(kHPmultMCTrueTracks,multMCTrueTracks);
+            hp->SetI(kHPnrefITS,nrefITS);
+            hp->SetI(kHPnrefTPC,nrefTPC);
+            hp->SetI(kHPnrefTRD,nrefTRD);
+            hp->SetI(kHPnrefTOF,nrefTOF);
+            hp->SetI(kHPnrefEMCAL,nrefEMCAL);
+            hp->SetI(kHPnrefPHOS,nrefPHOS);
+            hp->SetParticle(kHPparticle,particle);
+            hp->SetParticle(kHPparticleMother,particleMother);
+            hp->SetParticle(kHPparticleTPC,particleTPC);
+            hp->SetParticle(kHPparticleMotherTPC,particleMotherTPC);
+            hp->SetParticle(kHPparticleITS,particleITS);
+            hp->SetParticle(kHPparticleMotherITS,particleMotherITS);
+            Int_t mcInfo[3][5]={{mech,isPrim,isFromStrangess,isFromConversion,isFromMaterial},
+                                {mechTPC,isPrimTPC,isFromStrangessTPC,isFromConversionTPC,isFromMaterialTPC},
+                                {mechITS,isPrimITS,isFromStrangessITS,isFromConversionITS,isFromMaterialITS}};
+            for (Int_t i=0; i<3; i++) for (Int_t j=0; j<5; j++) hp->SetI(kHPmech+5*i+j,mcInfo[i][j]);
+          }
+          hp->Fill();
+        }
+        else if(fTreeSRedirector && dumpToTree && fFillTree) {
 	  downscaleCounter++;
-          (*fTreeSRedirector)<<"highPt"<<
+          (*fHighPtStream)<<
 	    "downscaleCounter="<<downscaleCounter<<   
             "gid="<<gid<<
             "fileName.="<<&fCurrentFileName<<                // name of the chunk file (hopefully full)
@@ -1473,7 +1748,7 @@ void AliAnalysisTaskFilteredTree::ProcessAll(AliESDEvent *const esdEvent, AliMCE
             "centralityF="<<centralityF;
 	  // info for 2 track resolution studies and matching efficency studies 
 	  //
-	  (*fTreeSRedirector)<<"highPt"<<
+	  (*fHighPtStream)<<
 	    "paramITS.="<<&paramITS<<                // nearest ITS track  -   chi2 distance at vertex
 	    "paramITSC.="<<&paramITSC<<              // nearest ITS track  -  to constrained track   chi2 distance at vertex
 	    "paramComb.="<<&paramComb<<              // nearest comb. tack -   chi2 distance at inner wall
@@ -1489,7 +1764,7 @@ void AliAnalysisTaskFilteredTree::ProcessAll(AliESDEvent *const esdEvent, AliMCE
             if (!refEMCAL) refEMCAL = &refDummy;
             if (!refPHOS) refPHOS = &refDummy;
 	    downscaleCounter++;
-            (*fTreeSRedirector)<<"highPt"<<	
+            (*fHighPtStream)<<	
               "multMCTrueTracks="<<multMCTrueTracks<<   // mC track multiplicities
               "nrefITS="<<nrefITS<<              // number of track references in the ITS
               "nrefTPC="<<nrefTPC<<              // number of track references in the TPC
@@ -1528,7 +1803,7 @@ void AliAnalysisTaskFilteredTree::ProcessAll(AliESDEvent *const esdEvent, AliMCE
           }
           //finish writing the entry
           AliInfo("writing tree highPt");
-          (*fTreeSRedirector)<<"highPt"<<"\n";
+          (*fHighPtStream)<<"\n";
         }
         AliSysInfo::AddStamp("filteringTask",iTrack,numberOfTracks,numberOfFriendTracks,(friendTrackStore)?0:1);
         delete tpcInnerC;
@@ -1781,7 +2056,7 @@ void AliAnalysisTaskFilteredTree::ProcessMCEff(AliESDEvent *const esdEvent, AliM
       //
       if(fTreeSRedirector && fFillTree) {
 	downscaleCounter++;
-        (*fTreeSRedirector)<<"MCEffTree"<<
+        (*fMCEffStream)<<
           "fileName.="<<&fCurrentFileName<<
           "triggerClass.="<<&triggerClass<<
           "runNumber="<<runNumber<<
@@ -1950,7 +2225,11 @@ void AliAnalysisTaskFilteredTree::ProcessV0(AliESDEvent *const esdEvent, AliMCEv
     // 
     Int_t ntracks = esdEvent->GetNumberOfTracks();
     Int_t evNr=esdEvent->GetEventNumberInFile();
-
+    if (fCompactOutput) {
+      // string columns are not cleared by Reset(), set them once per event
+      fV0Schema->SetS(kV0triggerClass,esdEvent->GetFiredTriggerClasses().Data());
+      fV0Schema->SetS(kV0fileName,fCurrentFileName.GetName());
+    }
 
     for (Int_t iv0=0; iv0<nV0s; iv0++){
  
@@ -1988,8 +2267,8 @@ void AliAnalysisTaskFilteredTree::ProcessV0(AliESDEvent *const esdEvent, AliMCEv
 	}
       }
       if (fFriendDownscaling<=0){
-	if (((*fTreeSRedirector)<<"V0s").GetTree()){
-	  TTree * tree = ((*fTreeSRedirector)<<"V0s").GetTree();
+	if (fV0Stream){
+	  TTree * tree = fV0Stream->GetTree();
 	  if (tree){
 	    Double_t sizeAll=tree->GetZipBytes();
 	    TBranch * br= tree->GetBranch("friendTrack0.fPoints");
@@ -2045,7 +2324,50 @@ void AliAnalysisTaskFilteredTree::ProcessV0(AliESDEvent *const esdEvent, AliMCEv
       }
 
       downscaleCounter++;
-      (*fTreeSRedirector)<<"V0s"<<
+      if (fCompactOutput) {
+        AliFilteredTreeSchema *sv0=fV0Schema;
+        Double_t xyz[3], pxpypz[3];
+        Float_t kfMass=0, kfMassErr=0;
+        kfparticle.GetMass(kfMass,kfMassErr);
+        sv0->SetL(kV0gid,gid);
+        sv0->SetI(kV0isDownscaled,isDownscaled);
+        sv0->SetF(kV0Bz,bz);
+        sv0->SetI(kV0runNumber,run);
+        sv0->SetI(kV0evtTimeStamp,time);
+        sv0->SetI(kV0evtNumberInFile,evNr);
+        sv0->SetI(kV0type,type);
+        sv0->SetI(kV0ntracks,ntracks);
+        v0->GetXYZ(xyz[0],xyz[1],xyz[2]);
+        v0->GetPxPyPz(pxpypz[0],pxpypz[1],pxpypz[2]);
+        sv0->SetVector(kV0v0XYZ,xyz,3);
+        sv0->SetVector(kV0v0PxPyPz,pxpypz,3);
+        sv0->SetF(kV0v0DcaDaughters,v0->GetDcaV0Daughters());
+        sv0->SetF(kV0v0CosPA,v0->GetV0CosineOfPointingAngle());
+        sv0->SetF(kV0v0Chi2,v0->GetChi2V0());
+        sv0->SetI(kV0v0OnFly,v0->GetOnFlyStatus());
+        sv0->SetF(kV0kfMass,kfMass);
+        sv0->SetF(kV0kfMassErr,kfMassErr);
+        sv0->SetF(kV0kfChi2,kfparticle.GetChi2());
+        sv0->SetI(kV0kfNDF,kfparticle.GetNDF());
+        sv0->SetF(kV0kfXYZ,kfparticle.GetX());
+        sv0->SetF(kV0kfXYZ+1,kfparticle.GetY());
+        sv0->SetF(kV0kfXYZ+2,kfparticle.GetZ());
+        sv0->SetF(kV0kfPxPyPz,kfparticle.GetPx());
+        sv0->SetF(kV0kfPxPyPz+1,kfparticle.GetPy());
+        sv0->SetF(kV0kfPxPyPz+2,kfparticle.GetPz());
+        sv0->SetTrack(kV0track0,track0);
+        sv0->SetTrack(kV0track1,track1);
+        sv0->SetVector(kV0tofClInfo0,tofClInfo0.GetMatrixArray(),5);
+        sv0->SetVector(kV0tofClInfo1,tofClInfo1.GetMatrixArray(),5);
+        sv0->SetVector(kV0tofNsigma0,tofNsigma0.GetMatrixArray(),nSpecies);
+        sv0->SetVector(kV0tofNsigma1,tofNsigma1.GetMatrixArray(),nSpecies);
+        sv0->SetVector(kV0tpcNsigma0,tpcNsigma0.GetMatrixArray(),nSpecies);
+        sv0->SetVector(kV0tpcNsigma1,tpcNsigma1.GetMatrixArray(),nSpecies);
+        sv0->SetF(kV0centralityF,centralityF);
+        sv0->Fill();
+        continue;
+      }
+      (*fV0Stream)<<
         "gid="<<gid<<                         //  global id of event
         "isDownscaled="<<isDownscaled<<       //  
         "triggerClass="<<&triggerClass<<      //  trigger
@@ -2158,6 +2480,11 @@ void AliAnalysisTaskFilteredTree::ProcessdEdx(AliESDEvent *const esdEvent, AliMC
     ULong64_t bunchCrossID = (ULong64_t)esdEvent->GetBunchCrossNumber();
     ULong64_t periodID     = (ULong64_t)esdEvent->GetPeriodNumber();
     ULong64_t gid          = ((periodID << 36) | (orbitID << 12) | bunchCrossID); 
+    if (fCompactOutput) {
+      // string columns are not cleared by Reset(), set them once per event
+      fdEdxSchema->SetS(kDEfileName,fCurrentFileName.GetName());
+      fdEdxSchema->SetS(kDEtriggerClass,esdEvent->GetFiredTriggerClasses().Data());
+    }
     
     // large dEdx
     for (Int_t iTrack = 0; iTrack < esdEvent->GetNumberOfTracks(); iTrack++)
@@ -2196,7 +2523,22 @@ void AliAnalysisTaskFilteredTree::ProcessdEdx(AliESDEvent *const esdEvent, AliMC
       }
 	
       downscaleCounter++;
-      (*fTreeSRedirector)<<"dEdx"<<           // high dEdx tree
+      if (fCompactOutput) {
+        AliFilteredTreeSchema *de=fdEdxSchema;
+        de->SetL(kDEgid,gid);
+        de->SetI(kDErunNumber,Int_t(runNumber));
+        de->SetI(kDEevtTimeStamp,Int_t(evtTimeStamp));
+        de->SetI(kDEevtNumberInFile,evtNumberInFile);
+        de->SetF(kDEBz,bz);
+        de->SetVector(kDEvtxESD,vert,3);
+        de->SetI(kDEmult,mult);
+        de->SetTrack(kDEesdTrack,track);
+        de->SetVector(kDEtofNsigma,tofNsigma.GetMatrixArray(),nSpecies);
+        de->SetVector(kDEtpcNsigma,tpcNsigma.GetMatrixArray(),nSpecies);
+        de->Fill();
+        continue;
+      }
+      (*fdEdxStream)<<           // high dEdx tree
         "gid="<<gid<<                         // global id
         "fileName.="<<&fCurrentFileName<<     // file name
         "runNumber="<<runNumber<<
@@ -2564,6 +2906,14 @@ void AliAnalysisTaskFilteredTree::FinishTaskOutput()
   }
   if (deleteTrees) delete fTreeSRedirector;
   fTreeSRedirector=NULL;
+  fHighPtStream=fV0Stream=fdEdxStream=NULL;
+  fLaserStream=fMCEffStream=fCosmicPairsStream=NULL;
+  // the compact trees are posted in the output containers and written by the manager
+  if (fCompactOutput) {
+    fHighPtSchema->ReleaseTree();
+    fV0Schema->ReleaseTree();
+    fdEdxSchema->ReleaseTree();
+  }
 }
 
 //_____________________________________________________________________________
@@ -28,11 +28,13 @@ class TList;
 class TObjArray;
 class TTree;
 class TTreeSRedirector;
+class TTreeStream;
 class TParticle;
 class TH3D;
 
 #include "AliTriggerAnalysis.h"
 #include "AliAnalysisTaskSE.h"
+#include "AliFilteredTreeSchema.h"
 
 class AliAnalysisTaskFilteredTree : public AliAnalysisTaskSE {
  public:
@@ -117,7 +119,55 @@ class AliAnalysisTaskFilteredTree : public AliAnalysisTaskSE {
   Int_t   GetNearestTrack(const AliExternalTrackParam * trackMatch, Int_t indexSkip, AliESDEvent*event, Int_t trackType, Int_t paramType,  AliExternalTrackParam & paramNearest);
   static void SetDefaultAliasesV0(TTree *treeV0);
   static void SetDefaultAliasesHighPt(TTree *treeV0);
+
+  // compact output of the highPt, V0s and dEdx trees - flat columns, see AliFilteredTreeSchema
+  void SetCompactOutput(Bool_t compact=kTRUE, const char *columns="", Int_t nBits=-1);
+  Bool_t IsCompactOutput() const                   { return fCompactOutput; }
+  AliFilteredTreeSchema* GetHighPtSchema() const   { return fHighPtSchema; }
+  AliFilteredTreeSchema* GetV0Schema() const       { return fV0Schema; }
+  AliFilteredTreeSchema* GetdEdxSchema() const     { return fdEdxSchema; }
  private:
+  // column handles of the compact trees, in registration order (see DefineCompactSchemas)
+  enum { kNPar=AliFilteredTreeSchema::kNParamColumns,
+         kNTrk=AliFilteredTreeSchema::kNTrackColumns,
+         kNPart=AliFilteredTreeSchema::kNParticleColumns };
+  enum EHighPtColumn {
+    kHPdownscaleCounter=0, kHPgid, kHPfileName, kHPrunNumber, kHPevtTimeStamp, kHPevtNumberInFile,
+    kHPtriggerClass, kHPBz, kHPvtxESD, kHPIRtot=kHPvtxESD+3, kHPIRint2, kHPmult, kHPntracks,
+    kHPcontTPC, kHPcontSPD, kHPvertexPosTPC, kHPvertexPosSPD=kHPvertexPosTPC+3,
+    kHPntracksTPC=kHPvertexPosSPD+3, kHPntracksITS, kHPcentralityF,
+    kHPesdTrack, kHPtofClInfo=kHPesdTrack+kNTrk,
+    kHPtofNsigma=kHPtofClInfo+5, kHPtpcNsigma=kHPtofNsigma+5, kHPtofPID=kHPtpcNsigma+5, kHPtpcPID=kHPtofPID+5,
+    kHPextTPCInnerC=kHPtpcPID+5, kHPextInnerParamV=kHPextTPCInnerC+kNPar, kHPextInnerParamC=kHPextInnerParamV+kNPar,
+    kHPextInnerParam=kHPextInnerParamC+kNPar, kHPextOuterITS=kHPextInnerParam+kNPar,
+    kHPextInnerParamRef=kHPextOuterITS+kNPar,
+    kHPchi2TPCInnerC=kHPextInnerParamRef+kNPar, kHPchi2InnerC, kHPchi2OuterITS,
+    kHPparamITS, kHPparamITSC=kHPparamITS+kNPar, kHPparamComb=kHPparamITSC+kNPar,
+    kHPindexNearestITS=kHPparamComb+kNPar, kHPindexNearestITSC, kHPindexNearestComb,
+    kHPmultMCTrueTracks, kHPnrefITS, kHPnrefTPC, kHPnrefTRD, kHPnrefTOF, kHPnrefEMCAL, kHPnrefPHOS,
+    kHPparticle, kHPparticleMother=kHPparticle+kNPart, kHPparticleTPC=kHPparticleMother+kNPart,
+    kHPparticleMotherTPC=kHPparticleTPC+kNPart, kHPparticleITS=kHPparticleMotherTPC+kNPart,
+    kHPparticleMotherITS=kHPparticleITS+kNPart,
+    kHPmech=kHPparticleMotherITS+kNPart, kHPisPrim, kHPisFromStrangess, kHPisFromConversion, kHPisFromMaterial,
+    kHPmechTPC, kHPisPrimTPC, kHPisFromStrangessTPC, kHPisFromConversionTPC, kHPisFromMaterialTPC,
+    kHPmechITS, kHPisPrimITS, kHPisFromStrangessITS, kHPisFromConversionITS, kHPisFromMaterialITS,
+    kHPNColumns };
+  enum EV0Column {
+    kV0gid=0, kV0isDownscaled, kV0triggerClass, kV0Bz, kV0fileName, kV0runNumber, kV0evtTimeStamp,
+    kV0evtNumberInFile, kV0type, kV0ntracks,
+    kV0v0XYZ, kV0v0PxPyPz=kV0v0XYZ+3, kV0v0DcaDaughters=kV0v0PxPyPz+3, kV0v0CosPA, kV0v0Chi2, kV0v0OnFly,
+    kV0kfMass, kV0kfMassErr, kV0kfChi2, kV0kfNDF, kV0kfXYZ, kV0kfPxPyPz=kV0kfXYZ+3,
+    kV0track0=kV0kfPxPyPz+3, kV0track1=kV0track0+kNTrk,
+    kV0tofClInfo0=kV0track1+kNTrk, kV0tofClInfo1=kV0tofClInfo0+5, kV0tofNsigma0=kV0tofClInfo1+5,
+    kV0tofNsigma1=kV0tofNsigma0+5, kV0tpcNsigma0=kV0tofNsigma1+5, kV0tpcNsigma1=kV0tpcNsigma0+5,
+    kV0centralityF=kV0tpcNsigma1+5,
+    kV0NColumns };
+  enum EdEdxColumn {
+    kDEgid=0, kDEfileName, kDErunNumber, kDEevtTimeStamp, kDEevtNumberInFile, kDEtriggerClass, kDEBz,
+    kDEvtxESD, kDEmult=kDEvtxESD+3, kDEesdTrack, kDEtofNsigma=kDEesdTrack+kNTrk, kDEtpcNsigma=kDEtofNsigma+5,
+    kDENColumns=kDEtpcNsigma+5 };
+
+  void DefineCompactSchemas();
 
   AliESDEvent *fESD;    //! ESD event
   AliMCEvent *fMC;      //! MC event
@@ -138,6 +188,17 @@ class AliAnalysisTaskFilteredTree : public AliAnalysisTaskSE {
   EAnalysisMode fAnalysisMode;   // analysis mode TPC only, TPC + ITS
 
   TTreeSRedirector* fTreeSRedirector;      //! temp tree to dump output
+  TTreeStream* fHighPtStream;       //! fixed handles to the redirector trees
+  TTreeStream* fV0Stream;           //!
+  TTreeStream* fdEdxStream;         //!
+  TTreeStream* fLaserStream;        //!
+  TTreeStream* fMCEffStream;        //!
+  TTreeStream* fCosmicPairsStream;  //!
+
+  Bool_t fCompactOutput;                   // write highPt, V0s and dEdx as flat columns
+  AliFilteredTreeSchema* fHighPtSchema;    // compact highPt tree
+  AliFilteredTreeSchema* fV0Schema;        // compact V0s tree
+  AliFilteredTreeSchema* fdEdxSchema;      // compact dEdx tree
 
   TString fCentralityEstimator;     // use centrality can be "VOM" (default), "FMD", "TRK", "TKL", "CL0", "CL1", "V0MvsFMD", "TKLvsV0M", "ZEMvsZDC"
 
@@ -172,7 +233,7 @@ class AliAnalysisTaskFilteredTree : public AliAnalysisTaskSE {
 
   AliAnalysisTaskFilteredTree(const AliAnalysisTaskFilteredTree&); // not implemented
   AliAnalysisTaskFilteredTree& operator=(const AliAnalysisTaskFilteredTree&); // not implemented
-  ClassDef(AliAnalysisTaskFilteredTree, 1); // example of analysis
+  ClassDef(AliAnalysisTaskFilteredTree, 2); // example of analysis
 };
 
 #endif
@@ -0,0 +1,442 @@
+/**************************************************************************
+ * Copyright(c) 1998-1999, ALICE Experiment at CERN, All rights reserved. *
+ *                                                                        *
+ * Author: The ALICE Off-line Project.                                    *
+ * Contributors are mentioned in the code where appropriate.              *
+ *                                                                        *
+ * Permission to use, copy, modify and distribute this software and its   *
+ * documentation strictly for non-commercial purposes is hereby granted   *
+ * without fee, provided that the above copyright notice appears in all   *
+ * copies and that both the copyright notice and this permission notice   *
+ * appear in the supporting documentation. The authors make no claims     *
+ * about the suitability of this software for any purpose. It is          *
+ * provided "as is" without express or implied warranty.                  *
+ **************************************************************************/
+
+/*
+  Compact column writer for the filtered trees (see AliAnalysisTaskFilteredTree::SetCompactOutput)
+  Usage:
+    AliFilteredTreeSchema schema("highPt","compact highPt");
+    Int_t hRun   = schema.AddColumn("runNumber",AliFilteredTreeSchema::kInt);
+    Int_t hFile  = schema.AddColumn("fileName",AliFilteredTreeSchema::kString);
+    Int_t hTrack = schema.AddTrack("esdTrack");
+    schema.SetSelection("runNumber esdTrack_*");
+    schema.SetPrecision(12,"esdTrack_C*");
+    schema.MakeTree();
+    // per event
+    schema.SetS(hFile,fileName);
+    // per entry
+    schema.SetI(hRun,run);
+    schema.SetTrack(hTrack,track);
+    schema.Fill();
+    // at the end
+    schema.GetTree()->Write();    // unless the tree is an output container
+    schema.ReleaseTree();
+*/
+
+#include <string.h>
+
+#include "TTree.h"
+#include "TBranch.h"
+#include "TObjString.h"
+#include "TRegexp.h"
+#include "TParticle.h"
+
+#include "AliExternalTrackParam.h"
+#include "AliESDtrack.h"
+#include "AliLog.h"
+
+#include "AliFilteredTreeSchema.h"
+
+ClassImp(AliFilteredTreeSchema)
+
+//_____________________________________________________________________________
+AliFilteredTreeSchema::AliFilteredTreeSchema(const char *name, const char *title)
+  : TNamed(name,title)
+  , fSelection("")
+  , fPrecisionPatterns()
+  , fPrecisionBits()
+  , fColumns()
+  , fTypes()
+  , fSlots()
+  , fBits()
+  , fIntValues()
+  , fLongValues()
+  , fFloatValues()
+  , fStringValues()
+  , fStringBranches()
+  , fTree(0)
+{
+  // Constructor
+  fPrecisionPatterns.SetOwner(kTRUE);
+  fColumns.SetOwner(kTRUE);
+  fStringValues.SetOwner(kTRUE);
+}
+
+//_____________________________________________________________________________
+AliFilteredTreeSchema::~AliFilteredTreeSchema()
+{
+  //
+  // Destructor - the tree is not deleted, it belongs to the directory where
+  // it was created and may still be referenced by an output container
+  //
+}
+
+//_____________________________________________________________________________
+Int_t AliFilteredTreeSchema::AddColumn(const char *column, EColumnType type)
+{
+  //
+  // Register a column, return the handle used to fill it
+  // Columns can be registered only before the tree is created
+  //
+  if (fTree) {
+    AliError(Form("%s: column %s registered after MakeTree()",GetName(),column));
+    return -1;
+  }
+  Int_t handle=fColumns.GetEntriesFast();
+  Int_t slot=0;
+  switch (type) {
+    case kInt:   slot=fIntValues.GetSize();   fIntValues.Set(slot+1);   break;
+    case kLong:  slot=fLongValues.GetSize();  fLongValues.Set(slot+1);  break;
+    case kString: slot=fStringValues.GetEntriesFast(); fStringValues.AddLast(new TObjString("")); break;
+    default:     slot=fFloatValues.GetSize(); fFloatValues.Set(slot+1); break;
+  }
+  fColumns.AddLast(new TObjString(column));
+  fTypes.Set(handle+1);
+  fSlots.Set(handle+1);
+  fBits.Set(handle+1);
+  fTypes[handle]=type;
+  fSlots[handle]=slot;
+  fBits[handle]=kMantissaBits;
+  return handle;
+}
+
+//_____________________________________________________________________________
+Int_t AliFilteredTreeSchema::AddVector(const char *prefix, Int_t n)
+{
+  //
+  // Register n float columns prefix0 ... prefix(n-1), return the first handle
+  //
+  Int_t handle=-1;
+  for (Int_t i=0; i<n; i++) {
+    Int_t h=AddColumn(Form("%s%d",prefix,i),kFloat);
+    if (i==0) handle=h;
+  }
+  return handle;
+}
+
+//_____________________________________________________________________________
+Int_t AliFilteredTreeSchema::AddParam(const char *prefix)
+{
+  //
+  // Register the kNParamColumns columns of a track parameterisation:
+  // prefix_X, prefix_Alpha, prefix_P0..P4, prefix_C0..C14
+  //
+  Int_t handle=AddColumn(Form("%s_X",prefix),kFloat);
+  AddColumn(Form("%s_Alpha",prefix),kFloat);
+  AddVector(Form("%s_P",prefix),5);
+  AddVector(Form("%s_C",prefix),15);
+  return handle;
+}
+
+//_____________________________________________________________________________
+Int_t AliFilteredTreeSchema::AddTrack(const char *prefix)
+{
+  //
+  // Register the kNTrackColumns columns of an ESD track:
+  // the track parameters followed by the detector information
+  //
+  Int_t handle=AddParam(prefix);
+  AddColumn(Form("%s_Status",prefix),kLong);
+  AddColumn(Form("%s_Label",prefix),kInt);
+  AddColumn(Form("%s_TPCLabel",prefix),kInt);
+  AddColumn(Form("%s_TPCsignal",prefix),kFloat);
+  AddColumn(Form("%s_TPCncl",prefix),kInt);
+  AddColumn(Form("%s_TPCnclF",prefix),kInt);
+  AddColumn(Form("%s_TPCnCrossedRows",prefix),kFloat);
+  AddColumn(Form("%s_TPCchi2",prefix),kFloat);
+  AddColumn(Form("%s_ITSclusterMap",prefix),kInt);
+  AddColumn(Form("%s_ITSchi2",prefix),kFloat);
+  AddColumn(Form("%s_TRDsignal",prefix),kFloat);
+  AddVector(Form("%s_DCA",prefix),2);
+  AddVector(Form("%s_DCATPC",prefix),2);
+  return handle;
+}
+
+//_____________________________________________________________________________
+Int_t AliFilteredTreeSchema::AddParticle(const char *prefix)
+{
+  //
+  // Register the kNParticleColumns columns of a MC particle:
+  // prefix_Pdg, prefix_Px, Py, Pz, prefix_Vx, Vy, Vz
+  //
+  Int_t handle=AddColumn(Form("%s_Pdg",prefix),kInt);
+  AddColumn(Form("%s_Px",prefix),kFloat);
+  AddColumn(Form("%s_Py",prefix),kFloat);
+  AddColumn(Form("%s_Pz",prefix),kFloat);
+  AddColumn(Form("%s_Vx",prefix),kFloat);
+  AddColumn(Form("%s_Vy",prefix),kFloat);
+  AddColumn(Form("%s_Vz",prefix),kFloat);
+  return handle;
+}
+
+//_____________________________________________________________________________
+void AliFilteredTreeSchema::SetPrecision(Int_t nBits, const char *columns)
+{
+  //
+  // Keep only nBits of the mantissa for the float columns matching the pattern
+  // Settings are applied in order, the last matching one wins
+  //
+  Int_t n=fPrecisionBits.GetSize();
+  fPrecisionPatterns.AddLast(new TObjString(columns));
+  fPrecisionBits.Set(n+1);
+  fPrecisionBits[n]=nBits;
+}
+
+//_____________________________________________________________________________
+Bool_t AliFilteredTreeSchema::MatchPattern(const TString &name, const TString &pattern)
+{
+  //
+  // Full match of the name to the wildcard pattern
+  //
+  TRegexp re(pattern,kTRUE);
+  Ssiz_t len=0;
+  Ssiz_t pos=re.Index(name,&len);
+  return pos==0 && len==name.Length();
+}
+
+//_____________________________________________________________________________
+Bool_t AliFilteredTreeSchema::IsSelected(const char *column) const
+{
+  //
+  // Column is written if it matches one of the selection patterns (or no pattern is given)
+  // and none of the exclusion patterns ('!pattern')
+  //
+  if (fSelection.IsNull()) return kTRUE;
+  TString name(column);
+  Bool_t hasInclusion=kFALSE;
+  Bool_t isIncluded=kFALSE;
+  TObjArray *patterns=fSelection.Tokenize(" ,;");
+  for (Int_t i=0; i<patterns->GetEntriesFast(); i++) {
+    TString pattern=((TObjString*)patterns->At(i))->String();
+    if (pattern.BeginsWith("!")) {
+      if (MatchPattern(name,pattern(1,pattern.Length()-1))) {
+        delete patterns;
+        return kFALSE;
+      }
+      continue;
+    }
+    hasInclusion=kTRUE;
+    if (MatchPattern(name,pattern)) isIncluded=kTRUE;
+  }
+  delete patterns;
+  return isIncluded || !hasInclusion;
+}
+
+//_____________________________________________________________________________
+TTree *AliFilteredTreeSchema::MakeTree()
+{
+  //
+  // Create the output tree in the current directory
+  // One branch per selected column, bound to the value buffers
+  //
+  if (fTree) return fTree;
+  fTree = new TTree(GetName(),GetTitle());
+  fStringBranches.Clear();
+  fStringBranches.Expand(fStringValues.GetEntriesFast());
+
+  Int_t nPrecision=fPrecisionBits.GetSize();
+  Int_t nColumns=fColumns.GetEntriesFast();
+  for (Int_t h=0; h<nColumns; h++) {
+    TString name=((TObjString*)fColumns.UncheckedAt(h))->String();
+    if (!IsSelected(name)) continue;  // value still buffered, not written
+    Int_t slot=fSlots[h];
+    switch (fTypes[h]) {
+      case kInt:
+        fTree->Branch(name,&(fIntValues.fArray[slot]),name+"/I");
+        break;
+      case kLong:
+        fTree->Branch(name,&(fLongValues.fArray[slot]),name+"/L");
+        break;
+      case kString:
+        fStringBranches.AddAt(fTree->Branch(name,(void*)((TObjString*)fStringValues.UncheckedAt(slot))->String().Data(),name+"/C"),slot);
+        break;
+      default:
+        for (Int_t i=0; i<nPrecision; i++) {
+          if (MatchPattern(name,((TObjString*)fPrecisionPatterns.UncheckedAt(i))->String()))
+            fBits[h]=(fPrecisionBits[i]>=0) ? fPrecisionBits[i]:kMantissaBits;
+        }
+        fTree->Branch(name,&(fFloatValues.fArray[slot]),name+"/F");
+        break;
+    }
+  }
+  AliInfo(Form("%s: %d of %d columns written",GetName(),fTree->GetListOfBranches()->GetEntriesFast(),nColumns));
+  return fTree;
+}
+
+//_____________________________________________________________________________
+void AliFilteredTreeSchema::ReleaseTree()
+{
+  //
+  // Stop filling the tree. The tree is neither written nor deleted: like the
+  // TTreeSRedirector trees it is owned by its directory (the output file),
+  // and writing it is left to the owner of the file (e.g. the analysis manager
+  // for the output containers)
+  //
+  fTree=0;
+  fStringBranches.Clear();
+}
+
+//_____________________________________________________________________________
+Float_t AliFilteredTreeSchema::TruncateMantissa(Float_t value, Int_t nBits)
+{
+  //
+  // Round the float to nBits of mantissa, the remaining bits are zeroed
+  // Inf and NaN are returned unchanged
+  //
+  if (nBits<0 || nBits>=kMantissaBits) return value;
+  UInt_t bits=0;
+  memcpy(&bits,&value,sizeof(bits));
+  if ((bits&0x7f800000u)==0x7f800000u) return value;
+  UInt_t shift=kMantissaBits-nBits;
+  bits+=1u<<(shift-1);      // round to nearest, a carry goes into the exponent
+  bits&=~((1u<<shift)-1);
+  memcpy(&value,&bits,sizeof(value));
+  return value;
+}
+
+//_____________________________________________________________________________
+void AliFilteredTreeSchema::SetVector(Int_t h, const Double_t *values, Int_t n)
+{
+  //
+  // Fill n consecutive float columns starting at handle h
+  //
+  for (Int_t i=0; i<n; i++) SetF(h+i,values[i]);
+}
+
+//_____________________________________________________________________________
+void AliFilteredTreeSchema::SetParam(Int_t h, const AliExternalTrackParam *param)
+{
+  //
+  // Fill the columns registered with AddParam(), zeros if param is not available
+  //
+  if (!param) {
+    for (Int_t i=0; i<kNParamColumns; i++) SetF(h+i,0.);
+    return;
+  }
+  SetF(h,param->GetX());
+  SetF(h+1,param->GetAlpha());
+  SetVector(h+2,param->GetParameter(),5);
+  SetVector(h+7,param->GetCovariance(),15);
+}
+
+//_____________________________________________________________________________
+void AliFilteredTreeSchema::SetTrack(Int_t h, const AliESDtrack *track)
+{
+  //
+  // Fill the columns registered with AddTrack()
+  //
+  SetParam(h,track);
+  Int_t hd=h+kNParamColumns;
+  if (!track) {
+    SetL(hd,0);
+    for (Int_t i=1; i<kNTrackColumns-kNParamColumns; i++) {
+      if (fTypes[hd+i]==kInt) SetI(hd+i,0);
+      else SetF(hd+i,0.);
+    }
+    return;
+  }
+  Float_t dca[2]={0.,0.};
+  Float_t dcaTPC[2]={0.,0.};
+  track->GetImpactParameters(dca[0],dca[1]);
+  track->GetImpactParametersTPC(dcaTPC[0],dcaTPC[1]);
+  SetL(hd,track->GetStatus());
+  SetI(hd+1,track->GetLabel());
+  SetI(hd+2,track->GetTPCLabel());
+  SetF(hd+3,track->GetTPCsignal());
+  SetI(hd+4,track->GetTPCNcls());
+  SetI(hd+5,track->GetTPCNclsF());
+  SetF(hd+6,track->GetTPCCrossedRows());
+  SetF(hd+7,track->GetTPCchi2());
+  SetI(hd+8,track->GetITSClusterMap());
+  SetF(hd+9,track->GetITSchi2());
+  SetF(hd+10,track->GetTRDsignal());
+  SetF(hd+11,dca[0]);
+  SetF(hd+12,dca[1]);
+  SetF(hd+13,dcaTPC[0]);
+  SetF(hd+14,dcaTPC[1]);
+}
+
+//_____________________________________________________________________________
+void AliFilteredTreeSchema::SetParticle(Int_t h, const TParticle *particle)
+{
+  //
+  // Fill the columns registered with AddParticle(), zeros if particle is not available
+  //
+  if (!particle) {
+    SetI(h,0);
+    for (Int_t i=1; i<kNParticleColumns; i++) SetF(h+i,0.);
+    return;
+  }
+  SetI(h,particle->GetPdgCode());
+  SetF(h+1,particle->Px());
+  SetF(h+2,particle->Py());
+  SetF(h+3,particle->Pz());
+  SetF(h+4,particle->Vx());
+  SetF(h+5,particle->Vy());
+  SetF(h+6,particle->Vz());
+}
+
+//_____________________________________________________________________________
+void AliFilteredTreeSchema::SetS(Int_t h, const char *value)
+{
+  //
+  // Fill a string column. The value is kept until the next SetS(), Reset() does not clear it
+  // The branch address is moved only if the string buffer was reallocated
+  //
+  Int_t slot=fSlots.fArray[h];
+  TString &buffer=((TObjString*)fStringValues.UncheckedAt(slot))->String();
+  const char *address=buffer.Data();
+  buffer=value;
+  if (buffer.Data()==address || slot>=fStringBranches.GetSize()) return;
+  TBranch *branch=(TBranch*)fStringBranches.UncheckedAt(slot);
+  if (branch) branch->SetAddress((void*)buffer.Data());
+}
+
+//_____________________________________________________________________________
+void AliFilteredTreeSchema::Reset()
+{
+  //
+  // Zero all numeric values - for entries filling only a part of the columns
+  // String columns keep their value, they are usually set once per event
+  //
+  fIntValues.Reset();
+  fLongValues.Reset();
+  fFloatValues.Reset();
+}
+
+//_____________________________________________________________________________
+Int_t AliFilteredTreeSchema::Fill()
+{
+  //
+  // Write the current values as a new entry
+  //
+  if (!fTree) return 0;
+  return fTree->Fill();
+}
+
+//_____________________________________________________________________________
+void AliFilteredTreeSchema::Print(Option_t *option) const
+{
+  //
+  // Print the columns with their type, precision and selection
+  //
+  Int_t nColumns=fColumns.GetEntriesFast();
+  Printf("%s: %d columns, selection \"%s\"",GetName(),nColumns,fSelection.Data());
+  if (!TString(option).Contains("all")) return;
+  const char *types[4]={"I","L","F","C"};
+  for (Int_t h=0; h<nColumns; h++) {
+    const char *name=fColumns.UncheckedAt(h)->GetName();
+    Printf("%4d %-32s %s bits=%2d %s",h,name,types[fTypes[h]],fBits[h],IsSelected(name)?"":"(not written)");
+  }
+}
@@ -0,0 +1,104 @@
+#ifndef ALIFILTEREDTREESCHEMA_H
+#define ALIFILTEREDTREESCHEMA_H
+
+//------------------------------------------------------------------------------
+// Compact column writer for the filtered trees.
+//
+// The columns of the output tree are registered once, before MakeTree(),
+// and filled afterwards through the integer handle returned at registration:
+// no branch or tree lookup by name is done per entry. Objects (tracks,
+// track parameters, MC particles) are split into one flat column per member.
+//
+// Optional modes, configured before MakeTree():
+//   SetSelection("esdTrack_* !*_C*") - only the matching columns get a branch,
+//                                      patterns with '!' exclude columns
+//   SetPrecision(10,"*_C*")          - float columns matching the pattern keep
+//                                      only 10 mantissa bits (rounded), which
+//                                      compresses much better
+// String columns (file name, trigger classes) are written per entry; they are
+// not cleared by Reset(), so values constant over an event are set once per
+// event. Identical consecutive values compress to almost nothing.
+//------------------------------------------------------------------------------
+
+#include "TNamed.h"
+#include "TArrayI.h"
+#include "TArrayF.h"
+#include "TArrayL64.h"
+#include "TObjArray.h"
+
+class TTree;
+class TParticle;
+class AliExternalTrackParam;
+class AliESDtrack;
+
+class AliFilteredTreeSchema : public TNamed
+{
+public:
+  enum EColumnType { kInt=0, kLong=1, kFloat=2, kString=3 };
+  enum { kNParamColumns=22, kNTrackColumns=kNParamColumns+15, kNParticleColumns=7 };
+
+  AliFilteredTreeSchema(const char *name="", const char *title="");
+  virtual ~AliFilteredTreeSchema();
+
+  // schema definition
+  Int_t AddColumn(const char *column, EColumnType type=kFloat);
+  Int_t AddVector(const char *prefix, Int_t n);
+  Int_t AddParam(const char *prefix);
+  Int_t AddTrack(const char *prefix);
+  Int_t AddParticle(const char *prefix);
+
+  void SetSelection(const char *selection) { fSelection = selection; }
+  void SetPrecision(Int_t nBits, const char *columns="*");
+  const char *GetSelection() const { return fSelection.Data(); }
+
+  TTree *MakeTree();
+  void   ReleaseTree();
+
+  // filling
+  void SetI(Int_t h, Int_t value)      { fIntValues.fArray[fSlots.fArray[h]] = value; }
+  void SetL(Int_t h, Long64_t value)   { fLongValues.fArray[fSlots.fArray[h]] = value; }
+  void SetF(Int_t h, Double_t value)   {
+    Int_t nBits = fBits.fArray[h];
+    fFloatValues.fArray[fSlots.fArray[h]] = (nBits<kMantissaBits) ? TruncateMantissa(value,nBits) : Float_t(value);
+  }
+  void SetS(Int_t h, const char *value);
+  void SetVector(Int_t h, const Double_t *values, Int_t n);
+  void SetParam(Int_t h, const AliExternalTrackParam *param);
+  void SetTrack(Int_t h, const AliESDtrack *track);
+  void SetParticle(Int_t h, const TParticle *particle);
+  void  Reset();
+  Int_t Fill();
+
+  TTree *GetTree() const        { return fTree; }
+  Int_t  GetNColumns() const    { return fColumns.GetEntriesFast(); }
+  Bool_t IsSelected(const char *column) const;
+  virtual void Print(Option_t *option="") const;
+
+  static Float_t TruncateMantissa(Float_t value, Int_t nBits);
+  static Bool_t  MatchPattern(const TString &name, const TString &pattern);
+
+private:
+  enum { kMantissaBits=23 };
+
+  TString   fSelection;         // column selection patterns, all columns if empty
+  TObjArray fPrecisionPatterns; // column patterns of the reduced precision settings
+  TArrayI   fPrecisionBits;     // mantissa bits kept for the corresponding pattern
+
+  TObjArray fColumns;           //! column names, index is the column handle
+  TArrayI   fTypes;             //! column types
+  TArrayI   fSlots;             //! position of the column in the value buffer of its type
+  TArrayI   fBits;              //! mantissa bits kept for float columns
+  TArrayI   fIntValues;         //! value buffers - addresses are fixed after MakeTree()
+  TArrayL64 fLongValues;        //!
+  TArrayF   fFloatValues;       //!
+  TObjArray fStringValues;      //! string buffers (TObjString), the branch address follows the buffer
+  TObjArray fStringBranches;    //! branches of the string columns, index is the slot
+  TTree     *fTree;             //! output tree, owned by its directory
+
+  AliFilteredTreeSchema(const AliFilteredTreeSchema&); // not implemented
+  AliFilteredTreeSchema& operator=(const AliFilteredTreeSchema&); // not implemented
+
+  ClassDef(AliFilteredTreeSchema, 2);
+};
+
+#endif
@@ -88,6 +88,7 @@
 #pragma link C++ class AliAnalysisTaskFilteredTree+;
 #pragma link C++ class AliFilteredTreeEventCuts+;
 #pragma link C++ class AliFilteredTreeAcceptanceCuts+;
+#pragma link C++ class AliFilteredTreeSchema+;
 
 #pragma link C++ class AliTaskConfigOCDB+;
 
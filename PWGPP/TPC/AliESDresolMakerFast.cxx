@@ -66,6 +66,12 @@
 #include "TMath.h"
 #include "TCut.h"
 #include "TTree.h"
+#include "TTreeFormula.h"
+#include "TTreeFormulaManager.h"
+#include "TLinearFitter.h"
+#include "TObjArray.h"
+#include "TObjString.h"
+#include <vector>
 
 #include "AliESDresolParams.h"
 #include "AliESDresolMakerFast.h"
@@ -107,45 +113,30 @@ TObjArray * AliESDresolMakerFast::MakeParamPrimFast(TTree * tree, TCut & cutDCA,
   */
 
   TObjArray *array = new TObjArray();
-  Double_t chi2=0;
-  Int_t    npoints=0;
-  TVectorD fitParam;
-  TMatrixD covMatrix;
   //
-  // y param
-  //
-  TString * dcayParam=  TStatToolkit::FitPlane(tree,"sqrt(Tracks[].fC[0])/(0.2+abs(Tracks[].fP[4]))","(abs(Tracks[].fP[4]))++(abs(Tracks[].fP[4]))^2++(abs(Tracks[].fP[3]))++(abs(Tracks[].fP[3]))^2++(abs(Tracks[].fP[4]))*(abs(Tracks[].fP[3]))", cutDCA, chi2,npoints,fitParam,covMatrix,fraction, 0, entries);
-  tree->SetAlias("dcayParam",dcayParam->Data());
-  array->AddAt(new TVectorD(fitParam),0);
-  printf("Y resol\t%s\n",dcayParam->Data());
-  //
-  // z param
-  //
-  TString * dcazParam= TStatToolkit::FitPlane(tree, "sqrt(Tracks[].fC[2])/(0.2+abs(Tracks[].fP[4]))", "(abs(Tracks[].fP[4]))++(abs(Tracks[].fP[4]))^2++(abs(Tracks[].fP[3]))++(abs(Tracks[].fP[3]))^2++(abs(Tracks[].fP[4]))*(abs(Tracks[].fP[3]))",  cutDCA, chi2,npoints,fitParam,covMatrix,fraction,0,entries);  
-  printf("Z resol\t%s\n",dcazParam->Data());  
-  tree->SetAlias("dcazParam",dcazParam->Data());
-  array->AddAt(new TVectorD(fitParam),1);
-  //
-  // Phi param
-  //
-  TString * dcaphiParam= TStatToolkit::FitPlane(tree, "sqrt(Tracks[].fC[5])/(0.1+abs(Tracks[].fP[4]))", "(abs(Tracks[].fP[4]))++(abs(Tracks[].fP[4]))^2++(abs(Tracks[].fP[3]))++(abs(Tracks[].fP[3]))^2++(abs(Tracks[].fP[4]))*(abs(Tracks[].fP[3]))",  cutDCA, chi2,npoints,fitParam,covMatrix,fraction,0,entries);  
-  printf("Phi resol\t%s\n",dcaphiParam->Data());   
-  tree->SetAlias("dcaphiParam",dcaphiParam->Data());
-  array->AddAt(new TVectorD(fitParam),2);
-  //
-  // theta param
-  //
-  TString * dcathParam=  TStatToolkit::FitPlane(tree, "sqrt(Tracks[].fC[9])/((0.1+abs(Tracks[].fP[4])*(1+abs(Tracks[].fParamP.fP[3]^2))))", "(abs(Tracks[].fP[4]))++(abs(Tracks[].fP[4]))^2++(abs(Tracks[].fP[3]))++(abs(Tracks[].fP[3]))^2++(abs(Tracks[].fP[4]))*(abs(Tracks[].fP[3]))",  cutDCA, chi2,npoints,fitParam,covMatrix,fraction,0,entries);  
-  printf("Theta resol\t%s\n",dcathParam->Data());   
-  tree->SetAlias("dcathParam",dcathParam->Data());
-  array->AddAt(new TVectorD(fitParam),3);
-  //
-  // 1pt param
-  //
-  TString * dca1ptParam=  TStatToolkit::FitPlane(tree, "sqrt(Tracks[].fC[14])/(1+abs(Tracks[].fP[4]))^2", "(abs(Tracks[].fP[4]))++(abs(Tracks[].fP[4]))^2++(abs(Tracks[].fP[3]))++(abs(Tracks[].fP[3]))^2++(abs(Tracks[].fP[4]))*(abs(Tracks[].fP[3]))",  cutDCA, chi2,npoints,fitParam,covMatrix,fraction,0,entries);  
-  printf("1pt resol\t%s\n",dca1ptParam->Data());  
-  tree->SetAlias("dca1ptParam",dca1ptParam->Data());
-  array->AddAt(new TVectorD(fitParam),4);
+  // all the parameterizations are fitted in one pass over the tree
+  //
+  const char * regressors = "(abs(Tracks[].fP[4]))++(abs(Tracks[].fP[4]))^2++(abs(Tracks[].fP[3]))++(abs(Tracks[].fP[3]))^2++(abs(Tracks[].fP[4]))*(abs(Tracks[].fP[3]))";
+  const Int_t kNParams = 5;
+  const char * drawCommands[kNParams] = {
+    "sqrt(Tracks[].fC[0])/(0.2+abs(Tracks[].fP[4]))",                                   // y param
+    "sqrt(Tracks[].fC[2])/(0.2+abs(Tracks[].fP[4]))",                                   // z param
+    "sqrt(Tracks[].fC[5])/(0.1+abs(Tracks[].fP[4]))",                                   // Phi param
+    "sqrt(Tracks[].fC[9])/((0.1+abs(Tracks[].fP[4])*(1+abs(Tracks[].fParamP.fP[3]^2))))",  // theta param
+    "sqrt(Tracks[].fC[14])/(1+abs(Tracks[].fP[4]))^2"                                   // 1pt param
+  };
+  const char * formulas[kNParams] = { regressors, regressors, regressors, regressors, regressors };
+  const char * aliases[kNParams]  = { "dcayParam", "dcazParam", "dcaphiParam", "dcathParam", "dca1ptParam" };
+  const char * titles[kNParams]   = { "Y", "Z", "Phi", "Theta", "1pt" };
+  TString * params[kNParams];
+  TVectorD fitParam[kNParams];
+  FitPlanes(tree, cutDCA, kNParams, drawCommands, formulas, params, fitParam, 0, fraction, 0, entries);
+  for (Int_t i=0; i<kNParams; i++){
+    printf("%s resol\t%s\n",titles[i],params[i]->Data());
+    tree->SetAlias(aliases[i],params[i]->Data());
+    array->AddAt(new TVectorD(fitParam[i]),i);
+    delete params[i];
+  }
   return array;
 }
 
@@ -177,11 +168,6 @@ TObjArray * AliESDresolMakerFast::MakeParamRFast(TTree * tree,  TCut &cutV0, Flo
   // 
   //
   TObjArray *array = new TObjArray;
- 
-  Double_t chi2=0;
-  Int_t    npoints=0;
-  TVectorD fitParam;
-  TMatrixD covMatrix;
   //
   //
   /*
@@ -189,35 +175,199 @@ TObjArray * AliESDresolMakerFast::MakeParamRFast(TTree * tree,  TCut &cutV0, Flo
     TCut  cutV0 = "abs((V0s[].fParamP.fC[0]))<3&&abs(V0s[].fParamP.fP[3])<1&&abs(V0s[].fParamP.fP[4])<8";//
   */
   //
-  //
-  //
-  TString * v0sigmaY= TStatToolkit::FitPlane(tree,"sqrt(sqrt((V0s[].fParamP.fC[0]))/(0.2+abs(V0s[].fParamP.fP[4])))","abs(V0s[].fParamP.fP[4])++V0s[].fParamP.fX++abs(V0s[].fParamP.fP[4])^2++V0s[].fParamP.fX^2++abs(V0s[].fParamP.fP[4])*V0s[].fParamP.fX++abs(V0s[].fParamP.fP[4])*V0s[].fParamP.fX^2", cutV0, chi2,npoints,fitParam,covMatrix,fraction,0,entries);
-  tree->SetAlias("v0sigmaY",v0sigmaY->Data());
-  array->AddAt(new TVectorD(fitParam),0);
-  //
-  //
-  //
-  TString * v0sigmaZ= TStatToolkit::FitPlane(tree,"sqrt(sqrt((V0s[].fParamP.fC[2])))","abs(V0s[].fParamP.fP[4])++V0s[].fParamP.fX++abs(V0s[].fParamP.fP[4])^2++V0s[].fParamP.fX^2++abs(V0s[].fParamP.fP[4])*V0s[].fParamP.fX++abs(V0s[].fParamP.fP[4])*V0s[].fParamP.fX^2", cutV0, chi2,npoints,fitParam,covMatrix,fraction,0,entries);
-  tree->SetAlias("v0sigmaZ",v0sigmaZ->Data());
-  array->AddLast(new TVectorD(fitParam));
-  //
-  //
-  //
-  TString * v0sigmaPhi= TStatToolkit::FitPlane(tree,"sqrt(sqrt((V0s[].fParamP.fC[5]))/(0.1+abs(V0s[].fParamP.fP[4])))","abs(V0s[].fParamP.fP[4])++V0s[].fParamP.fX++abs(V0s[].fParamP.fP[4])^2++abs(V0s[].fParamP.fP[4])*V0s[].fParamP.fX", cutV0, chi2,npoints,fitParam,covMatrix,fraction,0,entries);
-  tree->SetAlias("v0sigmaPhi",v0sigmaPhi->Data());
-  array->AddAt(new TVectorD(fitParam),2);
-  //
-  //
-  //
-  TString * v0sigmaTh= TStatToolkit::FitPlane(tree,"sqrt(sqrt((V0s[].fParamP.fC[9]))/((0.1+abs(V0s[].fParamP.fP[4])*(1+abs(V0s[].fParamP.fP[3])^2))))","abs(V0s[].fParamP.fP[4])++V0s[].fParamP.fX++abs(V0s[].fParamP.fP[4])^2++abs(V0s[].fParamP.fP[4])*V0s[].fParamP.fX", cutV0, chi2,npoints,fitParam,covMatrix,fraction,0,entries);
-  tree->SetAlias("v0sigmaTh",v0sigmaTh->Data());
-  array->AddAt(new TVectorD(fitParam),3);
-  //
-  //
-  //
-  TString * v0sigma1pt= TStatToolkit::FitPlane(tree,"sqrt(sqrt((V0s[].fParamP.fC[14])))","abs(V0s[].fParamP.fP[4])++V0s[].fParamP.fX++abs(V0s[].fParamP.fP[4])^2++V0s[].fParamP.fX^2++abs(V0s[].fParamP.fP[4])*V0s[].fParamP.fX++abs(V0s[].fParamP.fP[4])*V0s[].fParamP.fX^2", cutV0, chi2,npoints,fitParam,covMatrix,fraction,0,entries);
-  tree->SetAlias("v0sigma1pt",v0sigma1pt->Data());
-  array->AddAt(new TVectorD(fitParam),4);
+  // all the parameterizations are fitted in one pass over the tree
+  //
+  const char * regressors6 = "abs(V0s[].fParamP.fP[4])++V0s[].fParamP.fX++abs(V0s[].fParamP.fP[4])^2++V0s[].fParamP.fX^2++abs(V0s[].fParamP.fP[4])*V0s[].fParamP.fX++abs(V0s[].fParamP.fP[4])*V0s[].fParamP.fX^2";
+  const char * regressors4 = "abs(V0s[].fParamP.fP[4])++V0s[].fParamP.fX++abs(V0s[].fParamP.fP[4])^2++abs(V0s[].fParamP.fP[4])*V0s[].fParamP.fX";
+  const Int_t kNParams = 5;
+  const char * drawCommands[kNParams] = {
+    "sqrt(sqrt((V0s[].fParamP.fC[0]))/(0.2+abs(V0s[].fParamP.fP[4])))",
+    "sqrt(sqrt((V0s[].fParamP.fC[2])))",
+    "sqrt(sqrt((V0s[].fParamP.fC[5]))/(0.1+abs(V0s[].fParamP.fP[4])))",
+    "sqrt(sqrt((V0s[].fParamP.fC[9]))/((0.1+abs(V0s[].fParamP.fP[4])*(1+abs(V0s[].fParamP.fP[3])^2))))",
+    "sqrt(sqrt((V0s[].fParamP.fC[14])))"
+  };
+  const char * formulas[kNParams] = { regressors6, regressors6, regressors4, regressors4, regressors6 };
+  const char * aliases[kNParams]  = { "v0sigmaY", "v0sigmaZ", "v0sigmaPhi", "v0sigmaTh", "v0sigma1pt" };
+  TString * params[kNParams];
+  TVectorD fitParam[kNParams];
+  FitPlanes(tree, cutV0, kNParams, drawCommands, formulas, params, fitParam, 0, fraction, 0, entries);
+  for (Int_t i=0; i<kNParams; i++){
+    tree->SetAlias(aliases[i],params[i]->Data());
+    array->AddAt(new TVectorD(fitParam[i]),i);
+    delete params[i];
+  }
   return array;
 
 }
+
+
+Int_t AliESDresolMakerFast::FitPlanes(TTree * tree, const char * cuts, Int_t nModels, const char * const drawCommands[], const char * const formulas[],
+				      TString ** fitFormulas, TVectorD * fitParams, Double_t * chi2,
+				      Float_t frac, Int_t start, Int_t stop){
+  //
+  // Fit nModels linear parameterizations reading the tree only once
+  // Model i is the fit done by
+  //   TStatToolkit::FitPlane(tree, drawCommands[i], formulas[i], cuts, chi2, npoints, fitParam, covMatrix, frac, start, stop)
+  // drawCommands[i] - fitted value, optionally followed by ":error"
+  // formulas[i]     - regressors separated by "++"
+  //
+  // All the (distinct) expressions are compiled once and evaluated in one loop over the tree,
+  // the points being added to the fitter of each model in the same order as TTree::Draw gives them.
+  // Parameters and returned formulas are then the same as the ones of FitPlane.
+  // The expressions have to share the same array dimension (e.g. all Tracks[] or all V0s[]),
+  // as the number of instances per entry is common to all of them.
+  //
+  // Output:
+  // fitFormulas[i] - fitted formula (owned by the caller), or error message as FitPlane
+  // fitParams[i]   - fitted parameters
+  // chi2[i]        - chi2 of the fit, if chi2 is given
+  // Returns the number of points used in the fits, -1 in case of error
+  //
+  TObjArray expressions;          // distinct expressions, TTreeFormula compiled in the same order
+  TObjArray treeFormulas;
+  treeFormulas.SetOwner(kTRUE);
+  std::vector<Int_t> valueIndex(nModels), errorIndex(nModels);
+  std::vector< std::vector<Int_t> > regressorIndex(nModels);
+  std::vector<TObjArray*> regressors(nModels);
+  std::vector<TLinearFitter*> fitters(nModels);
+  //
+  TTreeFormula * select = 0;
+  if (tree->LoadTree(tree->GetEntryNumber(start))>=0) select = new TTreeFormula("Selection", cuts, tree);
+  if (!select || select->GetNdim()==0) {
+    delete select;
+    for (Int_t imodel=0; imodel<nModels; imodel++) fitFormulas[imodel] = new TString(TString::Format("ERROR expr: %s\t%s\tEntries==0",drawCommands[imodel],cuts));
+    return -1;
+  }
+  TTreeFormulaManager * manager = new TTreeFormulaManager;
+  manager->Add(select);
+  //
+  for (Int_t imodel=0; imodel<nModels; imodel++){
+    TString drawStr(drawCommands[imodel]);
+    TString ferr("1");
+    if (drawStr.Contains(":")){
+      TObjArray* valTokens = drawStr.Tokenize(":");
+      drawStr = valTokens->At(0)->GetName();
+      ferr    = valTokens->At(1)->GetName();
+      delete valTokens;
+    }
+    TString formulaStr(formulas[imodel]);
+    formulaStr.ReplaceAll("++", "~");
+    regressors[imodel] = formulaStr.Tokenize("~");
+    Int_t dim = regressors[imodel]->GetEntriesFast();
+    //
+    // index of each expression, compiled the first time it is seen
+    //
+    for (Int_t iexpr=0; iexpr<dim+2; iexpr++){
+      TString expr = (iexpr==0) ? drawStr : ((iexpr==1) ? ferr : TString(regressors[imodel]->At(iexpr-2)->GetName()));
+      Int_t index = -1;
+      for (Int_t j=0; j<expressions.GetEntriesFast(); j++) if (expr==expressions.At(j)->GetName()) { index=j; break;}
+      if (index<0){
+	TTreeFormula * treeFormula = new TTreeFormula(Form("Expr%d",expressions.GetEntriesFast()), expr.Data(), tree);
+	expressions.Add(new TObjString(expr));
+	treeFormulas.Add(treeFormula);
+	index = expressions.GetEntriesFast()-1;
+	if (treeFormula->GetNdim()>0) manager->Add(treeFormula);
+      }
+      if (iexpr==0) valueIndex[imodel]=index;
+      else if (iexpr==1) errorIndex[imodel]=index;
+      else regressorIndex[imodel].push_back(index);
+    }
+    fitParams[imodel].ResizeTo(dim);
+    fitters[imodel] = new TLinearFitter(dim+1, Form("hyp%d",dim));
+    fitters[imodel]->StoreData(kTRUE);
+    fitters[imodel]->ClearPoints();
+  }
+  manager->Sync();
+  //
+  // models with an expression which can not be compiled are not filled
+  //
+  std::vector<Bool_t> valid(nModels,kTRUE);
+  for (Int_t imodel=0; imodel<nModels; imodel++){
+    if (((TTreeFormula*)treeFormulas.At(valueIndex[imodel]))->GetNdim()==0) valid[imodel]=kFALSE;
+    if (((TTreeFormula*)treeFormulas.At(errorIndex[imodel]))->GetNdim()==0) valid[imodel]=kFALSE;
+    for (UInt_t j=0; j<regressorIndex[imodel].size(); j++) if (((TTreeFormula*)treeFormulas.At(regressorIndex[imodel][j]))->GetNdim()==0) valid[imodel]=kFALSE;
+  }
+  //
+  // single pass over the tree
+  //
+  Int_t nExpr = treeFormulas.GetEntriesFast();
+  std::vector<Double_t> values(nExpr);
+  std::vector<Double_t> x;
+  Int_t entries=0;
+  Int_t treeNumber=-1;
+  for (Long64_t entry=start; entry<stop; entry++){
+    Long64_t entryNumber = tree->GetEntryNumber(entry);
+    if (entryNumber<0) break;
+    if (tree->LoadTree(entryNumber)<0) break;
+    if (tree->GetTreeNumber()!=treeNumber){
+      treeNumber = tree->GetTreeNumber();
+      manager->UpdateFormulaLeaves();
+    }
+    Int_t ndata = manager->GetNdata();
+    if (ndata<=0) continue;
+    //
+    // instance 0 loads the branch data of the entry - done for every formula
+    // before the instance loop, as in TSelectorDraw::ProcessFillMultiple,
+    // otherwise formulas can be evaluated on the data of a previous entry
+    //
+    select->EvalInstance(0);
+    for (Int_t iexpr=0; iexpr<nExpr; iexpr++){
+      TTreeFormula * treeFormula = (TTreeFormula*)treeFormulas.UncheckedAt(iexpr);
+      if (treeFormula->GetNdim()>0) treeFormula->EvalInstance(0);
+    }
+    for (Int_t instance=0; instance<ndata; instance++){
+      if (select->EvalInstance(instance)==0) continue;
+      for (Int_t iexpr=0; iexpr<nExpr; iexpr++){
+	TTreeFormula * treeFormula = (TTreeFormula*)treeFormulas.UncheckedAt(iexpr);
+	values[iexpr] = (treeFormula->GetNdim()>0) ? treeFormula->EvalInstance(instance) : 0;
+      }
+      for (Int_t imodel=0; imodel<nModels; imodel++){
+	if (!valid[imodel]) continue;
+	Int_t dim = regressorIndex[imodel].size();
+	x.resize(dim);
+	for (Int_t j=0; j<dim; j++) x[j]=values[regressorIndex[imodel][j]];
+	fitters[imodel]->AddPoint(dim>0 ? &x[0] : 0, values[valueIndex[imodel]], values[errorIndex[imodel]]);
+      }
+      entries++;
+    }
+  }
+  //
+  // evaluate the fits and make the formulas as FitPlane
+  //
+  for (Int_t imodel=0; imodel<nModels; imodel++){
+    TLinearFitter * fitter = fitters[imodel];
+    TObjArray * formulaTokens = regressors[imodel];
+    Int_t dim = formulaTokens->GetEntriesFast();
+    if (!valid[imodel]){
+      TString drawStr = expressions.At(valueIndex[imodel])->GetName();
+      TString ferr    = expressions.At(errorIndex[imodel])->GetName();
+      if (((TTreeFormula*)treeFormulas.At(valueIndex[imodel]))->GetNdim()==0)
+	fitFormulas[imodel] = new TString(TString::Format("ERROR expr: %s\t%s\tEntries==0",drawStr.Data(),cuts));
+      else if (((TTreeFormula*)treeFormulas.At(errorIndex[imodel]))->GetNdim()==0)
+	fitFormulas[imodel] = new TString(TString::Format("ERROR error part: %s\t%s\tEntries==0",ferr.Data(),cuts));
+      else
+	fitFormulas[imodel] = new TString(TString::Format("ERROR: %s\t%s\tEntries==%d\tEntries2=%d\n",drawStr.Data(),cuts,entries,-1));
+    }else{
+      fitter->Eval();
+      if (frac>0.5 && frac<1){
+	fitter->EvalRobust(frac);
+      }
+      fitter->GetParameters(fitParams[imodel]);
+      if (chi2) chi2[imodel] = fitter->GetChisquare();
+      TString *preturnFormula = new TString(Form("( %f+",fitParams[imodel][0])), &returnFormula = *preturnFormula;
+      for (Int_t iparam = 0; iparam < dim; iparam++) {
+	returnFormula.Append(Form("%s*(%f)",((TObjString*)formulaTokens->At(iparam))->GetName(),fitParams[imodel][iparam+1]));
+	if (iparam < dim-1) returnFormula.Append("+");
+      }
+      returnFormula.Append(" )");
+      fitFormulas[imodel] = preturnFormula;
+    }
+    delete fitter;
+    delete formulaTokens;
+  }
+  expressions.Delete();
+  delete select;           // the manager is deleted with its last formula
+  treeFormulas.Delete();
+  return entries;
+}
@@ -15,6 +15,7 @@
 class TTree;
 class TObjArray; 
 class TCut;
+class TString;
 //
 class AliESDresolMakerFast : public TObject{
  public:
@@ -22,6 +23,10 @@ class AliESDresolMakerFast : public TObject{
   //
   static TObjArray * MakeParamPrimFast(TTree * tree, TCut &cutDCA, Float_t fraction=-1, Int_t entries=100000);
   static TObjArray * MakeParamRFast(TTree * tree, TCut &cutV0, Float_t fraction=-1, Int_t entries=100000);
+  //
+  static Int_t FitPlanes(TTree * tree, const char * cuts, Int_t nModels, const char * const drawCommands[], const char * const formulas[],
+                         TString ** fitFormulas, TVectorD * fitParams, Double_t * chi2=0,
+                         Float_t frac=-1, Int_t start=0, Int_t stop=10000000);
   // protected:
  public:
   // 
@@ -13,6 +13,7 @@
  * provided "as is" without express or implied warranty.                  *
  **************************************************************************/
 
+#include <TClass.h>
 #include <TClonesArray.h>
 #include <TFile.h>
 #include <TGeoGlobalMagField.h>
@@ -35,6 +36,7 @@
 #include "AliEMCALRecParam.h"
 #include "AliEMCALRecPoint.h"
 #include "AliEMCALRecoUtils.h"
+#include "AliEMCALTowerGridClusterizer.h"
 #include "AliESDCaloCluster.h"
 #include "AliESDEvent.h"
 #include "AliLog.h"
@@ -86,6 +88,10 @@ AliEMCALTenderSupply::AliEMCALTenderSupply() :
   ,fBasePath("")
   ,fReClusterize(kFALSE)
   ,fClusterizer(0)
+  ,fUseNativeClusterizer(kFALSE)
+  ,fGridClusterizer(0)
+  ,fValidateNativeClusterizer(kFALSE)
+  ,fGridClusters(0)
   ,fGeomMatrixSet(kFALSE)
   ,fLoadGeomMatrices(kFALSE)
   ,fRecParam(0x0)
@@ -156,6 +162,10 @@ AliEMCALTenderSupply::AliEMCALTenderSupply(const char *name, const AliTender *te
   ,fBasePath("")
   ,fReClusterize(kFALSE)
   ,fClusterizer(0)
+  ,fUseNativeClusterizer(kFALSE)
+  ,fGridClusterizer(0)
+  ,fValidateNativeClusterizer(kFALSE)
+  ,fGridClusters(0)
   ,fGeomMatrixSet(kFALSE)
   ,fLoadGeomMatrices(kFALSE)
   ,fRecParam(0x0)
@@ -226,6 +236,10 @@ AliEMCALTenderSupply::AliEMCALTenderSupply(const char *name, AliAnalysisTaskSE *
   ,fBasePath("")
   ,fReClusterize(kFALSE)
   ,fClusterizer(0)
+  ,fUseNativeClusterizer(kFALSE)
+  ,fGridClusterizer(0)
+  ,fValidateNativeClusterizer(kFALSE)
+  ,fGridClusters(0)
   ,fGeomMatrixSet(kFALSE)
   ,fLoadGeomMatrices(kFALSE)
   ,fRecParam(0x0)
@@ -266,6 +280,8 @@ AliEMCALTenderSupply::~AliEMCALTenderSupply()
     delete fEMCALRecoUtils;
     delete fRecParam;
     delete fUnfolder;
+    delete fGridClusterizer;
+    delete fGridClusters;
     
     if (!fClusterizer) 
     {
@@ -348,6 +364,8 @@ void AliEMCALTenderSupply::Init()
     fEtacut                 = tender->fEtacut;
     fPhicut                 = tender->fPhicut;
     fReClusterize           = tender->fReClusterize;
+    fUseNativeClusterizer   = tender->fUseNativeClusterizer;
+    fValidateNativeClusterizer = tender->fValidateNativeClusterizer;
     fLoadGeomMatrices       = tender->fLoadGeomMatrices;
     fRecParam               = tender->fRecParam;
     fDoNonLinearity         = tender->fDoNonLinearity;
@@ -373,6 +391,8 @@ void AliEMCALTenderSupply::Init()
     AliInfo(Form("UpdateCell : %d", fUpdateCell)); 
     AliInfo(Form("DoUpdateOnly : %d", fDoUpdateOnly)); 
     AliInfo(Form("Reclustering : %d", fReClusterize)); 
+    AliInfo(Form("NativeClusterizer : %d", fUseNativeClusterizer)); 
+    AliInfo(Form("NativeClusterizerValidation : %d", fValidateNativeClusterizer)); 
     AliInfo(Form("ClusterBadChannelCheck : %d", fClusterBadChannelCheck)); 
     AliInfo(Form("ClusterExoticChannelCheck : %d", fRejectExoticClusters)); 
     AliInfo(Form("CellFiducialRegion : %d", fFiducial)); 
@@ -734,9 +754,16 @@ void AliEMCALTenderSupply::ProcessEvent()
   // RECLUSTERIZATION ---------------------------------------------------------
   if (fReClusterize)
   {
-    FillDigitsArray();
-    Clusterize();
-    UpdateClusters();
+    if (UseNativeClusterizer())
+    {
+      ClusterizeOnTowerGrid();
+    }
+    else
+    {
+      FillDigitsArray();
+      Clusterize();
+      UpdateClusters();
+    }
   }
 
   // Store good clusters
@@ -1629,6 +1656,16 @@ Bool_t AliEMCALTenderSupply::InitClusterization()
   fClusterizer->SetDigitsArr(fDigitsArr);
   fClusterizer->SetOutput(0);
   fClusterArr = const_cast<TObjArray *>(fClusterizer->GetRecPoints());
+
+  // Tower grid clusterizer, the digits clusterizer above is kept for the
+  // events or settings it does not handle
+  if (fUseNativeClusterizer) 
+  {
+    if (!fGridClusterizer) 
+      fGridClusterizer = new AliEMCALTowerGridClusterizer;
+    fGridClusterizer->Init(fEMCALGeo, fRecParam);
+  }
+
   return kTRUE;
 }
 
@@ -1766,6 +1803,105 @@ void AliEMCALTenderSupply::Clusterize()
   fClusterizer->Digits2Clusters("");
 }
 
+//_____________________________________________________
+Bool_t AliEMCALTenderSupply::UseNativeClusterizer()
+{
+  // Check if the event can be reclusterized on the tower grid: no unfolding
+  // and no MC labels to propagate from the cells or the original clusters.
+
+  if (!fUseNativeClusterizer || !fGridClusterizer)
+    return kFALSE;
+
+  if (!AliEMCALTowerGridClusterizer::IsClusterizerSupported(fRecParam->GetClusterizerFlag()))
+    return kFALSE;
+
+  if (fRecParam->GetUnfold())
+    return kFALSE;
+
+  if (fSetCellMCLabelFromCluster || fSetCellMCLabelFromEdepFrac || fRemapMCLabelForAODs || GetMCEvent())
+    return kFALSE;
+
+  return kTRUE;
+}
+
+//_____________________________________________________
+void AliEMCALTenderSupply::ClusterizeOnTowerGrid()
+{
+  // Reclusterize the cells on the tower grid and replace the EMCAL clusters
+  // of the event. Same cell selection as in FillDigitsArray.
+
+  AliVEvent *event = GetEvent();
+
+  if (!event)
+    return;
+
+  TClonesArray *clus = dynamic_cast<TClonesArray*>(event->FindListObject("caloClusters"));
+  if (!clus) 
+    clus = dynamic_cast<TClonesArray*>(event->FindListObject("CaloClusters"));
+  if (!clus) 
+  {
+    AliError(" Null pointer to calo clusters array, returning");
+    return;
+  }
+
+  fGridClusterizer->Reset();
+
+  AliVCaloCells *cells = event->GetEMCALCells();
+  Int_t ncells = cells->GetNumberOfCells();
+  for (Int_t icell = 0; icell < ncells; ++icell) 
+  {
+    Short_t  cellNumber = cells->GetCellNumber(icell);
+    Double_t amp        = cells->GetAmplitude(icell);
+
+    // Do not add if energy already too low (some cells set to 0 if bad channels)
+    if (amp < fRecParam->GetMinECut())
+      continue;
+
+    // If requested, do not include exotic cells
+    if (fEMCALRecoUtils->IsExoticCell(cellNumber,cells,event->GetBunchCrossNumber())) 
+      continue;
+
+    fGridClusterizer->AddTower(cellNumber, amp, cells->GetTime(icell));
+  }
+
+  fGridClusterizer->Clusterize();
+
+  // Validation: the event gets the clusters of the digit path, the tower
+  // grid clusters are only compared to them
+  if (fValidateNativeClusterizer)
+  {
+    if (!fGridClusters)
+      fGridClusters = new TClonesArray(clus->GetClass()->GetName());
+    fGridClusters->Delete();
+    fGridClusterizer->FillClusters(fGridClusters);
+
+    FillDigitsArray();
+    Clusterize();
+    UpdateClusters();
+
+    Int_t ndiff = AliEMCALTowerGridClusterizer::CompareClusters(clus, fGridClusters);
+    if (ndiff > 0)
+      AliWarning(Form("Tower grid clusterizer: %d cluster differences in this event", ndiff));
+    return;
+  }
+
+  Int_t nents = clus->GetEntriesFast();
+  for (Int_t i=0; i < nents; ++i) 
+  {
+    AliVCluster *c = dynamic_cast<AliVCluster*>(clus->At(i));
+    if (!c)
+      continue;
+    if (c->IsEMCAL())
+    {
+      delete clus->RemoveAt(i);
+    }
+  }
+  
+  clus->Compress();
+
+  fGridClusterizer->FillClusters(clus);
+}
+
 //_____________________________________________________
 void AliEMCALTenderSupply::UpdateClusters()
 {
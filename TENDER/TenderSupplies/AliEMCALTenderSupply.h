@@ -31,6 +31,7 @@ class TTree;
 class TFile;
 class TString;
 class AliEMCALClusterizer;
+class AliEMCALTowerGridClusterizer;
 class AliEMCALAfterBurnerUF;
 class AliEMCALRecParam;
 class AliAnalysisTaskSE;
@@ -122,6 +123,11 @@ public:
   void     SwitchOnReclustering()                         { fReClusterize = kTRUE            ;}
   void     SwitchOffReclustering()                        { fReClusterize = kFALSE           ;}
 
+  void     SwitchOnNativeClusterizer()                    { fUseNativeClusterizer = kTRUE    ;}
+  void     SwitchOffNativeClusterizer()                   { fUseNativeClusterizer = kFALSE   ;}
+  void     SwitchOnNativeClusterizerValidation()          { fValidateNativeClusterizer = kTRUE  ;}
+  void     SwitchOffNativeClusterizerValidation()         { fValidateNativeClusterizer = kFALSE ;}
+
   void     SwitchOnCutEtaPhiSum()                         { fCutEtaPhiSum=kTRUE;      fCutEtaPhiSeparate=kFALSE ;}
   void     SwitchOnCutEtaPhiSeparate()                    { fCutEtaPhiSeparate=kTRUE; fCutEtaPhiSum=kFALSE      ;}
   
@@ -208,12 +214,14 @@ private:
   Int_t      InitTimeCalibration();
   Int_t      InitTimeCalibrationL1Phase();
   void       Clusterize();
+  void       ClusterizeOnTowerGrid();
   void       FillDigitsArray();
   void       GetPass();
   void       RecPoints2Clusters(TClonesArray *clus);
   void       RecalibrateCells();
   void       UpdateCells();
   void       UpdateClusters();
+  Bool_t     UseNativeClusterizer();
 
   AliAnalysisTaskSE     *fTask;                   // analysis task
   Int_t                  fRun;                    // current run number
@@ -255,6 +263,10 @@ private:
   TString                fBasePath;               // base folder path to get root files 
   Bool_t                 fReClusterize;           // switch for reclustering
   AliEMCALClusterizer   *fClusterizer;            //!clusterizer 
+  Bool_t                 fUseNativeClusterizer;   // reclusterize on the tower grid, without digits and rec points
+  AliEMCALTowerGridClusterizer *fGridClusterizer; //!tower grid clusterizer
+  Bool_t                 fValidateNativeClusterizer; // keep the digit clusterizer output, compare the tower grid clusters to it
+  TClonesArray          *fGridClusters;           //!tower grid clusters in validation mode
   Bool_t                 fGeomMatrixSet;          // set geometry matrices only once, for the first event.         
   Bool_t                 fLoadGeomMatrices;       // matrices set from configuration, not get from geometry.root or from ESDs/AODs
   AliEMCALRecParam      *fRecParam;               // reconstruction parameters container
@@ -293,6 +305,6 @@ private:
   AliEMCALTenderSupply(            const AliEMCALTenderSupply&c);
   AliEMCALTenderSupply& operator= (const AliEMCALTenderSupply&c);
   
-  ClassDef(AliEMCALTenderSupply, 19); // EMCAL tender task
+  ClassDef(AliEMCALTenderSupply, 21); // EMCAL tender task
 };
 #endif
@@ -0,0 +1,640 @@
+/**************************************************************************
+ * Copyright(c) 1998-1999, ALICE Experiment at CERN, All rights reserved. *
+ *                                                                        *
+ * Author: The ALICE Off-line Project.                                    *
+ * Contributors are mentioned in the code where appropriate.              *
+ *                                                                        *
+ * Permission to use, copy, modify and distribute this software and its   *
+ * documentation strictly for non-commercial purposes is hereby granted   *
+ * without fee, provided that the above copyright notice appears in all   *
+ * copies and that both the copyright notice and this permission notice   *
+ * appear in the supporting documentation. The authors make no claims     *
+ * about the suitability of this software for any purpose. It is          *
+ * provided "as is" without express or implied warranty.                  *
+ **************************************************************************/
+
+#include <algorithm>
+
+#include <TClonesArray.h>
+#include <TMath.h>
+#include "AliEMCALEMCGeometry.h"
+#include "AliEMCALGeoParams.h"
+#include "AliEMCALGeometry.h"
+#include "AliEMCALRecParam.h"
+#include "AliLog.h"
+#include "AliVCluster.h"
+#include "AliEMCALTowerGridClusterizer.h"
+
+/// \cond CLASSIMP
+ClassImp(AliEMCALTowerGridClusterizer)
+/// \endcond
+
+namespace {
+  /// Orders towers by their position in the aggregation order
+  struct CompareOrder {
+    const std::vector<Int_t> &fOrder;
+    CompareOrder(const std::vector<Int_t> &order) : fOrder(order) {}
+    bool operator()(Int_t a, Int_t b) const { return fOrder[a] < fOrder[b]; }
+  };
+
+  /// Orders towers by decreasing energy
+  struct CompareEnergy {
+    const std::vector<Float_t> &fEnergy;
+    CompareEnergy(const std::vector<Float_t> &energy) : fEnergy(energy) {}
+    bool operator()(Int_t a, Int_t b) const { return fEnergy[a] > fEnergy[b]; }
+  };
+}
+
+//_____________________________________________________
+AliEMCALTowerGridClusterizer::AliEMCALTowerGridClusterizer() :
+  TObject()
+  ,fGeom(0)
+  ,fClusterizerFlag(AliEMCALRecParam::kClusterizerv1)
+  ,fSeedE(0.1)
+  ,fMinECut(0.05)
+  ,fTimeCut(1.)
+  ,fTimeMin(-1.)
+  ,fTimeMax(1.)
+  ,fLocMaxCut(0.03)
+  ,fW0(4.5)
+  ,fNRowDiff(1)
+  ,fNColDiff(1)
+  ,fNTowers(0)
+  ,fSM()
+  ,fRow()
+  ,fCol()
+  ,fNeighbours()
+  ,fSMGrid()
+  ,fEnergy()
+  ,fTime()
+  ,fOrder()
+  ,fClusterId()
+  ,fActive()
+  ,fSeeds()
+  ,fClusterOffsets(1, 0)
+  ,fClusterCells()
+  ,fCandidates()
+{
+  // Default constructor.
+}
+
+//_____________________________________________________
+AliEMCALTowerGridClusterizer::~AliEMCALTowerGridClusterizer()
+{
+  // Destructor.
+}
+
+//_____________________________________________________
+Bool_t AliEMCALTowerGridClusterizer::IsClusterizerSupported(Int_t clusterizerFlag)
+{
+  // Clusterizer types which can be run on the tower grid.
+
+  return (clusterizerFlag == AliEMCALRecParam::kClusterizerv1 ||
+          clusterizerFlag == AliEMCALRecParam::kClusterizerv2 ||
+          clusterizerFlag == AliEMCALRecParam::kClusterizerNxN);
+}
+
+//_____________________________________________________
+void AliEMCALTowerGridClusterizer::Init(AliEMCALGeometry *geom, const AliEMCALRecParam *recParam)
+{
+  // Take the clusterization parameters from the reconstruction parameters,
+  // build the neighbour table if the geometry changed.
+
+  fClusterizerFlag = recParam->GetClusterizerFlag();
+  fSeedE           = recParam->GetClusteringThreshold();
+  fMinECut         = recParam->GetMinECut();
+  fTimeCut         = recParam->GetTimeCut();
+  fTimeMin         = recParam->GetTimeMin();
+  fTimeMax         = recParam->GetTimeMax();
+  fLocMaxCut       = recParam->GetLocMaxCut();
+  fW0              = recParam->GetW0();
+  fNRowDiff        = recParam->GetNRowDiff();
+  fNColDiff        = recParam->GetNColDiff();
+
+  if (!IsClusterizerSupported(fClusterizerFlag))
+    AliError(Form("Clusterizer < %d > not available on the tower grid", fClusterizerFlag));
+
+  if (geom != fGeom) {
+    fGeom = geom;
+    BuildNeighbourTable();
+  }
+}
+
+//_____________________________________________________
+void AliEMCALTowerGridClusterizer::BuildNeighbourTable()
+{
+  // Store super module, row and column of each tower, and the towers
+  // with a common side. Towers at eta=0 of the two super modules at the
+  // same phi position are neighbours, as in AliEMCALClusterizerv1::AreNeighbours.
+
+  const Int_t nRows = AliEMCALGeoParams::fgkEMCALRows;
+  const Int_t nCols = AliEMCALGeoParams::fgkEMCALCols;
+  const Int_t nSM   = fGeom->GetNumberOfSuperModules();
+
+  fNTowers = fGeom->GetNCells();
+  fSM   .assign(fNTowers, -1);
+  fRow  .assign(fNTowers, -1);
+  fCol  .assign(fNTowers, -1);
+  fSMGrid.assign(nSM * nRows * nCols, -1);
+  fNeighbours.assign(4 * fNTowers, -1);
+
+  for (Int_t absId = 0; absId < fNTowers; ++absId) {
+    if (!fGeom->CheckAbsCellId(absId))
+      continue;
+    Int_t iSM = -1, iMod = -1, iPhiMod = -1, iEtaMod = -1, iPhi = -1, iEta = -1;
+    fGeom->GetCellIndex(absId, iSM, iMod, iPhiMod, iEtaMod);
+    fGeom->GetCellPhiEtaIndexInSModule(iSM, iMod, iPhiMod, iEtaMod, iPhi, iEta);
+    fSM [absId] = iSM;
+    fRow[absId] = iPhi;
+    fCol[absId] = iEta;
+    fSMGrid[(iSM * nRows + iPhi) * nCols + iEta] = absId;
+  }
+
+  // Super module at the same phi position
+  std::vector<Int_t> partner(nSM, -1);
+  for (Int_t iSM1 = 0; iSM1 < nSM; ++iSM1) {
+    for (Int_t iSM2 = iSM1 + 1; iSM2 < nSM && partner[iSM1] < 0; ++iSM2) {
+      if (partner[iSM2] >= 0)
+        continue;
+      Float_t smPhi1 = fGeom->GetEMCGeometry()->GetPhiCenterOfSM(iSM1);
+      Float_t smPhi2 = fGeom->GetEMCGeometry()->GetPhiCenterOfSM(iSM2);
+      if (TMath::AreEqualAbs(smPhi1, smPhi2, 1e-3)) {
+        partner[iSM1] = iSM2;
+        partner[iSM2] = iSM1;
+      }
+    }
+  }
+
+  for (Int_t absId = 0; absId < fNTowers; ++absId) {
+    const Int_t iSM = fSM[absId];
+    if (iSM < 0)
+      continue;
+    const Int_t iPhi = fRow[absId];
+    const Int_t iEta = fCol[absId];
+    Int_t *neighbours = &fNeighbours[4 * absId];
+    if (iPhi > 0)
+      neighbours[0] = fSMGrid[(iSM * nRows + iPhi - 1) * nCols + iEta];
+    if (iPhi < nRows - 1)
+      neighbours[1] = fSMGrid[(iSM * nRows + iPhi + 1) * nCols + iEta];
+    // the columns of the C side (odd) super module continue the ones of the A side (even)
+    if (iEta > 0)
+      neighbours[2] = fSMGrid[(iSM * nRows + iPhi) * nCols + iEta - 1];
+    else if (iSM % 2 && partner[iSM] >= 0)
+      neighbours[2] = fSMGrid[(partner[iSM] * nRows + iPhi) * nCols + nCols - 1];
+    if (iEta < nCols - 1)
+      neighbours[3] = fSMGrid[(iSM * nRows + iPhi) * nCols + iEta + 1];
+    else if (!(iSM % 2) && partner[iSM] >= 0)
+      neighbours[3] = fSMGrid[(partner[iSM] * nRows + iPhi) * nCols];
+  }
+
+  fEnergy   .assign(fNTowers, 0);
+  fTime     .assign(fNTowers, 0);
+  fOrder    .assign(fNTowers, -1);
+  fClusterId.assign(fNTowers, -1);
+  fActive.clear();
+}
+
+//_____________________________________________________
+void AliEMCALTowerGridClusterizer::Reset()
+{
+  // Clear the towers and clusters of the previous event.
+
+  for (UInt_t i = 0; i < fActive.size(); ++i) {
+    const Int_t absId = fActive[i];
+    fEnergy   [absId] = 0;
+    fTime     [absId] = 0;
+    fOrder    [absId] = -1;
+    fClusterId[absId] = -1;
+  }
+  fActive.clear();
+  fClusterOffsets.assign(1, 0);
+  fClusterCells.clear();
+}
+
+//_____________________________________________________
+void AliEMCALTowerGridClusterizer::AddTower(Int_t absId, Float_t energy, Float_t time)
+{
+  // Add a calibrated cell. Cells below the minimum energy or outside
+  // the time window are not used, as in AliEMCALClusterizerv1::MakeClusters.
+
+  if (absId < 0 || absId >= fNTowers || fSM[absId] < 0)
+    return;
+  if (energy < fMinECut || time > fTimeMax || time < fTimeMin)
+    return;
+  if (fEnergy[absId] > 0) {
+    AliWarning(Form("Tower %d added twice, keeping the first one", absId));
+    return;
+  }
+
+  fEnergy[absId] = energy;
+  fTime  [absId] = time;
+  fActive.push_back(absId);
+}
+
+//_____________________________________________________
+Int_t AliEMCALTowerGridClusterizer::Clusterize()
+{
+  // Aggregate the towers into clusters. Return the number of clusters.
+
+  fClusterOffsets.assign(1, 0);
+  fClusterCells.clear();
+
+  // Seeds are taken in input order (v1) or in decreasing energy (v2, NxN);
+  // the same order is used to add the neighbours of a cell
+  fSeeds = fActive;
+  const Bool_t sorted = (fClusterizerFlag != AliEMCALRecParam::kClusterizerv1);
+  if (sorted)
+    std::stable_sort(fSeeds.begin(), fSeeds.end(), CompareEnergy(fEnergy));
+  for (UInt_t i = 0; i < fSeeds.size(); ++i)
+    fOrder[fSeeds[i]] = i;
+
+  for (UInt_t i = 0; i < fSeeds.size(); ++i) {
+    const Int_t seed = fSeeds[i];
+    if (fClusterId[seed] >= 0)
+      continue;
+    if (fEnergy[seed] <= fSeedE) {
+      if (sorted) break;
+      continue;
+    }
+
+    const Int_t iclus = fClusterOffsets.size() - 1;
+    AddToCluster(seed, iclus);
+    if (fClusterizerFlag == AliEMCALRecParam::kClusterizerNxN)
+      MakeFixedWindowCluster(seed, iclus);
+    else
+      GrowCluster(iclus, fTime[seed], fClusterizerFlag == AliEMCALRecParam::kClusterizerv2);
+    fClusterOffsets.push_back(fClusterCells.size());
+  }
+
+  return fClusterOffsets.size() - 1;
+}
+
+//_____________________________________________________
+void AliEMCALTowerGridClusterizer::AddToCluster(Int_t absId, Int_t iclus)
+{
+  // Assign a tower to a cluster.
+
+  fClusterId[absId] = iclus;
+  fClusterCells.push_back(absId);
+}
+
+//_____________________________________________________
+void AliEMCALTowerGridClusterizer::GrowCluster(Int_t iclus, Float_t seedTime, Bool_t gradient)
+{
+  // Add the free neighbours of the cells of the cluster, including the cells
+  // added in the process. With the gradient condition (v2) a neighbour is only
+  // added if its energy is below the one of the cell plus the local maximum cut.
+
+  for (UInt_t i = fClusterOffsets.back(); i < fClusterCells.size(); ++i) {
+    const Int_t absId = fClusterCells[i];
+    fCandidates.clear();
+    for (Int_t k = 0; k < 4; ++k) {
+      const Int_t absIdN = fNeighbours[4 * absId + k];
+      if (absIdN < 0 || fOrder[absIdN] < 0 || fClusterId[absIdN] >= 0)
+        continue;
+      if (TMath::Abs(seedTime - fTime[absIdN]) > fTimeCut)
+        continue;
+      if (gradient && fEnergy[absIdN] > fEnergy[absId] + fLocMaxCut)
+        continue;
+      fCandidates.push_back(absIdN);
+    }
+    std::sort(fCandidates.begin(), fCandidates.end(), CompareOrder(fOrder));
+    for (UInt_t j = 0; j < fCandidates.size(); ++j)
+      AddToCluster(fCandidates[j], iclus);
+  }
+}
+
+//_____________________________________________________
+void AliEMCALTowerGridClusterizer::MakeFixedWindowCluster(Int_t seed, Int_t iclus)
+{
+  // Add the free towers of the same super module within fNRowDiff rows
+  // and fNColDiff columns of the seed (NxN).
+
+  const Int_t nRows = AliEMCALGeoParams::fgkEMCALRows;
+  const Int_t nCols = AliEMCALGeoParams::fgkEMCALCols;
+  const Int_t iSM   = fSM[seed];
+
+  fCandidates.clear();
+  for (Int_t iPhi = TMath::Max(fRow[seed] - fNRowDiff, 0); iPhi <= TMath::Min(fRow[seed] + fNRowDiff, nRows - 1); ++iPhi) {
+    for (Int_t iEta = TMath::Max(fCol[seed] - fNColDiff, 0); iEta <= TMath::Min(fCol[seed] + fNColDiff, nCols - 1); ++iEta) {
+      const Int_t absIdN = fSMGrid[(iSM * nRows + iPhi) * nCols + iEta];
+      if (absIdN < 0 || fOrder[absIdN] < 0 || fClusterId[absIdN] >= 0)
+        continue;
+      if (TMath::Abs(fTime[seed] - fTime[absIdN]) > fTimeCut)
+        continue;
+      fCandidates.push_back(absIdN);
+    }
+  }
+  std::sort(fCandidates.begin(), fCandidates.end(), CompareOrder(fOrder));
+  for (UInt_t j = 0; j < fCandidates.size(); ++j)
+    AddToCluster(fCandidates[j], iclus);
+}
+
+//_____________________________________________________
+Bool_t AliEMCALTowerGridClusterizer::AreCornerNeighbours(Int_t absId1, Int_t absId2) const
+{
+  // Towers of the same super module sharing a side or a corner.
+
+  if (fSM[absId1] != fSM[absId2])
+    return kFALSE;
+  const Int_t rowdiff = TMath::Abs(fRow[absId1] - fRow[absId2]);
+  const Int_t coldiff = TMath::Abs(fCol[absId1] - fCol[absId2]);
+  return (rowdiff <= 1 && coldiff <= 1 && rowdiff + coldiff > 0);
+}
+
+//_____________________________________________________
+Int_t AliEMCALTowerGridClusterizer::GetNumberOfLocalMaxima(Int_t iclus) const
+{
+  // Number of local maxima, with fLocMaxCut as minimum energy
+  // difference between two maxima, as in AliEMCALRecPoint::GetNumberOfLocalMax.
+
+  const Int_t first = fClusterOffsets[iclus];
+  const Int_t n     = fClusterOffsets[iclus + 1] - first;
+  std::vector<Bool_t> isMax(n, kTRUE);
+
+  for (Int_t i = 0; i < n; ++i) {
+    if (!isMax[i])
+      continue;
+    const Int_t absId = fClusterCells[first + i];
+    for (Int_t j = 0; j < n; ++j) {
+      if (j == i)
+        continue;
+      const Int_t absIdN = fClusterCells[first + j];
+      if (!AreCornerNeighbours(absId, absIdN))
+        continue;
+      if (fEnergy[absId] > fEnergy[absIdN]) {
+        isMax[j] = kFALSE;
+        if (fEnergy[absId] < fEnergy[absIdN] + fLocMaxCut)
+          isMax[i] = kFALSE;
+      } else {
+        isMax[i] = kFALSE;
+        if (fEnergy[absId] > fEnergy[absIdN] - fLocMaxCut)
+          isMax[j] = kFALSE;
+      }
+    }
+  }
+
+  Int_t nMax = 0;
+  for (Int_t i = 0; i < n; ++i)
+    if (isMax[i]) ++nMax;
+  return nMax;
+}
+
+//_____________________________________________________
+Double_t AliEMCALTowerGridClusterizer::TmaxInCm(Double_t e) const
+{
+  // Depth of the shower maximum of a photon of energy e (GeV),
+  // as in AliEMCALRecPoint::TmaxInCm.
+
+  const Double_t ca = 4.82; // ln(1000/8.07)
+  Double_t x0 = 1.31;       // radiation length (cm)
+  if (!TString(fGeom->GetEMCGeometry()->GetGeoName()).Contains("V1"))
+    x0 = 1.28;
+
+  Double_t tmax = 0.;
+  if (e > 0.1)
+    tmax = (TMath::Log(e) + ca + 0.5) * x0;
+  return tmax;
+}
+
+//_____________________________________________________
+void AliEMCALTowerGridClusterizer::EvalGlobalPosition(Int_t iclus, Float_t energy, Float_t *pos) const
+{
+  // Logarithmically weighted center of gravity of the cells, each cell taken
+  // at the depth of the shower maximum of the cluster in global coordinates,
+  // as in AliEMCALRecPoint::EvalGlobalPosition.
+
+  const Int_t    first = fClusterOffsets[iclus];
+  const Int_t    last  = fClusterOffsets[iclus + 1];
+  const Double_t dist  = TmaxInCm(energy);
+
+  Double_t xyz[3] = {0., 0., 0.}, wtot = 0.;
+  for (Int_t i = first; i < last; ++i) {
+    const Int_t absId = fClusterCells[i];
+    Double_t w = (fW0 > 0) ? TMath::Max(0., fW0 + TMath::Log(fEnergy[absId] / energy)) : fEnergy[absId];
+    if (w <= 0)
+      continue;
+    Double_t loc[3], glob[3];
+    fGeom->RelPosCellInSModule(absId, dist, loc[0], loc[1], loc[2]);
+    fGeom->GetGlobal(loc, glob, fSM[absId]);
+    wtot += w;
+    for (Int_t k = 0; k < 3; ++k)
+      xyz[k] += w * glob[k];
+  }
+
+  for (Int_t k = 0; k < 3; ++k)
+    pos[k] = (wtot > 0) ? xyz[k] / wtot : -1.;
+}
+
+//_____________________________________________________
+void AliEMCALTowerGridClusterizer::EvalShowerShape(Int_t iclus, Float_t energy, Float_t &dispersion, Float_t &l0, Float_t &l1) const
+{
+  // Dispersion and axes of the shower ellipse in cell units, with logarithmic
+  // weights, as in AliEMCALRecPoint::EvalDispersion and EvalElipsAxis. For
+  // clusters shared by the two super modules of a phi rack the columns of
+  // the C side continue the ones of the A side.
+
+  const Int_t first = fClusterOffsets[iclus];
+  const Int_t last  = fClusterOffsets[iclus + 1];
+  const Int_t nCols = AliEMCALGeoParams::fgkEMCALCols;
+
+  Bool_t shared = kFALSE;
+  for (Int_t i = first + 1; i < last && !shared; ++i)
+    shared = (fSM[fClusterCells[i]] != fSM[fClusterCells[first]]);
+
+  Double_t wtot = 0., eta = 0., phi = 0., dxx = 0., dzz = 0., dxz = 0.;
+  Int_t    nstat = 0;
+  for (Int_t i = first; i < last; ++i) {
+    const Int_t absId = fClusterCells[i];
+    const Double_t w = TMath::Max(0., fW0 + TMath::Log(fEnergy[absId] / energy));
+    if (w <= 0)
+      continue;
+    const Double_t etai = fCol[absId] + ((shared && fSM[absId] % 2) ? nCols : 0);
+    const Double_t phii = fRow[absId];
+    ++nstat;
+    wtot += w;
+    eta  += w * etai;
+    phi  += w * phii;
+    dxx  += w * etai * etai;
+    dzz  += w * phii * phii;
+    dxz  += w * etai * phii;
+  }
+
+  dispersion = l0 = l1 = 0;
+  if (wtot <= 0)
+    return;
+
+  eta /= wtot;
+  phi /= wtot;
+  dxx  = dxx / wtot - eta * eta;
+  dzz  = dzz / wtot - phi * phi;
+  dxz  = dxz / wtot - eta * phi;
+
+  // sum of w*((eta_i-<eta>)^2+(phi_i-<phi>)^2)/wtot
+  if (nstat > 1 && dxx + dzz > 0)
+    dispersion = TMath::Sqrt(dxx + dzz);
+
+  const Double_t root = TMath::Sqrt(0.25 * (dxx - dzz) * (dxx - dzz) + dxz * dxz);
+  const Double_t lambda0 = 0.5 * (dxx + dzz) + root;
+  const Double_t lambda1 = 0.5 * (dxx + dzz) - root;
+  if (lambda0 > 0) l0 = TMath::Sqrt(lambda0);
+  if (lambda1 > 0) l1 = TMath::Sqrt(lambda1);
+}
+
+//_____________________________________________________
+Int_t AliEMCALTowerGridClusterizer::FillClusters(TClonesArray *clus) const
+{
+  // Append the clusters to the ESD/AOD cluster array, with the same content
+  // as the digit path (AliEMCALRecPoint::EvalAll and the conversion of the
+  // rec points in the callers): energy, cells, time of the most energetic
+  // cell, number of local maxima, global position, dispersion and shower
+  // shape. Return the number of clusters added.
+
+  const Int_t nClusters = fClusterOffsets.size() - 1;
+  std::vector<UShort_t>   absIds;
+  std::vector<Double32_t> fractions;
+
+  for (Int_t iclus = 0, nout = clus->GetEntriesFast(); iclus < nClusters; ++iclus) {
+    const Int_t first  = fClusterOffsets[iclus];
+    const Int_t ncells = fClusterOffsets[iclus + 1] - first;
+
+    absIds.resize(ncells);
+    fractions.assign(ncells, 1.);
+    Float_t energy = 0;
+    Int_t   maxId  = fClusterCells[first];
+    for (Int_t c = 0; c < ncells; ++c) {
+      const Int_t absId = fClusterCells[first + c];
+      absIds[c] = absId;
+      energy += fEnergy[absId];
+      if (fEnergy[absId] > fEnergy[maxId])
+        maxId = absId;
+    }
+
+    Float_t pos[3];
+    EvalGlobalPosition(iclus, energy, pos);
+    Float_t dispersion = 0, l0 = 0, l1 = 0;
+    EvalShowerShape(iclus, energy, dispersion, l0, l1);
+
+    AliVCluster *c = static_cast<AliVCluster*>(clus->New(nout++));
+    c->SetID(nout-1);
+    c->SetType(AliVCluster::kEMCALClusterv1);
+    c->SetE(energy);
+    c->SetPosition(pos);
+    c->SetNCells(ncells);
+    c->SetDispersion(dispersion);
+    c->SetCellsAbsId(&absIds[0]);
+    c->SetCellsAmplitudeFraction(&fractions[0]);
+    c->SetEmcCpvDistance(-1);
+    c->SetChi2(-1);
+    c->SetTOF(fTime[maxId]);
+    c->SetNExMax(GetNumberOfLocalMaxima(iclus));
+    c->SetM02(l0 * l0);
+    c->SetM20(l1 * l1);
+  }
+
+  return nClusters;
+}
+
+//_____________________________________________________
+Int_t AliEMCALTowerGridClusterizer::CompareClusters(const TClonesArray *ref, const TClonesArray *test, Int_t firstRef, Int_t firstTest)
+{
+  // Validation of the tower grid clusters (test) against the ones of the
+  // digit clusterizer (ref) of the same event. The EMCal clusters are matched
+  // by their smallest cell id (GetClusterKey). A pair is counted as different if
+  //  - the cells are not the same, or the number of local maxima differs,
+  //  - the energies differ by more than kRelTolE (relative),
+  //  - the positions differ by more than kPosTol (cm) in any coordinate,
+  //  - the dispersion, M02 or M20 differ by more than kShapeTol (cell units),
+  //  - the time differs by more than kTimeTol (s).
+  // The tolerances only absorb the float rounding of the different summation
+  // order. Unmatched clusters on either side are also counted.
+  // Return the number of differences, each one is reported with AliWarning.
+
+  const Double_t kRelTolE  = 1e-5;
+  const Double_t kPosTol   = 1e-3;
+  const Double_t kShapeTol = 1e-4;
+  const Double_t kTimeTol  = 1e-12;
+
+  std::vector<const AliVCluster*> refs;
+  for (Int_t i = firstRef; i < ref->GetEntriesFast(); ++i) {
+    const AliVCluster *c = static_cast<const AliVCluster*>(ref->At(i));
+    if (c && c->IsEMCAL())
+      refs.push_back(c);
+  }
+  std::vector<Bool_t> matched(refs.size(), kFALSE);
+
+  Int_t ndiff = 0;
+  for (Int_t i = firstTest; i < test->GetEntriesFast(); ++i) {
+    const AliVCluster *t = static_cast<const AliVCluster*>(test->At(i));
+    if (!t || !t->IsEMCAL())
+      continue;
+
+    const AliVCluster *r = 0;
+    const Int_t key = GetClusterKey(t);
+    for (UInt_t j = 0; j < refs.size() && !r; ++j) {
+      if (!matched[j] && GetClusterKey(refs[j]) == key) {
+        r = refs[j];
+        matched[j] = kTRUE;
+      }
+    }
+    if (!r) {
+      AliWarningClass(Form("Cluster with first cell %d (E=%.4f) not found in the reference", key, t->E()));
+      ++ndiff;
+      continue;
+    }
+
+    Bool_t sameCells = (r->GetNCells() == t->GetNCells());
+    for (Int_t k = 0; k < t->GetNCells() && sameCells; ++k) {
+      Bool_t found = kFALSE;
+      for (Int_t l = 0; l < r->GetNCells() && !found; ++l)
+        found = (r->GetCellAbsId(l) == t->GetCellAbsId(k));
+      sameCells = found;
+    }
+
+    Float_t pr[3], pt[3];
+    r->GetPosition(pr);
+    t->GetPosition(pt);
+    Bool_t samePos = kTRUE;
+    for (Int_t k = 0; k < 3; ++k)
+      samePos = samePos && TMath::Abs(pr[k] - pt[k]) <= kPosTol;
+
+    const Bool_t same = sameCells && samePos &&
+      r->GetNExMax() == t->GetNExMax() &&
+      TMath::Abs(r->E() - t->E()) <= kRelTolE * r->E() &&
+      TMath::Abs(r->GetDispersion() - t->GetDispersion()) <= kShapeTol &&
+      TMath::Abs(r->GetM02() - t->GetM02()) <= kShapeTol &&
+      TMath::Abs(r->GetM20() - t->GetM20()) <= kShapeTol &&
+      TMath::Abs(r->GetTOF() - t->GetTOF()) <= kTimeTol;
+
+    if (!same) {
+      AliWarningClass(Form("Cluster with first cell %d differs: ncells %d/%d, E %.5f/%.5f, pos (%.3f,%.3f,%.3f)/(%.3f,%.3f,%.3f), disp %.4f/%.4f, M02 %.4f/%.4f, M20 %.4f/%.4f, NLM %d/%d",
+                             key, r->GetNCells(), t->GetNCells(), r->E(), t->E(),
+                             pr[0], pr[1], pr[2], pt[0], pt[1], pt[2],
+                             r->GetDispersion(), t->GetDispersion(), r->GetM02(), t->GetM02(),
+                             r->GetM20(), t->GetM20(), r->GetNExMax(), t->GetNExMax()));
+      ++ndiff;
+    }
+  }
+
+  for (UInt_t j = 0; j < refs.size(); ++j) {
+    if (!matched[j]) {
+      AliWarningClass(Form("Reference cluster with first cell %d (E=%.4f) not found on the tower grid", GetClusterKey(refs[j]), refs[j]->E()));
+      ++ndiff;
+    }
+  }
+
+  return ndiff;
+}
+
+//_____________________________________________________
+Int_t AliEMCALTowerGridClusterizer::GetClusterKey(const AliVCluster *c)
+{
+  // Smallest absolute id of the cells of the cluster. Clusters with the same
+  // cells have the same key, whatever the order of their cells.
+
+  Int_t minId = -1;
+  for (Int_t k = 0; k < c->GetNCells(); ++k)
+    if (minId < 0 || c->GetCellAbsId(k) < minId)
+      minId = c->GetCellAbsId(k);
+  return minId;
+}
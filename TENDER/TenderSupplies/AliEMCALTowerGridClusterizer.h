@@ -0,0 +1,112 @@
+#ifndef ALIEMCALTOWERGRIDCLUSTERIZER_H
+#define ALIEMCALTOWERGRIDCLUSTERIZER_H
+
+/* Copyright(c) 1998-1999, ALICE Experiment at CERN, All rights reserved. *
+ * See cxx source for full Copyright notice                               */
+
+///
+/// \class AliEMCALTowerGridClusterizer
+/// \brief Clusterizer working directly on a flat grid of EMCal towers
+///
+/// Clusterizes calorimeter cells without going through AliEMCALDigit and
+/// AliEMCALRecPoint objects. The cells of the event are stored in flat
+/// arrays indexed by tower absolute id, the neighbour relations of the towers
+/// are computed once per geometry, and the clusters are written directly as
+/// AliVCluster objects.
+///
+/// The cells are aggregated following the rules of AliEMCALClusterizerv1
+/// (seeds in input order, neighbours with a common side, also across the two
+/// super modules of a phi rack), AliEMCALClusterizerv2 (seeds in decreasing
+/// energy, a neighbour is only added if its energy does not exceed the one of
+/// the cell it is attached to by more than the local maximum cut) and
+/// AliEMCALClusterizerNxN (fixed window around the seeds in decreasing energy).
+/// The cluster position (logarithmic weights, cells at the depth of the shower
+/// maximum), dispersion and shower shape are calculated as in AliEMCALRecPoint.
+/// CompareClusters() checks the clusters against the ones of the digit path,
+/// see the validation switches of the callers.
+///
+/// Unfolding, uncalibrated input, pedestal based bad channel rejection and
+/// MC labels are not handled: the callers keep the digit based clusterizers
+/// for these cases.
+///
+/// Used by AliEMCALTenderSupply and AliEmcalCorrectionClusterizer.
+///
+
+#include <vector>
+
+#include <TObject.h>
+
+class TClonesArray;
+class AliEMCALGeometry;
+class AliEMCALRecParam;
+class AliVCluster;
+
+class AliEMCALTowerGridClusterizer : public TObject {
+
+public:
+  AliEMCALTowerGridClusterizer();
+  virtual ~AliEMCALTowerGridClusterizer();
+
+  static Bool_t IsClusterizerSupported(Int_t clusterizerFlag);
+
+  void     Init(AliEMCALGeometry *geom, const AliEMCALRecParam *recParam);
+  void     Reset();
+  void     AddTower(Int_t absId, Float_t energy, Float_t time);
+  Int_t    Clusterize();
+  Int_t    FillClusters(TClonesArray *clus) const;
+
+  static Int_t CompareClusters(const TClonesArray *ref, const TClonesArray *test, Int_t firstRef = 0, Int_t firstTest = 0);
+
+  Int_t    GetNumberOfTowers()                      const { return fActive.size()            ;}
+  Int_t    GetNumberOfClusters()                    const { return fClusterOffsets.size() - 1;}
+
+private:
+  void     BuildNeighbourTable();
+  void     AddToCluster(Int_t absId, Int_t iclus);
+  void     GrowCluster(Int_t iclus, Float_t seedTime, Bool_t gradient);
+  void     MakeFixedWindowCluster(Int_t seed, Int_t iclus);
+  Int_t    GetNumberOfLocalMaxima(Int_t iclus) const;
+  Bool_t   AreCornerNeighbours(Int_t absId1, Int_t absId2) const;
+  Double_t TmaxInCm(Double_t e) const;
+  void     EvalGlobalPosition(Int_t iclus, Float_t energy, Float_t *pos) const;
+  void     EvalShowerShape(Int_t iclus, Float_t energy, Float_t &dispersion, Float_t &l0, Float_t &l1) const;
+  static Int_t GetClusterKey(const AliVCluster *c);
+
+  AliEMCALGeometry     *fGeom;                    //!<! geometry used to build the neighbour table
+  Int_t                 fClusterizerFlag;         ///< clusterizer type (AliEMCALRecParam::AliEMCALClusterizerFlag)
+  Float_t               fSeedE;                   ///< minimum seed energy
+  Float_t               fMinECut;                 ///< minimum cell energy
+  Float_t               fTimeCut;                 ///< maximum time difference to the seed
+  Float_t               fTimeMin;                 ///< minimum cell time
+  Float_t               fTimeMax;                 ///< maximum cell time
+  Float_t               fLocMaxCut;               ///< energy difference for the gradient and the local maxima
+  Float_t               fW0;                      ///< logarithmic weight of the position and shower shape
+  Int_t                 fNRowDiff;                ///< half window in rows (NxN)
+  Int_t                 fNColDiff;                ///< half window in columns (NxN)
+
+  Int_t                 fNTowers;                 //!<! number of towers of the geometry
+  std::vector<Int_t>    fSM;                      //!<! super module of each tower
+  std::vector<Int_t>    fRow;                     //!<! phi index in the super module of each tower
+  std::vector<Int_t>    fCol;                     //!<! eta index in the super module of each tower
+  std::vector<Int_t>    fNeighbours;              //!<! 4 towers with a common side [4*absId+k], -1 if none
+  std::vector<Int_t>    fSMGrid;                  //!<! absId from (super module, row, column)
+
+  std::vector<Float_t>  fEnergy;                  //!<! energy of each tower in this event
+  std::vector<Float_t>  fTime;                    //!<! time of each tower in this event
+  std::vector<Int_t>    fOrder;                   //!<! position of each tower in the aggregation order, -1 if not used
+  std::vector<Int_t>    fClusterId;               //!<! cluster of each tower, -1 if not clustered
+  std::vector<Int_t>    fActive;                  //!<! towers of this event, in input order
+  std::vector<Int_t>    fSeeds;                   //!<! towers of this event, in aggregation order
+  std::vector<Int_t>    fClusterOffsets;          //!<! index of the first cell of each cluster in fClusterCells
+  std::vector<Int_t>    fClusterCells;            //!<! cells of the clusters, in order of aggregation
+  std::vector<Int_t>    fCandidates;              //!<! neighbours of the cell being processed
+
+  AliEMCALTowerGridClusterizer(const AliEMCALTowerGridClusterizer&);
+  AliEMCALTowerGridClusterizer& operator=(const AliEMCALTowerGridClusterizer&);
+
+  /// \cond CLASSIMP
+  ClassDef(AliEMCALTowerGridClusterizer, 2); // EMCal clusterizer on a flat tower grid
+  /// \endcond
+};
+
+#endif
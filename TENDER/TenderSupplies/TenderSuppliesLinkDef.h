@@ -13,6 +13,7 @@
 #pragma link C++ class AliVtxTenderSupply+;
 #pragma link C++ class AliVZEROTenderSupply+;
 #pragma link C++ class AliEMCALTenderSupply+;
+#pragma link C++ class AliEMCALTowerGridClusterizer+;
 #pragma link C++ class AliPHOSTenderSupply+;
 #pragma link C++ class AliHMPIDTenderSupply+;
 #pragma link C++ class AliT0TenderSupply+;